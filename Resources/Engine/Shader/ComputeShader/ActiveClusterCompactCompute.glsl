@@ -0,0 +1,67 @@
+/**
+ * @brief This compute shader compacts the clusters flagged by the mark shader into the active cluster list, and counts
+ * the work groups of the light culling dispatch issued over that list.
+ */
+
+#version 430 core
+
+#define LOCAL_SIZE 128
+// Local size of the shaders dispatched over the active clusters, defined by the application
+#ifndef CULLING_LOCAL_SIZE
+#define CULLING_LOCAL_SIZE 128
+#endif
+layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+struct Cluster
+{
+    vec4 minAABB_VS;
+    vec4 maxAABB_VS;
+    uint lightOffset;
+    uint lightCount;
+};
+
+layout(std430, binding = 1) buffer ClusterInfoBlock
+{
+    uint xCount;
+    uint yCount;
+    uint zCount;
+    Cluster clusters[];
+};
+
+// Indirect dispatch arguments of the light culling, followed by the active clusters. Reset before the mark shader.
+layout(std430, binding = 7) buffer ActiveClusterBlock
+{
+    uint groupCountX;
+    uint groupCountY;
+    uint groupCountZ;
+    uint activeClusterCount;
+    uint activeClusters[];
+};
+
+layout(std430, binding = 8) buffer ClusterFlagBlock
+{
+    uint clusterFlags[];
+};
+
+void main()
+{
+    uint clusterIndex = gl_GlobalInvocationID.x;
+    if (clusterIndex >= xCount * yCount * zCount)
+        return;
+
+    // Inactive clusters are not culled this frame: their previous light range would be stale, so it is emptied
+    if (clusterFlags[clusterIndex] == 0u)
+    {
+        clusters[clusterIndex].lightCount = 0u;
+        return;
+    }
+
+    clusterFlags[clusterIndex] = 0u;
+
+    uint slot = atomicAdd(activeClusterCount, 1u);
+    activeClusters[slot] = clusterIndex;
+
+    // One more culling work group every CULLING_LOCAL_SIZE active clusters
+    if (slot % uint(CULLING_LOCAL_SIZE) == 0u)
+        atomicAdd(groupCountX, 1u);
+}
@@ -0,0 +1,63 @@
+/**
+ * @brief This compute shader flags the clusters holding at least one depth sample of the depth prepass.
+ * Each invocation handles a pixel, and finds its cluster the same way the fragment shaders do.
+ */
+
+#version 430 core
+
+#define LOCAL_SIZE 16
+layout(local_size_x = LOCAL_SIZE, local_size_y = LOCAL_SIZE, local_size_z = 1) in;
+
+struct Cluster
+{
+    vec4 minAABB_VS;
+    vec4 maxAABB_VS;
+    uint lightOffset;
+    uint lightCount;
+};
+
+layout(std430, binding = 1) readonly buffer ClusterInfoBlock
+{
+    uint xCount;
+    uint yCount;
+    uint zCount;
+    Cluster clusters[];
+};
+
+// One flag per cluster, cleared by the compaction shader
+layout(std430, binding = 8) writeonly buffer ClusterFlagBlock
+{
+    uint clusterFlags[];
+};
+
+uniform sampler2D u_Depth;
+uniform mat4 u_InvProjection;
+uniform float u_Near;
+uniform float u_Far;
+
+void main()
+{
+    ivec2 depthSize = textureSize(u_Depth, 0);
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if (pixel.x >= depthSize.x || pixel.y >= depthSize.y)
+        return;
+
+    // Nothing was drawn on this pixel
+    float depth = texelFetch(u_Depth, pixel, 0).r;
+    if (depth >= 1.0)
+        return;
+
+    // Back to view space, to get the camera depth the fragment shaders compute from the vertex position
+    vec4 position_NDC = vec4((vec2(pixel) + 0.5) / vec2(depthSize) * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 position_VS = u_InvProjection * position_NDC;
+    float cameraDepth = -position_VS.z / position_VS.w;
+
+    uint zCoord = uint((log(abs(cameraDepth) / u_Near) * zCount) / log(u_Far / u_Near));
+    vec2 clusterSizeXY = vec2(depthSize) / vec2(xCount, yCount);
+    uvec2 xyCoords = uvec2((vec2(pixel) + 0.5) / clusterSizeXY);
+    if (zCoord >= zCount || xyCoords.x >= xCount || xyCoords.y >= yCount)
+        return;
+
+    // Every sample of a cluster writes the same value, so no atomic is needed
+    clusterFlags[zCoord * (yCount * xCount) + xyCoords.y * xCount + xyCoords.x] = 1u;
+}
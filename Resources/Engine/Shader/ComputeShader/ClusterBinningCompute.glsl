@@ -0,0 +1,207 @@
+/**
+ * @brief This compute shader assigns lights to clusters from the side of the lights: each invocation handles a light, and
+ * only visits the clusters in the tile and depth slice ranges its bounding sphere projects to.
+ * It runs twice. The first dispatch counts the lights of each cluster. Once each cluster has reserved its range of the
+ * light index list, the second one writes the light indices, giving the counters back to zero.
+ * Invocations past the point lights handle the spot lights: their range sphere bounds the visited clusters, and each
+ * of them is also tested against the cone.
+ */
+
+#version 430 core
+
+#define LOCAL_SIZE 128
+layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+struct PointLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+};
+
+layout(std430, binding = 0) readonly buffer LightBlock
+{
+    uint pointLightCount;
+    PointLight pointLights[];
+};
+
+struct SpotLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+    float direction[3];
+    float cosOuterAngle;
+    float cosInnerAngle;
+};
+
+layout(std430, binding = 10) readonly buffer SpotLightBlock
+{
+    uint spotLightCount;
+    SpotLight spotLights[];
+};
+
+// Set on the light indices of spot lights, which come after the point lights
+#define SPOT_LIGHT_BIT 0x80000000u
+
+struct Cluster
+{
+    vec4 minAABB_VS;
+    vec4 maxAABB_VS;
+    uint lightOffset;
+    uint lightCount;
+};
+
+layout(std430, binding = 1) readonly buffer ClusterInfoBlock
+{
+    uint xCount;
+    uint yCount;
+    uint zCount;
+    Cluster clusters[];
+};
+
+layout(std430, binding = 6) writeonly buffer LightIndexBlock
+{
+    uint lightIndexCount;
+    uint lightIndices[];
+};
+
+// Lights counted in each cluster by the first dispatch
+layout(std430, binding = 9) buffer ClusterLightCounterBlock
+{
+    uint clusterLightCounters[];
+};
+
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+uniform float u_Near;
+uniform float u_Far;
+// False to count the lights of each cluster, true to write the light indices
+uniform bool u_Scatter;
+
+uint depthSlice(float depth)
+{
+    return min(uint(max(log(depth / u_Near) * zCount / log(u_Far / u_Near), 0.0)), zCount - 1);
+}
+
+bool sphereAABBIntersection(vec3 center, float radius, vec3 aabbMin, vec3 aabbMax)
+{
+    vec3 closestPoint = clamp(center, aabbMin, aabbMax);
+    float distanceSquared = dot(closestPoint - center, closestPoint - center);
+    return distanceSquared <= radius * radius;
+}
+
+// A cone, of angle under 90 degrees, touches a sphere when the sphere is close enough to the cone side, and not behind
+// its apex
+bool coneSphereIntersection(vec3 apex, vec3 direction, float cosAngle, float sinAngle, vec3 center, float radius)
+{
+    vec3 toCenter = center - apex;
+    float alongAxis = dot(toCenter, direction);
+    float fromAxis = sqrt(max(dot(toCenter, toCenter) - alongAxis * alongAxis, 0.0));
+    float distanceToCone = cosAngle * fromAxis - sinAngle * alongAxis;
+    return distanceToCone <= radius && alongAxis >= -radius;
+}
+
+void main()
+{
+    uint invocation = gl_GlobalInvocationID.x;
+    if (invocation >= pointLightCount + spotLightCount)
+        return;
+
+    // Spot lights are bounded by their range sphere, their apex being its center
+    bool isSpotLight = invocation >= pointLightCount;
+    uint lightIndex;
+    float radius;
+    vec3 position;
+    vec3 spotDirection = vec3(0.0);
+    float cosAngle = 0.0;
+    float sinAngle = 0.0;
+    if (isSpotLight)
+    {
+        SpotLight light = spotLights[invocation - pointLightCount];
+        lightIndex = (invocation - pointLightCount) | SPOT_LIGHT_BIT;
+        radius = light.radius;
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        spotDirection = mat3(u_View) * vec3(light.direction[0], light.direction[1], light.direction[2]);
+        cosAngle = light.cosOuterAngle;
+        sinAngle = sqrt(max(1.0 - cosAngle * cosAngle, 0.0));
+    }
+    else
+    {
+        lightIndex = invocation;
+        radius = pointLights[lightIndex].radius;
+        position = vec3(pointLights[lightIndex].position[0], pointLights[lightIndex].position[1], pointLights[lightIndex].position[2]);
+    }
+
+    // Lights of null radius light nothing
+    if (radius <= 0.0)
+        return;
+
+    vec3 center = vec3(u_View * vec4(position, 1.0));
+
+    // The camera looks down -z
+    float nearDepth = -center.z - radius;
+    float farDepth = -center.z + radius;
+    if (farDepth < u_Near || nearDepth > u_Far)
+        return;
+
+    uint zMin = depthSlice(max(nearDepth, u_Near));
+    uint zMax = depthSlice(min(farDepth, u_Far));
+
+    // A sphere crossing the near plane may cover any tile
+    uvec2 tileMin = uvec2(0, 0);
+    uvec2 tileMax = uvec2(xCount - 1, yCount - 1);
+    if (nearDepth > u_Near)
+    {
+        // The sphere is inside its bounding box, so the projected box bounds the projected sphere
+        vec2 ndcMin = vec2(3.4e38);
+        vec2 ndcMax = vec2(-3.4e38);
+        for (int i = 0; i < 8; ++i)
+        {
+            vec3 corner = center + radius * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+            vec4 corner_CS = u_Projection * vec4(corner, 1.0);
+            vec2 corner_NDC = corner_CS.xy / corner_CS.w;
+            ndcMin = min(ndcMin, corner_NDC);
+            ndcMax = max(ndcMax, corner_NDC);
+        }
+
+        if (any(lessThan(ndcMax, vec2(-1.0))) || any(greaterThan(ndcMin, vec2(1.0))))
+            return;
+
+        // Tiles split the NDC square evenly, like the cluster grid shader does
+        vec2 gridSize = vec2(xCount, yCount);
+        tileMin = uvec2(clamp(floor((ndcMin * 0.5 + 0.5) * gridSize), vec2(0.0), gridSize - 1.0));
+        tileMax = uvec2(clamp(floor((ndcMax * 0.5 + 0.5) * gridSize), vec2(0.0), gridSize - 1.0));
+    }
+
+    for (uint z = zMin; z <= zMax; ++z)
+    {
+        for (uint y = tileMin.y; y <= tileMax.y; ++y)
+        {
+            for (uint x = tileMin.x; x <= tileMax.x; ++x)
+            {
+                uint clusterIndex = x + y * xCount + z * xCount * yCount;
+                vec3 aabbMin = clusters[clusterIndex].minAABB_VS.xyz;
+                vec3 aabbMax = clusters[clusterIndex].maxAABB_VS.xyz;
+                if (!sphereAABBIntersection(center, radius, aabbMin, aabbMax))
+                    continue;
+                if (isSpotLight && !coneSphereIntersection(center, spotDirection, cosAngle, sinAngle, 0.5 * (aabbMin + aabbMax), 0.5 * length(aabbMax - aabbMin)))
+                    continue;
+
+                if (!u_Scatter)
+                {
+                    atomicAdd(clusterLightCounters[clusterIndex], 1u);
+                    continue;
+                }
+
+                // Slots are handed out from the end of the range, which brings the counter back to zero for the next frame.
+                // Lights past the stored count of the cluster did not fit in the list, they are dropped.
+                uint slot = atomicAdd(clusterLightCounters[clusterIndex], 0xFFFFFFFFu) - 1u;
+                if (slot < clusters[clusterIndex].lightCount)
+                    lightIndices[clusters[clusterIndex].lightOffset + slot] = lightIndex;
+            }
+        }
+    }
+}
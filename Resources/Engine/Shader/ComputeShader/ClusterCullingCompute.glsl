@@ -5,7 +5,10 @@
 
 #version 430 core
 
+// Defined by the application, which picks it at startup
+#ifndef LOCAL_SIZE
 #define LOCAL_SIZE 128
+#endif
 layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
 
 struct PointLight
@@ -22,12 +25,32 @@ layout(std430, binding = 0) buffer LightBlock
     PointLight pointLights[];
 };
 
+struct SpotLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+    float direction[3];
+    float cosOuterAngle;
+    float cosInnerAngle;
+};
+
+layout(std430, binding = 10) readonly buffer SpotLightBlock
+{
+    uint spotLightCount;
+    SpotLight spotLights[];
+};
+
+// Set on the light indices of spot lights, which come after the point lights
+#define SPOT_LIGHT_BIT 0x80000000u
+
 struct Cluster
 {
     vec4 minAABB_VS;
     vec4 maxAABB_VS;
-    uint indexCount;
-    uint lightIndices[100];
+    uint lightOffset;
+    uint lightCount;
 };
 
 layout(std430, binding = 1) buffer ClusterInfoBlock
@@ -38,30 +61,171 @@ layout(std430, binding = 1) buffer ClusterInfoBlock
     Cluster clusters[];
 };
 
+// Light indices of every cluster, one range per cluster. The count is reset before each dispatch.
+layout(std430, binding = 6) buffer LightIndexBlock
+{
+    uint lightIndexCount;
+    uint lightIndices[];
+};
+
+// Light count statistics, read back a few frames later for the engine metrics
+layout(std430, binding = 5) buffer ClusterStatisticsBlock
+{
+    uint totalLightIndices;
+    uint maxLightsPerCluster;
+};
+
+// Clusters holding depth samples of the depth prepass, culled instead of the whole grid when u_ActiveClustersOnly is set
+layout(std430, binding = 7) readonly buffer ActiveClusterBlock
+{
+    uint groupCountX;
+    uint groupCountY;
+    uint groupCountZ;
+    uint activeClusterCount;
+    uint activeClusters[];
+};
+
 uniform mat4 u_View;
+uniform bool u_ActiveClustersOnly;
+// Past this number of lights, a cluster keeps its most important ones
+uniform uint u_ClusterLightLimit;
 
-bool testSphereAABB(uint i, Cluster c);
+bool testLight(uint lightIndex, Cluster c);
+
+// Light index of the i-th light: point lights, then spot lights
+uint lightAt(uint i)
+{
+    return i < pointLightCount ? i : (i - pointLightCount) | SPOT_LIGHT_BIT;
+}
+
+// Importance of a light for a cluster: its intensity at the cluster center, attenuated as the shading models do
+float lightImportance(uint lightIndex, vec3 clusterCenter)
+{
+    vec3 position;
+    float power;
+    if ((lightIndex & SPOT_LIGHT_BIT) != 0u)
+    {
+        SpotLight light = spotLights[lightIndex & ~SPOT_LIGHT_BIT];
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        power = light.intensity * max(light.color[0], max(light.color[1], light.color[2]));
+    }
+    else
+    {
+        PointLight light = pointLights[lightIndex];
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        power = light.intensity * max(light.color[0], max(light.color[1], light.color[2]));
+    }
+
+    vec3 toCluster = clusterCenter - vec3(u_View * vec4(position, 1.0));
+    return power / max(dot(toCluster, toCluster), 1e-4);
+}
+
+// Ties go to the lowest light index, so that the kept lights do not depend on the order lights are visited in
+bool isLessImportant(uint a, uint b, vec3 clusterCenter)
+{
+    float importanceA = lightImportance(a, clusterCenter);
+    float importanceB = lightImportance(b, clusterCenter);
+    return importanceA < importanceB || (importanceA == importanceB && a > b);
+}
+
+// Min heap by importance over lightIndices[offset, offset + count[: the least important light is at the root
+void siftDownLight(uint offset, uint count, uint root, vec3 clusterCenter)
+{
+    for (uint child = 2u * root + 1u; child < count; child = 2u * root + 1u)
+    {
+        if (child + 1u < count && isLessImportant(lightIndices[offset + child + 1u], lightIndices[offset + child], clusterCenter))
+            child++;
+        if (!isLessImportant(lightIndices[offset + child], lightIndices[offset + root], clusterCenter))
+            break;
+
+        uint light = lightIndices[offset + root];
+        lightIndices[offset + root] = lightIndices[offset + child];
+        lightIndices[offset + child] = light;
+        root = child;
+    }
+}
+
+void buildLightHeap(uint offset, uint count, vec3 clusterCenter)
+{
+    for (uint i = count / 2u; i > 0u; --i)
+        siftDownLight(offset, count, i - 1u, clusterCenter);
+}
+
+// Keeps a light in a full range if it is more important than the least important one
+void offerLight(uint offset, uint count, uint lightIndex, vec3 clusterCenter)
+{
+    if (isLessImportant(lightIndices[offset], lightIndex, clusterCenter))
+    {
+        lightIndices[offset] = lightIndex;
+        siftDownLight(offset, count, 0u, clusterCenter);
+    }
+}
 
 // each invocation of main() is a thread processing a cluster
 void main()
 {
-    uint x = gl_GlobalInvocationID.x, y = gl_GlobalInvocationID.y, z = gl_GlobalInvocationID.z;
-    uint clusterIndex = x + y * xCount + z * xCount * yCount;
+    uint clusterIndex;
+    if (u_ActiveClustersOnly)
+    {
+        // The last work group of the indirect dispatch is partially filled
+        if (gl_GlobalInvocationID.x >= activeClusterCount)
+            return;
+        clusterIndex = activeClusters[gl_GlobalInvocationID.x];
+    }
+    else
+    {
+        uint x = gl_GlobalInvocationID.x, y = gl_GlobalInvocationID.y, z = gl_GlobalInvocationID.z;
+        clusterIndex = x + y * xCount + z * xCount * yCount;
+        if (clusterIndex >= xCount * yCount * zCount)
+            return;
+    }
+
     Cluster cluster = clusters[clusterIndex];
 
-    // we need to reset count because culling runs every frame.
-    // otherwise it would accumulate.
-    cluster.indexCount = 0;
+    // Lights are counted first, so that the cluster reserves a single range of the global list
+    uint totalLightCount = pointLightCount + spotLightCount;
+    uint lightCount = 0;
+    for (uint i = 0; i < totalLightCount; ++i)
+    {
+        if (testLight(lightAt(i), cluster))
+            lightCount++;
+    }
+
+    uint lightOffset = atomicAdd(lightIndexCount, min(lightCount, u_ClusterLightLimit));
 
-    for (uint i = 0; i < pointLightCount; ++i)
+    // Lights past the end of the list are dropped. The statistics hold the full counts, so the list is grown
+    // for the next frames.
+    uint capacity = uint(lightIndices.length());
+    uint storedCount = lightOffset < capacity ? min(min(lightCount, u_ClusterLightLimit), capacity - lightOffset) : 0;
+
+    // Once the range is full, the lights left are offered to a heap of the stored ones
+    bool overflow = lightCount > storedCount;
+    vec3 clusterCenter = 0.5 * (cluster.minAABB_VS.xyz + cluster.maxAABB_VS.xyz);
+    uint written = 0;
+    for (uint i = 0; i < totalLightCount && storedCount > 0 && (overflow || written < storedCount); ++i)
     {
-        if (testSphereAABB(i, cluster) && cluster.indexCount < 100)
+        uint light = lightAt(i);
+        if (!testLight(light, cluster))
+            continue;
+
+        if (written < storedCount)
         {
-            cluster.lightIndices[cluster.indexCount] = i;
-            cluster.indexCount++;
+            lightIndices[lightOffset + written] = light;
+            written++;
+            if (overflow && written == storedCount)
+                buildLightHeap(lightOffset, storedCount, clusterCenter);
+        }
+        else
+        {
+            offerLight(lightOffset, storedCount, light, clusterCenter);
         }
     }
-    clusters[clusterIndex] = cluster;
+
+    clusters[clusterIndex].lightOffset = lightOffset;
+    clusters[clusterIndex].lightCount = storedCount;
+
+    atomicAdd(totalLightIndices, lightCount);
+    atomicMax(maxLightsPerCluster, lightCount);
 }
 
 bool sphereAABBIntersection(vec3 center, float radius, vec3 aabbMin, vec3 aabbMax)
@@ -76,6 +240,10 @@ bool sphereAABBIntersection(vec3 center, float radius, vec3 aabbMin, vec3 aabbMa
 // this just unpacks data for sphereAABBIntersection
 bool testSphereAABB(uint i, Cluster cluster)
 {
+    // Lights of null radius light nothing
+    if (pointLights[i].radius <= 0.0)
+        return false;
+
     vec3 center = vec3(u_View * vec4(pointLights[i].position[0], pointLights[i].position[1], pointLights[i].position[2], 1.0));
     float radius = pointLights[i].radius;
 
@@ -83,4 +251,40 @@ bool testSphereAABB(uint i, Cluster cluster)
     vec3 aabbMax = cluster.maxAABB_VS.xyz;
 
     return sphereAABBIntersection(center, radius, aabbMin, aabbMax);
-}
\ No newline at end of file
+}
+
+// A cone, of angle under 90 degrees, touches a sphere when the sphere is close enough to the cone side, and not behind
+// its apex
+bool coneSphereIntersection(vec3 apex, vec3 direction, float cosAngle, float sinAngle, vec3 center, float radius)
+{
+    vec3 toCenter = center - apex;
+    float alongAxis = dot(toCenter, direction);
+    float fromAxis = sqrt(max(dot(toCenter, toCenter) - alongAxis * alongAxis, 0.0));
+    float distanceToCone = cosAngle * fromAxis - sinAngle * alongAxis;
+    return distanceToCone <= radius && alongAxis >= -radius;
+}
+
+// Range sphere against the AABB, then cone against the bounding sphere of the AABB
+bool testSpotLight(uint i, Cluster cluster)
+{
+    SpotLight light = spotLights[i];
+    if (light.radius <= 0.0)
+        return false;
+
+    vec3 apex = vec3(u_View * vec4(light.position[0], light.position[1], light.position[2], 1.0));
+    vec3 aabbMin = cluster.minAABB_VS.xyz;
+    vec3 aabbMax = cluster.maxAABB_VS.xyz;
+    if (!sphereAABBIntersection(apex, light.radius, aabbMin, aabbMax))
+        return false;
+
+    vec3 direction = mat3(u_View) * vec3(light.direction[0], light.direction[1], light.direction[2]);
+    float sinAngle = sqrt(max(1.0 - light.cosOuterAngle * light.cosOuterAngle, 0.0));
+    return coneSphereIntersection(apex, direction, light.cosOuterAngle, sinAngle, 0.5 * (aabbMin + aabbMax), 0.5 * length(aabbMax - aabbMin));
+}
+
+bool testLight(uint lightIndex, Cluster cluster)
+{
+    if ((lightIndex & SPOT_LIGHT_BIT) != 0u)
+        return testSpotLight(lightIndex & ~SPOT_LIGHT_BIT, cluster);
+    return testSphereAABB(lightIndex, cluster);
+}
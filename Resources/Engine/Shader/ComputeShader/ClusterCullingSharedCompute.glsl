@@ -0,0 +1,323 @@
+/**
+ * @brief Shared memory variant of the light culling shader. The work group loads the lights by batches of LOCAL_SIZE,
+ * transformed to view space once per batch, and each invocation tests its cluster against the batch in shared memory.
+ * Assigns each cluster the same set of lights as ClusterCullingCompute.glsl. The order of the lights of a cluster is
+ * not specified: past the cluster light limit, both kernels keep the most important lights in a heap.
+ * Spot lights are few, so they are read from their block by every invocation, after the batches of point lights.
+ */
+
+#version 430 core
+
+// Defined by the application, which picks it at startup from the device limits
+#ifndef LOCAL_SIZE
+#define LOCAL_SIZE 128
+#endif
+layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+struct PointLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+};
+
+layout(std430, binding = 0) readonly buffer LightBlock
+{
+    uint pointLightCount;
+    PointLight pointLights[];
+};
+
+struct SpotLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+    float direction[3];
+    float cosOuterAngle;
+    float cosInnerAngle;
+};
+
+layout(std430, binding = 10) readonly buffer SpotLightBlock
+{
+    uint spotLightCount;
+    SpotLight spotLights[];
+};
+
+// Set on the light indices of spot lights, which come after the point lights
+#define SPOT_LIGHT_BIT 0x80000000u
+
+struct Cluster
+{
+    vec4 minAABB_VS;
+    vec4 maxAABB_VS;
+    uint lightOffset;
+    uint lightCount;
+};
+
+layout(std430, binding = 1) buffer ClusterInfoBlock
+{
+    uint xCount;
+    uint yCount;
+    uint zCount;
+    Cluster clusters[];
+};
+
+// Light indices of every cluster, one range per cluster. The count is reset before each dispatch.
+layout(std430, binding = 6) buffer LightIndexBlock
+{
+    uint lightIndexCount;
+    uint lightIndices[];
+};
+
+// Light count statistics, read back a few frames later for the engine metrics
+layout(std430, binding = 5) buffer ClusterStatisticsBlock
+{
+    uint totalLightIndices;
+    uint maxLightsPerCluster;
+};
+
+// Clusters holding depth samples of the depth prepass, culled instead of the whole grid when u_ActiveClustersOnly is set
+layout(std430, binding = 7) readonly buffer ActiveClusterBlock
+{
+    uint groupCountX;
+    uint groupCountY;
+    uint groupCountZ;
+    uint activeClusterCount;
+    uint activeClusters[];
+};
+
+uniform mat4 u_View;
+uniform bool u_ActiveClustersOnly;
+// Past this number of lights, a cluster keeps its most important ones
+uniform uint u_ClusterLightLimit;
+
+// View space center and radius of the lights of the current batch
+shared vec4 batchLights[LOCAL_SIZE];
+
+// Loads the batch of lights starting at batchStart. Every invocation of the work group must call it.
+void loadBatch(uint batchStart)
+{
+    uint lightIndex = batchStart + gl_LocalInvocationIndex;
+    if (lightIndex < pointLightCount)
+    {
+        PointLight light = pointLights[lightIndex];
+        vec3 center = vec3(u_View * vec4(light.position[0], light.position[1], light.position[2], 1.0));
+        batchLights[gl_LocalInvocationIndex] = vec4(center, light.radius);
+    }
+    else
+    {
+        batchLights[gl_LocalInvocationIndex] = vec4(0.0);
+    }
+}
+
+bool testBatchLight(uint i, Cluster cluster)
+{
+    // Lights of null radius light nothing
+    vec4 light = batchLights[i];
+    if (light.w <= 0.0)
+        return false;
+
+    vec3 closestPoint = clamp(light.xyz, cluster.minAABB_VS.xyz, cluster.maxAABB_VS.xyz);
+    float distanceSquared = dot(closestPoint - light.xyz, closestPoint - light.xyz);
+    return distanceSquared <= light.w * light.w;
+}
+
+// A cone, of angle under 90 degrees, touches a sphere when the sphere is close enough to the cone side, and not behind
+// its apex
+bool coneSphereIntersection(vec3 apex, vec3 direction, float cosAngle, float sinAngle, vec3 center, float radius)
+{
+    vec3 toCenter = center - apex;
+    float alongAxis = dot(toCenter, direction);
+    float fromAxis = sqrt(max(dot(toCenter, toCenter) - alongAxis * alongAxis, 0.0));
+    float distanceToCone = cosAngle * fromAxis - sinAngle * alongAxis;
+    return distanceToCone <= radius && alongAxis >= -radius;
+}
+
+// Range sphere against the AABB, then cone against the bounding sphere of the AABB
+bool testSpotLight(uint i, Cluster cluster)
+{
+    SpotLight light = spotLights[i];
+    if (light.radius <= 0.0)
+        return false;
+
+    vec3 apex = vec3(u_View * vec4(light.position[0], light.position[1], light.position[2], 1.0));
+    vec3 aabbMin = cluster.minAABB_VS.xyz;
+    vec3 aabbMax = cluster.maxAABB_VS.xyz;
+    vec3 closestPoint = clamp(apex, aabbMin, aabbMax);
+    if (dot(closestPoint - apex, closestPoint - apex) > light.radius * light.radius)
+        return false;
+
+    vec3 direction = mat3(u_View) * vec3(light.direction[0], light.direction[1], light.direction[2]);
+    float sinAngle = sqrt(max(1.0 - light.cosOuterAngle * light.cosOuterAngle, 0.0));
+    return coneSphereIntersection(apex, direction, light.cosOuterAngle, sinAngle, 0.5 * (aabbMin + aabbMax), 0.5 * length(aabbMax - aabbMin));
+}
+
+// Importance of a light for a cluster: its intensity at the cluster center, attenuated as the shading models do
+float lightImportance(uint lightIndex, vec3 clusterCenter)
+{
+    vec3 position;
+    float power;
+    if ((lightIndex & SPOT_LIGHT_BIT) != 0u)
+    {
+        SpotLight light = spotLights[lightIndex & ~SPOT_LIGHT_BIT];
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        power = light.intensity * max(light.color[0], max(light.color[1], light.color[2]));
+    }
+    else
+    {
+        PointLight light = pointLights[lightIndex];
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        power = light.intensity * max(light.color[0], max(light.color[1], light.color[2]));
+    }
+
+    vec3 toCluster = clusterCenter - vec3(u_View * vec4(position, 1.0));
+    return power / max(dot(toCluster, toCluster), 1e-4);
+}
+
+// Ties go to the lowest light index, so that the kept lights do not depend on the order lights are visited in
+bool isLessImportant(uint a, uint b, vec3 clusterCenter)
+{
+    float importanceA = lightImportance(a, clusterCenter);
+    float importanceB = lightImportance(b, clusterCenter);
+    return importanceA < importanceB || (importanceA == importanceB && a > b);
+}
+
+// Min heap by importance over lightIndices[offset, offset + count[: the least important light is at the root
+void siftDownLight(uint offset, uint count, uint root, vec3 clusterCenter)
+{
+    for (uint child = 2u * root + 1u; child < count; child = 2u * root + 1u)
+    {
+        if (child + 1u < count && isLessImportant(lightIndices[offset + child + 1u], lightIndices[offset + child], clusterCenter))
+            child++;
+        if (!isLessImportant(lightIndices[offset + child], lightIndices[offset + root], clusterCenter))
+            break;
+
+        uint light = lightIndices[offset + root];
+        lightIndices[offset + root] = lightIndices[offset + child];
+        lightIndices[offset + child] = light;
+        root = child;
+    }
+}
+
+void buildLightHeap(uint offset, uint count, vec3 clusterCenter)
+{
+    for (uint i = count / 2u; i > 0u; --i)
+        siftDownLight(offset, count, i - 1u, clusterCenter);
+}
+
+// Keeps a light in a full range if it is more important than the least important one
+void offerLight(uint offset, uint count, uint lightIndex, vec3 clusterCenter)
+{
+    if (isLessImportant(lightIndices[offset], lightIndex, clusterCenter))
+    {
+        lightIndices[offset] = lightIndex;
+        siftDownLight(offset, count, 0u, clusterCenter);
+    }
+}
+
+// Writes a light of the cluster to its range, or offers it to the heap of the stored ones once the range is full
+void storeLight(uint lightIndex, uint lightOffset, uint storedCount, bool overflow, vec3 clusterCenter, inout uint written)
+{
+    if (written < storedCount)
+    {
+        lightIndices[lightOffset + written] = lightIndex;
+        written++;
+        if (overflow && written == storedCount)
+            buildLightHeap(lightOffset, storedCount, clusterCenter);
+    }
+    else
+    {
+        offerLight(lightOffset, storedCount, lightIndex, clusterCenter);
+    }
+}
+
+void main()
+{
+    // Invocations without a cluster still help loading the batches, barriers need the whole work group
+    bool hasCluster;
+    uint clusterIndex;
+    if (u_ActiveClustersOnly)
+    {
+        hasCluster = gl_GlobalInvocationID.x < activeClusterCount;
+        clusterIndex = hasCluster ? activeClusters[gl_GlobalInvocationID.x] : 0;
+    }
+    else
+    {
+        clusterIndex = gl_GlobalInvocationID.x;
+        hasCluster = clusterIndex < xCount * yCount * zCount;
+    }
+
+    Cluster cluster;
+    if (hasCluster)
+        cluster = clusters[clusterIndex];
+
+    // Lights are counted first, so that the cluster reserves a single range of the global list
+    uint lightCount = 0;
+    for (uint batchStart = 0; batchStart < pointLightCount; batchStart += LOCAL_SIZE)
+    {
+        loadBatch(batchStart);
+        barrier();
+
+        uint batchSize = min(uint(LOCAL_SIZE), pointLightCount - batchStart);
+        for (uint i = 0; hasCluster && i < batchSize; ++i)
+        {
+            if (testBatchLight(i, cluster))
+                lightCount++;
+        }
+        barrier();
+    }
+
+    for (uint i = 0; hasCluster && i < spotLightCount; ++i)
+    {
+        if (testSpotLight(i, cluster))
+            lightCount++;
+    }
+
+    uint lightOffset = 0;
+    uint storedCount = 0;
+    if (hasCluster)
+    {
+        lightOffset = atomicAdd(lightIndexCount, min(lightCount, u_ClusterLightLimit));
+
+        // Lights past the end of the list are dropped. The statistics hold the full counts, so the list is grown
+        // for the next frames.
+        uint capacity = uint(lightIndices.length());
+        storedCount = lightOffset < capacity ? min(min(lightCount, u_ClusterLightLimit), capacity - lightOffset) : 0;
+    }
+
+    // The work group keeps loading batches until every invocation has written its lights. Once the range is full,
+    // the lights left are offered to a heap of the stored ones.
+    bool overflow = lightCount > storedCount;
+    vec3 clusterCenter = 0.5 * (cluster.minAABB_VS.xyz + cluster.maxAABB_VS.xyz);
+    uint written = 0;
+    for (uint batchStart = 0; batchStart < pointLightCount; batchStart += LOCAL_SIZE)
+    {
+        loadBatch(batchStart);
+        barrier();
+
+        uint batchSize = min(uint(LOCAL_SIZE), pointLightCount - batchStart);
+        for (uint i = 0; i < batchSize && storedCount > 0 && (overflow || written < storedCount); ++i)
+        {
+            if (testBatchLight(i, cluster))
+                storeLight(batchStart + i, lightOffset, storedCount, overflow, clusterCenter, written);
+        }
+        barrier();
+    }
+
+    for (uint i = 0; i < spotLightCount && storedCount > 0 && (overflow || written < storedCount); ++i)
+    {
+        if (testSpotLight(i, cluster))
+            storeLight(i | SPOT_LIGHT_BIT, lightOffset, storedCount, overflow, clusterCenter, written);
+    }
+
+    if (!hasCluster)
+        return;
+
+    clusters[clusterIndex].lightOffset = lightOffset;
+    clusters[clusterIndex].lightCount = storedCount;
+
+    atomicAdd(totalLightIndices, lightCount);
+    atomicMax(maxLightsPerCluster, lightCount);
+}
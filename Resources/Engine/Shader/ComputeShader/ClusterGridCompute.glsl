@@ -10,8 +10,8 @@ struct Cluster
 {
     vec4 minAABB_VS;
     vec4 maxAABB_VS;
-    uint indexCount;
-    uint lightIndices[100];
+    uint lightOffset;
+    uint lightCount;
 };
 
 layout(std430, binding = 1) buffer ClusterInfoBlock
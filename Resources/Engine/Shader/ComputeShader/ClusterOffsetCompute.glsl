@@ -0,0 +1,88 @@
+/**
+ * @brief This compute shader reserves the range of the light index list of each cluster, from the light counts of the
+ * light binning shader.
+ */
+
+#version 430 core
+
+// Defined by the application, which picks it at startup
+#ifndef LOCAL_SIZE
+#define LOCAL_SIZE 128
+#endif
+layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+struct Cluster
+{
+    vec4 minAABB_VS;
+    vec4 maxAABB_VS;
+    uint lightOffset;
+    uint lightCount;
+};
+
+layout(std430, binding = 1) buffer ClusterInfoBlock
+{
+    uint xCount;
+    uint yCount;
+    uint zCount;
+    Cluster clusters[];
+};
+
+// Light indices of every cluster, one range per cluster. The count is reset before each dispatch.
+layout(std430, binding = 6) buffer LightIndexBlock
+{
+    uint lightIndexCount;
+    uint lightIndices[];
+};
+
+// Light count statistics, read back a few frames later for the engine metrics
+layout(std430, binding = 5) buffer ClusterStatisticsBlock
+{
+    uint totalLightIndices;
+    uint maxLightsPerCluster;
+};
+
+// Clusters holding depth samples of the depth prepass, the only ones visited when u_ActiveClustersOnly is set
+layout(std430, binding = 7) readonly buffer ActiveClusterBlock
+{
+    uint groupCountX;
+    uint groupCountY;
+    uint groupCountZ;
+    uint activeClusterCount;
+    uint activeClusters[];
+};
+
+layout(std430, binding = 9) readonly buffer ClusterLightCounterBlock
+{
+    uint clusterLightCounters[];
+};
+
+uniform bool u_ActiveClustersOnly;
+
+void main()
+{
+    uint clusterIndex = gl_GlobalInvocationID.x;
+    if (u_ActiveClustersOnly)
+    {
+        if (clusterIndex >= activeClusterCount)
+            return;
+        clusterIndex = activeClusters[clusterIndex];
+    }
+    else if (clusterIndex >= xCount * yCount * zCount)
+    {
+        return;
+    }
+
+    uint lightCount = clusterLightCounters[clusterIndex];
+    uint lightOffset = atomicAdd(lightIndexCount, lightCount);
+
+    // Lights past the end of the list are dropped. The statistics hold the full counts, so the list is grown
+    // for the next frames.
+    uint capacity = uint(lightIndices.length());
+    uint storedCount = lightOffset < capacity ? min(lightCount, capacity - lightOffset) : 0;
+
+    clusters[clusterIndex].lightOffset = lightOffset;
+    clusters[clusterIndex].lightCount = storedCount;
+
+    atomicAdd(totalLightIndices, lightCount);
+    atomicMax(maxLightsPerCluster, lightCount);
+}
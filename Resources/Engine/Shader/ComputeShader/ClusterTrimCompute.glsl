@@ -0,0 +1,173 @@
+/**
+ * @brief This compute shader applies the cluster light limit after light binning. Binning writes the lights of a cluster
+ * in any order, so a cluster touched by more lights than the limit keeps its most important ones here, as the light
+ * culling shaders do while they write.
+ */
+
+#version 430 core
+
+// Defined by the application, which picks it at startup
+#ifndef LOCAL_SIZE
+#define LOCAL_SIZE 128
+#endif
+layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+struct PointLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+};
+
+layout(std430, binding = 0) readonly buffer LightBlock
+{
+    uint pointLightCount;
+    PointLight pointLights[];
+};
+
+struct SpotLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+    float direction[3];
+    float cosOuterAngle;
+    float cosInnerAngle;
+};
+
+layout(std430, binding = 10) readonly buffer SpotLightBlock
+{
+    uint spotLightCount;
+    SpotLight spotLights[];
+};
+
+// Set on the light indices of spot lights, which come after the point lights
+#define SPOT_LIGHT_BIT 0x80000000u
+
+struct Cluster
+{
+    vec4 minAABB_VS;
+    vec4 maxAABB_VS;
+    uint lightOffset;
+    uint lightCount;
+};
+
+layout(std430, binding = 1) buffer ClusterInfoBlock
+{
+    uint xCount;
+    uint yCount;
+    uint zCount;
+    Cluster clusters[];
+};
+
+layout(std430, binding = 6) buffer LightIndexBlock
+{
+    uint lightIndexCount;
+    uint lightIndices[];
+};
+
+// Clusters holding depth samples of the depth prepass, the only ones visited when u_ActiveClustersOnly is set
+layout(std430, binding = 7) readonly buffer ActiveClusterBlock
+{
+    uint groupCountX;
+    uint groupCountY;
+    uint groupCountZ;
+    uint activeClusterCount;
+    uint activeClusters[];
+};
+
+uniform mat4 u_View;
+uniform bool u_ActiveClustersOnly;
+uniform uint u_ClusterLightLimit;
+
+// Importance of a light for a cluster: its intensity at the cluster center, attenuated as the shading models do
+float lightImportance(uint lightIndex, vec3 clusterCenter)
+{
+    vec3 position;
+    float power;
+    if ((lightIndex & SPOT_LIGHT_BIT) != 0u)
+    {
+        SpotLight light = spotLights[lightIndex & ~SPOT_LIGHT_BIT];
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        power = light.intensity * max(light.color[0], max(light.color[1], light.color[2]));
+    }
+    else
+    {
+        PointLight light = pointLights[lightIndex];
+        position = vec3(light.position[0], light.position[1], light.position[2]);
+        power = light.intensity * max(light.color[0], max(light.color[1], light.color[2]));
+    }
+
+    vec3 toCluster = clusterCenter - vec3(u_View * vec4(position, 1.0));
+    return power / max(dot(toCluster, toCluster), 1e-4);
+}
+
+// Ties go to the lowest light index, so that the kept lights do not depend on the order lights are visited in
+bool isLessImportant(uint a, uint b, vec3 clusterCenter)
+{
+    float importanceA = lightImportance(a, clusterCenter);
+    float importanceB = lightImportance(b, clusterCenter);
+    return importanceA < importanceB || (importanceA == importanceB && a > b);
+}
+
+// Min heap by importance over lightIndices[offset, offset + count[: the least important light is at the root
+void siftDownLight(uint offset, uint count, uint root, vec3 clusterCenter)
+{
+    for (uint child = 2u * root + 1u; child < count; child = 2u * root + 1u)
+    {
+        if (child + 1u < count && isLessImportant(lightIndices[offset + child + 1u], lightIndices[offset + child], clusterCenter))
+            child++;
+        if (!isLessImportant(lightIndices[offset + child], lightIndices[offset + root], clusterCenter))
+            break;
+
+        uint light = lightIndices[offset + root];
+        lightIndices[offset + root] = lightIndices[offset + child];
+        lightIndices[offset + child] = light;
+        root = child;
+    }
+}
+
+void buildLightHeap(uint offset, uint count, vec3 clusterCenter)
+{
+    for (uint i = count / 2u; i > 0u; --i)
+        siftDownLight(offset, count, i - 1u, clusterCenter);
+}
+
+// Keeps a light in a full range if it is more important than the least important one
+void offerLight(uint offset, uint count, uint lightIndex, vec3 clusterCenter)
+{
+    if (isLessImportant(lightIndices[offset], lightIndex, clusterCenter))
+    {
+        lightIndices[offset] = lightIndex;
+        siftDownLight(offset, count, 0u, clusterCenter);
+    }
+}
+
+void main()
+{
+    uint clusterIndex = gl_GlobalInvocationID.x;
+    if (u_ActiveClustersOnly)
+    {
+        if (clusterIndex >= activeClusterCount)
+            return;
+        clusterIndex = activeClusters[clusterIndex];
+    }
+    else if (clusterIndex >= xCount * yCount * zCount)
+    {
+        return;
+    }
+
+    Cluster cluster = clusters[clusterIndex];
+    if (cluster.lightCount <= u_ClusterLightLimit)
+        return;
+
+    // The first lights of the range make the heap, the others are offered to it
+    vec3 clusterCenter = 0.5 * (cluster.minAABB_VS.xyz + cluster.maxAABB_VS.xyz);
+    buildLightHeap(cluster.lightOffset, u_ClusterLightLimit, clusterCenter);
+    for (uint i = u_ClusterLightLimit; i < cluster.lightCount; ++i)
+        offerLight(cluster.lightOffset, u_ClusterLightLimit, lightIndices[cluster.lightOffset + i], clusterCenter);
+
+    clusters[clusterIndex].lightCount = u_ClusterLightLimit;
+}
@@ -0,0 +1,69 @@
+/**
+ * @brief This compute shader is responsible for frustum culling objects on the GPU, for the GPU driven renderer.
+ * Each invocation tests one object. Visible objects append their model matrix to the instances of their draw command.
+ */
+
+#version 430 core
+
+#define LOCAL_SIZE 64
+layout(local_size_x = LOCAL_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+struct ObjectData
+{
+    mat4 model;
+    vec4 boundingSphere; // Local center (xyz) and radius (w)
+    uint commandIndex;
+    uint padding[3];
+};
+
+// Same layout as DrawElementsIndirectCommand
+struct DrawCommand
+{
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 2) writeonly buffer InstanceBlock
+{
+    mat4 instanceModels[];
+};
+
+layout(std430, binding = 3) readonly buffer ObjectBlock
+{
+    ObjectData objects[];
+};
+
+layout(std430, binding = 4) buffer DrawCommandBlock
+{
+    DrawCommand commands[];
+};
+
+uniform uint u_ObjectCount;
+uniform vec4 u_FrustumPlanes[6];
+
+void main()
+{
+    uint objectIndex = gl_GlobalInvocationID.x;
+    if (objectIndex >= u_ObjectCount)
+        return;
+
+    ObjectData object = objects[objectIndex];
+
+    // World space bounding sphere. The radius is scaled by the largest axis scale to stay conservative.
+    vec3 center = vec3(object.model * vec4(object.boundingSphere.xyz, 1.0));
+    float maxScale = sqrt(max(dot(object.model[0].xyz, object.model[0].xyz), max(dot(object.model[1].xyz, object.model[1].xyz), dot(object.model[2].xyz, object.model[2].xyz))));
+    float radius = object.boundingSphere.w * maxScale;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        if (dot(u_FrustumPlanes[i].xyz, center) + u_FrustumPlanes[i].w < -radius)
+            return;
+    }
+
+    // Reserving a slot in the instances of the command. Instance counts are reset by the CPU every frame.
+    uint slot = atomicAdd(commands[object.commandIndex].instanceCount, 1);
+    instanceModels[commands[object.commandIndex].baseInstance + slot] = object.model;
+}
@@ -6,13 +6,8 @@ in vec3 v_Position;
 in vec2 v_TexCoord;
 in float v_CameraDepth;
 
-// From application
-uniform vec3 u_ViewPosition;
-uniform mat4 u_ViewProjection;
-uniform mat4 u_View;
-uniform float u_Near;
-uniform float u_Far;
-uniform uvec2 u_ViewportSize;
+// From application, for Vroom shader preprocessor
+#include FrameData
 
 struct PointLight
 {
@@ -28,12 +23,46 @@ layout(std430, binding = 0) buffer LightBlock
     PointLight pointLights[];
 };
 
+struct SpotLight
+{
+    float position[3];
+    float color[3];
+    float intensity;
+    float radius;
+    float direction[3];
+    float cosOuterAngle;
+    float cosInnerAngle;
+};
+
+layout(std430, binding = 10) buffer SpotLightBlock
+{
+    uint spotLightCount;
+    SpotLight spotLights[];
+};
+
+// Set on the light indices of spot lights in the cluster light lists
+#define SPOT_LIGHT_BIT 0x80000000u
+
+// Not clustered, every fragment is lit by every directional light
+struct DirectionalLight
+{
+    float direction[3];
+    float color[3];
+    float intensity;
+};
+
+layout(std430, binding = 11) buffer DirectionalLightBlock
+{
+    uint directionalLightCount;
+    DirectionalLight directionalLights[];
+};
+
 struct Cluster
 {
     vec4 minAABB_VS;
     vec4 maxAABB_VS;
-    uint indexCount;
-    uint lightIndices[100];
+    uint lightOffset;
+    uint lightCount;
 };
 
 layout(std430, binding = 1) buffer ClusterInfoBlock
@@ -44,6 +73,13 @@ layout(std430, binding = 1) buffer ClusterInfoBlock
     Cluster clusters[];
 };
 
+// Light indices of every cluster, one range per cluster
+layout(std430, binding = 6) buffer LightIndexBlock
+{
+    uint lightIndexCount;
+    uint lightIndices[];
+};
+
 // Function code found on Victor Gordan's Youtube video: https://www.youtube.com/watch?v=3xGKu4T4SCU
 float linearizeDepth(float depth)
 {
@@ -0,0 +1,8 @@
+// Shading model of the depth prepass: the pass has no color attachment, only depth is written.
+
+void PreFrag(out vec3 ambient, out vec3 diffuse, out vec3 specular, out float shininess);
+
+vec4 ComputeColor()
+{
+    return vec4(0.0, 0.0, 0.0, 1.0);
+}
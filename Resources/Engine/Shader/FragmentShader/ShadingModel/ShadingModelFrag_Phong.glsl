@@ -19,9 +19,25 @@
 //     int pointLightCount;
 //     PointLight pointLights[];
 // };
+// 
+// Each cluster lists its lights in lightIndices[lightOffset, lightOffset + lightCount[ (LightIndexBlock, binding 6)
+// Indices with SPOT_LIGHT_BIT set are spot lights: spotLights[index & ~SPOT_LIGHT_BIT] (SpotLightBlock, binding 10)
+// Directional lights are not clustered: directionalLights[] (DirectionalLightBlock, binding 11)
 
 void PreFrag(out vec3 ambient, out vec3 diffuse, out vec3 specular, out float shininess);
 
+vec3 ShadeLight(vec3 lightDir, vec3 lightColor, vec3 normal, vec3 viewDir, vec3 diffuse, vec3 specular, float shininess)
+{
+    // Diffuse factor
+    float diff = max(dot(normal, lightDir), 0.f);
+
+    // Specular factor
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.f), shininess);
+
+    return (diff * diffuse + spec * specular) * lightColor;
+}
+
 vec4 ComputeColor()
 {
     // Coordinates of the frag in VS for finding the right cluster
@@ -31,7 +47,8 @@ vec4 ComputeColor()
     // Coordinates of the frag in NDC space for finding the right cluster
     uvec3 clusterCoords = ivec3(gl_FragCoord.xy / clusterSizeXY, zCoord);
     uint clusterIndex = clusterCoords.z * (yCount * xCount) + clusterCoords.y * (xCount) + clusterCoords.x;
-    uint lightsCount = clusters[clusterIndex].indexCount;
+    uint lightOffset = clusters[clusterIndex].lightOffset;
+    uint lightsCount = clusters[clusterIndex].lightCount;
 
     // Getting values from PreFrag shader
     vec3 ambient, diffuse, specular;
@@ -46,7 +63,31 @@ vec4 ComputeColor()
     for (int i = 0; i < lightsCount; i++)
     //for (int i = 0; i < pointLightCount; i++)
     {
-        PointLight pointLight = pointLights[clusters[clusterIndex].lightIndices[i]];
+        uint lightIndex = lightIndices[lightOffset + i];
+        if ((lightIndex & SPOT_LIGHT_BIT) != 0u)
+        {
+            SpotLight spotLight = spotLights[lightIndex & ~SPOT_LIGHT_BIT];
+            vec3 lightPos = vec3(spotLight.position[0], spotLight.position[1], spotLight.position[2]);
+
+            float lightDistance2 = dot(lightPos - v_Position, lightPos - v_Position);
+            if (lightDistance2 > spotLight.radius * spotLight.radius)
+                continue;
+
+            // Full intensity inside the inner cone, fading out to the outer one
+            vec3 lightDir = normalize(lightPos - v_Position);
+            vec3 spotDir = vec3(spotLight.direction[0], spotLight.direction[1], spotLight.direction[2]);
+            // Inner and outer angles may be equal, where smoothstep is undefined
+            float coneRange = max(spotLight.cosInnerAngle - spotLight.cosOuterAngle, 1e-4);
+            float cone = smoothstep(0.f, 1.f, clamp((dot(-lightDir, spotDir) - spotLight.cosOuterAngle) / coneRange, 0.f, 1.f));
+            if (cone <= 0.f)
+                continue;
+
+            vec3 lightColor = vec3(spotLight.color[0], spotLight.color[1], spotLight.color[2]) * spotLight.intensity * cone / lightDistance2;
+            shadeColor += ShadeLight(lightDir, lightColor, normal, viewDir, diffuse, specular, shininess);
+            continue;
+        }
+
+        PointLight pointLight = pointLights[lightIndex];
         vec3 lightPos = vec3(pointLight.position[0], pointLight.position[1], pointLight.position[2]);
 
         float lightDistance2 = dot(lightPos - v_Position, lightPos - v_Position);
@@ -56,14 +97,17 @@ vec4 ComputeColor()
         vec3 lightColor = vec3(pointLight.color[0], pointLight.color[1], pointLight.color[2]) * pointLight.intensity / lightDistance2;
         vec3 lightDir = normalize(lightPos - v_Position);
 
-        // Diffuse factor
-        float diff = max(dot(normal, lightDir), 0.f);
+        shadeColor += ShadeLight(lightDir, lightColor, normal, viewDir, diffuse, specular, shininess);
+    }
 
-        // Specular factor
-        vec3 reflectDir = reflect(-lightDir, normal);
-        float spec = pow(max(dot(viewDir, reflectDir), 0.f), shininess);
+    // Directional lights are not attenuated
+    for (uint i = 0; i < directionalLightCount; i++)
+    {
+        DirectionalLight directionalLight = directionalLights[i];
+        vec3 lightDir = -vec3(directionalLight.direction[0], directionalLight.direction[1], directionalLight.direction[2]);
+        vec3 lightColor = vec3(directionalLight.color[0], directionalLight.color[1], directionalLight.color[2]) * directionalLight.intensity;
 
-        shadeColor += (diff * diffuse + spec * specular) * lightColor;
+        shadeColor += ShadeLight(lightDir, lightColor, normal, viewDir, diffuse, specular, shininess);
     }
 
     return vec4(shadeColor, 1.f);
@@ -0,0 +1,12 @@
+// Per camera data, written once per scene by the renderer.
+// Must match vrm::UBOFrameData (std140).
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 u_View;
+    mat4 u_Projection;
+    mat4 u_ViewProjection;
+    vec3 u_ViewPosition;
+    float u_Near;
+    uvec2 u_ViewportSize;
+    float u_Far;
+};
@@ -0,0 +1,13 @@
+#extension GL_ARB_shader_draw_parameters : require
+
+// Model matrices of every instance drawn this frame, written by the renderer.
+// Instances of a batch are contiguous, starting at the base instance of the draw.
+layout(std430, binding = 2) readonly buffer InstanceBlock
+{
+    mat4 instanceModels[];
+};
+
+mat4 GetModelMatrix()
+{
+    return instanceModels[gl_BaseInstanceARB + gl_InstanceID];
+}
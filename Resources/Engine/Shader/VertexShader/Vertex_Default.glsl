@@ -1,13 +1,27 @@
 #version 450 core
 
+// For Vroom shader preprocessor
+#include InstanceData
+#include FrameData
+
+#ifdef VRM_PACKED_VERTEX
+// Packed vertices: quantized position (dequantized by the model matrix), octahedral normal, half float texture coordinates.
+layout(location = 0) in vec4 packedPosition;
+layout(location = 1) in vec2 packedNormal;
+layout(location = 2) in vec2 texCoord;
+
+vec3 DecodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
+#else
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
-
-uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
-uniform mat4 u_ViewProjection;
+#endif
 
 out vec3 v_Position;
 out vec3 v_Normal;
@@ -16,13 +30,20 @@ out float v_CameraDepth;
 
 void main()
 {
-	vec4 worldPosition = u_Model * vec4(position, 1.0);
+#ifdef VRM_PACKED_VERTEX
+	vec3 position = packedPosition.xyz;
+	vec3 normal = DecodeOctahedral(packedNormal);
+#endif
+
+	mat4 model = GetModelMatrix();
+
+	vec4 worldPosition = model * vec4(position, 1.0);
 	vec4 cameraPosition = u_View * worldPosition;
 
 	gl_Position = u_Projection * cameraPosition;
 	
-	v_Position = vec3(u_Model * vec4(position, 1.0));
-	v_Normal = normalize(mat3(transpose(inverse(u_Model))) * normal);
+	v_Position = vec3(worldPosition);
+	v_Normal = normalize(mat3(transpose(inverse(model))) * normal);
 	v_TexCoord = texCoord;
 	v_CameraDepth = -cameraPosition.z;
-}
\ No newline at end of file
+}
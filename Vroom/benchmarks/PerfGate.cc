@@ -0,0 +1,313 @@
+#include "PerfGate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <Vroom/Core/Log.h>
+
+namespace vrm
+{
+
+// Scale turning a median absolute deviation into a standard deviation, for normally distributed samples
+static constexpr double MAD_TO_SIGMA = 1.4826;
+// Number of standard deviations a change must exceed to be significant
+static constexpr double SIGNIFICANCE_SIGMAS = 3.0;
+
+namespace
+{
+
+// Reads the subset of JSON the baseline uses. Unknown keys are skipped, so the file can hold comments as extra keys.
+class BaselineReader
+{
+public:
+    explicit BaselineReader(const std::string& text) : m_Text(text) {}
+
+    bool read(std::vector<PerfGate::Metric>& metrics)
+    {
+        if (!consume('{'))
+            return false;
+        if (consume('}'))
+            return true;
+
+        do
+        {
+            std::string key;
+            if (!readString(key) || !consume(':'))
+                return false;
+
+            const bool valid = key == "benchmarks" ? readMetrics(metrics) : skipValue();
+            if (!valid)
+                return false;
+        } while (consume(','));
+
+        return consume('}');
+    }
+
+    size_t getPosition() const { return m_Position; }
+
+private:
+    bool readMetrics(std::vector<PerfGate::Metric>& metrics)
+    {
+        if (!consume('['))
+            return false;
+        if (consume(']'))
+            return true;
+
+        do
+        {
+            PerfGate::Metric metric;
+            metric.tolerance = PerfGate::DefaultTolerance;
+            if (!readMetric(metric))
+                return false;
+            metrics.push_back(std::move(metric));
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    bool readMetric(PerfGate::Metric& metric)
+    {
+        if (!consume('{'))
+            return false;
+        if (consume('}'))
+            return !metric.name.empty();
+
+        do
+        {
+            std::string key;
+            if (!readString(key) || !consume(':'))
+                return false;
+
+            bool valid = true;
+            if (key == "name")
+                valid = readString(metric.name);
+            else if (key == "tolerance")
+                valid = readNumber(metric.tolerance);
+            else if (key == "median_ns")
+                valid = readNumber(metric.medianNs);
+            else if (key == "mad_ns")
+                valid = readNumber(metric.madNs);
+            else
+                valid = skipValue();
+
+            if (!valid)
+                return false;
+        } while (consume(','));
+
+        return consume('}') && !metric.name.empty();
+    }
+
+    bool readString(std::string& value)
+    {
+        if (!consume('"'))
+            return false;
+
+        value.clear();
+        while (m_Position < m_Text.size() && m_Text[m_Position] != '"')
+        {
+            // Escaped characters are kept as is, benchmark names have none
+            if (m_Text[m_Position] == '\\' && m_Position + 1 < m_Text.size())
+                m_Position++;
+            value.push_back(m_Text[m_Position++]);
+        }
+
+        if (m_Position == m_Text.size())
+            return false;
+        m_Position++;
+        return true;
+    }
+
+    bool readNumber(double& value)
+    {
+        skipSpaces();
+        const char* begin = m_Text.c_str() + m_Position;
+        char* end = nullptr;
+        value = std::strtod(begin, &end);
+        if (end == begin)
+            return false;
+
+        m_Position += static_cast<size_t>(end - begin);
+        return true;
+    }
+
+    bool skipValue()
+    {
+        skipSpaces();
+        if (m_Position == m_Text.size())
+            return false;
+
+        const char c = m_Text[m_Position];
+        if (c == '"')
+        {
+            std::string ignored;
+            return readString(ignored);
+        }
+
+        if (c == '{' || c == '[')
+        {
+            const char closing = c == '{' ? '}' : ']';
+            m_Position++;
+            if (consume(closing))
+                return true;
+
+            do
+            {
+                if (c == '{')
+                {
+                    std::string key;
+                    if (!readString(key) || !consume(':'))
+                        return false;
+                }
+                if (!skipValue())
+                    return false;
+            } while (consume(','));
+
+            return consume(closing);
+        }
+
+        for (const char* literal : { "true", "false", "null" })
+        {
+            if (m_Text.compare(m_Position, std::strlen(literal), literal) == 0)
+            {
+                m_Position += std::strlen(literal);
+                return true;
+            }
+        }
+
+        double ignored;
+        return readNumber(ignored);
+    }
+
+    bool consume(char c)
+    {
+        skipSpaces();
+        if (m_Position < m_Text.size() && m_Text[m_Position] == c)
+        {
+            m_Position++;
+            return true;
+        }
+        return false;
+    }
+
+    void skipSpaces()
+    {
+        while (m_Position < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Position])))
+            m_Position++;
+    }
+
+private:
+    const std::string& m_Text;
+    size_t m_Position = 0;
+};
+
+} // namespace
+
+bool PerfGate::ReadBaseline(const std::string& filePath, std::vector<Metric>& metrics)
+{
+    std::ifstream file(filePath);
+    if (!file.is_open())
+    {
+        VRM_LOG_ERROR("Failed to open performance baseline: {}", filePath);
+        return false;
+    }
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string text = ss.str();
+
+    BaselineReader reader(text);
+    if (!reader.read(metrics))
+    {
+        VRM_LOG_ERROR("Invalid performance baseline {}, near character {}.", filePath, reader.getPosition());
+        return false;
+    }
+
+    return true;
+}
+
+bool PerfGate::WriteBaseline(const std::string& filePath, const std::vector<Metric>& metrics)
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file << "{\n\"benchmarks\": [";
+    for (size_t i = 0; i < metrics.size(); ++i)
+    {
+        const auto& metric = metrics[i];
+        file << (i == 0 ? "\n" : ",\n")
+            << "  { \"name\": \"" << metric.name << "\""
+            << ", \"tolerance\": " << metric.tolerance
+            << ", \"median_ns\": " << metric.medianNs
+            << ", \"mad_ns\": " << metric.madNs << " }";
+    }
+    file << "\n]\n}\n";
+
+    return file.good();
+}
+
+PerfGate::Metric PerfGate::Summarize(const std::string& name, std::vector<double>& samplesNs)
+{
+    Metric metric;
+    metric.name = name;
+    if (samplesNs.empty())
+        return metric;
+
+    metric.medianNs = Median(samplesNs);
+    for (double& sample : samplesNs)
+        sample = std::abs(sample - metric.medianNs);
+    metric.madNs = Median(samplesNs);
+
+    return metric;
+}
+
+PerfGate::Verdict PerfGate::Compare(const Metric& baseline, const Metric& current)
+{
+    if (baseline.medianNs <= 0.0)
+        return Verdict::NotBlessed;
+    if (current.medianNs <= 0.0)
+        return Verdict::NotMeasured;
+
+    const double difference = current.medianNs - baseline.medianNs;
+    const double sigma = MAD_TO_SIGMA * std::sqrt(baseline.madNs * baseline.madNs + current.madNs * current.madNs);
+
+    // Both conditions: small relative changes are accepted even when stable, noisy ones even when large
+    const bool significant = std::abs(difference) > SIGNIFICANCE_SIGMAS * sigma;
+    const bool beyondTolerance = std::abs(difference) > baseline.tolerance * baseline.medianNs;
+    if (!significant || !beyondTolerance)
+        return Verdict::Unchanged;
+
+    return difference > 0.0 ? Verdict::Regression : Verdict::Improvement;
+}
+
+const char* PerfGate::GetVerdictName(Verdict verdict)
+{
+    switch (verdict)
+    {
+    case Verdict::Unchanged: return "unchanged";
+    case Verdict::Regression: return "REGRESSION";
+    case Verdict::Improvement: return "improvement";
+    case Verdict::NotBlessed: return "not blessed";
+    case Verdict::NotMeasured: return "not measured";
+    }
+    return "";
+}
+
+double PerfGate::Median(std::vector<double>& values)
+{
+    const size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    const double upper = values[middle];
+    if (values.size() % 2 == 1)
+        return upper;
+
+    const double lower = *std::max_element(values.begin(), values.begin() + middle);
+    return 0.5 * (lower + upper);
+}
+
+} // namespace vrm
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace vrm
+{
+
+/**
+ * @brief Compares benchmark timings to a baseline, flagging statistically significant regressions.
+ *
+ * Each benchmark is repeated, and summarized by the median and median absolute deviation (MAD) of its repetitions,
+ * which a few outliers cannot skew. A change is significant when it exceeds both the tolerance of the metric and three
+ * standard deviations of the difference, estimated from the MADs of the baseline and of the current run.
+ */
+class PerfGate
+{
+public:
+    struct Metric
+    {
+        std::string name;
+        // Relative change allowed before the metric is flagged, 0.1 for 10%
+        double tolerance = 0.0;
+        // Zero when the metric was never blessed
+        double medianNs = 0.0;
+        double madNs = 0.0;
+    };
+
+    enum class Verdict
+    {
+        Unchanged,
+        Regression,
+        Improvement,
+        NotBlessed,
+        NotMeasured
+    };
+
+    static constexpr double DefaultTolerance = 0.1;
+
+public:
+    PerfGate() = delete;
+
+    /**
+     * @brief Reads a baseline file.
+     *
+     * @param filePath The baseline file path.
+     * @param metrics The metrics of the baseline.
+     * @return true If the file could be read and parsed.
+     * @return false Otherwise. The error is logged.
+     */
+    static bool ReadBaseline(const std::string& filePath, std::vector<Metric>& metrics);
+
+    /**
+     * @brief Writes a baseline file, readable by ReadBaseline.
+     *
+     * @param filePath The baseline file path.
+     * @param metrics The metrics of the baseline.
+     * @return true If the file could be written.
+     * @return false Otherwise.
+     */
+    static bool WriteBaseline(const std::string& filePath, const std::vector<Metric>& metrics);
+
+    /**
+     * @brief Summarizes the repetitions of a benchmark.
+     *
+     * @param name The benchmark name.
+     * @param samplesNs The time of each repetition, in nanoseconds. Reordered.
+     * @return Metric The metric, without tolerance.
+     */
+    static Metric Summarize(const std::string& name, std::vector<double>& samplesNs);
+
+    /**
+     * @brief Compares a measured metric to its baseline.
+     *
+     * @param baseline The baseline metric, holding the tolerance.
+     * @param current The measured metric.
+     * @return Verdict The verdict. NotBlessed if the baseline has no timing.
+     */
+    static Verdict Compare(const Metric& baseline, const Metric& current);
+
+    static const char* GetVerdictName(Verdict verdict);
+
+private:
+    static double Median(std::vector<double>& values);
+};
+
+} // namespace vrm
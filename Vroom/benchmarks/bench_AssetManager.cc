@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <Vroom/Asset/AssetManager.h>
+#include <Vroom/Asset/AssetInstance/AssetInstance.h>
+
+namespace
+{
+
+// Asset loading nothing, so that only the lookup and instance creation are measured, without an OpenGL context
+class NullInstance : public vrm::AssetInstance
+{
+public:
+    using vrm::AssetInstance::AssetInstance;
+};
+
+class NullAsset : public vrm::StaticAsset
+{
+public:
+    using InstanceType = NullInstance;
+
+    [[nodiscard]] NullInstance createInstance() { return NullInstance(this); }
+
+protected:
+    bool loadImpl(const std::string&) override { return true; }
+};
+
+} // namespace
+
+// Argument: number of loaded assets. Paths look like the engine ones, so that hashing costs the same.
+static void BM_AssetManagerGetAsset(benchmark::State& state)
+{
+    vrm::AssetManager::Init();
+
+    std::vector<std::string> paths;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        paths.push_back("Resources/Meshes/Generated/Mesh_" + std::to_string(i) + ".obj");
+        vrm::AssetManager::Get().loadAsset<NullAsset>(paths.back());
+    }
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        auto instance = vrm::AssetManager::Get().getAsset<NullAsset>(paths[i]);
+        benchmark::DoNotOptimize(instance);
+        i = (i + 1) % paths.size();
+    }
+
+    vrm::AssetManager::Shutdown();
+}
+BENCHMARK(BM_AssetManagerGetAsset)->Arg(16)->Arg(1'024)->Arg(65'536);
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Vroom/Render/Clustering/ClusterLightCuller.h>
+#include <Vroom/Render/Clustering/LightRegistry.h>
+
+// CPU light culling over the renderer cluster grid. The GPU paths are measured by VroomBench, with --cpu-culling 0,1.
+
+namespace
+{
+
+// Lights spread in front of a camera at origin looking towards -Z, as in the bench scenes
+const std::vector<std::byte>& BuildLightBlock(vrm::LightRegistry& registry, size_t count)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> lateral(-40.f, 40.f);
+    std::uniform_real_distribution<float> depth(-90.f, 0.f);
+
+    registry.reserve(static_cast<int>(count));
+    registry.beginFrame();
+    for (size_t i = 0; i < count; ++i)
+    {
+        vrm::PointLightComponent light{ glm::vec3(1.f), 1.f, 10.f };
+        registry.submitPointLight(light, { lateral(generator), lateral(generator), depth(generator) }, static_cast<entt::entity>(i));
+    }
+    return registry.prepareFrame();
+}
+
+} // namespace
+
+// Arguments: light count, worker count
+static void BM_ClusterLightCullerCull(benchmark::State& state)
+{
+    vrm::LightRegistry registry;
+    const auto& lightBlock = BuildLightBlock(registry, static_cast<size_t>(state.range(0)));
+
+    vrm::ClusterLightCuller culler;
+    culler.setWorkerCount(static_cast<unsigned int>(state.range(1)));
+    culler.buildClusters({ 12, 12, 24 }, glm::perspective(glm::radians(90.f), 16.f / 9.f, 0.1f, 100.f), 0.1f, 100.f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+
+    for (auto _ : state)
+    {
+        culler.cull(view, lightBlock);
+        benchmark::DoNotOptimize(culler.getLightIndices().data());
+    }
+
+    state.counters["light_indices"] = static_cast<double>(culler.getLightIndices().size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ClusterLightCullerCull)
+    ->ArgsProduct({ { 1'000, 10'000, 50'000 }, { 1, 4 } })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_ClusterLightCullerBuildClusters(benchmark::State& state)
+{
+    vrm::ClusterLightCuller culler;
+    const glm::mat4 projection = glm::perspective(glm::radians(90.f), 16.f / 9.f, 0.1f, 100.f);
+
+    for (auto _ : state)
+    {
+        culler.buildClusters({ 12, 12, 24 }, projection, 0.1f, 100.f);
+        benchmark::DoNotOptimize(culler.getClusters().data());
+    }
+}
+BENCHMARK(BM_ClusterLightCullerBuildClusters)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <Vroom/Event/CustomEvent/CustomEventManager.h>
+#include <Vroom/Event/Trigger/TriggerManager.h>
+
+// Argument: number of custom events or triggers bound to the checked input, out of as many unrelated ones
+
+static void BM_CustomEventCheck(benchmark::State& state)
+{
+    vrm::CustomEventManager manager;
+    size_t calls = 0;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        manager.createCustomEvent("Bound_" + std::to_string(i))
+            .bindInput(vrm::Event::Type::KeyPressed, vrm::KeyCode::W)
+            .bindCallback([&calls](const vrm::Event&) { calls++; });
+        manager.createCustomEvent("Unbound_" + std::to_string(i))
+            .bindInput(vrm::Event::Type::MouseMoved)
+            .bindCallback([&calls](const vrm::Event&) { calls++; });
+    }
+
+    vrm::Event event;
+    event.type = vrm::Event::Type::KeyPressed;
+    event.keyCode = vrm::KeyCode::W;
+
+    for (auto _ : state)
+    {
+        event.handled = false;
+        manager.check(event);
+    }
+
+    benchmark::DoNotOptimize(calls);
+}
+BENCHMARK(BM_CustomEventCheck)->Arg(1)->Arg(8)->Arg(64);
+
+// An input no custom event is bound to, as most raw events are
+static void BM_CustomEventCheckUnbound(benchmark::State& state)
+{
+    vrm::CustomEventManager manager;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        manager.createCustomEvent("Event_" + std::to_string(i))
+            .bindInput(vrm::Event::Type::KeyPressed, vrm::KeyCode::W);
+    }
+
+    vrm::Event event;
+    event.type = vrm::Event::Type::KeyPressed;
+    event.keyCode = vrm::KeyCode::S;
+
+    for (auto _ : state)
+    {
+        event.handled = false;
+        manager.check(event);
+    }
+}
+BENCHMARK(BM_CustomEventCheckUnbound)->Arg(1)->Arg(64);
+
+static void BM_TriggerCheck(benchmark::State& state)
+{
+    vrm::TriggerManager manager;
+    size_t calls = 0;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        manager.createTrigger("Bound_" + std::to_string(i))
+            .bindInput(vrm::KeyCode::W)
+            .bindCallback([&calls](bool) { calls++; });
+        manager.createTrigger("Unbound_" + std::to_string(i))
+            .bindInput(vrm::KeyCode::S)
+            .bindCallback([&calls](bool) { calls++; });
+    }
+
+    // Pressed then released, as a trigger only fires when its state changes
+    vrm::Event pressed;
+    pressed.type = vrm::Event::Type::KeyPressed;
+    pressed.keyCode = vrm::KeyCode::W;
+    vrm::Event released = pressed;
+    released.type = vrm::Event::Type::KeyReleased;
+
+    for (auto _ : state)
+    {
+        manager.check(pressed);
+        manager.check(released);
+    }
+
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_TriggerCheck)->Arg(1)->Arg(8)->Arg(64);
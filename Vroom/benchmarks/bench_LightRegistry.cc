@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <Vroom/Render/Clustering/LightRegistry.h>
+
+// The light block is built as for the renderer, but never uploaded: prepareFrame stands for endFrame without a ring buffer.
+
+namespace
+{
+
+struct LightSet
+{
+    explicit LightSet(size_t count)
+    {
+        entities.reserve(count);
+        positions.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            entities.push_back(static_cast<entt::entity>(i));
+            positions.push_back({ static_cast<float>(i % 100), 2.f, static_cast<float>(i / 100) });
+        }
+    }
+
+    void submit(vrm::LightRegistry& registry, size_t first = 0)
+    {
+        for (size_t i = first; i < entities.size(); ++i)
+            registry.submitPointLight(light, positions[i], entities[i]);
+    }
+
+    vrm::PointLightComponent light{ glm::vec3{ 1.f, 1.f, 1.f }, 10.f, 5.f };
+    std::vector<entt::entity> entities;
+    std::vector<glm::vec3> positions;
+};
+
+} // namespace
+
+// Every light already has a slot: the common frame
+static void BM_LightRegistrySteadyFrame(benchmark::State& state)
+{
+    LightSet lights(static_cast<size_t>(state.range(0)));
+
+    vrm::LightRegistry registry;
+    registry.reserve(static_cast<int>(state.range(0)));
+    registry.beginFrame();
+    lights.submit(registry);
+    registry.prepareFrame();
+
+    for (auto _ : state)
+    {
+        registry.beginFrame();
+        lights.submit(registry);
+        benchmark::DoNotOptimize(registry.prepareFrame().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LightRegistrySteadyFrame)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMicrosecond);
+
+// Every light is new: the frame a scene is loaded
+static void BM_LightRegistryFirstFrame(benchmark::State& state)
+{
+    LightSet lights(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        vrm::LightRegistry registry;
+        registry.reserve(static_cast<int>(state.range(0)));
+        registry.beginFrame();
+        lights.submit(registry);
+        benchmark::DoNotOptimize(registry.prepareFrame().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LightRegistryFirstFrame)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMicrosecond);
+
+// A tenth of the lights is removed then added back every other frame, so slots are compacted then appended
+static void BM_LightRegistryChurn(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    LightSet lights(count);
+
+    vrm::LightRegistry registry;
+    registry.reserve(static_cast<int>(count));
+    registry.beginFrame();
+    lights.submit(registry);
+    registry.prepareFrame();
+
+    bool removed = false;
+    for (auto _ : state)
+    {
+        removed = !removed;
+        registry.beginFrame();
+        lights.submit(registry, removed ? count / 10 : 0);
+        benchmark::DoNotOptimize(registry.prepareFrame().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LightRegistryChurn)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMicrosecond);
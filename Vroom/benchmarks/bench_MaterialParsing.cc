@@ -0,0 +1,14 @@
+#include <benchmark/benchmark.h>
+
+#include <Vroom/Asset/Parsing/MaterialParsing.h>
+
+// Reads the material file and its shader sources, then assembles them. Needs the Resources folder next to the executable.
+static void BM_MaterialParsingDefault(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto results = vrm::MaterialParsing::Parse("Resources/Engine/Material/Mat_Default.asset");
+        benchmark::DoNotOptimize(results.fragment.data());
+    }
+}
+BENCHMARK(BM_MaterialParsingDefault)->Unit(benchmark::kMicrosecond);
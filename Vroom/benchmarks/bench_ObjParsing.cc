@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Vroom/Asset/Parsing/ObjParsing.h>
+
+// CPU side of MeshAsset::loadObj. Uploading to the geometry pool and loading materials need an OpenGL context.
+
+// Writes a square grid of quads, split in two triangles each, with positions, texture coordinates and normals
+static std::string WriteGridObj(size_t side)
+{
+    const std::string path = "bench_grid_" + std::to_string(side) + ".obj";
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    file << "o Grid\n";
+    for (size_t z = 0; z <= side; ++z)
+    {
+        for (size_t x = 0; x <= side; ++x)
+        {
+            file << "v " << x << " 0 " << z << "\n";
+            file << "vt " << static_cast<float>(x) / side << " " << static_cast<float>(z) / side << "\n";
+        }
+    }
+    file << "vn 0 1 0\n";
+
+    // Obj indices start at 1
+    auto index = [side](size_t x, size_t z) { return z * (side + 1) + x + 1; };
+    auto corner = [&file](size_t i) { file << " " << i << "/" << i << "/1"; };
+    for (size_t z = 0; z < side; ++z)
+    {
+        for (size_t x = 0; x < side; ++x)
+        {
+            file << "f"; corner(index(x, z)); corner(index(x, z + 1)); corner(index(x + 1, z + 1)); file << "\n";
+            file << "f"; corner(index(x, z)); corner(index(x + 1, z + 1)); corner(index(x + 1, z)); file << "\n";
+        }
+    }
+
+    return path;
+}
+
+// Argument: grid side, the mesh has 2 * side * side triangles
+static void BM_ObjParsingGrid(benchmark::State& state)
+{
+    const std::string path = WriteGridObj(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::vector<vrm::ObjParsing::SubMesh> subMeshes;
+        if (!vrm::ObjParsing::Parse(path, subMeshes))
+        {
+            state.SkipWithError("Failed to parse the generated obj file.");
+            break;
+        }
+        benchmark::DoNotOptimize(subMeshes.data());
+    }
+
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_ObjParsingGrid)->Arg(16)->Arg(64)->Arg(128)->Unit(benchmark::kMillisecond);
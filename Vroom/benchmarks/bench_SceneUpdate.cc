@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <string>
+
+#include <Vroom/Scene/Scene.h>
+#include <Vroom/Scene/Entity.h>
+#include <Vroom/Scene/Components/NameComponent.h>
+#include <Vroom/Scene/Components/ScriptComponent.h>
+#include <Vroom/Scene/Components/TransformComponent.h>
+
+namespace
+{
+
+// Moves its entity on a circle, as the sandbox scripts do. ScriptComponent::getEntity needs the application,
+// so the registry is given at construction.
+class OrbitScript : public vrm::ScriptComponent
+{
+public:
+    OrbitScript(entt::registry& registry, entt::entity entity, float angle)
+        : m_Registry(registry), m_Entity(entity), m_Angle(angle)
+    {
+    }
+
+    void onUpdate(float dt) override
+    {
+        m_Angle += dt;
+
+        auto& transform = m_Registry.get<vrm::TransformComponent>(m_Entity);
+        transform.setPosition({ 10.f * std::cos(m_Angle), 0.f, 10.f * std::sin(m_Angle) });
+        transform.setRotation({ 0.f, -m_Angle, 0.f });
+    }
+
+private:
+    entt::registry& m_Registry;
+    entt::entity m_Entity;
+    float m_Angle;
+};
+
+} // namespace
+
+// Argument: number of scripted entities, each moved every frame
+static void BM_SceneUpdate(benchmark::State& state)
+{
+    vrm::Scene scene;
+    auto& registry = scene.getRegistry();
+
+    // Components are added to the registry directly: Scene::createEntity checks name unicity in linear time
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        auto handle = registry.create();
+        registry.emplace<vrm::NameComponent>(handle, "Scripted_" + std::to_string(i));
+        registry.emplace<vrm::TransformComponent>(handle);
+
+        vrm::Entity entity(handle, &registry);
+        entity.addScriptComponent<OrbitScript>(registry, handle, static_cast<float>(i));
+    }
+
+    for (auto _ : state)
+    {
+        scene.update(1.f / 60.f);
+        benchmark::ClobberMemory();
+    }
+
+    registry.clear();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneUpdate)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include <Vroom/Core/Application.h>
+#include <Vroom/Scene/Scene.h>
+#include <Vroom/Scene/Components/MeshComponent.h>
+#include <Vroom/Scene/Components/NameComponent.h>
+#include <Vroom/Scene/Components/PointLightComponent.h>
+#include <Vroom/Scene/Components/TransformComponent.h>
+#include <Vroom/Asset/StaticAsset/MeshAsset.h>
+#include <Vroom/Render/Abstraction/GLCall.h>
+
+// Scene::render through the renderer, in a headless application. Meshes have no sub mesh, so nothing is drawn: the
+// time is spent in the views, the submissions, and the per scene work of the renderer. Lights do not move, so their
+// clusters are only culled on the first frame.
+// Arguments: mesh count, point light count.
+static void BM_SceneRenderViews(benchmark::State& state)
+{
+    const size_t meshCount = static_cast<size_t>(state.range(0));
+    const size_t lightCount = static_cast<size_t>(state.range(1));
+
+    static char name[] = "VroomBenchmarks";
+    static char headless[] = "--headless";
+    char* argv[] = { name, headless };
+    auto app = std::make_unique<vrm::Application>(2, argv);
+
+    {
+        // An empty mesh asset is never uploaded, instances only reference it
+        auto meshAsset = std::make_unique<vrm::MeshAsset>();
+
+        // Components are added to the registry directly: Scene::createEntity checks name unicity in linear time
+        vrm::Scene scene;
+        auto& registry = scene.getRegistry();
+        for (size_t i = 0; i < meshCount; ++i)
+        {
+            auto entity = registry.create();
+            registry.emplace<vrm::NameComponent>(entity, "Mesh_" + std::to_string(i));
+            registry.emplace<vrm::TransformComponent>(entity).setPosition({ static_cast<float>(i), 0.f, 0.f });
+            registry.emplace<vrm::MeshComponent>(entity, meshAsset->createInstance());
+        }
+        for (size_t i = 0; i < lightCount; ++i)
+        {
+            auto entity = registry.create();
+            registry.emplace<vrm::NameComponent>(entity, "PointLight_" + std::to_string(i));
+            registry.emplace<vrm::TransformComponent>(entity).setPosition({ static_cast<float>(i), 2.f, 0.f });
+            registry.emplace<vrm::PointLightComponent>(entity, glm::vec3{ 1.f, 1.f, 1.f }, 10.f, 5.f);
+        }
+
+        for (auto _ : state)
+            scene.render();
+
+        // Commands still queued are not part of the measure, but must complete before the context is destroyed
+        GLCall(glFinish());
+        registry.clear();
+    }
+
+    app.reset();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(meshCount + lightCount));
+}
+BENCHMARK(BM_SceneRenderViews)->Args({ 1'000, 100 })->Args({ 10'000, 1'000 })->Args({ 100'000, 1'000 });
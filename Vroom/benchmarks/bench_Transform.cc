@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include <Vroom/Scene/Components/TransformComponent.h>
+
+// Every call recomputes the matrix, as for an entity moved each frame
+static void BM_TransformRecompute(benchmark::State& state)
+{
+    vrm::TransformComponent transform;
+    transform.setRotation({ 0.1f, 0.2f, 0.3f });
+    transform.setScale({ 2.f, 2.f, 2.f });
+
+    float x = 0.f;
+    for (auto _ : state)
+    {
+        transform.setPosition({ x, 1.f, 2.f });
+        benchmark::DoNotOptimize(transform.getTransform());
+        x += 1.f;
+    }
+}
+BENCHMARK(BM_TransformRecompute);
+
+// The matrix is cached, as for a static entity
+static void BM_TransformCached(benchmark::State& state)
+{
+    vrm::TransformComponent transform;
+    transform.setPosition({ 1.f, 2.f, 3.f });
+    benchmark::DoNotOptimize(transform.getTransform());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(transform.getTransform());
+}
+BENCHMARK(BM_TransformCached);
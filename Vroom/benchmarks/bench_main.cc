@@ -0,0 +1,215 @@
+#include <benchmark/benchmark.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Vroom/Core/Log.h>
+
+#include "PerfGate.h"
+
+// Repetitions of each benchmark in performance gate mode, unless --benchmark_repetitions is given
+static constexpr int PERF_GATE_REPETITIONS = 10;
+
+namespace
+{
+
+// Collects the time of every repetition, on top of the usual console output
+class PerfGateReporter : public benchmark::ConsoleReporter
+{
+public:
+    void ReportRuns(const std::vector<Run>& runs) override
+    {
+        benchmark::ConsoleReporter::ReportRuns(runs);
+
+        for (const auto& run : runs)
+        {
+            if (run.run_type != Run::RT_Iteration || run.skipped)
+                continue;
+
+            const double timeNs = run.GetAdjustedRealTime() * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+            m_Samples[run.run_name.str()].push_back(timeNs);
+        }
+    }
+
+    std::map<std::string, std::vector<double>>& getSamples() { return m_Samples; }
+
+private:
+    std::map<std::string, std::vector<double>> m_Samples;
+};
+
+} // namespace
+
+// Only the benchmarks listed in the baseline are run
+static std::string BuildFilter(const std::vector<vrm::PerfGate::Metric>& baseline)
+{
+    std::string filter = "^(";
+    for (size_t i = 0; i < baseline.size(); ++i)
+    {
+        if (i > 0)
+            filter += '|';
+        for (char c : baseline[i].name)
+        {
+            if (std::string_view(".^$|()[]{}*+?\\").find(c) != std::string_view::npos)
+                filter += '\\';
+            filter += c;
+        }
+    }
+    return filter + ")$";
+}
+
+// Benchmarks missing from the run fail the gate, unless a filter excluded them on purpose. So do benchmarks without a
+// blessed timing, which could never regress.
+static int CheckBaseline(const std::vector<vrm::PerfGate::Metric>& baseline, std::map<std::string, std::vector<double>>& samples,
+    bool requireAll)
+{
+    size_t failures = 0;
+    size_t notBlessed = 0;
+
+    std::cout << "\nPerformance gate, medians in ns:\n";
+    for (const auto& expected : baseline)
+    {
+        auto current = vrm::PerfGate::Summarize(expected.name, samples[expected.name]);
+        const auto verdict = vrm::PerfGate::Compare(expected, current);
+        if (verdict == vrm::PerfGate::Verdict::Regression || (requireAll && verdict == vrm::PerfGate::Verdict::NotMeasured))
+            failures++;
+        if (verdict == vrm::PerfGate::Verdict::NotBlessed && (requireAll || current.medianNs > 0.0))
+            notBlessed++;
+
+        std::cout << std::left << std::setw(48) << expected.name << std::right
+            << std::setw(14) << expected.medianNs << std::setw(14) << current.medianNs;
+        if (expected.medianNs > 0.0 && current.medianNs > 0.0)
+        {
+            const double change = 100.0 * (current.medianNs - expected.medianNs) / expected.medianNs;
+            std::cout << std::showpos << std::setw(10) << std::fixed << std::setprecision(1) << change << '%'
+                << std::noshowpos << std::defaultfloat << std::setprecision(6);
+        }
+        else
+        {
+            std::cout << std::setw(11) << "-";
+        }
+        std::cout << "  " << vrm::PerfGate::GetVerdictName(verdict)
+            << " (tolerance " << 100.0 * expected.tolerance << "%)\n";
+    }
+
+    if (notBlessed > 0)
+        VRM_LOG_ERROR("{} benchmark(s) have no baseline timing: bless a baseline with --perf-bless=<file>.", notBlessed);
+    if (failures > 0)
+        VRM_LOG_ERROR("{} benchmark(s) regressed or were not measured.", failures);
+
+    return failures + notBlessed > 0 ? 1 : 0;
+}
+
+// The blessed baseline is written to its own file, so that the list of benchmarks it was read from stays untouched
+static int BlessBaseline(const std::string& blessedPath, std::vector<vrm::PerfGate::Metric> baseline,
+    std::map<std::string, std::vector<double>>& samples)
+{
+    for (auto& metric : baseline)
+    {
+        if (samples[metric.name].empty())
+        {
+            VRM_LOG_WARN("{} was not measured, its baseline is kept.", metric.name);
+            continue;
+        }
+
+        auto current = vrm::PerfGate::Summarize(metric.name, samples[metric.name]);
+        metric.medianNs = current.medianNs;
+        metric.madNs = current.madNs;
+    }
+
+    if (!vrm::PerfGate::WriteBaseline(blessedPath, baseline))
+    {
+        VRM_LOG_ERROR("Failed to write performance baseline: {}", blessedPath);
+        return 1;
+    }
+
+    VRM_LOG_WARN("Performance baseline blessed: {}", blessedPath);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    // Loading assets logs every file, which would end up in the measurements
+    Log::Init();
+    spdlog::set_level(spdlog::level::level_enum::warn);
+
+    // Performance gate options are removed before the benchmark library parses the others
+    std::string baselinePath;
+    std::string blessedPath;
+    bool repetitionsGiven = false;
+    bool filterGiven = false;
+
+    std::vector<char*> arguments;
+    for (int i = 0; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument.starts_with("--perf-baseline="))
+        {
+            baselinePath = argument.substr(std::string_view("--perf-baseline=").size());
+            continue;
+        }
+        if (argument.starts_with("--perf-bless"))
+        {
+            if (!argument.starts_with("--perf-bless=") || argument.size() == std::string_view("--perf-bless=").size())
+            {
+                VRM_LOG_ERROR("--perf-bless needs the file to write the blessed baseline to: --perf-bless=<file>.");
+                return 1;
+            }
+            blessedPath = argument.substr(std::string_view("--perf-bless=").size());
+            continue;
+        }
+
+        repetitionsGiven |= argument.starts_with("--benchmark_repetitions=");
+        filterGiven |= argument.starts_with("--benchmark_filter=");
+        arguments.push_back(argv[i]);
+    }
+
+    if (!blessedPath.empty() && baselinePath.empty())
+    {
+        VRM_LOG_ERROR("--perf-bless needs --perf-baseline=<file>, the benchmarks to measure.");
+        return 1;
+    }
+
+    std::vector<vrm::PerfGate::Metric> baseline;
+    std::string repetitionsArgument = "--benchmark_repetitions=" + std::to_string(PERF_GATE_REPETITIONS);
+    std::string filterArgument;
+    if (!baselinePath.empty())
+    {
+        if (!vrm::PerfGate::ReadBaseline(baselinePath, baseline))
+            return 1;
+
+        if (!repetitionsGiven)
+            arguments.push_back(repetitionsArgument.data());
+        if (!filterGiven)
+        {
+            filterArgument = "--benchmark_filter=" + BuildFilter(baseline);
+            arguments.push_back(filterArgument.data());
+        }
+    }
+
+    int argumentCount = static_cast<int>(arguments.size());
+    arguments.push_back(nullptr);
+
+    benchmark::Initialize(&argumentCount, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data()))
+        return 1;
+
+    if (baselinePath.empty())
+    {
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+        return 0;
+    }
+
+    PerfGateReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (!blessedPath.empty())
+        return BlessBaseline(blessedPath, std::move(baseline), reporter.getSamples());
+
+    return CheckBaseline(baseline, reporter.getSamples(), !filterGiven);
+}
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "Vroom/Asset/AssetData/Vertex.h"
+#include "Vroom/Math/BoundingVolumes.h"
 
 namespace vrm
 {
@@ -30,9 +31,21 @@ public:
     size_t getTriangleCount() const { return getIndexCount() / 3; }
     size_t getVertexCount() const { return m_Vertices.size(); }
 
+    const AABB& getBoundingBox() const { return m_BoundingBox; }
+    const BoundingSphere& getBoundingSphere() const { return m_BoundingSphere; }
+
+private:
+    /**
+     * @brief Computes the local space bounding box and bounding sphere of the vertices.
+     */
+    void computeBounds();
+
 private:
     std::vector<Vertex> m_Vertices;
     std::vector<uint32_t> m_Indices;
+
+    AABB m_BoundingBox;
+    BoundingSphere m_BoundingSphere;
 };
 
 } // namespace vrm
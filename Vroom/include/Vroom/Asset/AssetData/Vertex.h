@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <glm/glm.hpp>
 
 namespace vrm
@@ -12,4 +14,28 @@ struct Vertex
     glm::vec2 texCoords;
 };
 
+/**
+ * @brief Compressed vertex, half the size of Vertex.
+ * - Position: unorm16, relative to a cube enclosing the mesh bounding box. The fourth component is padding.
+ * - Normal: octahedral encoding, snorm16.
+ * - Texture coordinates: half floats.
+ */
+struct PackedVertex
+{
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t texCoords[2];
+};
+
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must be 16 bytes.");
+
+/**
+ * @brief Vertex formats a mesh can be stored with on the GPU.
+ */
+enum class VertexFormat : uint8_t
+{
+    Standard = 0, // Vertex
+    Packed        // PackedVertex
+};
+
 } // namespace vrm
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Vroom/Asset/AssetData/Vertex.h"
+#include "Vroom/Math/BoundingVolumes.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Converts vertices to the packed vertex format.
+ * 
+ * Positions are quantized relative to a cube enclosing the bounding box, rather than the box itself: dequantization is then
+ * a translation and a uniform scale, which can be folded into the model matrix without changing normal directions.
+ */
+class VertexPacking
+{
+public:
+    VertexPacking() = delete;
+
+    /**
+     * @brief Texture coordinates are stored as half floats. Beyond this magnitude, their precision is too low for large textures.
+     */
+    static constexpr float MaxTexCoord = 16.f;
+
+    /**
+     * @brief Position dequantization: position = offset + quantized * scale, quantized being in [0, 1].
+     */
+    struct PositionQuantization
+    {
+        glm::vec3 offset = glm::vec3(0.f);
+        float scale = 1.f;
+
+        /**
+         * @brief Gets the dequantization as a matrix, to be applied before the model matrix.
+         * 
+         * @return glm::mat4 The dequantization matrix.
+         */
+        glm::mat4 getMatrix() const;
+    };
+
+    /**
+     * @brief Checks if vertices can be packed without visible precision loss.
+     * 
+     * @param vertices The vertices.
+     * @return true If every texture coordinate is in [-MaxTexCoord, MaxTexCoord].
+     */
+    static bool CanPack(const std::vector<Vertex>& vertices);
+
+    /**
+     * @brief Computes the position quantization of a mesh.
+     * 
+     * @param box The bounding box of the mesh.
+     * @return PositionQuantization The quantization.
+     */
+    static PositionQuantization ComputeQuantization(const AABB& box);
+
+    /**
+     * @brief Packs vertices.
+     * 
+     * @param vertices The vertices to pack.
+     * @param quantization The position quantization, from ComputeQuantization.
+     * @return std::vector<PackedVertex> The packed vertices.
+     */
+    static std::vector<PackedVertex> Pack(const std::vector<Vertex>& vertices, const PositionQuantization& quantization);
+
+    /**
+     * @brief Unpacks a vertex. Mostly useful for tests and tools.
+     * 
+     * @param vertex The packed vertex.
+     * @param quantization The position quantization used to pack the vertex.
+     * @return Vertex The unpacked vertex.
+     */
+    static Vertex Unpack(const PackedVertex& vertex, const PositionQuantization& quantization);
+
+    /**
+     * @brief Encodes a unit vector on the octahedron, mapped to [-1, 1]^2.
+     * 
+     * @param normal The unit vector.
+     * @return glm::vec2 The encoded vector.
+     */
+    static glm::vec2 EncodeOctahedral(const glm::vec3& normal);
+
+    /**
+     * @brief Decodes a vector encoded with EncodeOctahedral.
+     * 
+     * @param encoded The encoded vector.
+     * @return glm::vec3 The unit vector.
+     */
+    static glm::vec3 DecodeOctahedral(const glm::vec2& encoded);
+};
+
+} // namespace vrm
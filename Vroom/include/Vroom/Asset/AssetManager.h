@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "Vroom/Core/Assert.h"
+#include "Vroom/Core/Profiler.h"
 #include "Vroom/Asset/StaticAsset/StaticAsset.h"
 
 namespace vrm
@@ -68,6 +69,8 @@ public:
     {
         if (!isAssetLoaded(assetID))
         {
+            VRM_PROFILE_SCOPE("AssetManager::loadAsset");
+
             auto asset = std::make_unique<T>();
             VRM_ASSERT_MSG(asset->load(assetID), "Failed to load asset: {}", assetID);
 
@@ -22,9 +22,6 @@ public:
     
     static ParsingResults Parse(const std::string& filePath);
 
-private:
-
-
 private:
     struct MaterialParameters
     {
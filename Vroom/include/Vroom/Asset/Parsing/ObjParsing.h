@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Vroom/Asset/AssetData/MeshData.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Reads the geometry of obj files. CPU side only: uploading the meshes and loading their materials is left to MeshAsset.
+ */
+class ObjParsing
+{
+public:
+    struct SubMesh
+    {
+        std::string name;
+        MeshData meshData;
+        // Material asset path, next to the obj file. Empty if the sub mesh has no material.
+        std::string materialPath;
+    };
+
+public:
+    ObjParsing() = delete;
+
+    /**
+     * @brief Parses the sub meshes of an obj file.
+     * 
+     * @param filePath The obj file path.
+     * @param subMeshes The parsed sub meshes, appended to the vector.
+     * @return true If the file could be parsed.
+     * @return false If the file could not be read.
+     */
+    static bool Parse(const std::string& filePath, std::vector<SubMesh>& subMeshes);
+};
+
+} // namespace vrm
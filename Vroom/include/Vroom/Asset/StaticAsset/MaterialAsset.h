@@ -4,9 +4,13 @@
 #include "Vroom/Asset/AssetInstance/MaterialInstance.h"
 #include "Vroom/Asset/AssetInstance/TextureInstance.h"
 
+#include "Vroom/Asset/AssetData/Vertex.h"
+
 #include "Vroom/Render/Abstraction/Shader.h"
 
+#include <cstdint>
 #include <fstream>
+#include <string>
 #include <vector>
 
 namespace vrm
@@ -28,11 +32,20 @@ public:
     [[nodiscard]] MaterialInstance createInstance();
 
     /**
-     * @brief Get the shader of the material.
+     * @brief Get the shader of the material, compiled for a vertex format. The packed vertex variant is compiled the first
+     * time it is requested, so that materials never drawn with packed meshes do not pay for it.
      * 
+     * @param vertexFormat The vertex format of the mesh drawn with the material.
      * @return const Shader& The shader.
      */
-    [[nodiscard]] inline const Shader& getShader() const { return m_Shader; }
+    [[nodiscard]] inline const Shader& getShader(VertexFormat vertexFormat = VertexFormat::Standard) const
+    {
+        if (vertexFormat != VertexFormat::Packed)
+            return m_Shader;
+        if (!m_PackedShaderLoaded)
+            loadPackedShader();
+        return m_PackedShader;
+    }
     
     /**
      * @brief Get the number of textures in the material.
@@ -49,12 +62,40 @@ public:
      */
     [[nodiscard]] inline const TextureInstance& getTexture(size_t slot) const { return m_Textures[slot]; }
 
+    /**
+     * @brief Get the identifier of the material. Every material asset gets a different one, used to sort draws.
+     * 
+     * @return uint32_t The identifier.
+     */
+    [[nodiscard]] inline uint32_t getID() const { return m_ID; }
+
+    /**
+     * @brief Get an identifier of the textures used by the material. Materials using the same textures get the same identifier.
+     * 
+     * @return uint32_t The texture set identifier.
+     */
+    [[nodiscard]] inline uint32_t getTextureSetID() const { return m_TextureSetID; }
+
 protected:
     bool loadImpl(const std::string& filePath) override;
 
+private:
+    void loadPackedShader() const;
+
 private:
     Shader m_Shader;
+    // Compiled on first use, from the sources kept at load
+    mutable Shader m_PackedShader;
+    mutable bool m_PackedShaderLoaded = false;
+    std::string m_PackedVertexSource;
+    std::string m_FragmentSource;
+    std::string m_FilePath;
     std::vector<TextureInstance> m_Textures;
+
+    uint32_t m_ID;
+    uint32_t m_TextureSetID = 0;
+
+    static uint32_t s_NextID;
 };
 
 } // namespace vrm
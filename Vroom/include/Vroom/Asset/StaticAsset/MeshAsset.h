@@ -33,14 +33,28 @@ public:
 
     const std::list<SubMesh>& getSubMeshes() const { return m_SubMeshes; }
 
+    /**
+     * @brief Enables or disables packed vertices for meshes loaded afterwards. Disabled by default: packed positions are
+     * quantized, which an application opts in to.
+     * Sub meshes whose texture coordinates cannot be packed keep the standard format.
+     * 
+     * @param enabled Whether loaded meshes use packed vertices.
+     */
+    static void SetPackedVerticesEnabled(bool enabled) { s_PackedVerticesEnabled = enabled; }
+    static bool IsPackedVerticesEnabled() { return s_PackedVerticesEnabled; }
+
 protected: 
     bool loadImpl(const std::string& filePath) override;
 
 private:
     bool loadObj(const std::string& filePath);
 
+    static VertexFormat selectVertexFormat(const MeshData& meshData);
+
 private:
     std::list<SubMesh> m_SubMeshes;
+
+    static bool s_PackedVerticesEnabled;
 };
 
 } // namespace vrm
\ No newline at end of file
@@ -28,6 +28,8 @@ public:
 
     /**
      * @brief Construct an Application object and intializes the engine.
+     * With the --headless argument, the OpenGL context is created offscreen (EGL, or OSMesa as a fallback), without any display.
+     * Nothing is presented then, so rendering must target off screen frame buffers.
      * 
      * @param argc Command line argc.
      * @param argv Command line argv.
@@ -48,6 +50,12 @@ public:
      */
     static Application& Get() { return *s_Instance; }
 
+    /**
+     * @brief Checks if the application runs without any display.
+     * @return True if the OpenGL context is offscreen.
+     */
+    inline bool isHeadless() const { return m_Headless; }
+
     /**
      * @brief Starts the application main loop.
      */
@@ -116,6 +124,14 @@ private:
      */
     bool initGLFW();
 
+    /**
+     * @brief Creates the window, and its OpenGL context.
+     * 
+     * @return true If the window was created successfully.
+     * @return false Otherwise.
+     */
+    bool createWindow();
+
     /**
      * @brief Initialize the layers.
      * 
@@ -146,6 +162,7 @@ private:
     std::chrono::high_resolution_clock::time_point m_LastFrameTimePoint;
 
     bool m_PendingKilled = false;
+    bool m_Headless = false;
 
 };
 
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Vroom/DataStructure/RollingStatistics.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Engine metrics of each frame. Modules feed counters during the frame, and endFrame() stores them in a fixed size history.
+ *
+ * The history can be written as CSV or JSON, and frames can be streamed to a file as they end, for offline analysis.
+ * The engine instance fed by the modules is created by the application. Standalone instances can also be created.
+ */
+class FrameStats
+{
+public:
+    /**
+     * @brief Counters of a frame. Reset at the end of every frame.
+     */
+    enum class Counter
+    {
+        DrawCalls = 0,
+        ProgramBinds,
+        VertexArrayBinds,
+        TextureBinds,
+        Triangles,
+        VisibleObjects,
+        CulledObjects,
+        LightsSubmitted,
+        LightsCulled,
+        AverageLightsPerCluster,
+        MaxLightsPerCluster,
+        ActiveClusters,
+        BytesUploaded,
+        EntitiesUpdated,
+        ScriptsUpdated,
+        Count
+    };
+
+    static constexpr size_t CounterCount = static_cast<size_t>(Counter::Count);
+
+    /**
+     * @brief Number of frames kept in the history.
+     */
+    static constexpr size_t HistoryFrames = 600;
+
+    /**
+     * @brief Format of exported frames.
+     */
+    enum class Format
+    {
+        CSV,
+        JSON
+    };
+
+    /**
+     * @brief Metrics of an ended frame.
+     */
+    struct Frame
+    {
+        uint64_t index = 0;
+        float frameTime = 0.f; // Milliseconds
+        std::array<double, CounterCount> counters = {};
+
+        inline double get(Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+    };
+
+public:
+    FrameStats();
+    ~FrameStats();
+
+    FrameStats(const FrameStats&) = delete;
+    FrameStats& operator=(const FrameStats&) = delete;
+
+    /**
+     * @brief Initializes the engine frame statistics.
+     */
+    static void Init();
+
+    /**
+     * @brief Shuts down the engine frame statistics, ending any recording.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief Gets the engine frame statistics, fed by the engine modules.
+     * @return The engine frame statistics.
+     */
+    static FrameStats& Get();
+
+    /**
+     * @brief Checks if the engine frame statistics are initialized.
+     * @return True if the engine frame statistics are initialized.
+     */
+    static bool IsInitialized();
+
+    /**
+     * @brief Gets the name of a counter, used as a CSV column and a JSON key.
+     * @param counter The counter.
+     * @return The snake case name of the counter.
+     */
+    static std::string_view GetCounterName(Counter counter);
+
+    /**
+     * @brief Adds to a counter of the current frame.
+     * @param counter The counter.
+     * @param value The value to add.
+     */
+    inline void add(Counter counter, double value = 1.0) { m_Current[static_cast<size_t>(counter)] += value; }
+
+    /**
+     * @brief Sets a counter of the current frame.
+     * @param counter The counter.
+     * @param value The new value.
+     */
+    inline void set(Counter counter, double value) { m_Current[static_cast<size_t>(counter)] = value; }
+
+    /**
+     * @brief Gets a counter of the current frame.
+     * @param counter The counter.
+     * @return The value accumulated so far.
+     */
+    inline double get(Counter counter) const { return m_Current[static_cast<size_t>(counter)]; }
+
+    /**
+     * @brief Ends the current frame: stores its counters in the history, streams it if recording, and resets the counters.
+     * @param frameTime The duration of the frame, in milliseconds.
+     */
+    void endFrame(float frameTime);
+
+    /**
+     * @brief Gets the number of frames in the history.
+     * @return The number of frames, at most HistoryFrames.
+     */
+    inline size_t getFrameCount() const { return m_Count; }
+
+    /**
+     * @brief Gets a frame of the history.
+     * @param i The index of the frame, 0 being the oldest one.
+     * @return The frame.
+     */
+    const Frame& getFrame(size_t i) const;
+
+    /**
+     * @brief Gets the last ended frame. Empty if no frame ended yet.
+     * @return The last frame.
+     */
+    const Frame& getLastFrame() const;
+
+    /**
+     * @brief Gets the frame times of the history, in milliseconds.
+     * @return The frame time statistics.
+     */
+    inline const RollingStatistics& getFrameTimes() const { return m_FrameTimes; }
+
+    /**
+     * @brief Gets a percentile of the frame times of the history.
+     * @param percentile The percentile, between 0 and 100.
+     * @return The frame time, in milliseconds.
+     */
+    inline float getFrameTimePercentile(float percentile) const { return m_FrameTimes.getPercentile(percentile); }
+
+    /**
+     * @brief Removes every frame of the history, and resets the counters of the current frame.
+     */
+    void clear();
+
+    /**
+     * @brief Writes the history, oldest frame first.
+     * @param stream The output stream.
+     * @param format The format to write.
+     */
+    void write(std::ostream& stream, Format format) const;
+
+    /**
+     * @brief Starts streaming every ended frame to a file, until stopRecording() is called. Stops any previous recording.
+     * @param filePath The path of the file, overwritten.
+     * @param format The format to write.
+     * @return True if the file could be opened.
+     */
+    bool startRecording(const std::string& filePath, Format format);
+
+    /**
+     * @brief Stops streaming frames, and closes the file.
+     */
+    void stopRecording();
+
+    /**
+     * @brief Checks if frames are being streamed to a file.
+     * @return True if recording.
+     */
+    inline bool isRecording() const { return m_Recording.is_open(); }
+
+private:
+    static void WriteHeader(std::ostream& stream, Format format);
+    static void WriteFrame(std::ostream& stream, Format format, const Frame& frame, bool first);
+    static void WriteFooter(std::ostream& stream, Format format);
+
+private:
+    static std::unique_ptr<FrameStats> s_Instance;
+
+    std::array<double, CounterCount> m_Current = {};
+    uint64_t m_FrameIndex = 0;
+
+    std::vector<Frame> m_History;
+    size_t m_Next = 0;
+    size_t m_Count = 0;
+    RollingStatistics m_FrameTimes;
+
+    std::ofstream m_Recording;
+    Format m_RecordingFormat = Format::CSV;
+    bool m_RecordedFrame = false;
+};
+
+} // namespace vrm
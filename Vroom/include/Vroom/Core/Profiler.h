@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define VRM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VRM_PROFILE_CONCAT(a, b) VRM_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef VRM_PROFILING
+    /**
+     * @brief Records the CPU time spent until the end of the enclosing C++ scope. The name must be a string literal.
+     * Compiled out when VRM_PROFILING is not defined.
+     */
+    #define VRM_PROFILE_SCOPE(name) ::vrm::ProfileScope VRM_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+    #define VRM_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+namespace vrm
+{
+
+/**
+ * @brief CPU frame profiler. Scopes are recorded into thread local buffers, and can be exported as Chrome trace JSON,
+ * readable by chrome://tracing and Perfetto.
+ *
+ * Events are only kept for the current frame, unless frames are being captured.
+ */
+class Profiler
+{
+public:
+    /**
+     * @brief A closed scope.
+     */
+    struct Event
+    {
+        const char* name;
+        int64_t start;    // Nanoseconds, from an arbitrary origin
+        int64_t duration; // Nanoseconds
+        uint32_t threadID;
+        uint32_t depth;
+    };
+
+public:
+    Profiler() = delete;
+
+    /**
+     * @brief Enables or disables recording at runtime. Enabled by default.
+     * @param enabled True to record scopes.
+     */
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+    /**
+     * @brief Ends a frame. Drops its events, unless frames are being captured. Writes the capture once it is complete.
+     */
+    static void EndFrame();
+
+    /**
+     * @brief Captures the events of the next frames, and writes them as Chrome trace JSON once done.
+     * @param frameCount The number of frames to capture.
+     * @param filePath The path of the JSON file to write.
+     */
+    static void CaptureFrames(size_t frameCount, const std::string& filePath);
+
+    /**
+     * @brief Checks if frames are being captured.
+     * @return True if a capture is pending.
+     */
+    static bool IsCapturing();
+
+    /**
+     * @brief Gets every recorded event of every thread, sorted by start time.
+     * @return The events.
+     */
+    static std::vector<Event> CollectEvents();
+
+    /**
+     * @brief Drops every recorded event.
+     */
+    static void Clear();
+
+    /**
+     * @brief Writes events as Chrome trace JSON.
+     * @param stream The output stream.
+     * @param events The events to write.
+     */
+    static void WriteChromeTrace(std::ostream& stream, const std::vector<Event>& events);
+
+    /**
+     * @brief Records a closed scope on the calling thread.
+     * @param name The name of the scope. Must outlive the profiler, typically a string literal.
+     * @param start The start of the scope, from Now().
+     * @param end The end of the scope, from Now().
+     * @param depth The nesting depth of the scope on its thread.
+     */
+    static void Record(const char* name, int64_t start, int64_t end, uint32_t depth);
+
+    /**
+     * @brief Gets the current time of the profiler clock.
+     * @return int64_t The time, in nanoseconds.
+     */
+    static int64_t Now();
+};
+
+/**
+ * @brief Records a CPU scope for its whole lifetime. Usually created through VRM_PROFILE_SCOPE.
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_Name;
+    int64_t m_Start;
+    bool m_Active;
+};
+
+} // namespace vrm
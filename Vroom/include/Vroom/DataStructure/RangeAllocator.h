@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <optional>
+
+namespace vrm
+{
+
+/**
+ * @brief Sub allocates ranges of a linear resource (typically a GPU buffer), in abstract units.
+ * Free ranges are kept sorted by offset, so that freed neighbours are merged back into a single range.
+ * Allocation is first fit.
+ */
+class RangeAllocator
+{
+public:
+    RangeAllocator() = default;
+
+    /**
+     * @brief Constructs an allocator with a single free range covering the whole capacity.
+     *
+     * @param capacity The capacity, in units.
+     */
+    explicit RangeAllocator(size_t capacity);
+
+    RangeAllocator(const RangeAllocator&) = default;
+    RangeAllocator(RangeAllocator&&) = default;
+    ~RangeAllocator() = default;
+
+    RangeAllocator& operator=(const RangeAllocator&) = default;
+    RangeAllocator& operator=(RangeAllocator&&) = default;
+
+    /**
+     * @brief Allocates a range.
+     *
+     * @param size The size of the range. Must be greater than 0.
+     * @return std::optional<size_t> The offset of the range, or nothing if no free range is large enough.
+     */
+    std::optional<size_t> allocate(size_t size);
+
+    /**
+     * @brief Frees a range previously returned by allocate.
+     *
+     * @param offset The offset of the range.
+     * @param size The size of the range, as requested to allocate.
+     */
+    void free(size_t offset, size_t size);
+
+    /**
+     * @brief Grows the capacity. The new space is appended to the free ranges.
+     *
+     * @param capacity The new capacity. Does nothing if not greater than the current capacity.
+     */
+    void grow(size_t capacity);
+
+    /**
+     * @brief Shrinks the capacity, dropping trailing free space. Allocated ranges are never moved.
+     *
+     * @param capacity The new capacity. Clamped to getUsedEnd(). Does nothing if not lower than the current capacity.
+     */
+    void shrink(size_t capacity);
+
+    /**
+     * @brief Frees every range, keeping the capacity.
+     *
+     */
+    void clear();
+
+    inline size_t getCapacity() const { return m_Capacity; }
+    inline size_t getUsed() const { return m_Used; }
+    inline size_t getFree() const { return m_Capacity - m_Used; }
+    inline size_t getFreeRangeCount() const { return m_FreeRanges.size(); }
+
+    /**
+     * @brief Gets the size of the largest free range.
+     *
+     * @return size_t The size of the largest free range. 0 if the allocator is full.
+     */
+    size_t getLargestFreeRange() const;
+
+    /**
+     * @brief Gets the end of the last allocated range: the smallest capacity keeping every allocated range.
+     *
+     * @return size_t The end of the last allocated range. 0 if nothing is allocated.
+     */
+    size_t getUsedEnd() const;
+
+private:
+    size_t m_Capacity = 0;
+    size_t m_Used = 0;
+
+    // Offset -> size
+    std::map<size_t, size_t> m_FreeRanges;
+};
+
+} // namespace vrm
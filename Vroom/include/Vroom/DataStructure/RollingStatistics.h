@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace vrm
+{
+
+/**
+ * @brief Keeps the last samples of a measure in a fixed size window, and gives their minimum, average and maximum.
+ */
+class RollingStatistics
+{
+public:
+    /**
+     * @brief Constructs an empty window.
+     *
+     * @param windowSize The number of samples kept. Must be greater than 0.
+     */
+    explicit RollingStatistics(size_t windowSize = 120);
+
+    /**
+     * @brief Adds a sample, replacing the oldest one when the window is full.
+     *
+     * @param value The sample.
+     */
+    void push(float value);
+
+    /**
+     * @brief Removes every sample.
+     */
+    void clear();
+
+    inline size_t getSampleCount() const { return m_Count; }
+    inline size_t getWindowSize() const { return m_Samples.size(); }
+    inline float getLast() const { return m_Last; }
+
+    /**
+     * @brief Gets the smallest sample of the window. 0 if empty.
+     */
+    float getMin() const;
+
+    /**
+     * @brief Gets the average of the samples of the window. 0 if empty.
+     */
+    float getAverage() const;
+
+    /**
+     * @brief Gets the largest sample of the window. 0 if empty.
+     */
+    float getMax() const;
+
+    /**
+     * @brief Gets a percentile of the samples of the window, with the nearest rank method. 0 if empty.
+     *
+     * @param percentile The percentile, between 0 and 100.
+     */
+    float getPercentile(float percentile) const;
+
+private:
+    std::vector<float> m_Samples;
+    size_t m_Next = 0;
+    size_t m_Count = 0;
+    float m_Last = 0.f;
+};
+
+} // namespace vrm
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Axis aligned bounding box.
+ *
+ */
+struct AABB
+{
+    glm::vec3 min = glm::vec3(0.f);
+    glm::vec3 max = glm::vec3(0.f);
+
+    inline glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+    inline glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+};
+
+/**
+ * @brief Bounding sphere.
+ *
+ */
+struct BoundingSphere
+{
+    glm::vec3 center = glm::vec3(0.f);
+    float radius = 0.f;
+};
+
+} // namespace vrm
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -14,12 +15,28 @@ public:
     ~ComputeShader();
 
     bool loadFromFile(const std::string& filePath);
+
+    /**
+     * @brief Loads a compute shader from a file, with preprocessor definitions added after its version directive.
+     * @param filePath The shader path.
+     * @param defines The definitions, such as "LOCAL_SIZE 64".
+     * @return true If loaded successfuly.
+     */
+    bool loadFromFile(const std::string& filePath, const std::vector<std::string>& defines);
     bool loadFromSource(const std::string& source);
     void unload();
     void bind() const;
     void dispatch(unsigned int x, unsigned int y, unsigned int z) const;
     void dispatchCustomBarrier(unsigned int x, unsigned int y, unsigned int z, unsigned int barrier) const;
 
+    /**
+     * @brief Dispatches with work group counts read from a buffer, as three consecutive unsigned ints.
+     * @param indirectBuffer The OpenGL ID of the buffer holding the work group counts.
+     * @param offset The offset of the work group counts in the buffer, in bytes. Must be a multiple of 4.
+     * @param barrier The memory barrier issued after the dispatch.
+     */
+    void dispatchIndirectCustomBarrier(unsigned int indirectBuffer, size_t offset, unsigned int barrier) const;
+
     inline void setMemoryBarrier(unsigned int barrier) { m_MemoryBarrier = barrier; }
     inline unsigned int getMemoryBarrier() const { return m_MemoryBarrier; }
 
@@ -101,7 +118,26 @@ public:
 	 */
 	void setUniformMat4f(const std::string& name, const glm::mat4& mat) const;
 
-private:
+	/**
+	 * @brief Sends unsigned int data to shader, skipping the name lookup.
+	 * @param location Uniform location, from getUniformLocation.
+	 * @param value Data to send.
+	 */
+	void setUniform1ui(int location, unsigned int value) const;
+
+	/**
+	 * @brief Sends vec4f array data to shader, skipping the name lookup.
+	 * @param location Location of the first element, from getUniformLocation.
+	 * @param count Number of elements in the array.
+	 * @param values Data to send.
+	 */
+	void setUniform4fv(int location, int count, const glm::vec4* values) const;
+
+	/**
+	 * @brief Gets the location of a uniform, to set it every frame without looking its name up.
+	 * @param name Uniform name.
+	 * @return The location, -1 if the uniform does not exist.
+	 */
 	int getUniformLocation(const std::string& name) const;
     
 private:
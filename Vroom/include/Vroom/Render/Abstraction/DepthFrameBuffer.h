@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Vroom/Render/Abstraction/Texture2D.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Off screen frame buffer with a single depth texture attachment, which shaders can sample.
+ */
+class DepthFrameBuffer
+{
+public:
+    DepthFrameBuffer();
+    DepthFrameBuffer(const DepthFrameBuffer&) = delete;
+    DepthFrameBuffer(DepthFrameBuffer&&) = delete;
+    ~DepthFrameBuffer();
+
+    DepthFrameBuffer& operator=(const DepthFrameBuffer&) = delete;
+    DepthFrameBuffer& operator=(DepthFrameBuffer&&) = delete;
+
+    /**
+     * @brief Binds the frame buffer, with depth test enabled and blending disabled.
+     */
+    void bind() const;
+    void unbind() const;
+
+    /**
+     * @brief Creates the frame buffer on the first call, then recreates the depth texture when the size changes.
+     * @param width The width, in pixels.
+     * @param height The height, in pixels.
+     */
+    void resize(int width, int height);
+
+    void clear() const;
+
+    inline unsigned int getRendererID() const { return m_RendererID; }
+
+    inline const Texture2D& getDepthTexture() const { return m_DepthTexture; }
+
+private:
+    unsigned int m_RendererID = 0;
+    Texture2D m_DepthTexture;
+};
+
+} // namespace vrm
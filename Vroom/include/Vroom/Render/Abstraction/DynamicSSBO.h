@@ -2,11 +2,15 @@
 
 #include "Vroom/Core/Assert.h"
 
-#include "Vroom/Render/Abstraction/ShaderStorageBufferObject.h"
+#include "Vroom/Render/Abstraction/GPUBufferAllocator.h"
 
 namespace vrm
 {
 
+/**
+ * @brief SSBO growing when written out of its capacity. Growth copies the previous content on the GPU.
+ * 
+ */
 class DynamicSSBO
 {
 public:
@@ -25,10 +29,37 @@ public:
 
     int getCapacity() const;
 
+    inline unsigned int getRendererID() const { return m_Buffer.getRendererID(); }
+
+    /**
+     * @brief Makes sure the SSBO can hold a given number of bytes. The content is kept.
+     * 
+     * @param capacity The requested capacity, in bytes.
+     */
     void reserve(int capacity);
 
+    /**
+     * @brief Shrinks the SSBO to the end of the data written since the last setData or clear.
+     * 
+     */
+    void shrinkToFit();
+
     void clear();
 
+    /**
+     * @brief Tells that the data past a given size is no longer needed, so that it may be dropped when the SSBO shrinks.
+     * 
+     * @param size The size of the data still in use, in bytes.
+     */
+    void truncate(int size);
+
+    /**
+     * @brief Ends a frame. After enough frames without growth, a mostly unused SSBO shrinks to the end of its written data,
+     * with some headroom. Only meant for SSBOs whose content is written from the CPU: data written by shaders is not tracked.
+     * 
+     */
+    void endFrame();
+
     void setSubData(const void* data, int size, int offset);
     void setData(const void* data, int size);
 
@@ -49,7 +80,9 @@ public:
             totalSize += dataSize;
         }
 
-        reserve(static_cast<int>(totalSize));
+        // Every byte is overwritten, so growing does not need to copy the previous content
+        m_Buffer.reserve(totalSize, false);
+        m_Size = 0;
 
         size_t offset = 0;
         for (const auto& [dataPtr, dataSize] : ptrAndSize)
@@ -60,8 +93,9 @@ public:
     }
 
 private:
-    ShaderStorageBufferObject m_SSBO;
-    int m_SSBOCapacity = 0;
+    GPUBufferAllocator m_Buffer = GPUBufferAllocator(GL_SHADER_STORAGE_BUFFER, 4);
+    // End of the written data
+    int m_Size = 0;
 };
 
 } // namespace vrm
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "Vroom/DataStructure/RangeAllocator.h"
+
+namespace vrm
+{
+
+/**
+ * @brief OpenGL buffer with sub allocation, growing and shrinking entirely on the GPU.
+ *
+ * Ranges are sub allocated with a free list, in units of a fixed granularity. When the buffer is full, its content is moved
+ * to a larger storage with glCopyBufferSubData, without any read back to the CPU.
+ * Storages left behind by growth are kept as spares, and reused by later moves instead of allocating new ones.
+ * After enough frames without growth, a mostly empty buffer shrinks to fit its last allocated range.
+ */
+class GPUBufferAllocator
+{
+public:
+    /**
+     * @brief Number of consecutive frames without growth before endFrame considers shrinking.
+     */
+    static constexpr unsigned int QuietFramesBeforeShrink = 120;
+
+    /**
+     * @brief Maximum number of spare storages kept for reuse.
+     */
+    static constexpr size_t MaxSpareStorages = 2;
+
+public:
+    /**
+     * @brief Constructs an empty allocator. No OpenGL storage is created until the first allocation or reserve.
+     *
+     * @param bindingTarget The indexed target used by setBindingPoint, typically GL_SHADER_STORAGE_BUFFER.
+     * @param granularity The allocation unit, in bytes. Every offset is a multiple of it.
+     */
+    explicit GPUBufferAllocator(GLenum bindingTarget = GL_SHADER_STORAGE_BUFFER, size_t granularity = 16);
+    GPUBufferAllocator(const GPUBufferAllocator&) = delete;
+    GPUBufferAllocator(GPUBufferAllocator&&);
+    ~GPUBufferAllocator();
+
+    GPUBufferAllocator& operator=(const GPUBufferAllocator&) = delete;
+    GPUBufferAllocator& operator=(GPUBufferAllocator&&);
+
+    /**
+     * @brief Allocates a range, growing the buffer if no free range is large enough.
+     *
+     * @param size The size of the range, in bytes. Rounded up to the granularity.
+     * @return size_t The offset of the range, in bytes.
+     */
+    size_t allocate(size_t size);
+
+    /**
+     * @brief Frees a range returned by allocate.
+     *
+     * @param offset The offset of the range, in bytes.
+     * @param size The size of the range, as requested to allocate.
+     */
+    void free(size_t offset, size_t size);
+
+    /**
+     * @brief Frees every range. Capacity and content are kept.
+     */
+    void clear();
+
+    /**
+     * @brief Writes data to the buffer.
+     *
+     * @param data The data.
+     * @param size The size of the data, in bytes.
+     * @param offset The offset to write to, in bytes. The range must fit in the capacity.
+     */
+    void write(const void* data, size_t size, size_t offset);
+
+    /**
+     * @brief Makes sure the buffer can hold a given number of bytes.
+     *
+     * @param capacity The requested capacity, in bytes.
+     * @param preserveContent If false, the previous content is not copied to the new storage.
+     */
+    void reserve(size_t capacity, bool preserveContent = true);
+
+    /**
+     * @brief Moves the content to a smaller storage. Allocated ranges are kept.
+     *
+     * @param capacity The requested capacity, in bytes. Clamped to the end of the last allocated range.
+     */
+    void shrink(size_t capacity);
+
+    /**
+     * @brief Shrinks the buffer to the end of its last allocated range.
+     */
+    void shrinkToFit();
+
+    /**
+     * @brief Ends a frame. After QuietFramesBeforeShrink frames without growth, shrinks the buffer if at most a quarter of it is in use.
+     *
+     * @param keptSize Bytes at the start of the buffer in use besides the allocated ranges, for owners writing the buffer
+     * without sub allocating it.
+     */
+    void endFrame(size_t keptSize = 0);
+
+    /**
+     * @brief Binds the buffer to an indexed binding point. The binding follows the buffer when its storage moves.
+     *
+     * @param bindingPoint The binding point.
+     */
+    void setBindingPoint(unsigned int bindingPoint);
+
+    inline unsigned int getRendererID() const { return m_RendererID; }
+    inline size_t getCapacity() const { return m_Ranges.getCapacity() * m_Granularity; }
+    inline size_t getUsed() const { return m_Ranges.getUsed() * m_Granularity; }
+    inline size_t getUsedEnd() const { return m_Ranges.getUsedEnd() * m_Granularity; }
+    inline size_t getGranularity() const { return m_Granularity; }
+    inline size_t getSpareStorageCount() const { return m_SpareStorages.size(); }
+
+private:
+    struct Storage
+    {
+        unsigned int rendererID;
+        size_t capacity;
+    };
+
+    /**
+     * @brief Moves the content to another storage, taken from the spares when possible.
+     *
+     * @param units The capacity of the new storage, in granularity units.
+     * @param copySize The number of bytes to copy from the current storage.
+     * @param spareCurrent True to keep the current storage as a spare, false to delete it.
+     */
+    void moveStorage(size_t units, size_t copySize, bool spareCurrent);
+
+    Storage acquireStorage(size_t capacity);
+    void releaseStorages();
+
+    inline size_t toUnits(size_t size) const { return (size + m_Granularity - 1) / m_Granularity; }
+
+private:
+    GLenum m_BindingTarget;
+    size_t m_Granularity;
+
+    unsigned int m_RendererID = 0;
+    RangeAllocator m_Ranges;
+
+    bool m_HasBindingPoint = false;
+    unsigned int m_BindingPoint = 0;
+
+    std::vector<Storage> m_SpareStorages;
+
+    bool m_GrewThisFrame = false;
+    unsigned int m_QuietFrames = 0;
+};
+
+} // namespace vrm
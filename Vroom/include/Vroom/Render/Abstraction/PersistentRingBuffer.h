@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <GL/glew.h>
+
+/**
+ * @brief Buffer for transient per frame data, persistently mapped and split in one region per frame in flight.
+ *
+ * Data is written straight into mapped memory and bound by range, so updates never go through driver copies.
+ * A fence is placed at the end of each frame; a region is only reused once the GPU is done with the frame that wrote it.
+ * If a frame needs more memory than its region, the buffer is replaced by a larger one. The previous buffer stays alive
+ * until the GPU is done with it, so allocations made earlier in the frame remain valid.
+ */
+class PersistentRingBuffer
+{
+public:
+    /**
+     * @brief Number of frames the CPU can write ahead of the GPU.
+     */
+    static constexpr unsigned int FrameCount = 3;
+
+    /**
+     * @brief A range of the ring buffer, valid for the current frame only.
+     */
+    struct Allocation
+    {
+        void* data = nullptr;
+        size_t offset = 0;
+        size_t size = 0;
+        unsigned int rendererID = 0;
+
+        inline bool isValid() const { return data != nullptr; }
+    };
+
+public:
+    /**
+     * @brief Creates the buffer. Needs an OpenGL context.
+     *
+     * @param frameCapacity The initial size of each frame region, in bytes.
+     */
+    explicit PersistentRingBuffer(size_t frameCapacity);
+    PersistentRingBuffer(const PersistentRingBuffer&) = delete;
+    PersistentRingBuffer(PersistentRingBuffer&&) = delete;
+    ~PersistentRingBuffer();
+
+    PersistentRingBuffer& operator=(const PersistentRingBuffer&) = delete;
+    PersistentRingBuffer& operator=(PersistentRingBuffer&&) = delete;
+
+    /**
+     * @brief Starts writing a new frame. Waits for the GPU if it still reads the region of this frame.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Ends the current frame, placing a fence after every command reading its data.
+     */
+    void endFrame();
+
+    /**
+     * @brief Allocates memory in the region of the current frame.
+     *
+     * @param size The size of the allocation, in bytes.
+     * @param alignment The alignment of the allocation offset. Must be a power of two.
+     * @return Allocation The allocation.
+     */
+    Allocation allocate(size_t size, size_t alignment = GetBindAlignment());
+
+    /**
+     * @brief Allocates memory in the region of the current frame and copies data into it.
+     *
+     * @param data The data to copy.
+     * @param size The size of the data, in bytes.
+     * @param alignment The alignment of the allocation offset. Must be a power of two.
+     * @return Allocation The allocation.
+     */
+    Allocation push(const void* data, size_t size, size_t alignment = GetBindAlignment());
+
+    /**
+     * @brief Binds an allocation to an indexed binding point.
+     *
+     * @param target GL_SHADER_STORAGE_BUFFER or GL_UNIFORM_BUFFER.
+     * @param bindingPoint The binding point.
+     * @param allocation The allocation. Its offset must be aligned on GetBindAlignment().
+     */
+    static void BindRange(GLenum target, unsigned int bindingPoint, const Allocation& allocation);
+
+    /**
+     * @brief Gets the alignment satisfying both uniform and shader storage buffer range bindings.
+     *
+     * @return size_t The alignment, in bytes.
+     */
+    static size_t GetBindAlignment();
+
+    inline unsigned int getRendererID() const { return m_RendererID; }
+    inline size_t getFrameCapacity() const { return m_FrameCapacity; }
+    inline size_t getFrameUsed() const { return m_FrameOffset; }
+
+    /**
+     * @brief Gets the number of frames for which beginFrame had to wait for the GPU.
+     *
+     * @return size_t The number of stalls since creation.
+     */
+    inline size_t getStallCount() const { return m_StallCount; }
+
+private:
+    void createStorage(size_t frameCapacity);
+    void retireStorage();
+    void releaseRetiredStorages();
+
+    static bool WaitFence(GLsync fence, bool wait);
+
+private:
+    struct RetiredStorage
+    {
+        unsigned int rendererID;
+        GLsync fence;
+    };
+
+    unsigned int m_RendererID = 0;
+    std::byte* m_MappedData = nullptr;
+    size_t m_FrameCapacity = 0;
+
+    unsigned int m_FrameIndex = 0;
+    size_t m_FrameOffset = 0;
+    std::array<GLsync, FrameCount> m_Fences = {};
+
+    // Replaced buffers, deleted once their fence is signaled. Retired during the current frame when the fence is null.
+    std::vector<RetiredStorage> m_RetiredStorages;
+
+    size_t m_StallCount = 0;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+namespace vrm
+{
+
+/**
+ * @brief Edits GLSL sources before they are compiled.
+ */
+class ShaderSource
+{
+public:
+    ShaderSource() = delete;
+
+    /**
+     * @brief Adds a preprocessor definition to a shader source, right after its version directive.
+     * 
+     * @param source The shader source.
+     * @param define The name of the definition, optionally followed by its value.
+     * @return std::string The shader source with the definition.
+     */
+    static std::string AddDefine(const std::string& source, const std::string& define);
+};
+
+} // namespace vrm
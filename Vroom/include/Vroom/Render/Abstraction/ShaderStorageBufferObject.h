@@ -37,6 +37,8 @@ public:
 
     bool hasBindingPoint() const { return m_HasBindingPoint; }
 
+    unsigned int getRendererID() const { return m_RendererID; }
+
 private:
     constexpr static GLenum AccessTypeToGL(AccessType accessType);
 
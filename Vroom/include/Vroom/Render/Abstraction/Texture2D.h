@@ -6,7 +6,9 @@ public:
     enum class Format
     {
         RGB,
-        RGBA
+        RGBA,
+        // 32 bit float depth, for depth attachments sampled by shaders
+        Depth
     };
 
 public:
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <GL/glew.h>
+
+class UniformBufferObject
+{
+public:
+    UniformBufferObject();
+    UniformBufferObject(const UniformBufferObject&) = delete;
+    UniformBufferObject(UniformBufferObject&&);
+    ~UniformBufferObject();
+
+    UniformBufferObject& operator=(const UniformBufferObject&) = delete;
+    UniformBufferObject& operator=(UniformBufferObject&&);
+
+    void bind() const;
+    void unbind() const;
+
+    void setData(const void* data, int size);
+    void setSubData(const void* data, int size, int offset);
+
+    /**
+     * @brief Binds the whole buffer to a uniform block binding point.
+     * 
+     * @param bindingPoint The binding point.
+     */
+    void setBindingPoint(unsigned int bindingPoint);
+
+    /**
+     * @brief Binds a range of the buffer to a uniform block binding point.
+     * 
+     * @param bindingPoint The binding point.
+     * @param offset The offset of the range. Must be a multiple of GetOffsetAlignment().
+     * @param size The size of the range.
+     */
+    void setBindingPointRange(unsigned int bindingPoint, int offset, int size);
+
+    unsigned int getBindingPoint() const;
+
+    bool hasBindingPoint() const { return m_HasBindingPoint; }
+
+    inline int getSize() const { return m_Size; }
+
+    /**
+     * @brief Gets the alignment required by the driver for ranges bound with setBindingPointRange.
+     * 
+     * @return int The offset alignment, in bytes.
+     */
+    static int GetOffsetAlignment();
+
+private:
+    unsigned int m_RendererID;
+    int m_Size = 0;
+    bool m_HasBindingPoint = false;
+    unsigned int m_BindingPoint;
+};
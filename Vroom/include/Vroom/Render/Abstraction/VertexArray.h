@@ -40,6 +40,12 @@ public:
 	 */
 	void unbind() const;
 
+	/**
+	 * @brief Gets OpenGL ID from this vertex array.
+	 * @return OpenGL ID.
+	 */
+	inline unsigned int getRendererID() const { return m_RendererID; }
+
 private:
 	unsigned int m_RendererID;
 };
\ No newline at end of file
@@ -19,6 +19,9 @@ struct VertexBufferElement
 		case GL_FLOAT:			return 4;
 		case GL_UNSIGNED_INT:	return 4;
 		case GL_UNSIGNED_BYTE:	return 1;
+		case GL_UNSIGNED_SHORT:	return 2;
+		case GL_SHORT:			return 2;
+		case GL_HALF_FLOAT:		return 2;
 		}
 
 		VRM_ASSERT(false);
@@ -78,6 +81,36 @@ public:
 		m_Stride += VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE) * count;
 	}
 
+	/**
+	 * @brief Registers an unsigned short element to the layout, normalized to [0, 1] when read by the shader.
+	 * @param count Number of unsigned shorts of the element.
+	 */
+	void pushUShortNormalized(unsigned int count)
+	{
+		m_Elements.push_back({ GL_UNSIGNED_SHORT, count, GL_TRUE });
+		m_Stride += VertexBufferElement::GetSizeOfType(GL_UNSIGNED_SHORT) * count;
+	}
+
+	/**
+	 * @brief Registers a short element to the layout, normalized to [-1, 1] when read by the shader.
+	 * @param count Number of shorts of the element.
+	 */
+	void pushShortNormalized(unsigned int count)
+	{
+		m_Elements.push_back({ GL_SHORT, count, GL_TRUE });
+		m_Stride += VertexBufferElement::GetSizeOfType(GL_SHORT) * count;
+	}
+
+	/**
+	 * @brief Registers a half float element to the layout.
+	 * @param count Number of half floats of the element.
+	 */
+	void pushHalfFloat(unsigned int count)
+	{
+		m_Elements.push_back({ GL_HALF_FLOAT, count, GL_FALSE });
+		m_Stride += VertexBufferElement::GetSizeOfType(GL_HALF_FLOAT) * count;
+	}
+
 	/**
 	 * @brief Gets the ordered list of elements of this layout.
 	 * @return The list of elements.
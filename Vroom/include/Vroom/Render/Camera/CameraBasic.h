@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include "Vroom/Render/Culling/Frustum.h"
+
 namespace vrm
 {
 
@@ -26,6 +28,13 @@ public:
     const glm::mat4& getProjection() const;
     const glm::mat4& getViewProjection() const;
 
+    /**
+     * @brief Gets the world space frustum of the camera, extracted from its view projection matrix.
+     * 
+     * @return Frustum The frustum, with normalized planes pointing inwards.
+     */
+    Frustum getFrustum() const;
+
     glm::vec3 getForwardVector() const;
     glm::vec3 getUpVector() const;
     glm::vec3 getRightVector() const;
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief How the number of depth slices of the cluster grid is chosen. Slices are always exponentially spaced between
+ * the near and far planes.
+ */
+enum class DepthSlicing
+{
+    // The number of slices of the settings
+    Fixed = 0,
+    // As many slices as needed for clusters to be about as deep as they are wide
+    MatchTiles
+};
+
+/**
+ * @brief Sizes the cluster grid from the viewport instead of a fixed number of clusters, so that the screen area of a
+ * cluster stays the same from one resolution to another.
+ */
+struct ClusterGridSettings
+{
+    /**
+     * @brief Most clusters of a grid. Depth slices are removed past it.
+     */
+    static constexpr unsigned int MaxClusterCount = 1u << 16;
+
+    /**
+     * @brief Most depth slices of a grid.
+     */
+    static constexpr unsigned int MaxDepthSlices = 64;
+
+    // Width and height of a tile, in pixels
+    unsigned int tileSize = 128;
+    DepthSlicing depthSlicing = DepthSlicing::Fixed;
+    // Used with DepthSlicing::Fixed
+    unsigned int depthSlices = 24;
+
+    /**
+     * @brief Gets the cluster grid for a viewport. The tile count is rounded up, and the viewport split evenly
+     * between the tiles, so every tile may be slightly smaller than the tile size.
+     *
+     * @param viewportSize The viewport size, in pixels. An empty viewport gets a single tile.
+     * @param projection The perspective projection of the camera.
+     * @param near The near plane distance.
+     * @param far The far plane distance.
+     * @return glm::uvec3 The number of clusters along each axis.
+     */
+    glm::uvec3 getClusterCount(const glm::uvec2& viewportSize, const glm::mat4& projection, float near, float far) const;
+
+    bool operator==(const ClusterGridSettings&) const = default;
+};
+
+} // namespace vrm
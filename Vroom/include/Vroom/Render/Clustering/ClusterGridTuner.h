@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+
+#include "Vroom/Render/Clustering/ClusterGrid.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Picks the cluster grid settings giving the lowest GPU time for the current scene, by rendering a few frames
+ * with each candidate. Does not measure anything itself: the renderer feeds it the GPU time of every frame.
+ *
+ * The first frames of a candidate are not measured. They let the GPU timings of the previous grid come back, and the
+ * light index list grow for the new one.
+ */
+class ClusterGridTuner
+{
+public:
+    /**
+     * @brief Measured cost of a candidate: the average GPU time of its measured frames.
+     */
+    struct Result
+    {
+        ClusterGridSettings settings;
+        float milliseconds;
+    };
+
+    static constexpr unsigned int DefaultSettleFrames = 8;
+    static constexpr unsigned int DefaultMeasureFrames = 16;
+
+public:
+    ClusterGridTuner() = default;
+    ClusterGridTuner(const ClusterGridTuner&) = default;
+    ClusterGridTuner(ClusterGridTuner&&) = default;
+    ~ClusterGridTuner() = default;
+
+    ClusterGridTuner& operator=(const ClusterGridTuner&) = default;
+    ClusterGridTuner& operator=(ClusterGridTuner&&) = default;
+
+    /**
+     * @brief Gets tile sizes from 64 to 256 pixels, with 16, 24 or 32 depth slices.
+     */
+    static std::vector<ClusterGridSettings> GetDefaultCandidates();
+
+    /**
+     * @brief Starts measuring candidates, from the first one. Results of a previous run are dropped.
+     *
+     * @param candidates The settings to measure. Must not be empty.
+     * @param settleFrames Frames rendered with a candidate before it is measured.
+     * @param measureFrames Frames measured for each candidate.
+     */
+    void start(std::vector<ClusterGridSettings> candidates, unsigned int settleFrames = DefaultSettleFrames,
+        unsigned int measureFrames = DefaultMeasureFrames);
+
+    /**
+     * @brief Stops measuring. The best settings are the best candidate measured so far, if any.
+     */
+    void stop();
+
+    inline bool isRunning() const { return m_Running; }
+
+    /**
+     * @brief Gets the settings the current frame has to be rendered with.
+     */
+    inline const ClusterGridSettings& getCurrentSettings() const { return m_Candidates[m_CandidateIndex]; }
+
+    /**
+     * @brief Records the GPU time of a frame rendered with the current settings, and moves to the next candidate once
+     * it is measured. Does nothing when not running.
+     *
+     * @param milliseconds The GPU time of the frame.
+     */
+    void pushFrame(float milliseconds);
+
+    /**
+     * @brief Gets the measured candidates, in measure order.
+     */
+    inline const std::vector<Result>& getResults() const { return m_Results; }
+
+    /**
+     * @brief Gets the settings of the cheapest measured candidate. Ties go to the first one.
+     * @return False if no candidate was measured.
+     */
+    bool getBestSettings(ClusterGridSettings& settings) const;
+
+private:
+    std::vector<ClusterGridSettings> m_Candidates;
+    std::vector<Result> m_Results;
+    size_t m_CandidateIndex = 0;
+    unsigned int m_SettleFrames = DefaultSettleFrames;
+    unsigned int m_MeasureFrames = DefaultMeasureFrames;
+    unsigned int m_Frame = 0;
+    double m_MeasuredMilliseconds = 0.0;
+    bool m_Running = false;
+};
+
+} // namespace vrm
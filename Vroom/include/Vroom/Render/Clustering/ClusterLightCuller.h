@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Vroom/Render/RawShaderData/SSBOCluster.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Assigns point and spot lights to clusters on the CPU, with the same results as the light culling compute shader.
+ * Does not need an OpenGL context.
+ *
+ * Lights are transformed to view space once, and stored as structure of arrays, so that each cluster tests 8 (AVX) or
+ * 4 (SSE) lights at once. Remaining lights, or every light when neither is available, are tested with scalar code.
+ * Clusters are split in contiguous ranges across worker threads, and each range writes its own light indices, which
+ * are then concatenated in cluster order. Worker threads are started by the first cull and wait for the next ones.
+ *
+ * Spot lights are few and tested with scalar code only: their range sphere against the AABB of the cluster, then their
+ * cone against the bounding sphere of the AABB. They are listed after the point lights, with SpotLightBit set on their
+ * index in the spot light block.
+ *
+ * A cluster touched by more lights than its limit keeps the most important ones: the brightest at its center, as the
+ * shading models attenuate them. Ties go to the lowest light index, as in the compute shaders.
+ */
+class ClusterLightCuller
+{
+public:
+    /**
+     * @brief Set on the light indices of spot lights, in the light index lists of the clusters.
+     */
+    static constexpr unsigned int SpotLightBit = 0x80000000u;
+
+public:
+    /**
+     * @brief Constructs a culler with one worker per hardware thread.
+     */
+    ClusterLightCuller();
+    ClusterLightCuller(const ClusterLightCuller&) = delete;
+    ClusterLightCuller(ClusterLightCuller&&);
+    ~ClusterLightCuller();
+
+    ClusterLightCuller& operator=(const ClusterLightCuller&) = delete;
+    ClusterLightCuller& operator=(ClusterLightCuller&&);
+
+    /**
+     * @brief Sets the number of threads culling lights, the calling thread included. Changing it restarts the worker
+     * threads at the next cull.
+     * @param workerCount The number of threads. 0 is treated as 1.
+     */
+    void setWorkerCount(unsigned int workerCount);
+
+    inline unsigned int getWorkerCount() const { return m_WorkerCount; }
+
+    /**
+     * @brief Sets the maximum number of lights kept in a cluster. Unlimited by default.
+     * @param clusterLightLimit The limit. 0 is treated as 1.
+     */
+    void setClusterLightLimit(unsigned int clusterLightLimit);
+
+    inline unsigned int getClusterLightLimit() const { return m_ClusterLightLimit; }
+
+    /**
+     * @brief Builds the view space AABBs of the cluster grid, as ClusterGridCompute.glsl does.
+     * Depth slices are exponential between the near and far planes.
+     *
+     * @param clusterCount The number of clusters along each axis.
+     * @param projection The camera projection.
+     * @param near The camera near plane distance.
+     * @param far The camera far plane distance.
+     */
+    void buildClusters(const glm::uvec3& clusterCount, const glm::mat4& projection, float near, float far);
+
+    /**
+     * @brief Assigns lights to every cluster. Lights of null radius, which light nothing, are skipped.
+     *
+     * @param view The camera view matrix.
+     * @param lightBlock The light block: light count followed by the point lights, as built by LightRegistry.
+     * @param spotLightBlock The spot light block, as built by LightRegistry. Empty for no spot lights.
+     */
+    void cull(const glm::mat4& view, const std::vector<std::byte>& lightBlock, const std::vector<std::byte>& spotLightBlock = {});
+
+    /**
+     * @brief Flags the clusters touched by a view space sphere, with the test of cull.
+     *
+     * @param center_VS The sphere center, in view space.
+     * @param radius The sphere radius.
+     * @param clusterFlags One flag per cluster, set to 1 for the touched clusters. Others are left as they are.
+     */
+    void markClusters(const glm::vec3& center_VS, float radius, std::vector<uint8_t>& clusterFlags) const;
+
+    inline const glm::uvec3& getClusterCount() const { return m_ClusterCount; }
+
+    /**
+     * @brief Gets the clusters, in the layout of the cluster block. Light ranges are set by the last cull.
+     */
+    inline const std::vector<SSBOCluster>& getClusters() const { return m_Clusters; }
+
+    /**
+     * @brief Gets the light indices of every cluster, in cluster order. Each cluster points to its range, whose order is
+     * unspecified once the cluster light limit is reached.
+     */
+    inline const std::vector<unsigned int>& getLightIndices() const { return m_LightIndices; }
+
+    /**
+     * @brief Gets the largest number of lights touching a cluster during the last cull, before the cluster light limit.
+     */
+    inline unsigned int getMaxLightsPerCluster() const { return m_MaxLightsPerCluster; }
+
+private:
+    class WorkerPool;
+
+    void cullClusters(size_t begin, size_t end, std::vector<unsigned int>& lightIndices, unsigned int& maxLightsPerCluster);
+    void keepMostImportantLights(const SSBOCluster& cluster, std::vector<unsigned int>& lightIndices, size_t clusterOffset) const;
+
+private:
+    unsigned int m_WorkerCount = 1;
+    // Threads besides the calling one, started by the first cull
+    std::unique_ptr<WorkerPool> m_WorkerPool;
+    unsigned int m_ClusterLightLimit = UINT32_MAX;
+
+    glm::uvec3 m_ClusterCount = glm::uvec3(0);
+    float m_Near = 0.f, m_Far = 0.f;
+    std::vector<SSBOCluster> m_Clusters;
+
+    // View space lights of non null radius, structure of arrays, with their index in the light block.
+    // Power is the intensity times the largest color channel.
+    std::vector<float> m_LightX, m_LightY, m_LightZ, m_LightRadius, m_LightPower;
+    std::vector<unsigned int> m_LightBlockIndices;
+    // Spot lights come after the point lights, with their view space direction and cone angle
+    size_t m_PointLightCount = 0;
+    std::vector<glm::vec3> m_SpotDirections;
+    std::vector<float> m_SpotCosAngles, m_SpotSinAngles;
+
+    // Light indices written by each worker, concatenated in m_LightIndices
+    std::vector<std::vector<unsigned int>> m_WorkerLightIndices;
+    std::vector<unsigned int> m_WorkerMaxLightsPerCluster;
+    std::vector<unsigned int> m_LightIndices;
+    unsigned int m_MaxLightsPerCluster = 0;
+};
+
+} // namespace vrm
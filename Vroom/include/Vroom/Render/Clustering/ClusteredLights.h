@@ -8,15 +8,24 @@
  * 
  */
 
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <vector>
 #include <string>
 
+#include <GL/glew.h>
+
 #include "Vroom/Asset/AssetInstance/ComputeShaderInstance.h"
 
 #include "Vroom/Render/Clustering/Cluster.h"
+#include "Vroom/Render/Clustering/ClusterLightCuller.h"
+#include "Vroom/Render/Clustering/LightRegistry.h"
 #include "Vroom/Render/RawShaderData/SSBOClusterInfo.h"
 
+#include "Vroom/Render/Abstraction/ComputeShader.h"
 #include "Vroom/Render/Abstraction/DynamicSSBO.h"
+#include "Vroom/Render/Abstraction/Texture2D.h"
 #include "Vroom/Render/Camera/CameraBasic.h"
 
 
@@ -26,29 +35,314 @@ namespace vrm
 class ClusteredLights
 {
 public:
+    /**
+     * @brief How lights are assigned to clusters.
+     */
+    enum class CullingMode
+    {
+        // Each cluster tests every light. Cost grows with clusters times lights.
+        PerCluster,
+        // Each light visits the clusters its bounding sphere projects to. Cost grows with the clusters lights cover.
+        PerLight,
+        // Each cluster tests every light on the CPU, with SIMD across worker threads. The clusters are then uploaded.
+        // For drivers with slow compute. Active clusters are ignored.
+        CPU
+    };
+
+    /**
+     * @brief Shader testing lights against clusters in PerCluster mode.
+     */
+    enum class CullingKernel
+    {
+        // Each invocation reads every light from the light block, and transforms it to view space
+        Global,
+        // The work group loads batches of lights to shared memory, transformed to view space once per batch
+        SharedMemory
+    };
+
+    /**
+     * @brief Local size of the shaders dispatched over clusters, unless the device does not support it.
+     */
+    static constexpr unsigned int DefaultCullingLocalSize = 128;
+
+    /**
+     * @brief Lights kept in a cluster by default, which bounds the lights a fragment shades.
+     */
+    static constexpr unsigned int DefaultClusterLightLimit = 128;
+
+public:
+    /**
+     * @brief Loads the shaders. If the device has enough shared memory for the shared memory kernel, both kernels are
+     * timed on the first cullings of every cluster in PerCluster mode, and the faster one is kept.
+     */
     ClusteredLights();
-    ClusteredLights(const ClusteredLights&) = default;
-    ClusteredLights(ClusteredLights&&) = default;
-    ~ClusteredLights() = default;
+    ClusteredLights(const ClusteredLights&) = delete;
+    ClusteredLights(ClusteredLights&&) = delete;
+    ~ClusteredLights();
+
+    ClusteredLights& operator=(const ClusteredLights&) = delete;
+    ClusteredLights& operator=(ClusteredLights&&) = delete;
+
+    /**
+     * @brief Sets the binding points of the cluster grid, and of the global light index list the clusters point into.
+     */
+    void setBindingPoints(int clusterInfoBindingPoint, int lightIndexBindingPoint);
+
+    /**
+     * @brief Sets how lights are assigned to clusters. PerCluster by default.
+     */
+    void setCullingMode(CullingMode mode);
+
+    inline CullingMode getCullingMode() const { return m_CullingMode; }
+
+    /**
+     * @brief Sets the light culling kernel, recompiling the shaders dispatched over clusters with a local size. Ends the
+     * selection of the kernel, if it is still running.
+     * @param kernel The culling kernel.
+     * @param localSize The number of clusters of a work group. Also the batch size of the shared memory kernel.
+     */
+    void setCullingKernel(CullingKernel kernel, unsigned int localSize = DefaultCullingLocalSize);
 
-    ClusteredLights& operator=(const ClusteredLights&) = default;
-    ClusteredLights& operator=(ClusteredLights&&) = default;
+    inline CullingKernel getCullingKernel() const { return m_CullingKernel; }
+    inline unsigned int getCullingLocalSize() const { return m_CullingLocalSize; }
 
-    void setBindingPoint(int clusterInfoBindingPoint);
+    /**
+     * @brief Whether both culling kernels are still being timed. The culling kernel may change until then.
+     */
+    inline bool isSelectingCullingKernel() const { return m_SelectingKernel; }
+
+    /**
+     * @brief Sets the maximum number of lights kept in a cluster. A cluster touched by more lights keeps the most
+     * important ones: the brightest at its center, as the shading models attenuate them.
+     * @param clusterLightLimit The limit. 0 is treated as 1.
+     */
+    void setClusterLightLimit(unsigned int clusterLightLimit);
+
+    inline unsigned int getClusterLightLimit() const { return m_ClusterLightLimit; }
 
     void setupClusters(const glm::uvec3& clusterCount, const CameraBasic& camera);
 
-    void processLights(const CameraBasic& camera);
+    /**
+     * @brief Gets the number of clusters along each axis, set by the last setupClusters call.
+     */
+    inline const glm::uvec3& getClusterCount() const { return m_ClusterCount; }
+
+    /**
+     * @brief Flags the clusters holding at least one depth sample, and compacts them into the active cluster list.
+     * The next processLights call only culls lights against these clusters, with an indirect dispatch. The other
+     * clusters are left without lights.
+     *
+     * @param depthTexture The depth of the scene from the camera, at viewport size.
+     * @param camera The camera the clusters were set up with.
+     */
+    void findActiveClusters(const Texture2D& depthTexture, const CameraBasic& camera);
+
+    /**
+     * @brief Whether the next processLights call assigns lights to every cluster, instead of reusing the assignment of
+     * the previous calls: when the view, the culling mode or more than MaxPartialUpdateLights lights changed, or when
+     * the last assignment only covered active clusters.
+     *
+     * @param camera The camera the clusters were set up with.
+     * @param lightRegistry The registry whose light block is bound for this frame.
+     */
+    bool needsFullCulling(const CameraBasic& camera, const LightRegistry& lightRegistry) const;
+
+    /**
+     * @brief Whether findActiveClusters is worth calling before the next processLights call: when it culls every
+     * cluster, unless nothing changed since an assignment of active clusters only. Every cluster is culled then, so that
+     * the next frames can reuse the assignment.
+     */
+    bool needsActiveClusters(const CameraBasic& camera, const LightRegistry& lightRegistry) const;
+
+    /**
+     * @brief Assigns lights to clusters: every cluster, or the active ones if findActiveClusters was called since the
+     * last call. Also counts the lights per cluster on the GPU, and reports the counts of the latest dispatch the GPU
+     * is done with to FrameStats.
+     *
+     * Each cluster reserves a range of a global light index list. The list is sized from the light count, and grown
+     * from the statistics when clusters need more: lights that do not fit are dropped until then.
+     *
+     * When needsFullCulling is false, the previous assignment is kept. Only the clusters touched by the old or new
+     * bounding sphere of a changed light are culled again, and append their new ranges to the light index list. Every
+     * cluster is culled instead when these ranges may not fit in the list.
+     *
+     * In CPU mode, lights are culled from the light block of the registry and the result is uploaded. Statistics are
+     * reported right away.
+     *
+     * @param camera The camera the clusters were set up with.
+     * @param lightRegistry The registry whose light block is bound for this frame.
+     */
+    void processLights(const CameraBasic& camera, const LightRegistry& lightRegistry);
+
+    /**
+     * @brief Forgets the light assignment, so that the next processLights call culls every cluster.
+     */
+    void invalidateLightAssignment();
+
+    inline unsigned int getLightIndexCapacity() const { return m_LightIndexCapacity; }
+
+    /**
+     * @brief Gets the cluster block: grid size followed by the clusters and their light ranges.
+     */
+    inline const DynamicSSBO& getClusterInfoSSBO() const { return m_SSBOClusterInfoSSBO; }
+
+    /**
+     * @brief Gets the light index block: light index count followed by the light indices of every cluster.
+     */
+    inline const DynamicSSBO& getLightIndexSSBO() const { return m_LightIndexSSBO; }
+
+    /**
+     * @brief Gets the active cluster block: culling work group counts and active cluster count, followed by the clusters
+     * listed by the last findActiveClusters call, or by the last partial update.
+     */
+    inline const DynamicSSBO& getActiveClusterSSBO() const { return m_ActiveClusterSSBO; }
+
+    /**
+     * @brief Number of light culling dispatches whose statistics can be in flight. More readbacks are added when the GPU
+     * is further behind.
+     */
+    static constexpr unsigned int StatisticsLatency = 3;
+
+    /**
+     * @brief Most lights changing in a frame for which only the clusters they touch are culled again.
+     */
+    static constexpr size_t MaxPartialUpdateLights = 64;
+
+    /**
+     * @brief Cullings of every cluster timed for each kernel during its selection. The first one of each kernel is not
+     * counted, as it may include the first use of the shaders.
+     */
+    static constexpr unsigned int KernelSelectionSamples = 4;
+
+private:
+    struct StatisticsReadback
+    {
+        GLuint rendererID = 0;
+        GLsync fence = nullptr;
+        unsigned int clusterCount = 0;
+        bool activeClustersOnly = false;
+        // Only the light index count is meaningful for partial updates
+        bool partialUpdate = false;
+    };
+
+    struct KernelTiming
+    {
+        GLuint query = 0;
+        CullingKernel kernel = CullingKernel::Global;
+    };
+
+    struct LightStatistics
+    {
+        double averageLightsPerCluster = 0.0;
+        double maxLightsPerCluster = 0.0;
+        double culledClusters = 0.0;
+    };
+
+    /**
+     * @brief Dispatches a compute shader with one invocation per cluster, or per listed cluster with an indirect dispatch.
+     * @param listedClustersOnly Whether the clusters are the ones listed in the active cluster block.
+     */
+    void dispatchOverClusters(const ComputeShader& computeShader, bool listedClustersOnly) const;
+
+    void processLightsCPU(const CameraBasic& camera, const std::vector<std::byte>& lightBlock, const std::vector<std::byte>& spotLightBlock);
+
+    /**
+     * @brief Recompiles the shaders dispatched over clusters, for a culling kernel and a local size.
+     */
+    void loadCullingKernel(CullingKernel kernel, unsigned int localSize);
+
+    /**
+     * @brief Reads the timings of the culling kernels the GPU is done with, without waiting. Moves to the other kernel
+     * once the current one is timed, and keeps the faster one once both are.
+     */
+    void readKernelTimings();
+
+    /**
+     * @brief Culls the clusters touched by the changed lights again, listed in the active cluster block.
+     * @return Whether the clusters were culled. They are not when their new ranges may not fit in the light index list,
+     * every cluster must be culled again then.
+     */
+    bool updateChangedClusters(const CameraBasic& camera, const LightRegistry& lightRegistry);
+
+    /**
+     * @brief Clears and binds the statistics buffer of the next readback.
+     */
+    StatisticsReadback& beginStatistics();
+
+    /**
+     * @brief Copies the counts the statistics need, and fences the readback.
+     */
+    void endStatistics(StatisticsReadback& readback, bool activeClustersOnly, bool partialUpdate);
+
+    /**
+     * @brief Reads every readback the GPU is done with, oldest first, without waiting. Readbacks it is still behind on
+     * are kept for the next frames.
+     */
+    void readStatistics();
+
+    /**
+     * @brief Reads a readback if its fence is signaled, and grows the light index list if it overflowed.
+     * @return Whether the fence was signaled. The readback is left pending otherwise.
+     */
+    bool readStatistics(StatisticsReadback& readback);
+
+    void reportStatistics() const;
+    void reserveLightIndices(unsigned int capacity);
 
 private:
     SSBOClusterInfo m_SSBOClusterInfoData;
     DynamicSSBO m_SSBOClusterInfoSSBO;
+    // Light index count, followed by the light indices of every cluster
+    DynamicSSBO m_LightIndexSSBO;
+    unsigned int m_LightIndexCapacity = 0;
+    // Light index count of the last full culling read back, and the most light indices appended by partial updates since
+    // the last full culling
+    std::optional<unsigned int> m_FullCullingLightIndexCount;
+    unsigned int m_AppendedLightIndexBound = 0;
 
-    glm::uvec3 m_ClusterCount;
-    unsigned int m_TotalClusters;
+    // Light culling dispatch arguments and active cluster count, followed by the active clusters
+    DynamicSSBO m_ActiveClusterSSBO;
+    // One flag per cluster, set by the mark shader and cleared by the compaction shader
+    DynamicSSBO m_ClusterFlagSSBO;
+    bool m_ActiveClustersFound = false;
+    // Lights of each cluster, counted by the first light binning dispatch and given back by the second one
+    DynamicSSBO m_ClusterLightCounterSSBO;
+    CullingMode m_CullingMode = CullingMode::PerCluster;
+    unsigned int m_ClusterLightLimit = DefaultClusterLightLimit;
+    // Clusters built along with the GPU ones, used in CPU mode and to find the clusters touched by changed lights
+    ClusterLightCuller m_CPUCuller;
+
+    // Assignment of every cluster, kept while the view and the lights do not change
+    bool m_LightAssignmentValid = false;
+    bool m_AssignmentCoversAllClusters = false;
+    glm::mat4 m_AssignedView = glm::mat4(1.f);
+    CullingMode m_AssignedCullingMode = CullingMode::PerCluster;
+    std::vector<uint8_t> m_ChangedClusterFlags;
+    // Header of the active cluster block, followed by the clusters touched by changed lights
+    std::vector<GLuint> m_ChangedClusters;
+    // Statistics of the current assignment, reported every frame
+    LightStatistics m_LightStatistics;
+
+    glm::uvec3 m_ClusterCount = glm::uvec3(0);
+    unsigned int m_TotalClusters = 0;
     glm::mat4 m_Projection;
 
-    ComputeShaderInstance m_ClustersBuilder, m_LightsCuller;
+    ComputeShaderInstance m_ClustersBuilder, m_LightsBinner, m_ActiveClusterMarker;
+
+    // Compiled with the culling local size
+    ComputeShader m_LightsCuller, m_LightOffsetsReserver, m_LightsTrimmer, m_ActiveClusterCompactor;
+    CullingKernel m_CullingKernel = CullingKernel::Global;
+    unsigned int m_CullingLocalSize = DefaultCullingLocalSize;
+
+    // Selection of the culling kernel: time elapsed queries in flight, then the timings read back for each kernel
+    bool m_SelectingKernel = false;
+    std::vector<KernelTiming> m_KernelTimings;
+    std::array<double, 2> m_KernelMilliseconds = {};
+    std::array<unsigned int, 2> m_KernelSampleCounts = {};
+
+    // Ring of readbacks, the next one to write first
+    std::vector<StatisticsReadback> m_StatisticsReadbacks;
+    unsigned int m_StatisticsIndex = 0;
 };
 
 } // namespace vrm
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "Vroom/Scene/Components/PointLightComponent.h"
+#include "Vroom/Scene/Components/SpotLightComponent.h"
+#include "Vroom/Scene/Components/DirectionalLightComponent.h"
+
+namespace vrm
+{
+
+class CameraBasic;
+class LightRegistry;
+
+/**
+ * @brief Selects the point lights worth sending to the GPU, before the light block is built. Does not need an OpenGL context.
+ *
+ * Lights whose bounding sphere is outside the camera frustum are dropped. The others are scored by the part of the
+ * screen their sphere covers times their intensity, and only the best scored ones are kept when there are more than
+ * the budget. The radius of a light is cut where its attenuated intensity falls below the intensity cutoff, so that
+ * bright lights are not bounded by an arbitrary radius only.
+ *
+ * Spot lights get the same radius cut and frustum culling, but are always kept: they are expected to be few, and do
+ * not count against the budget. Directional lights light everything and are always kept.
+ */
+class LightBudget
+{
+public:
+    /**
+     * @brief Budget keeping every visible light.
+     */
+    static constexpr unsigned int Unlimited = UINT32_MAX;
+
+    /**
+     * @brief Below one step of an 8 bit color channel.
+     */
+    static constexpr float DefaultIntensityCutoff = 1.f / 256.f;
+
+public:
+    LightBudget() = default;
+    LightBudget(const LightBudget&) = default;
+    LightBudget(LightBudget&&) = default;
+    ~LightBudget() = default;
+
+    LightBudget& operator=(const LightBudget&) = default;
+    LightBudget& operator=(LightBudget&&) = default;
+
+    /**
+     * @brief Sets the maximum number of lights kept per frame. Unlimited by default.
+     */
+    inline void setMaxLights(unsigned int maxLights) { m_MaxLights = maxLights; }
+
+    inline unsigned int getMaxLights() const { return m_MaxLights; }
+
+    /**
+     * @brief Sets the intensity under which a light is considered to light nothing.
+     * @param intensityCutoff The cutoff. 0 or less keeps the radius of the components.
+     */
+    inline void setIntensityCutoff(float intensityCutoff) { m_IntensityCutoff = intensityCutoff; }
+
+    inline float getIntensityCutoff() const { return m_IntensityCutoff; }
+
+    /**
+     * @brief Gets the radius of a light, at which its intensity, attenuated by the squared distance as the shading
+     * models do, falls to the cutoff. The radius of the component is an upper bound.
+     *
+     * @param pointLight The point light.
+     * @param intensityCutoff The cutoff. 0 or less gives the radius of the component.
+     */
+    static float GetEffectiveRadius(const PointLightComponent& pointLight, float intensityCutoff);
+
+    void beginFrame();
+
+    void submitPointLight(const PointLightComponent& pointLight, const glm::vec3& position, entt::entity entity);
+    void submitSpotLight(const SpotLightComponent& spotLight, const glm::vec3& position, const glm::vec3& direction);
+    void submitDirectionalLight(const DirectionalLightComponent& directionalLight, const glm::vec3& direction);
+
+    /**
+     * @brief Culls and scores the lights submitted during the frame, and submits the kept ones to the registry, with their
+     * effective radius, in the order they were submitted in. Visible spot lights and directional lights are submitted too.
+     *
+     * @param camera The camera the frame is rendered from.
+     * @param lightRegistry The registry, between its beginFrame and prepareFrame or endFrame calls.
+     */
+    void selectLights(const CameraBasic& camera, LightRegistry& lightRegistry);
+
+    /**
+     * @brief Gets the number of point lights submitted during the frame. Counts only point lights, as the two below.
+     */
+    inline unsigned int getSubmittedLightCount() const { return static_cast<unsigned int>(m_Lights.size()); }
+
+    /**
+     * @brief Gets the number of lights inside the frustum, during the last selectLights call.
+     */
+    inline unsigned int getVisibleLightCount() const { return m_VisibleLightCount; }
+
+    /**
+     * @brief Gets the number of lights submitted to the registry by the last selectLights call.
+     */
+    inline unsigned int getKeptLightCount() const { return m_KeptLightCount; }
+
+private:
+    struct SubmittedLight
+    {
+        PointLightComponent pointLight;
+        glm::vec3 position;
+        entt::entity entity;
+    };
+
+    struct SubmittedSpotLight
+    {
+        SpotLightComponent spotLight;
+        glm::vec3 position;
+        glm::vec3 direction;
+    };
+
+    struct SubmittedDirectionalLight
+    {
+        DirectionalLightComponent directionalLight;
+        glm::vec3 direction;
+    };
+
+private:
+    unsigned int m_MaxLights = Unlimited;
+    float m_IntensityCutoff = DefaultIntensityCutoff;
+
+    std::vector<SubmittedLight> m_Lights;
+    std::vector<SubmittedSpotLight> m_SpotLights;
+    std::vector<SubmittedDirectionalLight> m_DirectionalLights;
+    // Scores of the visible lights, with their submission index, and whether each submitted light is kept
+    std::vector<std::pair<float, unsigned int>> m_Scores;
+    std::vector<uint8_t> m_Kept;
+    unsigned int m_VisibleLightCount = 0;
+    unsigned int m_KeptLightCount = 0;
+};
+
+} // namespace vrm
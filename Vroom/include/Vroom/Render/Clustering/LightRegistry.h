@@ -1,56 +1,217 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
-#include <list>
-#include <string>
 
+#include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
 #include "Vroom/Scene/Components/PointLightComponent.h"
+#include "Vroom/Scene/Components/SpotLightComponent.h"
+#include "Vroom/Scene/Components/DirectionalLightComponent.h"
 #include "Vroom/Render/RawShaderData/SSBOPointLightData.h"
+#include "Vroom/Render/RawShaderData/SSBOSpotLightData.h"
+#include "Vroom/Render/RawShaderData/SSBODirectionalLightData.h"
 #include "Vroom/Render/Abstraction/DynamicSSBO.h"
 
 namespace vrm
 {
 
+/**
+ * @brief Keeps the point lights of the scene in a dense array, in the order of the light block, keyed by entity.
+ *
+ * Lights that are not submitted during a frame are removed by moving the last light in their slot, so the block never
+ * holds free slots. Only the slots that changed during the frame are written to the GPU, merged in a few ranges.
+ *
+ * Spot and directional lights are far fewer: their blocks are rebuilt every frame in submit order, and uploaded whole
+ * when they differ from the previous frame.
+ */
 class LightRegistry
 {
+public:
+    /**
+     * @brief A slot of the light block whose light changed since the previous frame: added, removed, moved or edited.
+     * Slots past the end of a block hold zeroed lights.
+     */
+    struct PointLightChange
+    {
+        unsigned int slot;
+        SSBOPointLightData previous;
+        SSBOPointLightData current;
+    };
+
+    /**
+     * @brief A range of the light block written during the last frame, in bytes.
+     */
+    struct DirtyRange
+    {
+        size_t offset;
+        size_t size;
+    };
+
+    /**
+     * @brief Changed slots closer than this are uploaded in the same range, unchanged slots in between included.
+     */
+    static constexpr unsigned int DirtyRangeMergeGap = 16;
+
+    /**
+     * @brief Largest outer angle of a spot light cone, a bit under 90 degrees. Wider cones are clamped to it.
+     */
+    static constexpr float MaxSpotLightAngle = 1.55f;
+
 public:
     LightRegistry() = default;
-    LightRegistry(const LightRegistry&) = default;
+    LightRegistry(const LightRegistry&) = delete;
     LightRegistry(LightRegistry&&) = default;
     ~LightRegistry() = default;
 
-    LightRegistry& operator=(const LightRegistry&) = default;
+    LightRegistry& operator=(const LightRegistry&) = delete;
     LightRegistry& operator=(LightRegistry&&) = default;
 
     void setBindingPoint(int bindingPoint);
+    void setSpotLightBindingPoint(int bindingPoint);
+    void setDirectionalLightBindingPoint(int bindingPoint);
     void reserve(int lightCount);
 
     void beginFrame();
 
-    void submitPointLight(const PointLightComponent& pointLight, const glm::vec3& position, const std::string& identifier);
+    /**
+     * @brief Submits a point light for the current frame. Submitting the same entity twice keeps the last light.
+     */
+    void submitPointLight(const PointLightComponent& pointLight, const glm::vec3& position, entt::entity entity);
+
+    /**
+     * @brief Submits a spot light for the current frame.
+     *
+     * @param direction The cone axis, in world space. Does not need to be normalized.
+     */
+    void submitSpotLight(const SpotLightComponent& spotLight, const glm::vec3& position, const glm::vec3& direction);
 
+    /**
+     * @brief Submits a directional light for the current frame.
+     *
+     * @param direction The direction the light travels in, in world space. Does not need to be normalized.
+     */
+    void submitDirectionalLight(const DirectionalLightComponent& directionalLight, const glm::vec3& direction);
+
+    /**
+     * @brief Removes the lights that were not submitted during the frame, and writes the changed slots to the light
+     * block. Rebuilds the spot and directional light blocks if they changed. Does not need an OpenGL context.
+     * Called by endFrame, use it instead of endFrame only when the block is not uploaded.
+     *
+     * @return const std::vector<std::byte>& The light block: light count followed by the point lights.
+     */
+    const std::vector<std::byte>& prepareFrame();
+
+    /**
+     * @brief Prepares the frame, then writes the dirty ranges of the light block to the light SSBO, uploads the changed
+     * spot and directional light blocks, and binds the three SSBOs. The SSBOs shrink after quiet frames once lights are
+     * removed.
+     */
     void endFrame();
 
-    const std::unordered_map<int, SSBOPointLightData>& getPointLights() const { return m_PointLights; }
+    /**
+     * @brief Gets the point lights, in slot order.
+     */
+    inline const std::vector<SSBOPointLightData>& getPointLights() const { return m_PointLights; }
+
+    /**
+     * @brief Gets the light block built by the last prepareFrame or endFrame call.
+     */
+    inline const std::vector<std::byte>& getPointLightBlock() const { return m_PointLightBlock; }
+
+    /**
+     * @brief Gets the slots whose light changed between the two last light blocks, in slot order.
+     */
+    inline const std::vector<PointLightChange>& getPointLightChanges() const { return m_PointLightChanges; }
+
+    /**
+     * @brief Gets the ranges of the light block written by the last prepareFrame call, in offset order.
+     */
+    inline const std::vector<DirtyRange>& getDirtyRanges() const { return m_DirtyRanges; }
+
+    /**
+     * @brief Gets the number of point lights in the light block.
+     */
+    inline unsigned int getPointLightSlotCount() const { return static_cast<unsigned int>(m_PointLights.size()); }
+
+    /**
+     * @brief Gets the spot lights, in submit order. Cone angles are stored as cosines.
+     */
+    inline const std::vector<SSBOSpotLightData>& getSpotLights() const { return m_SpotLights; }
+
+    /**
+     * @brief Gets the spot light block built by the last prepareFrame or endFrame call: light count followed by the
+     * spot lights.
+     */
+    inline const std::vector<std::byte>& getSpotLightBlock() const { return m_SpotLightBlock; }
+
+    /**
+     * @brief Tells whether the spot lights of the two last frames differ.
+     */
+    inline bool haveSpotLightsChanged() const { return m_SpotLightsChanged; }
+
+    inline unsigned int getSpotLightCount() const { return static_cast<unsigned int>(m_SpotLights.size()); }
+
+    /**
+     * @brief Gets the directional lights, in submit order.
+     */
+    inline const std::vector<SSBODirectionalLightData>& getDirectionalLights() const { return m_DirectionalLights; }
+
+    /**
+     * @brief Gets the directional light block built by the last prepareFrame or endFrame call: light count followed by
+     * the directional lights.
+     */
+    inline const std::vector<std::byte>& getDirectionalLightBlock() const { return m_DirectionalLightBlock; }
+
+    /**
+     * @brief Tells whether the directional lights of the two last frames differ.
+     */
+    inline bool haveDirectionalLightsChanged() const { return m_DirectionalLightsChanged; }
 
 private:
-    void updateData();
+    void writePointLight(unsigned int slot, const SSBOPointLightData& pointLight);
+    void removePointLight(unsigned int slot);
+    void finishChanges();
+    void buildBlock(unsigned int previousSlotCount);
 
 private:
-    // Point lights that are currently in the scene
-    std::unordered_map<int, SSBOPointLightData> m_PointLights;
-    // SSBO for point lights
-    DynamicSSBO m_SSBOPointLights;
-    // Identifiers point to the address of the light in the SSBO
-    std::unordered_map<std::string, int> m_PointLightAddresses;
-
-    std::unordered_map<std::string, SSBOPointLightData> m_AddedPointLights;
-    std::unordered_set<int> m_FreePointLightAdresses;
-    int m_NextPointLightAddress = sizeof(int);
+    static constexpr unsigned int NoIndex = UINT32_MAX;
+
+    // Point lights that are currently in the scene, with their entity and the last frame they were submitted in
+    std::vector<SSBOPointLightData> m_PointLights;
+    std::vector<entt::entity> m_PointLightEntities;
+    std::vector<uint32_t> m_PointLightFrames;
+    // Slot of each entity, indexed by entity index
+    std::vector<unsigned int> m_PointLightSlots;
+    uint32_t m_Frame = 0;
+    unsigned int m_SubmittedCount = 0;
+    unsigned int m_FrameStartSlotCount = 0;
+
+    // Changes recorded during the frame, and the index of the change of each slot
+    std::vector<PointLightChange> m_PointLightChanges;
+    std::vector<unsigned int> m_ChangeIndices;
+
+    // CPU copy of the light block: light count followed by the point lights. Only dirty ranges are written.
+    std::vector<std::byte> m_PointLightBlock;
+    std::vector<DirtyRange> m_DirtyRanges;
+    DynamicSSBO m_PointLightSSBO;
+    int m_BindingPoint = 0;
+
+    // Spot and directional lights of the current and previous frames, and their blocks
+    std::vector<SSBOSpotLightData> m_SpotLights;
+    std::vector<SSBOSpotLightData> m_PreviousSpotLights;
+    std::vector<std::byte> m_SpotLightBlock;
+    bool m_SpotLightsChanged = false;
+    DynamicSSBO m_SpotLightSSBO;
+    int m_SpotLightBindingPoint = 0;
+
+    std::vector<SSBODirectionalLightData> m_DirectionalLights;
+    std::vector<SSBODirectionalLightData> m_PreviousDirectionalLights;
+    std::vector<std::byte> m_DirectionalLightBlock;
+    bool m_DirectionalLightsChanged = false;
+    DynamicSSBO m_DirectionalLightSSBO;
+    int m_DirectionalLightBindingPoint = 0;
 };
 
 } // namespace vrm
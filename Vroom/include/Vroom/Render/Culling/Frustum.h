@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief View frustum, described by six planes pointing inwards.
+ * A plane is stored as (normal, distance): a point p is on the inner side when dot(normal, p) + distance >= 0.
+ *
+ */
+struct Frustum
+{
+    enum Plane
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Count
+    };
+
+    std::array<glm::vec4, Plane::Count> planes;
+
+    /**
+     * @brief Extracts the world space frustum planes from a view projection matrix (OpenGL clip space convention).
+     *
+     * @param viewProjection The view projection matrix.
+     * @return Frustum The frustum, with normalized planes.
+     */
+    static Frustum FromViewProjection(const glm::mat4& viewProjection);
+};
+
+} // namespace vrm
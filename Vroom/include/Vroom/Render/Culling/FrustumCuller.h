@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Vroom/Math/BoundingVolumes.h"
+#include "Vroom/Render/Culling/Frustum.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Tests batches of bounding volumes against a frustum.
+ * World space bounds are stored as structure of arrays, so that the test runs on 8 (AVX) or 4 (SSE) volumes at once.
+ * Remaining volumes, or every volume when neither is available, are tested with scalar code.
+ *
+ * Each volume is tested with its bounding sphere first, then with its bounding box. A volume is visible when both
+ * intersect the frustum.
+ */
+class FrustumCuller
+{
+public:
+    FrustumCuller() = default;
+    FrustumCuller(const FrustumCuller&) = default;
+    FrustumCuller(FrustumCuller&&) = default;
+    ~FrustumCuller() = default;
+
+    FrustumCuller& operator=(const FrustumCuller&) = default;
+    FrustumCuller& operator=(FrustumCuller&&) = default;
+
+    /**
+     * @brief Removes every volume. Memory is kept for next frame.
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Reserves memory for a given number of volumes.
+     *
+     * @param count The number of volumes.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Transforms local bounds to world space and adds them to the batch.
+     *
+     * @param box The local space bounding box.
+     * @param sphere The local space bounding sphere.
+     * @param model The model matrix.
+     * @return size_t The index of the volume, used to read its visibility after cull.
+     */
+    size_t push(const AABB& box, const BoundingSphere& sphere, const glm::mat4& model);
+
+    /**
+     * @brief Tests every volume against the frustum.
+     *
+     * @param frustum The frustum, with normalized planes.
+     * @return size_t The number of visible volumes.
+     */
+    size_t cull(const Frustum& frustum);
+
+    /**
+     * @brief Gets the visibility of a volume, computed by the last cull.
+     *
+     * @param index The index returned by push.
+     * @return true If the volume intersects the frustum.
+     */
+    inline bool isVisible(size_t index) const { return m_Visibility[index] != 0; }
+
+    inline size_t size() const { return m_Count; }
+
+private:
+    void cullScalar(const Frustum& frustum, size_t begin);
+
+private:
+    size_t m_Count = 0;
+
+    // World space bounds, structure of arrays
+    std::vector<float> m_SphereX, m_SphereY, m_SphereZ, m_SphereRadius;
+    std::vector<float> m_BoxCenterX, m_BoxCenterY, m_BoxCenterZ;
+    std::vector<float> m_BoxExtentX, m_BoxExtentY, m_BoxExtentZ;
+
+    std::vector<uint8_t> m_Visibility;
+};
+
+} // namespace vrm
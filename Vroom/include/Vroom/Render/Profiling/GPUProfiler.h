@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Vroom/DataStructure/RollingStatistics.h"
+
+#define VRM_GPU_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VRM_GPU_PROFILE_CONCAT(a, b) VRM_GPU_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Times the GPU commands issued until the end of the enclosing C++ scope, under a name.
+ */
+#define VRM_GPU_PROFILE_SCOPE(name) ::vrm::GPUProfileScope VRM_GPU_PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+
+namespace vrm
+{
+
+/**
+ * @brief Measures the GPU time of named scopes, with timestamp queries.
+ *
+ * Queries of a frame are read LatencyFrames frames later, once available, so reading results never stalls.
+ * Scopes can be nested. Each scope is also emitted as an OpenGL debug group, visible in external capture tools.
+ */
+class GPUProfiler
+{
+public:
+    /**
+     * @brief Number of frames of queries in flight.
+     */
+    static constexpr unsigned int LatencyFrames = 3;
+
+    /**
+     * @brief Number of frames the rolling statistics of each scope cover.
+     */
+    static constexpr size_t HistoryFrames = 120;
+
+    /**
+     * @brief Timings of a named scope, in milliseconds.
+     */
+    struct ScopeStatistics
+    {
+        std::string name;
+        unsigned int depth = 0;
+        RollingStatistics milliseconds = RollingStatistics(HistoryFrames);
+        // Number of the collected frame holding the last sample, see getCollectedFrameCount
+        size_t lastFrame = 0;
+    };
+
+public:
+    /**
+     * @brief Initializes the GPU profiler. Needs an OpenGL context.
+     */
+    static void Init();
+
+    /**
+     * @brief Shuts down the GPU profiler, releasing its queries.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief Gets the GPU profiler instance.
+     * @return The GPU profiler instance.
+     */
+    static GPUProfiler& Get();
+
+    /**
+     * @brief Checks if the GPU profiler is initialized.
+     * @return True if the GPU profiler is initialized.
+     */
+    static bool IsInitialized();
+
+    GPUProfiler(const GPUProfiler&) = delete;
+    GPUProfiler(GPUProfiler&&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+    GPUProfiler& operator=(GPUProfiler&&) = delete;
+
+    ~GPUProfiler();
+
+    /**
+     * @brief Starts a new frame. Collects the results of the frame issued LatencyFrames frames ago, if available.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Ends the current frame.
+     */
+    void endFrame();
+
+    /**
+     * @brief Starts a named scope.
+     * @param name The name of the scope. Scopes with the same name share their statistics.
+     */
+    void beginScope(std::string_view name);
+
+    /**
+     * @brief Ends the last started scope.
+     */
+    void endScope();
+
+    /**
+     * @brief Enables or disables timing. Debug groups are emitted either way. Enabled by default.
+     * @param enabled True to time scopes.
+     */
+    inline void setEnabled(bool enabled) { m_Enabled = enabled; }
+    inline bool isEnabled() const { return m_Enabled; }
+
+    /**
+     * @brief Gets the statistics of every scope, in order of first appearance.
+     * @return The scope statistics.
+     */
+    inline const std::vector<ScopeStatistics>& getScopes() const { return m_Scopes; }
+
+    /**
+     * @brief Removes the samples of every scope. Results of the frames in flight are still collected afterwards.
+     */
+    void clearStatistics();
+
+    /**
+     * @brief Gets the number of frames whose results were collected. The scopes sampled in the last collected frame are
+     * the ones whose lastFrame equals this number.
+     * @return The number of collected frames.
+     */
+    inline size_t getCollectedFrameCount() const { return m_CollectedFrameCount; }
+
+    /**
+     * @brief Gets the number of frames whose results were not available in time, and were dropped.
+     * @return The number of dropped frames.
+     */
+    inline size_t getDroppedFrameCount() const { return m_DroppedFrameCount; }
+
+private:
+    GPUProfiler() = default;
+
+    size_t getScopeIndex(std::string_view name, unsigned int depth);
+    unsigned int acquireQuery();
+    void collectFrame(unsigned int frameIndex);
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    struct ScopeRecord
+    {
+        size_t scopeIndex;
+        unsigned int beginQuery;
+        unsigned int endQuery;
+    };
+
+    struct FrameQueries
+    {
+        std::vector<unsigned int> queries;
+        size_t usedQueryCount = 0;
+        std::vector<ScopeRecord> records;
+    };
+
+    static std::unique_ptr<GPUProfiler> s_Instance;
+
+    bool m_Enabled = true;
+    bool m_InFrame = false;
+
+    std::array<FrameQueries, LatencyFrames> m_Frames;
+    unsigned int m_FrameIndex = 0;
+
+    // Indices of the records of the scopes currently open
+    std::vector<size_t> m_OpenRecords;
+
+    std::vector<ScopeStatistics> m_Scopes;
+    std::unordered_map<std::string, size_t, StringHash, std::equal_to<>> m_ScopeIndices;
+
+    size_t m_CollectedFrameCount = 0;
+    size_t m_DroppedFrameCount = 0;
+};
+
+/**
+ * @brief Times a GPU scope for its whole lifetime. Does nothing if the GPU profiler is not initialized.
+ */
+class GPUProfileScope
+{
+public:
+    explicit GPUProfileScope(std::string_view name);
+    ~GPUProfileScope();
+
+    GPUProfileScope(const GPUProfileScope&) = delete;
+    GPUProfileScope& operator=(const GPUProfileScope&) = delete;
+
+private:
+    bool m_Active;
+};
+
+} // namespace vrm
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <array>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace vrm
@@ -10,8 +10,9 @@ struct alignas(16) SSBOCluster
 {
     glm::vec4 minAABB_VS;
     glm::vec4 maxAABB_VS;
-    unsigned int indexCount;
-    std::array<unsigned int, 100> lightIndices;
+    // Range of the cluster lights in the global light index list
+    unsigned int lightOffset;
+    unsigned int lightCount;
 
     std::vector<std::pair<const void*, size_t>> getData() const
     {
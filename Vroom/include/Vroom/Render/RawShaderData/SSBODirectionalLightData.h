@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Data for a directional light to be stored in a SSBO. This is the formatted data for openGL std430 SSBO.
+ * As for point lights, vec3's are retrieved with float[3]'s in the shader.
+ * 
+ */
+struct SSBODirectionalLightData
+{
+    // Normalized, in world space
+    glm::vec3 direction;
+    glm::vec3 color;
+    float intensity;
+
+    bool operator==(const SSBODirectionalLightData& other) const
+    {
+        return direction == other.direction && color == other.color && intensity == other.intensity;
+    }
+
+    bool operator!=(const SSBODirectionalLightData& other) const
+    {
+        return !(*this == other);
+    }
+
+    std::vector<std::pair<const void*, size_t>> getData() const
+    {
+        return { { &direction, sizeof(glm::vec3) * 2 + sizeof(float) } };
+    }
+};
+
+} // namespace vrm
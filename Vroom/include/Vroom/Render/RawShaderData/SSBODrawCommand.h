@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vrm
+{
+
+/**
+ * @brief Indirect draw command, as read by glMultiDrawElementsIndirect (DrawElementsIndirectCommand).
+ * Also stored in a SSBO, so that the GPU culling shader can fill the instance count.
+ * 
+ */
+struct SSBODrawCommand
+{
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+static_assert(sizeof(SSBODrawCommand) == 20, "SSBODrawCommand must be tightly packed, as expected by indirect draws.");
+
+} // namespace vrm
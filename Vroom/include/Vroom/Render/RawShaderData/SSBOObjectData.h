@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Data of an object to be culled on the GPU. This is the formatted data for openGL std430 SSBO.
+ * 
+ */
+struct SSBOObjectData
+{
+    glm::mat4 model;
+    glm::vec4 boundingSphere; // Local center (xyz) and radius (w)
+    uint32_t commandIndex;
+    uint32_t padding[3];
+};
+
+static_assert(sizeof(SSBOObjectData) == 96, "SSBOObjectData must match the std430 layout of ObjectData.");
+
+} // namespace vrm
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Data for a spot light to be stored in a SSBO. This is the formatted data for openGL std430 SSBO.
+ * As for point lights, vec3's are retrieved with float[3]'s in the shader.
+ * 
+ */
+struct SSBOSpotLightData
+{
+    glm::vec3 position;
+    glm::vec3 color;
+    float intensity;
+    float radius;
+    // Normalized, in world space
+    glm::vec3 direction;
+    float cosOuterAngle;
+    float cosInnerAngle;
+
+    bool operator==(const SSBOSpotLightData& other) const
+    {
+        return position == other.position && color == other.color && intensity == other.intensity && radius == other.radius
+            && direction == other.direction && cosOuterAngle == other.cosOuterAngle && cosInnerAngle == other.cosInnerAngle;
+    }
+
+    bool operator!=(const SSBOSpotLightData& other) const
+    {
+        return !(*this == other);
+    }
+
+    std::vector<std::pair<const void*, size_t>> getData() const
+    {
+        return { { &position, sizeof(glm::vec3) * 3 + sizeof(float) * 4 } };
+    }
+};
+
+} // namespace vrm
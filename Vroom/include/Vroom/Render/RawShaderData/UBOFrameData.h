@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Per camera data, laid out as the std140 FrameData uniform block (Resources/Engine/Shader/FrameData.glsl).
+ *
+ */
+struct alignas(16) UBOFrameData
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::vec3 viewPosition;
+    float nearPlane;
+    glm::uvec2 viewportSize;
+    float farPlane;
+    float _padding;
+};
+
+static_assert(sizeof(UBOFrameData) == 224, "UBOFrameData must match the std140 layout of the FrameData block.");
+static_assert(offsetof(UBOFrameData, viewPosition) == 192);
+static_assert(offsetof(UBOFrameData, nearPlane) == 204);
+static_assert(offsetof(UBOFrameData, viewportSize) == 208);
+static_assert(offsetof(UBOFrameData, farPlane) == 216);
+
+} // namespace vrm
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Vroom/DataStructure/RangeAllocator.h"
+
+#include "Vroom/Asset/AssetData/Vertex.h"
+
+#include "Vroom/Render/Abstraction/VertexArray.h"
+#include "Vroom/Render/Abstraction/VertexBufferLayout.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Global storage for mesh geometry. Vertices and indices of every mesh are sub allocated from two large OpenGL buffers,
+ * shared by a single vertex array. Switching meshes then only changes the base vertex and first index of the draw.
+ * There is one pool per vertex format and index type, each with its own vertex array.
+ * 
+ * Indices are stored relative to the first vertex of their mesh, and drawn with base vertex draws.
+ * Buffers grow when full, and are compacted when free space is too fragmented to fit a new mesh.
+ */
+class GeometryPool
+{
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = ~Handle(0);
+
+    enum class IndexType : uint8_t
+    {
+        UInt16 = 0,
+        UInt32
+    };
+
+    /**
+     * @brief Location of a mesh in the pool buffers. Offsets may change when the pool is compacted.
+     */
+    struct Allocation
+    {
+        unsigned int baseVertex = 0;
+        unsigned int vertexCount = 0;
+        unsigned int firstIndex = 0;
+        unsigned int indexCount = 0;
+        bool alive = false;
+    };
+
+public:
+
+    /**
+     * @brief Initializes the geometry pools. Needs an OpenGL context.
+     */
+    static void Init();
+
+    /**
+     * @brief Shuts down the geometry pools, releasing GPU memory.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief Gets the geometry pool storing a vertex format and an index type. Pools are created on first use.
+     * @param vertexFormat The vertex format.
+     * @param indexType The index type.
+     * @return The geometry pool.
+     */
+    static GeometryPool& Get(VertexFormat vertexFormat, IndexType indexType);
+
+    /**
+     * @brief Checks if the geometry pools are initialized.
+     * @return True if the geometry pools are initialized.
+     */
+    static bool IsInitialized();
+
+    /**
+     * @brief Gets the index type fitting a mesh: 16 bits indices when every vertex can be addressed with them.
+     * @param vertexCount The number of vertices of the mesh.
+     * @return The index type.
+     */
+    static IndexType SelectIndexType(size_t vertexCount);
+
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool(GeometryPool&&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+    GeometryPool& operator=(GeometryPool&&) = delete;
+
+    /**
+     * @brief Releases GPU memory.
+     */
+    ~GeometryPool();
+
+    /**
+     * @brief Uploads a mesh to the pool.
+     * 
+     * @param vertices Raw vertex data, matching the pool vertex format.
+     * @param vertexCount The number of vertices.
+     * @param indices Raw index data, matching the pool index type. Indices are relative to the first vertex of the mesh.
+     * @param indexCount The number of indices.
+     * @return Handle The handle of the mesh allocation.
+     */
+    Handle allocate(const void* vertices, unsigned int vertexCount, const void* indices, unsigned int indexCount);
+
+    /**
+     * @brief Releases the ranges of a mesh. They are reused by next allocations.
+     * 
+     * @param handle The handle of the mesh allocation.
+     */
+    void free(Handle handle);
+
+    /**
+     * @brief Moves every mesh to the beginning of the buffers, merging all free space into a single range.
+     */
+    void compact();
+
+    /**
+     * @brief Gets the current location of a mesh.
+     * 
+     * @param handle The handle of the mesh allocation.
+     * @return const Allocation& The allocation.
+     */
+    inline const Allocation& getAllocation(Handle handle) const { return m_Allocations[handle]; }
+
+    inline const VertexArray& getVertexArray() const { return m_VertexArray; }
+    inline const VertexBufferLayout& getLayout() const { return m_Layout; }
+    inline VertexFormat getVertexFormat() const { return m_VertexFormat; }
+    inline IndexType getIndexType() const { return m_IndexType; }
+    inline unsigned int getIndexSize() const { return m_IndexType == IndexType::UInt16 ? 2u : 4u; }
+
+    /**
+     * @brief Gets the OpenGL type of the indices, to pass to draw calls.
+     * @return unsigned int GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+     */
+    inline unsigned int getGLIndexType() const { return m_IndexType == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+
+    inline size_t getVertexCapacity() const { return m_VertexAllocator.getCapacity(); }
+    inline size_t getIndexCapacity() const { return m_IndexAllocator.getCapacity(); }
+    inline size_t getUsedVertexCount() const { return m_VertexAllocator.getUsed(); }
+    inline size_t getUsedIndexCount() const { return m_IndexAllocator.getUsed(); }
+
+private:
+
+    /**
+     * @brief Creates the buffers and the vertex array.
+     * @param vertexFormat The vertex format stored by the pool.
+     * @param indexType The index type stored by the pool.
+     */
+    GeometryPool(VertexFormat vertexFormat, IndexType indexType);
+
+    /**
+     * @brief Makes sure a mesh fits in the buffers, compacting them if free space is fragmented, and growing them if it is not enough.
+     * 
+     * @param vertexCount The number of vertices of the mesh.
+     * @param indexCount The number of indices of the mesh.
+     */
+    void ensureFreeSpace(unsigned int vertexCount, unsigned int indexCount);
+
+    /**
+     * @brief Reallocates a buffer with a larger capacity, keeping its content.
+     * 
+     * @param isVertex True for the vertex buffer, false for the index buffer.
+     * @param capacity The new capacity, in elements.
+     */
+    void growBuffer(bool isVertex, size_t capacity);
+
+    /**
+     * @brief Attaches the current buffers to the vertex array.
+     */
+    void setupVertexArray();
+
+private:
+    static std::array<std::unique_ptr<GeometryPool>, 4> s_Pools;
+    static bool s_Initialized;
+
+    VertexFormat m_VertexFormat;
+    IndexType m_IndexType;
+    VertexBufferLayout m_Layout;
+    VertexArray m_VertexArray;
+
+    unsigned int m_VertexBufferID = 0;
+    unsigned int m_IndexBufferID = 0;
+
+    RangeAllocator m_VertexAllocator;
+    RangeAllocator m_IndexAllocator;
+
+    std::vector<Allocation> m_Allocations;
+    std::vector<Handle> m_FreeHandles;
+};
+
+} // namespace vrm
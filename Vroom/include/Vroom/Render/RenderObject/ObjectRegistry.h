@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "Vroom/Asset/AssetInstance/MeshInstance.h"
+#include "Vroom/Asset/StaticAsset/MeshAsset.h"
+#include "Vroom/Render/Abstraction/DynamicSSBO.h"
+#include "Vroom/Render/RawShaderData/SSBODrawCommand.h"
+#include "Vroom/Render/RawShaderData/SSBOObjectData.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Keeps the objects drawn by the GPU driven renderer from frame to frame, keyed by entity: one object per sub mesh
+ * of the mesh of an entity, and one indirect draw command per unique sub mesh.
+ *
+ * Objects live in a dense array, in the order of the object block. Entities that are not submitted during a frame are
+ * removed by moving the last objects in their slots. Only the objects that were added, removed or moved are written to
+ * the GPU, merged in a few ranges.
+ *
+ * Draw commands are sorted by state, so that commands sharing a state are contiguous. They are only sorted again when
+ * a sub mesh appears or disappears, and only their instance ranges are updated when an object is added or removed.
+ */
+class ObjectRegistry
+{
+public:
+    /**
+     * @brief A run of consecutive draw commands sharing their material and geometry pool, drawn with a single multi draw.
+     */
+    struct IndirectBatch
+    {
+        const MeshAsset::SubMesh* subMesh;
+        unsigned int firstCommand;
+        unsigned int commandCount;
+    };
+
+    /**
+     * @brief A range of the object block written during the last frame, in bytes.
+     */
+    struct DirtyRange
+    {
+        size_t offset;
+        size_t size;
+    };
+
+    /**
+     * @brief Changed objects closer than this are uploaded in the same range, unchanged objects in between included.
+     */
+    static constexpr unsigned int DirtyRangeMergeGap = 16;
+
+public:
+    ObjectRegistry() = default;
+    ObjectRegistry(const ObjectRegistry&) = delete;
+    ObjectRegistry(ObjectRegistry&&) = default;
+    ~ObjectRegistry() = default;
+
+    ObjectRegistry& operator=(const ObjectRegistry&) = delete;
+    ObjectRegistry& operator=(ObjectRegistry&&) = default;
+
+    /**
+     * @brief Sets the binding points of the object block and of the draw commands, which the GPU culling fills.
+     */
+    void setBindingPoints(int objectBindingPoint, int drawCommandBindingPoint);
+
+    void beginFrame();
+
+    /**
+     * @brief Submits the mesh of an entity for the current frame. Submitting the same entity twice keeps the last mesh.
+     */
+    void submitMesh(const MeshInstance& mesh, const glm::mat4& model, entt::entity entity);
+
+    /**
+     * @brief Removes the entities that were not submitted during the frame, sorts the draw commands again if sub meshes
+     * appeared or disappeared, and lists the dirty ranges of the object block. Does not need an OpenGL context.
+     * Called by endFrame, use it instead of endFrame only when nothing is uploaded.
+     */
+    void prepareFrame();
+
+    /**
+     * @brief Prepares the frame, then writes the dirty ranges of the object block and the changed draw commands. Resets the
+     * instance counts of the draw commands on the GPU, and binds both SSBOs.
+     */
+    void endFrame();
+
+    /**
+     * @brief Gets the objects, in the order of the object block.
+     */
+    inline const std::vector<SSBOObjectData>& getObjects() const { return m_Objects; }
+
+    inline unsigned int getObjectCount() const { return static_cast<unsigned int>(m_Objects.size()); }
+
+    /**
+     * @brief Gets the draw commands, sorted by state, with zero instances. Each command owns a range of the instance buffer,
+     * large enough for all its objects.
+     */
+    inline const std::vector<SSBODrawCommand>& getDrawCommands() const { return m_DrawCommands; }
+
+    inline const std::vector<IndirectBatch>& getIndirectBatches() const { return m_IndirectBatches; }
+
+    /**
+     * @brief Gets the ranges of the object block written by the last prepareFrame call, in offset order.
+     */
+    inline const std::vector<DirtyRange>& getDirtyRanges() const { return m_DirtyRanges; }
+
+    /**
+     * @brief Tells whether the draw commands changed during the last prepareFrame call.
+     */
+    inline bool haveDrawCommandsChanged() const { return m_DrawCommandsChanged; }
+
+    /**
+     * @brief Gets the draw commands the GPU culling fills, also read as indirect draw commands.
+     */
+    inline const DynamicSSBO& getDrawCommandSSBO() const { return m_DrawCommandSSBO; }
+
+private:
+    struct Entry
+    {
+        entt::entity entity;
+        MeshInstance mesh;
+        glm::mat4 model;
+        uint32_t frame;
+        // Slot of the object of each sub mesh
+        std::vector<unsigned int> objects;
+    };
+
+    struct Command
+    {
+        const MeshAsset::SubMesh* subMesh;
+        uint64_t key;
+        unsigned int objectCount;
+    };
+
+    void addObjects(unsigned int entryIndex);
+    void writeObjects(unsigned int entryIndex);
+    void removeObjects(unsigned int entryIndex);
+    void removeEntry(unsigned int entryIndex);
+    void markDirty(unsigned int slot);
+    void sortCommands();
+    void buildDrawCommands();
+    void buildDirtyRanges();
+
+private:
+    static constexpr unsigned int NoIndex = UINT32_MAX;
+
+    // Submitted entities, and the entry of each entity, indexed by entity index
+    std::vector<Entry> m_Entries;
+    std::vector<unsigned int> m_EntryIndices;
+    uint32_t m_Frame = 0;
+
+    // Object block, with the entry and the sub mesh of each object
+    std::vector<SSBOObjectData> m_Objects;
+    std::vector<unsigned int> m_ObjectEntries;
+    std::vector<const MeshAsset::SubMesh*> m_ObjectSubMeshes;
+
+    // Objects changed during the frame, possibly past the end of the block once objects are removed
+    std::vector<unsigned int> m_DirtyObjects;
+    std::vector<uint8_t> m_DirtyFlags;
+    std::vector<DirtyRange> m_DirtyRanges;
+
+    // Draw commands, and the command of each sub mesh. Commands stay in place until they are sorted again.
+    std::vector<Command> m_Commands;
+    std::unordered_map<const MeshAsset::SubMesh*, unsigned int> m_CommandIndices;
+    bool m_CommandsUnsorted = false;
+
+    std::vector<SSBODrawCommand> m_DrawCommands;
+    std::vector<IndirectBatch> m_IndirectBatches;
+    bool m_DrawCommandsChanged = false;
+
+    DynamicSSBO m_ObjectSSBO;
+    // Draw commands with zero instances, copied on the GPU to the filled commands every frame
+    DynamicSSBO m_DrawCommandTemplateSSBO;
+    DynamicSSBO m_DrawCommandSSBO;
+    int m_ObjectBindingPoint = 0;
+    int m_DrawCommandBindingPoint = 0;
+};
+
+} // namespace vrm
@@ -1,19 +1,31 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
 #include "Vroom/Asset/AssetData/MeshData.h"
+#include "Vroom/Asset/AssetData/VertexPacking.h"
 
 #include "Vroom/Render/Abstraction/VertexArray.h"
-#include "Vroom/Render/Abstraction/IndexBuffer.h"
-#include "Vroom/Render/Abstraction/VertexBuffer.h"
-#include "Vroom/Render/Abstraction/VertexBufferLayout.h"
+#include "Vroom/Render/RenderObject/GeometryPool.h"
 
 namespace vrm
 {
 
+/**
+ * @brief GPU side of a mesh. Geometry lives in the global GeometryPool, the render mesh only owns its allocation.
+ * 
+ * Indices are uploaded as 16 bits integers when the mesh has few enough vertices.
+ */
 class RenderMesh
 {
 public:
-    RenderMesh(const MeshData& meshData);
+    /**
+     * @brief Uploads a mesh to the geometry pool matching its vertex format and index type.
+     * 
+     * @param meshData The mesh data.
+     * @param vertexFormat The vertex format to upload the vertices with.
+     */
+    RenderMesh(const MeshData& meshData, VertexFormat vertexFormat = VertexFormat::Standard);
 
     RenderMesh(const RenderMesh&) = delete;
     RenderMesh& operator=(const RenderMesh&) = delete;
@@ -23,14 +35,68 @@ public:
 
     ~RenderMesh();
 
-    const VertexArray& getVertexArray() const { return m_VertexArray; }
-    const IndexBuffer& getIndexBuffer() const { return m_IndexBuffer; }
+    /**
+     * @brief Gets the vertex array to bind to draw this mesh. Shared by every mesh of the same pool.
+     * 
+     * @return const VertexArray& The vertex array.
+     */
+    const VertexArray& getVertexArray() const { return getPool().getVertexArray(); }
+
+    /**
+     * @brief Gets the unique identifier of this mesh geometry, across every pool.
+     * 
+     * @return uint32_t The identifier.
+     */
+    uint32_t getID() const { return m_Handle * 4 + getPoolIndex(); }
+
+    unsigned int getIndexCount() const { return m_Handle == GeometryPool::InvalidHandle ? 0 : getPool().getAllocation(m_Handle).indexCount; }
+    unsigned int getFirstIndex() const { return m_Handle == GeometryPool::InvalidHandle ? 0 : getPool().getAllocation(m_Handle).firstIndex; }
+    unsigned int getBaseVertex() const { return m_Handle == GeometryPool::InvalidHandle ? 0 : getPool().getAllocation(m_Handle).baseVertex; }
+
+    /**
+     * @brief Gets the OpenGL type of the indices.
+     * 
+     * @return unsigned int GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+     */
+    unsigned int getGLIndexType() const { return m_IndexType == GeometryPool::IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+
+    /**
+     * @brief Gets the size of an index, in bytes.
+     * 
+     * @return unsigned int 2 or 4.
+     */
+    unsigned int getIndexSize() const { return m_IndexType == GeometryPool::IndexType::UInt16 ? 2u : 4u; }
+
+    VertexFormat getVertexFormat() const { return m_VertexFormat; }
+    GeometryPool::IndexType getIndexType() const { return m_IndexType; }
+    bool isPacked() const { return m_VertexFormat == VertexFormat::Packed; }
+
+    /**
+     * @brief Gets the transform bringing stored positions to mesh space. Identity unless vertices are packed.
+     * 
+     * @return const glm::mat4& The transform, to apply before the model matrix.
+     */
+    const glm::mat4& getPositionTransform() const { return m_PositionTransform; }
+
+    /**
+     * @brief Gets the position quantization of packed vertices.
+     * 
+     * @return const VertexPacking::PositionQuantization& The quantization.
+     */
+    const VertexPacking::PositionQuantization& getPositionQuantization() const { return m_Quantization; }
+
+private:
+    void release();
+
+    uint32_t getPoolIndex() const { return static_cast<uint32_t>(m_VertexFormat) * 2 + static_cast<uint32_t>(m_IndexType); }
+    GeometryPool& getPool() const { return GeometryPool::Get(m_VertexFormat, m_IndexType); }
 
 private:
-    VertexBuffer m_VertexBuffer;
-    IndexBuffer m_IndexBuffer;
-    VertexArray m_VertexArray;
-    VertexBufferLayout m_VertexBufferLayout;
+    GeometryPool::Handle m_Handle = GeometryPool::InvalidHandle;
+    VertexFormat m_VertexFormat = VertexFormat::Standard;
+    GeometryPool::IndexType m_IndexType = GeometryPool::IndexType::UInt32;
+    VertexPacking::PositionQuantization m_Quantization;
+    glm::mat4 m_PositionTransform = glm::mat4(1.f);
 };
 
 } // namespace vrm
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vrm
+{
+
+/**
+ * @brief Passes a draw packet can belong to. Packets are sorted by pass first, so passes are submitted in this order.
+ *
+ */
+enum class RenderPass : uint8_t
+{
+    Opaque = 0
+};
+
+/**
+ * @brief Builds the 64 bits keys used to sort draw packets in the render queue.
+ * Most significant bits are the most expensive state changes, so sorting the keys groups draws sharing the same state.
+ *
+ * Layout, from most significant to least significant bit:
+ * | pass (2) | shader (12) | material (12) | textures (10) | mesh (12) | depth (16) |
+ *
+ * Identifiers wider than their field are truncated. Two different states may then share an identifier, which only
+ * affects the ordering quality: the renderer always compares the actual states before skipping a bind.
+ */
+class RenderKey
+{
+public:
+    RenderKey() = delete;
+
+    static constexpr unsigned int PassBits = 2;
+    static constexpr unsigned int ShaderBits = 12;
+    static constexpr unsigned int MaterialBits = 12;
+    static constexpr unsigned int TexturesBits = 10;
+    static constexpr unsigned int MeshBits = 12;
+    static constexpr unsigned int DepthBits = 16;
+
+    static constexpr unsigned int DepthShift = 0;
+    static constexpr unsigned int MeshShift = DepthShift + DepthBits;
+    static constexpr unsigned int TexturesShift = MeshShift + MeshBits;
+    static constexpr unsigned int MaterialShift = TexturesShift + TexturesBits;
+    static constexpr unsigned int ShaderShift = MaterialShift + MaterialBits;
+    static constexpr unsigned int PassShift = ShaderShift + ShaderBits;
+
+    static_assert(PassShift + PassBits == 64, "Render key fields must fill exactly 64 bits.");
+
+    /**
+     * @brief Builds a sort key.
+     *
+     * @param pass The pass of the draw.
+     * @param shader The shader identifier (typically the OpenGL program id).
+     * @param material The material identifier.
+     * @param textures An identifier of the set of textures bound by the material.
+     * @param mesh The mesh identifier (typically the OpenGL vertex array id).
+     * @param depth The normalized depth of the draw, in [0, 1]. Values outside are clamped.
+     * @return uint64_t The sort key.
+     */
+    static constexpr uint64_t Build(RenderPass pass, uint32_t shader, uint32_t material, uint32_t textures, uint32_t mesh, float depth)
+    {
+        return field(static_cast<uint32_t>(pass), PassBits, PassShift)
+            | field(shader, ShaderBits, ShaderShift)
+            | field(material, MaterialBits, MaterialShift)
+            | field(textures, TexturesBits, TexturesShift)
+            | field(mesh, MeshBits, MeshShift)
+            | field(QuantizeDepth(depth), DepthBits, DepthShift);
+    }
+
+    /**
+     * @brief Quantizes a normalized depth to the depth field of the key.
+     *
+     * @param depth The normalized depth, in [0, 1].
+     * @return uint32_t The quantized depth.
+     */
+    static constexpr uint32_t QuantizeDepth(float depth)
+    {
+        constexpr float maxDepth = static_cast<float>((1u << DepthBits) - 1u);
+        if (!(depth > 0.f)) // Also catches NaN
+            return 0u;
+        if (depth >= 1.f)
+            return static_cast<uint32_t>(maxDepth);
+        return static_cast<uint32_t>(depth * maxDepth);
+    }
+
+    /**
+     * @brief Gets the key with its depth field cleared. Two packets with the same state key can be drawn without any state change.
+     *
+     * @param key The sort key.
+     * @return uint64_t The key without depth.
+     */
+    static constexpr uint64_t StateOf(uint64_t key)
+    {
+        return key & ~(((uint64_t(1) << DepthBits) - 1u) << DepthShift);
+    }
+
+private:
+    static constexpr uint64_t field(uint32_t value, unsigned int bits, unsigned int shift)
+    {
+        return (static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1u)) << shift;
+    }
+};
+
+} // namespace vrm
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Vroom/Asset/StaticAsset/MeshAsset.h"
+
+namespace vrm
+{
+
+/**
+ * @brief A single draw: one sub mesh with one model matrix.
+ *
+ */
+struct DrawPacket
+{
+    uint64_t key;
+    const MeshAsset::SubMesh* subMesh;
+    const glm::mat4* model;
+};
+
+/**
+ * @brief Queue of draw packets, sorted by key before submission so that consecutive packets share as much state as possible.
+ *
+ */
+class RenderQueue
+{
+public:
+    RenderQueue() = default;
+    RenderQueue(const RenderQueue&) = default;
+    RenderQueue(RenderQueue&&) = default;
+    ~RenderQueue() = default;
+
+    RenderQueue& operator=(const RenderQueue&) = default;
+    RenderQueue& operator=(RenderQueue&&) = default;
+
+    /**
+     * @brief Removes every packet. Memory is kept for next frame.
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Reserves memory for a given number of packets.
+     *
+     * @param packetCount The number of packets.
+     */
+    void reserve(size_t packetCount);
+
+    /**
+     * @brief Adds a packet to the queue.
+     *
+     * @param packet The packet to add.
+     */
+    void push(const DrawPacket& packet);
+
+    /**
+     * @brief Sorts the packets by ascending key, with a LSD radix sort. The sort is stable.
+     *
+     */
+    void sort();
+
+    inline const std::vector<DrawPacket>& getPackets() const { return m_Packets; }
+    inline size_t size() const { return m_Packets.size(); }
+    inline bool empty() const { return m_Packets.empty(); }
+
+private:
+    std::vector<DrawPacket> m_Packets;
+    std::vector<DrawPacket> m_Scratch;
+};
+
+} // namespace vrm
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -8,15 +10,30 @@
 #include "Vroom/Render/Abstraction/VertexBuffer.h"
 #include "Vroom/Render/Abstraction/VertexBufferLayout.h"
 #include "Vroom/Render/Abstraction/IndexBuffer.h"
+#include "Vroom/Render/Abstraction/PersistentRingBuffer.h"
+#include "Vroom/Render/Abstraction/DepthFrameBuffer.h"
 
+#include "Vroom/Render/Clustering/ClusterGrid.h"
+#include "Vroom/Render/Clustering/ClusterGridTuner.h"
+#include "Vroom/Render/Clustering/LightBudget.h"
 #include "Vroom/Render/Clustering/LightRegistry.h"
 #include "Vroom/Render/Clustering/ClusteredLights.h"
 
+#include "Vroom/Render/RenderQueue/RenderQueue.h"
+
+#include "Vroom/Render/Culling/FrustumCuller.h"
+
+#include "Vroom/Render/RenderObject/ObjectRegistry.h"
+
 #include "Vroom/Asset/AssetInstance/MeshInstance.h"
+#include "Vroom/Asset/AssetInstance/MaterialInstance.h"
 #include "Vroom/Asset/AssetInstance/ShaderInstance.h"
+#include "Vroom/Asset/AssetInstance/ComputeShaderInstance.h"
 
 #include "Vroom/Render/Camera/CameraBasic.h"
 
+class Shader;
+
 namespace vrm
 {
 
@@ -59,8 +76,22 @@ public:
 	 */
 	~Renderer();
 
+	/**
+	 * @brief Has to be called once per frame, before any scene.
+	 * Waits for the GPU to be done with the per frame data region written FrameCount frames ago, if needed.
+	 * 
+	 */
+	void beginFrame();
+
+	/**
+	 * @brief Has to be called once per frame, after every scene. Fences the per frame data written during the frame.
+	 * 
+	 */
+	void endFrame();
+
 	/**
 	 * @brief Has to be called before any rendering of current frame.
+	 * Writes the camera data to the per frame ring buffer, bound to uniform binding point 0.
 	 * 
 	 */
 	void beginScene(const CameraBasic& camera);
@@ -81,8 +112,9 @@ public:
 	 * 
 	 * @param mesh  The mesh to submit.
 	 * @param model  The model matrix.
+	 * @param entity  The entity of the mesh, which identifies it from frame to frame with GPU driven rendering.
 	 */
-	void submitMesh(const MeshInstance& mesh, const glm::mat4& model);
+	void submitMesh(const MeshInstance& mesh, const glm::mat4& model, entt::entity entity);
 
 	/**
 	 * @brief Submits a point light to be drawn.
@@ -91,17 +123,192 @@ public:
 	 * 
 	 * @param position  The position of the light.
 	 * @param pointLight  The point light component.
-	 * @param identifier  The identifier of the light.
+	 * @param entity  The entity of the light, which identifies it from frame to frame.
 	 */
-	void submitPointLight(const glm::vec3& position, const PointLightComponent& pointLight, const std::string& identifier);
+	void submitPointLight(const glm::vec3& position, const PointLightComponent& pointLight, entt::entity entity);
 
 	/**
-	 * @brief  Draws a mesh with a shader and a camera.
+	 * @brief Submits a spot light to be drawn. The component is copied.
 	 * 
-	 * @param mesh  The mesh to draw.
-	 * @param model  The model matrix.
+	 * @param position  The position of the light, the apex of its cone.
+	 * @param direction  The axis of the cone, in world space.
+	 * @param spotLight  The spot light component.
+	 */
+	void submitSpotLight(const glm::vec3& position, const glm::vec3& direction, const SpotLightComponent& spotLight);
+
+	/**
+	 * @brief Submits a directional light to be drawn. The component is copied. Directional lights are not clustered.
+	 * 
+	 * @param direction  The direction the light travels in, in world space.
+	 * @param directionalLight  The directional light component.
+	 */
+	void submitDirectionalLight(const glm::vec3& direction, const DirectionalLightComponent& directionalLight);
+
+	/**
+	 * @brief Enables or disables frustum culling of sub meshes. Enabled by default.
+	 * @param enabled True to cull sub meshes outside of the camera frustum.
+	 */
+	void setFrustumCullingEnabled(bool enabled);
+
+	/**
+	 * @brief Checks if frustum culling is enabled.
+	 * @return True if frustum culling is enabled.
+	 */
+	inline bool isFrustumCullingEnabled() const { return m_FrustumCullingEnabled; }
+
+	/**
+	 * @brief Enables or disables the GPU driven mode. Disabled by default.
+	 * In this mode, object transforms and bounds are uploaded to GPU buffers, frustum culling runs in a compute shader which fills
+	 * indirect draw commands, and the opaque pass is submitted with glMultiDrawElementsIndirect.
+	 * @param enabled True to render with the GPU driven path.
+	 */
+	void setGPUDrivenEnabled(bool enabled);
+
+	/**
+	 * @brief Checks if the GPU driven mode is enabled.
+	 * @return True if the GPU driven mode is enabled.
+	 */
+	inline bool isGPUDrivenEnabled() const { return m_GPUDrivenEnabled; }
+
+	/**
+	 * @brief Enables or disables active cluster detection. Disabled by default.
+	 * In this mode, a depth prepass renders the opaque geometry before lights are culled. Clusters holding at least one depth sample
+	 * are gathered in a list on the GPU, and lights are only culled against these clusters.
+	 * @param enabled True to cull lights against active clusters only.
 	 */
-	void drawMesh(const MeshInstance& mesh, const glm::mat4& model) const;
+	void setActiveClustersEnabled(bool enabled);
+
+	/**
+	 * @brief Checks if active cluster detection is enabled.
+	 * @return True if active cluster detection is enabled.
+	 */
+	inline bool isActiveClustersEnabled() const { return m_ActiveClustersEnabled; }
+
+	/**
+	 * @brief Sets how lights are assigned to clusters. Per cluster by default.
+	 * Per light culling bins each light into the clusters its bounding sphere projects to, so its cost follows the clusters lights
+	 * actually cover instead of clusters times lights. It scales to many more lights.
+	 * @param mode The light culling mode.
+	 */
+	void setLightCullingMode(ClusteredLights::CullingMode mode);
+
+	/**
+	 * @brief Gets how lights are assigned to clusters.
+	 * @return The light culling mode.
+	 */
+	inline ClusteredLights::CullingMode getLightCullingMode() const { return m_ClusteredLights.getCullingMode(); }
+
+	/**
+	 * @brief Sets the shader testing lights against clusters in per cluster mode. Otherwise, the faster one is picked by
+	 * timing both on the first frames.
+	 * @param kernel The light culling kernel.
+	 * @param localSize The number of clusters of a work group.
+	 */
+	void setLightCullingKernel(ClusteredLights::CullingKernel kernel, unsigned int localSize = ClusteredLights::DefaultCullingLocalSize);
+
+	/**
+	 * @brief Gets the shader testing lights against clusters in per cluster mode.
+	 * @return The light culling kernel.
+	 */
+	inline ClusteredLights::CullingKernel getLightCullingKernel() const { return m_ClusteredLights.getCullingKernel(); }
+
+	/**
+	 * @brief Gets the number of clusters of a light culling work group, picked at startup from the device limits.
+	 * @return The light culling local size.
+	 */
+	inline unsigned int getLightCullingLocalSize() const { return m_ClusteredLights.getCullingLocalSize(); }
+
+	/**
+	 * @brief Sets the maximum number of point lights sent to the GPU per scene. Unlimited by default.
+	 * Lights outside of the camera frustum are always dropped. Past the budget, the lights covering the least of the screen
+	 * with the least intensity are dropped too.
+	 * @param maxLights The light budget, or LightBudget::Unlimited.
+	 */
+	void setLightBudget(unsigned int maxLights);
+
+	/**
+	 * @brief Gets the maximum number of point lights sent to the GPU per scene.
+	 * @return The light budget.
+	 */
+	inline unsigned int getLightBudget() const { return m_LightBudget.getMaxLights(); }
+
+	/**
+	 * @brief Sets the intensity under which a point light is considered to light nothing. Its radius is cut there.
+	 * @param intensityCutoff The cutoff. 0 or less keeps the radius of the components.
+	 */
+	void setLightIntensityCutoff(float intensityCutoff);
+
+	/**
+	 * @brief Gets the intensity under which a point light is considered to light nothing.
+	 * @return The intensity cutoff.
+	 */
+	inline float getLightIntensityCutoff() const { return m_LightBudget.getIntensityCutoff(); }
+
+	/**
+	 * @brief Sets the maximum number of lights of a cluster. Clusters touched by more lights keep the most important ones.
+	 * @param clusterLightLimit The limit.
+	 */
+	void setClusterLightLimit(unsigned int clusterLightLimit);
+
+	/**
+	 * @brief Gets the maximum number of lights of a cluster.
+	 * @return The cluster light limit.
+	 */
+	inline unsigned int getClusterLightLimit() const { return m_ClusteredLights.getClusterLightLimit(); }
+
+	/**
+	 * @brief Sets how the cluster grid is sized from the viewport. The grid follows viewport and projection changes.
+	 * Stops a running cluster grid tuning.
+	 * @param settings The cluster grid settings.
+	 */
+	void setClusterGridSettings(const ClusterGridSettings& settings);
+
+	/**
+	 * @brief Gets how the cluster grid is sized from the viewport.
+	 * @return The cluster grid settings.
+	 */
+	inline const ClusterGridSettings& getClusterGridSettings() const { return m_ClusterGridSettings; }
+
+	/**
+	 * @brief Gets the number of clusters along each axis, used by the last scene.
+	 * @return The cluster grid size.
+	 */
+	inline const glm::uvec3& getClusterCount() const { return m_ClusteredLights.getClusterCount(); }
+
+	/**
+	 * @brief Renders the next frames with each candidate grid, measuring the GPU time of light culling and of the opaque
+	 * pass, then keeps the cheapest one as the cluster grid settings. Every cluster is culled during these frames.
+	 * Needs the GPU profiler.
+	 * @param candidates The cluster grid settings to measure.
+	 * @return False if the GPU profiler is not initialized or not enabled, nothing is measured then.
+	 */
+	bool startClusterGridTuning(std::vector<ClusterGridSettings> candidates = ClusterGridTuner::GetDefaultCandidates());
+
+	/**
+	 * @brief Checks if the cluster grid is being tuned.
+	 * @return True while candidate grids are measured.
+	 */
+	inline bool isClusterGridTuning() const { return m_ClusterGridTuner.isRunning(); }
+
+	/**
+	 * @brief Gets the cluster grid tuner, holding the results of the last tuning.
+	 * @return The cluster grid tuner.
+	 */
+	inline const ClusterGridTuner& getClusterGridTuner() const { return m_ClusterGridTuner; }
+
+	/**
+	 * @brief Gets the number of sub meshes that passed frustum culling during the last scene.
+	 * Always 0 in GPU driven mode, because culling results are not read back.
+	 * @return The number of visible sub meshes.
+	 */
+	inline size_t getVisibleSubMeshCount() const { return m_VisibleSubMeshCount; }
+
+	/**
+	 * @brief Gets the number of sub meshes rejected by frustum culling during the last scene.
+	 * Always 0 in GPU driven mode, because culling results are not read back.
+	 * @return The number of culled sub meshes.
+	 */
+	inline size_t getCulledSubMeshCount() const { return m_CulledSubMeshCount; }
 
 	/**
 	 * @brief Gets the viewport origin.
@@ -141,6 +348,63 @@ private:
 	 */
 	Renderer();
 
+	/**
+	 * @brief Splits every submitted mesh into one draw packet per sub mesh, skipping sub meshes outside of the camera frustum,
+	 * and sorts the packets by state.
+	 */
+	void buildRenderQueue();
+
+	/**
+	 * @brief Merges consecutive packets drawing the same sub mesh into instanced batches, and writes their model matrices to the ring buffer.
+	 */
+	void buildInstanceBatches();
+
+	/**
+	 * @brief Draws the instanced batches. Shader, material textures and vertex array are only bound when they change.
+	 * @param materialOverride If not null, the material every batch is drawn with.
+	 */
+	void drawRenderQueue(const MaterialAsset* materialOverride = nullptr);
+
+	/**
+	 * @brief Uploads the objects and indirect draw commands that changed since the last frame, and culls every object with a compute shader.
+	 */
+	void buildGPUDrivenCommands();
+
+	/**
+	 * @brief Draws the indirect commands filled by the GPU culling, with one multi draw per run of commands sharing their state.
+	 * @param materialOverride If not null, the material every command is drawn with.
+	 */
+	void drawGPUDrivenCommands(const MaterialAsset* materialOverride = nullptr);
+
+	/**
+	 * @brief Draws the batches built for the opaque pass to the depth prepass target, with the depth only material.
+	 */
+	void drawDepthPrepass();
+
+	/**
+	 * @brief Feeds the GPU time of the last collected frame, once, to the cluster grid tuner, and keeps the best grid once it is done.
+	 */
+	void updateClusterGridTuning();
+
+	/**
+	 * @brief OpenGL states bound while drawing, to skip redundant binds.
+	 */
+	struct BoundState
+	{
+		const Shader* shader = nullptr;
+		const MaterialAsset* material = nullptr;
+		const VertexArray* vertexArray = nullptr;
+		std::array<unsigned int, 8> textures = {};
+	};
+
+	/**
+	 * @brief Binds the shader, material textures and vertex array of a sub mesh, skipping what is already bound.
+	 * @param subMesh The sub mesh to draw.
+	 * @param boundState The currently bound states. Updated.
+	 * @param materialOverride If not null, the material used instead of the sub mesh one.
+	 */
+	void bindSubMeshState(const MeshAsset::SubMesh& subMesh, BoundState& boundState, const MaterialAsset* materialOverride = nullptr) const;
+
 private:
 	// Structs to store data to be drawn
 	struct QueuedMesh
@@ -149,6 +413,13 @@ private:
 		const glm::mat4& model;
 	};
 
+	struct InstanceBatch
+	{
+		const MeshAsset::SubMesh* subMesh;
+		unsigned int baseInstance;
+		unsigned int instanceCount;
+	};
+
 private:
 	static std::unique_ptr<Renderer> s_Instance;
 
@@ -164,7 +435,41 @@ private:
 	const CameraBasic* m_Camera = nullptr;
 
 	std::vector<QueuedMesh> m_Meshes;
-
+	RenderQueue m_RenderQueue;
+
+	// Frustum culling
+	FrustumCuller m_FrustumCuller;
+	bool m_FrustumCullingEnabled = true;
+	size_t m_VisibleSubMeshCount = 0;
+	size_t m_CulledSubMeshCount = 0;
+
+	// Transient per frame data: camera data, lights, instance matrices, objects and indirect commands.
+	// Written straight into mapped memory and bound by range.
+	PersistentRingBuffer m_FrameRing;
+
+	// Instanced drawing
+	std::vector<InstanceBatch> m_InstanceBatches;
+	std::vector<glm::mat4> m_InstanceModels;
+
+	// GPU driven rendering
+	bool m_GPUDrivenEnabled = false;
+	ObjectRegistry m_ObjectRegistry;
+	ComputeShaderInstance m_GPUCuller;
+	int m_GPUCullerObjectCountLocation = -1;
+	int m_GPUCullerFrustumPlanesLocation = -1;
+
+	// Active cluster detection
+	bool m_ActiveClustersEnabled = false;
+	DepthFrameBuffer m_DepthPrepassTarget;
+	MaterialInstance m_DepthPrepassMaterial;
+
+	// Cluster grid sizing
+	ClusterGridSettings m_ClusterGridSettings;
+	ClusterGridTuner m_ClusterGridTuner;
+	// Last collected GPU profiler frame fed to the tuner
+	size_t m_ClusterGridTunedFrame = 0;
+
+	LightBudget m_LightBudget;
 	LightRegistry m_LightRegistry;
 	ClusteredLights m_ClusteredLights;
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Light lighting the whole scene along the entity forward axis, the -z axis rotated by its transform, such as the sun.
+ * Not clustered: every fragment is lit by every directional light.
+ */
+struct DirectionalLightComponent
+{
+    glm::vec3 color = glm::vec3(1.0f);
+    float intensity = 1.0f;
+};
+
+} // namespace vrm
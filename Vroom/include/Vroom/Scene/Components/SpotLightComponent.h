@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace vrm
+{
+
+/**
+ * @brief Light shining from the entity position along its forward axis, the -z axis rotated by its transform, inside a cone.
+ */
+struct SpotLightComponent
+{
+    glm::vec3 color = glm::vec3(1.0f);
+    float intensity = 1.0f;
+    float radius = 1.0f;
+    // Half angles of the cone, in radians: full intensity inside the inner one, none outside the outer one.
+    // The outer angle is kept below 90 degrees.
+    float innerAngle = glm::radians(20.0f);
+    float outerAngle = glm::radians(30.0f);
+};
+
+} // namespace vrm
@@ -1,16 +1,20 @@
 #include "Vroom/Asset/AssetData/MeshData.h"
 
+#include <cmath>
+
 namespace vrm
 {
 
 MeshData::MeshData(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
     : m_Vertices(vertices), m_Indices(indices)
 {
+    computeBounds();
 }
 
 MeshData::MeshData(std::vector<Vertex>&& vertices, std::vector<uint32_t>&& indices)
     : m_Vertices(std::move(vertices)), m_Indices(std::move(indices))
 {
+    computeBounds();
 }
 
 MeshData::MeshData()
@@ -19,12 +23,12 @@ MeshData::MeshData()
 }
 
 MeshData::MeshData(const MeshData& other)
-    : m_Vertices(other.m_Vertices), m_Indices(other.m_Indices)
+    : m_Vertices(other.m_Vertices), m_Indices(other.m_Indices), m_BoundingBox(other.m_BoundingBox), m_BoundingSphere(other.m_BoundingSphere)
 {
 }
 
 MeshData::MeshData(MeshData&& other)
-    : m_Vertices(std::move(other.m_Vertices)), m_Indices(std::move(other.m_Indices))
+    : m_Vertices(std::move(other.m_Vertices)), m_Indices(std::move(other.m_Indices)), m_BoundingBox(other.m_BoundingBox), m_BoundingSphere(other.m_BoundingSphere)
 {
 }
 
@@ -34,6 +38,8 @@ MeshData& MeshData::operator=(const MeshData& other)
     {
         m_Vertices = other.m_Vertices;
         m_Indices = other.m_Indices;
+        m_BoundingBox = other.m_BoundingBox;
+        m_BoundingSphere = other.m_BoundingSphere;
     }
 
     return *this;
@@ -45,6 +51,8 @@ MeshData& MeshData::operator=(MeshData&& other)
     {
         m_Vertices = std::move(other.m_Vertices);
         m_Indices = std::move(other.m_Indices);
+        m_BoundingBox = other.m_BoundingBox;
+        m_BoundingSphere = other.m_BoundingSphere;
     }
 
     return *this;
@@ -54,6 +62,31 @@ MeshData::~MeshData()
 {
 }
 
+void MeshData::computeBounds()
+{
+    if (m_Vertices.empty())
+    {
+        m_BoundingBox = AABB();
+        m_BoundingSphere = BoundingSphere();
+        return;
+    }
+
+    m_BoundingBox.min = m_BoundingBox.max = m_Vertices.front().position;
+    for (const auto& vertex : m_Vertices)
+    {
+        m_BoundingBox.min = glm::min(m_BoundingBox.min, vertex.position);
+        m_BoundingBox.max = glm::max(m_BoundingBox.max, vertex.position);
+    }
 
+    // Sphere centered on the box, reaching the farthest vertex. Tighter than the box half diagonal for most meshes.
+    m_BoundingSphere.center = m_BoundingBox.getCenter();
+    float maxDistance2 = 0.f;
+    for (const auto& vertex : m_Vertices)
+    {
+        const glm::vec3 offset = vertex.position - m_BoundingSphere.center;
+        maxDistance2 = glm::max(maxDistance2, glm::dot(offset, offset));
+    }
+    m_BoundingSphere.radius = std::sqrt(maxDistance2);
+}
 
 } // namespace vrm
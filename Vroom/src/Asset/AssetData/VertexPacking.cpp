@@ -0,0 +1,120 @@
+#include "Vroom/Asset/AssetData/VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace vrm
+{
+
+glm::mat4 VertexPacking::PositionQuantization::getMatrix() const
+{
+    return glm::scale(glm::translate(glm::mat4(1.f), offset), glm::vec3(scale));
+}
+
+bool VertexPacking::CanPack(const std::vector<Vertex>& vertices)
+{
+    for (const auto& vertex : vertices)
+    {
+        if (std::abs(vertex.texCoords.x) > MaxTexCoord || std::abs(vertex.texCoords.y) > MaxTexCoord)
+            return false;
+    }
+    return true;
+}
+
+VertexPacking::PositionQuantization VertexPacking::ComputeQuantization(const AABB& box)
+{
+    PositionQuantization quantization;
+    quantization.offset = box.min;
+
+    const glm::vec3 size = box.max - box.min;
+    quantization.scale = std::max(size.x, std::max(size.y, size.z));
+    if (quantization.scale <= 0.f) // Single point mesh
+        quantization.scale = 1.f;
+
+    return quantization;
+}
+
+std::vector<PackedVertex> VertexPacking::Pack(const std::vector<Vertex>& vertices, const PositionQuantization& quantization)
+{
+    std::vector<PackedVertex> packedVertices;
+    packedVertices.reserve(vertices.size());
+
+    const float invScale = 1.f / quantization.scale;
+
+    for (const auto& vertex : vertices)
+    {
+        PackedVertex packed;
+
+        const glm::vec3 position = (vertex.position - quantization.offset) * invScale;
+        packed.position[0] = glm::packUnorm1x16(position.x);
+        packed.position[1] = glm::packUnorm1x16(position.y);
+        packed.position[2] = glm::packUnorm1x16(position.z);
+        packed.position[3] = 0;
+
+        const glm::vec2 normal = EncodeOctahedral(vertex.normal);
+        packed.normal[0] = static_cast<int16_t>(glm::packSnorm1x16(normal.x));
+        packed.normal[1] = static_cast<int16_t>(glm::packSnorm1x16(normal.y));
+
+        packed.texCoords[0] = glm::packHalf1x16(vertex.texCoords.x);
+        packed.texCoords[1] = glm::packHalf1x16(vertex.texCoords.y);
+
+        packedVertices.push_back(packed);
+    }
+
+    return packedVertices;
+}
+
+Vertex VertexPacking::Unpack(const PackedVertex& vertex, const PositionQuantization& quantization)
+{
+    Vertex unpacked;
+
+    const glm::vec3 position(
+        glm::unpackUnorm1x16(vertex.position[0]),
+        glm::unpackUnorm1x16(vertex.position[1]),
+        glm::unpackUnorm1x16(vertex.position[2])
+    );
+    unpacked.position = quantization.offset + position * quantization.scale;
+
+    unpacked.normal = DecodeOctahedral(glm::vec2(
+        glm::unpackSnorm1x16(static_cast<uint16_t>(vertex.normal[0])),
+        glm::unpackSnorm1x16(static_cast<uint16_t>(vertex.normal[1]))
+    ));
+
+    unpacked.texCoords = glm::vec2(glm::unpackHalf1x16(vertex.texCoords[0]), glm::unpackHalf1x16(vertex.texCoords[1]));
+
+    return unpacked;
+}
+
+glm::vec2 VertexPacking::EncodeOctahedral(const glm::vec3& normal)
+{
+    const float l1Norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1Norm <= 0.f)
+        return glm::vec2(0.f);
+
+    glm::vec3 n = normal / l1Norm;
+    if (n.z < 0.f)
+    {
+        // Folding the lower hemisphere over the diagonals
+        const float x = n.x, y = n.y;
+        n.x = (1.f - std::abs(y)) * (x >= 0.f ? 1.f : -1.f);
+        n.y = (1.f - std::abs(x)) * (y >= 0.f ? 1.f : -1.f);
+    }
+
+    return glm::vec2(n.x, n.y);
+}
+
+glm::vec3 VertexPacking::DecodeOctahedral(const glm::vec2& encoded)
+{
+    // Same decoding as the default vertex shader
+    glm::vec3 n(encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y));
+    const float t = std::max(-n.z, 0.f);
+    n.x += n.x >= 0.f ? -t : t;
+    n.y += n.y >= 0.f ? -t : t;
+
+    return glm::normalize(n);
+}
+
+} // namespace vrm
@@ -9,6 +9,17 @@
 namespace vrm
 {
 
+// FrameData uniform block declaration, shared by the vertex and fragment shaders of every material
+static std::string ReadFrameData()
+{
+    std::ifstream file("Resources/Engine/Shader/FrameData.glsl");
+    VRM_ASSERT_MSG(file.is_open(), "Failed to open frame data shader file: Resources/Engine/Shader/FrameData.glsl");
+
+    std::stringstream frameData;
+    frameData << file.rdbuf() << '\n';
+    return frameData.str();
+}
+
 MaterialParsing::ParsingResults MaterialParsing::Parse(const std::string& filePath)
 {
     // Getting material data
@@ -24,7 +35,34 @@ MaterialParsing::ParsingResults MaterialParsing::Parse(const std::string& filePa
 
     ParsingResults output;
 
-    output.vertex = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::string frameData = ReadFrameData();
+
+    std::stringstream vertexSS;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line == "#include InstanceData")
+        {
+            std::ifstream includeFile;
+            includeFile.open("Resources/Engine/Shader/VertexShader/InstanceData.glsl");
+            VRM_ASSERT_MSG(includeFile.is_open(), "Failed to open instance data shader file: Resources/Engine/Shader/VertexShader/InstanceData.glsl");
+
+            vertexSS << includeFile.rdbuf() << '\n';
+
+            includeFile.close();
+        }
+        else if (line == "#include FrameData")
+        {
+            vertexSS << frameData;
+        }
+        else
+        {
+            vertexSS << line << '\n';
+        }
+    }
+
+    output.vertex = vertexSS.str();
     file.close();
 
     // Reading fragment shader assembler
@@ -33,7 +71,6 @@ MaterialParsing::ParsingResults MaterialParsing::Parse(const std::string& filePa
 
     std::stringstream fragSS;
 
-    std::string line;
     while (std::getline(file, line))
     {
         if (line == "#include PreFragShader")
@@ -66,6 +103,10 @@ MaterialParsing::ParsingResults MaterialParsing::Parse(const std::string& filePa
 
             includeFile.close();
         }
+        else if (line == "#include FrameData")
+        {
+            fragSS << frameData;
+        }
         else if (line == "#include Sampler2DUniform")
         {
             auto size = parameters.textures.size();
@@ -104,7 +145,8 @@ const MaterialParsing::MaterialParameters MaterialParsing::getMaterialParameters
     };
 
     static const std::unordered_map<std::string, std::string> shadingModels = {
-        {"Phong", "Resources/Engine/Shader/FragmentShader/ShadingModel/ShadingModelFrag_Phong.glsl"}
+        {"Phong", "Resources/Engine/Shader/FragmentShader/ShadingModel/ShadingModelFrag_Phong.glsl"},
+        {"DepthOnly", "Resources/Engine/Shader/FragmentShader/ShadingModel/ShadingModelFrag_DepthOnly.glsl"}
     };
 
     std::unordered_map<std::string, std::string> parameters;
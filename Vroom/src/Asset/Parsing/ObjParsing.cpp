@@ -0,0 +1,70 @@
+#include "Vroom/Asset/Parsing/ObjParsing.h"
+
+#include <OBJ_Loader/OBJ_Loader.h>
+
+#include "Vroom/Core/Log.h"
+
+namespace vrm
+{
+
+bool ObjParsing::Parse(const std::string& filePath, std::vector<SubMesh>& subMeshes)
+{
+    objl::Loader loader;
+    if (!loader.LoadFile(filePath))
+        return false;
+
+    std::string fileDirectoryPath;
+    size_t lastSlashIndex = filePath.find_last_of('/');
+    if (lastSlashIndex != std::string::npos)
+    {
+        fileDirectoryPath = filePath.substr(0, lastSlashIndex + 1);
+    }
+    else
+    {
+        lastSlashIndex = filePath.find_last_of('\\');
+        if (lastSlashIndex != std::string::npos)
+        {
+            fileDirectoryPath = filePath.substr(0, lastSlashIndex + 1);
+        }
+    }
+
+    VRM_LOG_TRACE("| Parsing {} submeshes.", loader.LoadedMeshes.size());
+
+    subMeshes.reserve(subMeshes.size() + loader.LoadedMeshes.size());
+    for (const auto& mesh : loader.LoadedMeshes)
+    {
+        VRM_LOG_TRACE("| | SubMesh: {}", mesh.MeshName);
+        VRM_LOG_TRACE("| | | Vertices count: {}", mesh.Vertices.size());
+        VRM_LOG_TRACE("| | | Indices count: {}", mesh.Indices.size());
+        VRM_LOG_TRACE("| | | Material: {}", mesh.MaterialName);
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+
+        vertices.reserve(mesh.Vertices.size());
+        indices.reserve(mesh.Indices.size());
+
+        for (const auto& vertex : mesh.Vertices)
+        {
+            vertices.emplace_back(
+                Vertex{ 
+                    { vertex.Position.X         , vertex.Position.Y         , vertex.Position.Z },
+                    { vertex.Normal.X           , vertex.Normal.Y           , vertex.Normal.Z },
+                    { vertex.TextureCoordinate.X, vertex.TextureCoordinate.Y }
+                }
+            );
+        }
+
+        for (const auto& index : mesh.Indices)
+        {
+            indices.emplace_back(index);
+        }
+
+        std::string materialPath = mesh.MaterialName.empty() ? std::string() : fileDirectoryPath + mesh.MaterialName + ".asset";
+        subMeshes.push_back({ mesh.MeshName, MeshData(std::move(vertices), std::move(indices)), std::move(materialPath) });
+    }
+
+    return true;
+}
+
+} // namespace vrm
@@ -7,14 +7,17 @@
 
 #include "Vroom/Asset/AssetManager.h"
 #include "Vroom/Asset/Parsing/MaterialParsing.h"
+#include "Vroom/Render/Abstraction/ShaderSource.h"
 
 #include "Vroom/Asset/StaticAsset/TextureAsset.h"
 
 namespace vrm
 {
 
+uint32_t MaterialAsset::s_NextID = 0;
+
 MaterialAsset::MaterialAsset()
-    : StaticAsset()
+    : StaticAsset(), m_ID(s_NextID++)
 {
 }
 
@@ -39,13 +42,34 @@ bool MaterialAsset::loadImpl(const std::string& filePath)
         return false;
     }
 
+    // The packed vertex variant is only compiled once a packed mesh is drawn with this material
+    m_PackedVertexSource = ShaderSource::AddDefine(shadersData.vertex, "VRM_PACKED_VERTEX");
+    m_FragmentSource = std::move(shadersData.fragment);
+    m_FilePath = filePath;
+
     // Loading textures
     for (const std::string& texturePath : shadersData.texturePaths)
     {
         m_Textures.emplace_back(AssetManager::Get().getAsset<TextureAsset>(texturePath));
     }
 
+    // Combining texture ids, so that materials sharing their textures are sorted together
+    m_TextureSetID = 0;
+    for (const auto& texture : m_Textures)
+    {
+        uint32_t textureID = texture.getStaticAsset()->getGPUTexture().getRendererID();
+        m_TextureSetID = m_TextureSetID * 31u + textureID;
+    }
+
     return true;
 }
 
+void MaterialAsset::loadPackedShader() const
+{
+    const bool loaded = m_PackedShader.loadFromSource(m_PackedVertexSource, m_FragmentSource);
+    VRM_ASSERT_MSG(loaded, "Failed to load packed vertex variant of material: {}", m_FilePath);
+
+    m_PackedShaderLoaded = true;
+}
+
 } // namespace vrm
\ No newline at end of file
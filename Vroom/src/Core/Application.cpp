@@ -1,9 +1,16 @@
 #include "Vroom/Core/Application.h"
 
+#include <string_view>
+
 #include "Vroom/Core/Assert.h"
+#include "Vroom/Core/Profiler.h"
+#include "Vroom/Core/FrameStats.h"
 #include "Vroom/Event/GLFWEventsConverter.h"
 #include "Vroom/Core/Window.h"
+#include "Vroom/Render/Abstraction/GLCall.h"
 #include "Vroom/Render/Renderer.h"
+#include "Vroom/Render/RenderObject/GeometryPool.h"
+#include "Vroom/Render/Profiling/GPUProfiler.h"
 #include "Vroom/Core/GameLayer.h"
 #include "Vroom/Scene/Scene.h"
 #include "Vroom/Asset/AssetManager.h"
@@ -19,16 +26,30 @@ Application::Application(int argc, char** argv)
     VRM_ASSERT_MSG(s_Instance == nullptr, "Application already exists.");
     s_Instance = this;
 
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--headless")
+            m_Headless = true;
+    }
+
     Log::Init();
     GLFWEventsConverter::Init();
 
     VRM_ASSERT(initGLFW());
-    m_Window = std::make_unique<Window>();
-    VRM_ASSERT(m_Window->create("Vroom engine", 800, 600));
+    VRM_ASSERT(createWindow());
 
     glewExperimental = GL_TRUE;
-    VRM_ASSERT(glewInit() == GLEW_OK);
-    
+    GLenum glewStatus = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX cannot find a display with an EGL context, but OpenGL functions are loaded anyway
+    if (m_Headless && glewStatus == GLEW_ERROR_NO_GLX_DISPLAY)
+        glewStatus = GLEW_OK;
+#endif
+    VRM_ASSERT(glewStatus == GLEW_OK);
+
+    FrameStats::Init();
+    GPUProfiler::Init();
+    GeometryPool::Init();
     AssetManager::Init();
 
     Renderer::Init();
@@ -49,20 +70,53 @@ Application::~Application()
 
     Renderer::Shutdown();
     AssetManager::Shutdown();
+    GeometryPool::Shutdown();
+    GPUProfiler::Shutdown();
+    FrameStats::Shutdown();
     m_Window.release();
     glfwTerminate();
 }
 
 bool Application::initGLFW()
 {
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    // The null platform needs no display server
+    if (m_Headless && glfwPlatformSupported(GLFW_PLATFORM_NULL))
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+    if (m_Headless)
+        VRM_LOG_WARN("GLFW is older than 3.4, headless mode still needs a display server.");
+#endif
+
     if (!glfwInit()) return false;
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
 
+    if (m_Headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
     return true;
 }
 
+bool Application::createWindow()
+{
+    m_Window = std::make_unique<Window>();
+
+    if (!m_Headless)
+        return m_Window->create("Vroom engine", 800, 600);
+
+    // Surfaceless EGL first, then OSMesa, which both run on software rasterizers such as llvmpipe
+    for (int contextAPI : { GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API })
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextAPI);
+        if (m_Window->create("Vroom engine", 800, 600))
+            return true;
+    }
+
+    return false;
+}
+
 void Application::initLayers()
 {
     for (Layer& layer : m_LayerStack)
@@ -75,8 +129,16 @@ void Application::run()
 
     while (!m_PendingKilled)
     {
-        update();
-        draw();
+        const auto frameStart = std::chrono::steady_clock::now();
+        {
+            VRM_PROFILE_SCOPE("Frame");
+            update();
+            draw();
+        }
+        Profiler::EndFrame();
+
+        const std::chrono::duration<float, std::milli> frameTime = std::chrono::steady_clock::now() - frameStart;
+        FrameStats::Get().endFrame(frameTime.count());
     }
 }
 
@@ -87,6 +149,8 @@ void Application::exit()
 
 void Application::update()
 {
+    VRM_PROFILE_SCOPE("Application::update");
+
     auto now = std::chrono::high_resolution_clock::now();
     auto dt = static_cast<float>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_LastFrameTimePoint).count()) / 1'000'000'000.f;
     m_LastFrameTimePoint = now;
@@ -109,10 +173,26 @@ void Application::update()
 
 void Application::draw()
 {
+    VRM_PROFILE_SCOPE("Application::draw");
+
+    GPUProfiler::Get().beginFrame();
+    Renderer::Get().beginFrame();
+
     for (Layer& layer : m_LayerStack)
         layer.render();
 
-    m_Window->swapBuffers();
+    Renderer::Get().endFrame();
+    GPUProfiler::Get().endFrame();
+
+    // Without anything to present, waiting for the GPU keeps frame times meaningful
+    if (m_Headless)
+    {
+        GLCall(glFinish());
+    }
+    else
+    {
+        m_Window->swapBuffers();
+    }
 }
 
 } // namespace vrm
@@ -0,0 +1,183 @@
+#include "Vroom/Core/FrameStats.h"
+
+#include <algorithm>
+
+#include "Vroom/Core/Assert.h"
+
+namespace vrm
+{
+
+static constexpr std::array<std::string_view, FrameStats::CounterCount> COUNTER_NAMES = {
+    "draw_calls",
+    "program_binds",
+    "vertex_array_binds",
+    "texture_binds",
+    "triangles",
+    "visible_objects",
+    "culled_objects",
+    "lights_submitted",
+    "lights_culled",
+    "average_lights_per_cluster",
+    "max_lights_per_cluster",
+    "active_clusters",
+    "bytes_uploaded",
+    "entities_updated",
+    "scripts_updated",
+};
+
+std::unique_ptr<FrameStats> FrameStats::s_Instance = nullptr;
+
+FrameStats::FrameStats()
+    : m_History(HistoryFrames), m_FrameTimes(HistoryFrames)
+{
+}
+
+FrameStats::~FrameStats()
+{
+    stopRecording();
+}
+
+void FrameStats::Init()
+{
+    VRM_ASSERT_MSG(s_Instance == nullptr, "Frame statistics already initialized.");
+    s_Instance = std::make_unique<FrameStats>();
+}
+
+void FrameStats::Shutdown()
+{
+    s_Instance.reset();
+}
+
+FrameStats& FrameStats::Get()
+{
+    VRM_ASSERT_MSG(s_Instance != nullptr, "Frame statistics not initialized.");
+    return *s_Instance;
+}
+
+bool FrameStats::IsInitialized()
+{
+    return s_Instance != nullptr;
+}
+
+std::string_view FrameStats::GetCounterName(Counter counter)
+{
+    VRM_DEBUG_ASSERT_MSG(counter != Counter::Count, "Invalid frame statistics counter.");
+    return COUNTER_NAMES[static_cast<size_t>(counter)];
+}
+
+void FrameStats::endFrame(float frameTime)
+{
+    Frame& frame = m_History[m_Next];
+    frame.index = m_FrameIndex++;
+    frame.frameTime = frameTime;
+    frame.counters = m_Current;
+
+    m_Next = (m_Next + 1) % m_History.size();
+    m_Count = std::min(m_Count + 1, m_History.size());
+    m_FrameTimes.push(frameTime);
+
+    if (m_Recording.is_open())
+    {
+        WriteFrame(m_Recording, m_RecordingFormat, frame, !m_RecordedFrame);
+        m_RecordedFrame = true;
+    }
+
+    m_Current.fill(0.0);
+}
+
+const FrameStats::Frame& FrameStats::getFrame(size_t i) const
+{
+    VRM_DEBUG_ASSERT_MSG(i < m_Count, "Frame {} is out of the frame statistics history.", i);
+    return m_History[(m_Next + m_History.size() - m_Count + i) % m_History.size()];
+}
+
+const FrameStats::Frame& FrameStats::getLastFrame() const
+{
+    return m_History[(m_Next + m_History.size() - 1) % m_History.size()];
+}
+
+void FrameStats::clear()
+{
+    m_Current.fill(0.0);
+    m_History.assign(m_History.size(), Frame());
+    m_Next = 0;
+    m_Count = 0;
+    m_FrameTimes.clear();
+}
+
+void FrameStats::write(std::ostream& stream, Format format) const
+{
+    WriteHeader(stream, format);
+    for (size_t i = 0; i < m_Count; ++i)
+        WriteFrame(stream, format, getFrame(i), i == 0);
+    WriteFooter(stream, format);
+}
+
+bool FrameStats::startRecording(const std::string& filePath, Format format)
+{
+    stopRecording();
+
+    m_Recording.open(filePath, std::ios::out | std::ios::trunc);
+    if (!m_Recording.is_open())
+    {
+        VRM_LOG_ERROR("Failed to open frame statistics file: {}", filePath);
+        return false;
+    }
+
+    m_RecordingFormat = format;
+    m_RecordedFrame = false;
+    WriteHeader(m_Recording, m_RecordingFormat);
+    return true;
+}
+
+void FrameStats::stopRecording()
+{
+    if (!m_Recording.is_open())
+        return;
+
+    WriteFooter(m_Recording, m_RecordingFormat);
+    m_Recording.close();
+}
+
+void FrameStats::WriteHeader(std::ostream& stream, Format format)
+{
+    if (format == Format::JSON)
+    {
+        stream << "[";
+        return;
+    }
+
+    stream << "frame,frame_time_ms";
+    for (auto name : COUNTER_NAMES)
+        stream << ',' << name;
+    stream << '\n';
+}
+
+void FrameStats::WriteFrame(std::ostream& stream, Format format, const Frame& frame, bool first)
+{
+    if (format == Format::JSON)
+        stream << (first ? "\n" : ",\n") << "{\"frame\":" << frame.index << ",\"frame_time_ms\":" << frame.frameTime;
+    else
+        stream << frame.index << ',' << frame.frameTime;
+
+    // Enough digits to write byte counts in full rather than in scientific notation
+    const auto precision = stream.precision(15);
+    for (size_t i = 0; i < CounterCount; ++i)
+    {
+        if (format == Format::JSON)
+            stream << ",\"" << COUNTER_NAMES[i] << "\":" << frame.counters[i];
+        else
+            stream << ',' << frame.counters[i];
+    }
+    stream.precision(precision);
+
+    stream << (format == Format::JSON ? "}" : "\n");
+}
+
+void FrameStats::WriteFooter(std::ostream& stream, Format format)
+{
+    if (format == Format::JSON)
+        stream << "\n]\n";
+}
+
+} // namespace vrm
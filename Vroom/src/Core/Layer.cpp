@@ -1,5 +1,7 @@
 #include "Vroom/Core/Layer.h"
 
+#include "Vroom/Core/Profiler.h"
+
 namespace vrm
 {
 
@@ -15,12 +17,14 @@ void Layer::end()
 
 void Layer::update(float dt)
 {
+    VRM_PROFILE_SCOPE("Layer::update");
     if (m_ShouldUpdate)
         onUpdate(dt);
 }
 
 void Layer::render()
 {
+    VRM_PROFILE_SCOPE("Layer::render");
     if (m_ShouldRender)
         onRender();
 }
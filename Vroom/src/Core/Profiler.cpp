@@ -0,0 +1,234 @@
+#include "Vroom/Core/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+#include "Vroom/Core/Log.h"
+
+namespace vrm
+{
+
+namespace
+{
+
+/**
+ * @brief Events of one thread. The lock is only contended while the main thread collects or clears events.
+ */
+struct ThreadBuffer
+{
+    std::mutex mutex;
+    std::vector<Profiler::Event> events;
+    uint32_t threadID = 0;
+};
+
+struct ProfilerState
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t nextThreadID = 0;
+
+    size_t captureFramesLeft = 0;
+    std::string capturePath;
+};
+
+ProfilerState& GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+std::atomic<bool> s_Enabled = true;
+thread_local uint32_t t_Depth = 0;
+
+ThreadBuffer& GetThreadBuffer()
+{
+    // Buffers are shared with the global state, so that events of finished threads can still be exported
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []()
+    {
+        auto newBuffer = std::make_shared<ThreadBuffer>();
+        auto& state = GetState();
+        std::lock_guard lock(state.mutex);
+        newBuffer->threadID = state.nextThreadID++;
+        state.buffers.push_back(newBuffer);
+        return newBuffer;
+    }();
+    return *buffer;
+}
+
+void WriteJSONString(std::ostream& stream, const char* value)
+{
+    stream << '"';
+    for (const char* c = value; *c; ++c)
+    {
+        switch (*c)
+        {
+        case '"': stream << "\\\""; break;
+        case '\\': stream << "\\\\"; break;
+        case '\n': stream << "\\n"; break;
+        case '\t': stream << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(*c) >= 0x20)
+                stream << *c;
+            break;
+        }
+    }
+    stream << '"';
+}
+
+} // namespace
+
+void Profiler::SetEnabled(bool enabled)
+{
+    s_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+    return s_Enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::EndFrame()
+{
+    auto& state = GetState();
+
+    std::string capturePath;
+    {
+        std::lock_guard lock(state.mutex);
+        if (state.captureFramesLeft > 0)
+        {
+            if (--state.captureFramesLeft > 0)
+                return;
+            capturePath = std::move(state.capturePath);
+        }
+    }
+
+    if (!capturePath.empty())
+    {
+        std::ofstream file(capturePath, std::ios::out | std::ios::trunc);
+        if (file.is_open())
+        {
+            WriteChromeTrace(file, CollectEvents());
+            VRM_LOG_INFO("Profiler capture written to: {}", capturePath);
+        }
+        else
+        {
+            VRM_LOG_ERROR("Failed to open profiler capture file: {}", capturePath);
+        }
+    }
+
+    Clear();
+}
+
+void Profiler::CaptureFrames(size_t frameCount, const std::string& filePath)
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    state.captureFramesLeft = frameCount;
+    state.capturePath = filePath;
+}
+
+bool Profiler::IsCapturing()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    return state.captureFramesLeft > 0;
+}
+
+std::vector<Profiler::Event> Profiler::CollectEvents()
+{
+    auto& state = GetState();
+    std::vector<Event> events;
+
+    std::lock_guard lock(state.mutex);
+    for (const auto& buffer : state.buffers)
+    {
+        std::lock_guard bufferLock(buffer->mutex);
+        events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+    }
+
+    // Parents first when starting at the same time, as trace viewers expect
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b)
+    {
+        return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+    });
+    return events;
+}
+
+void Profiler::Clear()
+{
+    auto& state = GetState();
+    std::lock_guard lock(state.mutex);
+    for (const auto& buffer : state.buffers)
+    {
+        std::lock_guard bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+void Profiler::WriteChromeTrace(std::ostream& stream, const std::vector<Event>& events)
+{
+    const int64_t origin = events.empty() ? 0 : events.front().start;
+
+    // Complete events ("X"), timestamps in microseconds. Nanoseconds are kept as decimals: with the default precision,
+    // timestamps past a second would be rounded to tens of microseconds, and nested events would overlap.
+    const auto flags = stream.flags();
+    const auto precision = stream.precision(3);
+    stream << std::fixed;
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const auto& event = events[i];
+        if (i > 0)
+            stream << ',';
+
+        stream << "\n{\"name\":";
+        WriteJSONString(stream, event.name);
+        stream << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.threadID
+            << ",\"ts\":" << static_cast<double>(event.start - origin) / 1000.0
+            << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << '}';
+    }
+    stream << "\n]}\n";
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void Profiler::Record(const char* name, int64_t start, int64_t end, uint32_t depth)
+{
+    auto& buffer = GetThreadBuffer();
+    std::lock_guard lock(buffer.mutex);
+    buffer.events.push_back({ name, start, end - start, buffer.threadID, depth });
+}
+
+int64_t Profiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : m_Name(name), m_Start(0), m_Active(Profiler::IsEnabled())
+{
+    if (!m_Active)
+        return;
+
+    t_Depth++;
+    m_Start = Profiler::Now();
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (!m_Active)
+        return;
+
+    const int64_t end = Profiler::Now();
+    t_Depth--;
+    Profiler::Record(m_Name, m_Start, end, t_Depth);
+}
+
+} // namespace vrm
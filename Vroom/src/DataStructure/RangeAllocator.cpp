@@ -0,0 +1,125 @@
+#include "Vroom/DataStructure/RangeAllocator.h"
+
+#include <algorithm>
+
+#include "Vroom/Core/Assert.h"
+
+namespace vrm
+{
+
+RangeAllocator::RangeAllocator(size_t capacity)
+    : m_Capacity(capacity)
+{
+    if (capacity > 0)
+        m_FreeRanges.emplace(0, capacity);
+}
+
+std::optional<size_t> RangeAllocator::allocate(size_t size)
+{
+    VRM_DEBUG_ASSERT_MSG(size > 0, "Cannot allocate an empty range.");
+
+    for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+    {
+        auto [offset, rangeSize] = *it;
+        if (rangeSize < size)
+            continue;
+
+        m_FreeRanges.erase(it);
+        if (rangeSize > size)
+            m_FreeRanges.emplace(offset + size, rangeSize - size);
+
+        m_Used += size;
+        return offset;
+    }
+
+    return std::nullopt;
+}
+
+void RangeAllocator::free(size_t offset, size_t size)
+{
+    VRM_DEBUG_ASSERT_MSG(offset + size <= m_Capacity, "Freed range is out of the allocator capacity.");
+    VRM_DEBUG_ASSERT_MSG(size <= m_Used, "Freeing more than what is allocated.");
+
+    m_Used -= size;
+
+    auto next = m_FreeRanges.lower_bound(offset);
+    VRM_DEBUG_ASSERT_MSG(next == m_FreeRanges.end() || next->first >= offset + size, "Freed range overlaps a free range.");
+
+    // Merging with the previous free range
+    if (next != m_FreeRanges.begin())
+    {
+        auto previous = std::prev(next);
+        VRM_DEBUG_ASSERT_MSG(previous->first + previous->second <= offset, "Freed range overlaps a free range.");
+        if (previous->first + previous->second == offset)
+        {
+            offset = previous->first;
+            size += previous->second;
+            m_FreeRanges.erase(previous);
+        }
+    }
+
+    // Merging with the next free range
+    if (next != m_FreeRanges.end() && offset + size == next->first)
+    {
+        size += next->second;
+        m_FreeRanges.erase(next);
+    }
+
+    m_FreeRanges.emplace(offset, size);
+}
+
+void RangeAllocator::grow(size_t capacity)
+{
+    if (capacity <= m_Capacity)
+        return;
+
+    const size_t oldCapacity = m_Capacity;
+    m_Capacity = capacity;
+
+    // Appending the new space as a free range, which merges with a trailing free range if any
+    m_Used += capacity - oldCapacity;
+    free(oldCapacity, capacity - oldCapacity);
+}
+
+void RangeAllocator::shrink(size_t capacity)
+{
+    capacity = std::max(capacity, getUsedEnd());
+    if (capacity >= m_Capacity)
+        return;
+
+    // Only the trailing free range lies beyond the used end
+    auto last = std::prev(m_FreeRanges.end());
+    const size_t offset = last->first;
+    m_FreeRanges.erase(last);
+    if (capacity > offset)
+        m_FreeRanges.emplace(offset, capacity - offset);
+
+    m_Capacity = capacity;
+}
+
+void RangeAllocator::clear()
+{
+    m_FreeRanges.clear();
+    m_Used = 0;
+    if (m_Capacity > 0)
+        m_FreeRanges.emplace(0, m_Capacity);
+}
+
+size_t RangeAllocator::getLargestFreeRange() const
+{
+    size_t largest = 0;
+    for (const auto& [offset, size] : m_FreeRanges)
+        largest = std::max(largest, size);
+    return largest;
+}
+
+size_t RangeAllocator::getUsedEnd() const
+{
+    if (m_FreeRanges.empty())
+        return m_Capacity;
+
+    const auto& [offset, size] = *m_FreeRanges.rbegin();
+    return offset + size == m_Capacity ? offset : m_Capacity;
+}
+
+} // namespace vrm
@@ -0,0 +1,71 @@
+#include "Vroom/DataStructure/RollingStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "Vroom/Core/Assert.h"
+
+namespace vrm
+{
+
+RollingStatistics::RollingStatistics(size_t windowSize)
+    : m_Samples(windowSize, 0.f)
+{
+    VRM_ASSERT_MSG(windowSize > 0, "Rolling statistics window must hold at least one sample.");
+}
+
+void RollingStatistics::push(float value)
+{
+    m_Samples[m_Next] = value;
+    m_Next = (m_Next + 1) % m_Samples.size();
+    m_Count = std::min(m_Count + 1, m_Samples.size());
+    m_Last = value;
+}
+
+void RollingStatistics::clear()
+{
+    m_Next = 0;
+    m_Count = 0;
+    m_Last = 0.f;
+}
+
+// Samples live in the first m_Count slots until the window is full, then in every slot.
+
+float RollingStatistics::getMin() const
+{
+    if (m_Count == 0)
+        return 0.f;
+    return *std::min_element(m_Samples.begin(), m_Samples.begin() + m_Count);
+}
+
+float RollingStatistics::getAverage() const
+{
+    if (m_Count == 0)
+        return 0.f;
+    return std::accumulate(m_Samples.begin(), m_Samples.begin() + m_Count, 0.f) / static_cast<float>(m_Count);
+}
+
+float RollingStatistics::getMax() const
+{
+    if (m_Count == 0)
+        return 0.f;
+    return *std::max_element(m_Samples.begin(), m_Samples.begin() + m_Count);
+}
+
+float RollingStatistics::getPercentile(float percentile) const
+{
+    if (m_Count == 0)
+        return 0.f;
+
+    // Nearest rank: the smallest sample with at least percentile % of the samples lower or equal to it
+    const float clamped = std::clamp(percentile, 0.f, 100.f);
+    const size_t rank = static_cast<size_t>(std::ceil(clamped / 100.f * static_cast<float>(m_Count)));
+    const size_t index = rank > 0 ? rank - 1 : 0;
+
+    std::vector<float> sorted(m_Samples.begin(), m_Samples.begin() + m_Count);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+} // namespace vrm
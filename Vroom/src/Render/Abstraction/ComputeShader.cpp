@@ -3,6 +3,7 @@
 #include <fstream>
 
 #include "Vroom/Core/Log.h"
+#include "Vroom/Render/Abstraction/ShaderSource.h"
 
 static std::string LoadShader(const std::string& path)
 {
@@ -46,6 +47,15 @@ bool ComputeShader::loadFromFile(const std::string& filePath)
     return loadFromSource(source);
 }
 
+bool ComputeShader::loadFromFile(const std::string& filePath, const std::vector<std::string>& defines)
+{
+    std::string source = LoadShader(filePath);
+    for (const auto& define : defines)
+        source = vrm::ShaderSource::AddDefine(source, define);
+
+    return loadFromSource(source);
+}
+
 bool ComputeShader::loadFromSource(const std::string& source)
 {
     unload();
@@ -125,6 +135,15 @@ void ComputeShader::dispatchCustomBarrier(unsigned int x, unsigned int y, unsign
     GLCall(glMemoryBarrier(barrier));
 }
 
+void ComputeShader::dispatchIndirectCustomBarrier(unsigned int indirectBuffer, size_t offset, unsigned int barrier) const
+{
+    bind();
+    GLCall(glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, indirectBuffer));
+    GLCall(glDispatchComputeIndirect(static_cast<GLintptr>(offset)));
+    GLCall(glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0));
+    GLCall(glMemoryBarrier(barrier));
+}
+
 void ComputeShader::setUniform1i(const std::string& name, int value) const
 {
     GLCall(glUniform1i(getUniformLocation(name), value));
@@ -175,6 +194,16 @@ void ComputeShader::setUniformMat4f(const std::string& name, const glm::mat4& ma
     GLCall(glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]));
 }
 
+void ComputeShader::setUniform1ui(int location, unsigned int value) const
+{
+    GLCall(glUniform1ui(location, value));
+}
+
+void ComputeShader::setUniform4fv(int location, int count, const glm::vec4* values) const
+{
+    GLCall(glUniform4fv(location, count, &values[0][0]));
+}
+
 int ComputeShader::getUniformLocation(const std::string& name) const
 {
     if (m_UniformLocationCache.contains(name))
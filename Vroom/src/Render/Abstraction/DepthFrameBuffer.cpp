@@ -0,0 +1,57 @@
+#include "Vroom/Render/Abstraction/DepthFrameBuffer.h"
+
+#include "Vroom/Render/Abstraction/GLCall.h"
+
+namespace vrm
+{
+
+DepthFrameBuffer::DepthFrameBuffer()
+{
+}
+
+DepthFrameBuffer::~DepthFrameBuffer()
+{
+    GLCall_nothrow(glDeleteFramebuffers(1, &m_RendererID));
+}
+
+void DepthFrameBuffer::bind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glEnable(GL_DEPTH_TEST));
+    GLCall(glDisable(GL_BLEND));
+}
+
+void DepthFrameBuffer::unbind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void DepthFrameBuffer::resize(int width, int height)
+{
+    if (m_RendererID != 0 && m_DepthTexture.getWidth() == width && m_DepthTexture.getHeight() == height)
+        return;
+
+    if (m_RendererID == 0)
+    {
+        GLCall(glGenFramebuffers(1, &m_RendererID));
+    }
+
+    m_DepthTexture.create(width, height, Texture2D::Format::Depth);
+
+    // Attaching again, so that the frame buffer picks up the new storage of the texture
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthTexture.getRendererID(), 0));
+    GLCall(glDrawBuffer(GL_NONE));
+    GLCall(glReadBuffer(GL_NONE));
+
+    VRM_ASSERT_MSG(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Depth framebuffer is incomplete!");
+
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void DepthFrameBuffer::clear() const
+{
+    GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+}
+
+} // namespace vrm
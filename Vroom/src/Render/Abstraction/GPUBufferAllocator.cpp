@@ -0,0 +1,249 @@
+#include "Vroom/Render/Abstraction/GPUBufferAllocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Vroom/Core/FrameStats.h"
+#include "Vroom/Render/Abstraction/GLCall.h"
+
+namespace vrm
+{
+
+GPUBufferAllocator::GPUBufferAllocator(GLenum bindingTarget, size_t granularity)
+    : m_BindingTarget(bindingTarget), m_Granularity(granularity)
+{
+    VRM_ASSERT_MSG(granularity > 0, "GPU buffer allocator granularity must be greater than 0.");
+}
+
+GPUBufferAllocator::GPUBufferAllocator(GPUBufferAllocator&& other)
+    : m_BindingTarget(other.m_BindingTarget), m_Granularity(other.m_Granularity),
+      m_RendererID(std::exchange(other.m_RendererID, 0)), m_Ranges(std::move(other.m_Ranges)),
+      m_HasBindingPoint(other.m_HasBindingPoint), m_BindingPoint(other.m_BindingPoint),
+      m_SpareStorages(std::move(other.m_SpareStorages)),
+      m_GrewThisFrame(other.m_GrewThisFrame), m_QuietFrames(other.m_QuietFrames)
+{
+    other.m_Ranges = RangeAllocator();
+    other.m_SpareStorages.clear();
+    other.m_HasBindingPoint = false;
+}
+
+GPUBufferAllocator::~GPUBufferAllocator()
+{
+    releaseStorages();
+}
+
+GPUBufferAllocator& GPUBufferAllocator::operator=(GPUBufferAllocator&& other)
+{
+    if (this != &other)
+    {
+        releaseStorages();
+
+        m_BindingTarget = other.m_BindingTarget;
+        m_Granularity = other.m_Granularity;
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_Ranges = std::exchange(other.m_Ranges, RangeAllocator());
+        m_HasBindingPoint = std::exchange(other.m_HasBindingPoint, false);
+        m_BindingPoint = other.m_BindingPoint;
+        m_SpareStorages = std::move(other.m_SpareStorages);
+        other.m_SpareStorages.clear();
+        m_GrewThisFrame = other.m_GrewThisFrame;
+        m_QuietFrames = other.m_QuietFrames;
+    }
+
+    return *this;
+}
+
+size_t GPUBufferAllocator::allocate(size_t size)
+{
+    const size_t units = std::max<size_t>(toUnits(size), 1);
+
+    auto offset = m_Ranges.allocate(units);
+    if (!offset)
+    {
+        // Growing geometrically. The new space merges with a trailing free range, so capacity + units always fits.
+        const size_t capacity = m_Ranges.getCapacity();
+        reserve(std::max(capacity * 2, capacity + units) * m_Granularity);
+
+        offset = m_Ranges.allocate(units);
+        VRM_ASSERT_MSG(offset.has_value(), "GPU buffer allocation failed after growing.");
+    }
+
+    return *offset * m_Granularity;
+}
+
+void GPUBufferAllocator::free(size_t offset, size_t size)
+{
+    VRM_DEBUG_ASSERT_MSG(offset % m_Granularity == 0, "Freed offset is not a multiple of the granularity.");
+    m_Ranges.free(offset / m_Granularity, std::max<size_t>(toUnits(size), 1));
+}
+
+void GPUBufferAllocator::clear()
+{
+    m_Ranges.clear();
+}
+
+void GPUBufferAllocator::write(const void* data, size_t size, size_t offset)
+{
+    VRM_DEBUG_ASSERT_MSG(offset + size <= getCapacity(), "Writing out of the GPU buffer capacity.");
+    if (size == 0)
+        return;
+
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    FrameStats::Get().add(FrameStats::Counter::BytesUploaded, static_cast<double>(size));
+}
+
+void GPUBufferAllocator::reserve(size_t capacity, bool preserveContent)
+{
+    const size_t units = toUnits(capacity);
+    if (units <= m_Ranges.getCapacity())
+        return;
+
+    // The old storage is kept as a spare: a later shrink can move back into it
+    moveStorage(units, preserveContent ? getCapacity() : 0, true);
+    m_GrewThisFrame = true;
+}
+
+void GPUBufferAllocator::shrink(size_t capacity)
+{
+    const size_t units = std::max(toUnits(capacity), m_Ranges.getUsedEnd());
+    if (units >= m_Ranges.getCapacity())
+        return;
+
+    if (units == 0)
+    {
+        releaseStorages();
+        m_Ranges.shrink(0);
+        if (m_HasBindingPoint)
+        {
+            GLCall(glBindBufferBase(m_BindingTarget, m_BindingPoint, 0));
+        }
+        return;
+    }
+
+    // Spares are smaller than the current storage anyway, so it is deleted rather than kept
+    moveStorage(units, units * m_Granularity, false);
+}
+
+void GPUBufferAllocator::shrinkToFit()
+{
+    shrink(0);
+}
+
+void GPUBufferAllocator::endFrame(size_t keptSize)
+{
+    if (m_GrewThisFrame)
+    {
+        m_GrewThisFrame = false;
+        m_QuietFrames = 0;
+        return;
+    }
+
+    if (++m_QuietFrames < QuietFramesBeforeShrink)
+        return;
+
+    m_QuietFrames = 0;
+
+    // Keeping some headroom, so that the next allocations do not grow it back right away
+    const size_t usedEnd = std::max(getUsedEnd(), keptSize);
+    if (getCapacity() > 0 && usedEnd * 4 <= getCapacity())
+        shrink(usedEnd * 2);
+}
+
+void GPUBufferAllocator::setBindingPoint(unsigned int bindingPoint)
+{
+    m_BindingPoint = bindingPoint;
+    m_HasBindingPoint = true;
+    GLCall(glBindBufferBase(m_BindingTarget, m_BindingPoint, m_RendererID));
+}
+
+void GPUBufferAllocator::moveStorage(size_t units, size_t copySize, bool spareCurrent)
+{
+    Storage next = acquireStorage(units * m_Granularity);
+
+    if (m_RendererID != 0)
+    {
+        // Copying on the GPU, without any round trip through the CPU
+        copySize = std::min({ copySize, getCapacity(), next.capacity });
+        if (copySize > 0)
+        {
+            GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_RendererID));
+            GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, next.rendererID));
+            GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)copySize));
+            GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+            GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+        }
+
+        if (spareCurrent)
+        {
+            m_SpareStorages.push_back({ m_RendererID, getCapacity() });
+            if (m_SpareStorages.size() > MaxSpareStorages)
+            {
+                GLCall(glDeleteBuffers(1, &m_SpareStorages.front().rendererID));
+                m_SpareStorages.erase(m_SpareStorages.begin());
+            }
+        }
+        else
+        {
+            GLCall(glDeleteBuffers(1, &m_RendererID));
+        }
+    }
+
+    m_RendererID = next.rendererID;
+
+    // A reused spare may be a bit larger than requested
+    const size_t nextUnits = next.capacity / m_Granularity;
+    if (nextUnits > m_Ranges.getCapacity())
+        m_Ranges.grow(nextUnits);
+    else
+        m_Ranges.shrink(nextUnits);
+
+    if (m_HasBindingPoint)
+    {
+        GLCall(glBindBufferBase(m_BindingTarget, m_BindingPoint, m_RendererID));
+    }
+}
+
+GPUBufferAllocator::Storage GPUBufferAllocator::acquireStorage(size_t capacity)
+{
+    // Reusing the smallest spare that fits, unless it would waste more than half of its memory
+    auto best = m_SpareStorages.end();
+    for (auto it = m_SpareStorages.begin(); it != m_SpareStorages.end(); ++it)
+    {
+        if (it->capacity >= capacity && it->capacity <= capacity * 2 && (best == m_SpareStorages.end() || it->capacity < best->capacity))
+            best = it;
+    }
+
+    if (best != m_SpareStorages.end())
+    {
+        Storage storage = *best;
+        m_SpareStorages.erase(best);
+        return storage;
+    }
+
+    Storage storage = { 0, capacity };
+    GLCall(glGenBuffers(1, &storage.rendererID));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, storage.rendererID));
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)capacity, nullptr, GL_DYNAMIC_DRAW));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+    return storage;
+}
+
+void GPUBufferAllocator::releaseStorages()
+{
+    for (auto& spare : m_SpareStorages)
+    {
+        GLCall_nothrow(glDeleteBuffers(1, &spare.rendererID));
+    }
+    m_SpareStorages.clear();
+
+    if (m_RendererID != 0)
+    {
+        GLCall_nothrow(glDeleteBuffers(1, &m_RendererID));
+    }
+    m_RendererID = 0;
+}
+
+} // namespace vrm
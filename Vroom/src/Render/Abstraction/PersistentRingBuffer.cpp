@@ -0,0 +1,208 @@
+#include "Vroom/Render/Abstraction/PersistentRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Vroom/Core/FrameStats.h"
+#include "Vroom/Render/Abstraction/GLCall.h"
+
+static constexpr GLbitfield STORAGE_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// Waiting one second at most per call, so that a lost context does not hang forever without a message
+static constexpr GLuint64 FENCE_TIMEOUT_NS = 1'000'000'000;
+
+PersistentRingBuffer::PersistentRingBuffer(size_t frameCapacity)
+{
+    createStorage(frameCapacity);
+}
+
+PersistentRingBuffer::~PersistentRingBuffer()
+{
+    for (GLsync& fence : m_Fences)
+    {
+        if (fence)
+        {
+            GLCall_nothrow(glDeleteSync(fence));
+        }
+        fence = nullptr;
+    }
+
+    // The driver defers the actual deletion of buffers still used by the GPU
+    for (const auto& retired : m_RetiredStorages)
+    {
+        if (retired.fence)
+        {
+            GLCall_nothrow(glDeleteSync(retired.fence));
+        }
+        GLCall_nothrow(glDeleteBuffers(1, &retired.rendererID));
+    }
+    m_RetiredStorages.clear();
+
+    GLCall_nothrow(glDeleteBuffers(1, &m_RendererID));
+}
+
+void PersistentRingBuffer::beginFrame()
+{
+    m_FrameOffset = 0;
+
+    GLsync& fence = m_Fences[m_FrameIndex];
+    if (!fence)
+        return;
+
+    // The GPU should be done with a frame written FrameCount frames ago. If not, the CPU is too far ahead and must wait.
+    if (!WaitFence(fence, false))
+    {
+        m_StallCount++;
+        WaitFence(fence, true);
+    }
+
+    GLCall(glDeleteSync(fence));
+    fence = nullptr;
+}
+
+void PersistentRingBuffer::endFrame()
+{
+    GLCall(m_Fences[m_FrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    // Buffers replaced during this frame may still be read by its commands
+    for (auto& retired : m_RetiredStorages)
+    {
+        if (!retired.fence)
+        {
+            GLCall(retired.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        }
+    }
+
+    releaseRetiredStorages();
+
+    m_FrameIndex = (m_FrameIndex + 1) % FrameCount;
+    m_FrameOffset = 0;
+}
+
+PersistentRingBuffer::Allocation PersistentRingBuffer::allocate(size_t size, size_t alignment)
+{
+    VRM_DEBUG_ASSERT_MSG(alignment > 0 && (alignment & (alignment - 1)) == 0, "Ring buffer alignment must be a power of two.");
+
+    size_t offset = (m_FrameOffset + alignment - 1) & ~(alignment - 1);
+    if (offset + size > m_FrameCapacity)
+    {
+        size_t newCapacity = m_FrameCapacity * 2;
+        while (newCapacity < size)
+            newCapacity *= 2;
+
+        VRM_LOG_TRACE("Growing persistent ring buffer from {} to {} bytes per frame.", m_FrameCapacity, newCapacity);
+
+        retireStorage();
+        createStorage(newCapacity);
+        offset = 0;
+    }
+
+    m_FrameOffset = offset + size;
+
+    const size_t bufferOffset = static_cast<size_t>(m_FrameIndex) * m_FrameCapacity + offset;
+    return { m_MappedData + bufferOffset, bufferOffset, size, m_RendererID };
+}
+
+PersistentRingBuffer::Allocation PersistentRingBuffer::push(const void* data, size_t size, size_t alignment)
+{
+    Allocation allocation = allocate(size, alignment);
+    if (size > 0)
+        std::memcpy(allocation.data, data, size);
+
+    vrm::FrameStats::Get().add(vrm::FrameStats::Counter::BytesUploaded, static_cast<double>(size));
+    return allocation;
+}
+
+void PersistentRingBuffer::BindRange(GLenum target, unsigned int bindingPoint, const Allocation& allocation)
+{
+    VRM_DEBUG_ASSERT_MSG(allocation.size > 0, "Cannot bind an empty ring buffer allocation.");
+    GLCall(glBindBufferRange(target, bindingPoint, allocation.rendererID, (GLintptr)allocation.offset, (GLsizeiptr)allocation.size));
+}
+
+size_t PersistentRingBuffer::GetBindAlignment()
+{
+    static size_t alignment = 0;
+    if (alignment == 0)
+    {
+        GLint uniformAlignment = 0;
+        GLint storageAlignment = 0;
+        GLCall(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment));
+        GLCall(glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment));
+
+        // Alignments are powers of two, so the largest one satisfies both
+        alignment = static_cast<size_t>(std::max({ uniformAlignment, storageAlignment, GLint(16) }));
+    }
+    return alignment;
+}
+
+void PersistentRingBuffer::createStorage(size_t frameCapacity)
+{
+    // Each frame region starts on a bind alignment boundary
+    const size_t alignment = GetBindAlignment();
+    m_FrameCapacity = std::max((frameCapacity + alignment - 1) & ~(alignment - 1), alignment);
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>(m_FrameCapacity * FrameCount);
+
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+    GLCall(glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, STORAGE_FLAGS));
+    GLCall(void* mappedData = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, STORAGE_FLAGS));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    VRM_ASSERT_MSG(mappedData != nullptr, "Failed to map persistent ring buffer.");
+    m_MappedData = static_cast<std::byte*>(mappedData);
+}
+
+void PersistentRingBuffer::retireStorage()
+{
+    m_RetiredStorages.push_back({ m_RendererID, nullptr });
+
+    // Fences of previous frames guard the retired buffer only. The fence placed for it at the end of this frame
+    // is signaled after all of them, so they are not needed anymore.
+    for (GLsync& fence : m_Fences)
+    {
+        if (fence)
+        {
+            GLCall(glDeleteSync(fence));
+        }
+        fence = nullptr;
+    }
+
+    m_RendererID = 0;
+    m_MappedData = nullptr;
+}
+
+void PersistentRingBuffer::releaseRetiredStorages()
+{
+    std::erase_if(m_RetiredStorages, [](const RetiredStorage& retired)
+    {
+        if (!retired.fence || !WaitFence(retired.fence, false))
+            return false;
+
+        GLCall(glDeleteSync(retired.fence));
+        GLCall(glDeleteBuffers(1, &retired.rendererID));
+        return true;
+    });
+}
+
+bool PersistentRingBuffer::WaitFence(GLsync fence, bool wait)
+{
+    if (!wait)
+    {
+        GLCall(GLenum result = glClientWaitSync(fence, 0, 0));
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    while (true)
+    {
+        GLCall(GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS));
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            return true;
+        if (result == GL_WAIT_FAILED)
+        {
+            VRM_LOG_ERROR("Failed to wait for a ring buffer fence.");
+            return false;
+        }
+        VRM_LOG_WARN("Still waiting for the GPU to release a ring buffer frame.");
+    }
+}
@@ -0,0 +1,28 @@
+#include "Vroom/Render/Abstraction/ShaderSource.h"
+
+namespace vrm
+{
+
+std::string ShaderSource::AddDefine(const std::string& source, const std::string& define)
+{
+    // #version must stay the first directive, so the definition goes on the next line
+    size_t insertPosition = 0;
+    size_t versionPosition = source.find("#version");
+    if (versionPosition != std::string::npos)
+    {
+        size_t lineEnd = source.find('\n', versionPosition);
+        insertPosition = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+
+    std::string output = source;
+    if (insertPosition == output.size() && !output.empty() && output.back() != '\n')
+    {
+        output += '\n';
+        insertPosition = output.size();
+    }
+
+    output.insert(insertPosition, "#define " + define + '\n');
+    return output;
+}
+
+} // namespace vrm
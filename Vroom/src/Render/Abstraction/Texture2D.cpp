@@ -9,6 +9,7 @@ static constexpr GLenum toGLFormat(Texture2D::Format format)
     {
     case Texture2D::Format::RGB: return GL_RGB;
     case Texture2D::Format::RGBA: return GL_RGBA;
+    case Texture2D::Format::Depth: return GL_DEPTH_COMPONENT;
     default: return GL_RGB;
     }
 }
@@ -19,10 +20,16 @@ static constexpr GLenum toGLInternalFormat(Texture2D::Format format)
     {
     case Texture2D::Format::RGB: return GL_RGB8;
     case Texture2D::Format::RGBA: return GL_RGBA8;
+    case Texture2D::Format::Depth: return GL_DEPTH_COMPONENT32F;
     default: return GL_RGB8;
     }
 }
 
+static constexpr GLenum toGLType(Texture2D::Format format)
+{
+    return format == Texture2D::Format::Depth ? GL_FLOAT : GL_UNSIGNED_BYTE;
+}
+
 Texture2D::Texture2D()
 {
     GLCall(glGenTextures(1, &m_RendererID));
@@ -54,5 +61,5 @@ void Texture2D::create(int width, int height, Format format)
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, toGLInternalFormat(format), m_Width, m_Height, 0, toGLFormat(format), GL_UNSIGNED_BYTE, nullptr));
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, toGLInternalFormat(format), m_Width, m_Height, 0, toGLFormat(format), toGLType(format), nullptr));
 }
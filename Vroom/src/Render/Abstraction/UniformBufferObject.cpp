@@ -0,0 +1,90 @@
+#include "Vroom/Render/Abstraction/UniformBufferObject.h"
+
+#include "Vroom/Render/Abstraction/GLCall.h"
+
+UniformBufferObject::UniformBufferObject()
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+}
+
+UniformBufferObject::UniformBufferObject(UniformBufferObject&& other)
+    : m_RendererID(other.m_RendererID), m_Size(other.m_Size), m_HasBindingPoint(other.m_HasBindingPoint), m_BindingPoint(other.m_BindingPoint)
+{
+    other.m_RendererID = 0;
+    other.m_Size = 0;
+}
+
+UniformBufferObject::~UniformBufferObject()
+{
+    GLCall_nothrow(glDeleteBuffers(1, &m_RendererID));
+}
+
+UniformBufferObject& UniformBufferObject::operator=(UniformBufferObject&& other)
+{
+    if (this != &other)
+    {
+        this->~UniformBufferObject();
+        m_RendererID = other.m_RendererID;
+        m_Size = other.m_Size;
+        m_HasBindingPoint = other.m_HasBindingPoint;
+        m_BindingPoint = other.m_BindingPoint;
+        other.m_RendererID = 0;
+        other.m_Size = 0;
+    }
+
+    return *this;
+}
+
+void UniformBufferObject::bind() const
+{
+    GLCall(glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID));
+}
+
+void UniformBufferObject::unbind() const
+{
+    GLCall(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+void UniformBufferObject::setData(const void* data, int size)
+{
+    bind();
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW));
+    m_Size = size;
+}
+
+void UniformBufferObject::setSubData(const void* data, int size, int offset)
+{
+    bind();
+    GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+}
+
+void UniformBufferObject::setBindingPoint(unsigned int bindingPoint)
+{
+    m_BindingPoint = bindingPoint;
+    GLCall(glBindBufferBase(GL_UNIFORM_BUFFER, m_BindingPoint, m_RendererID));
+    m_HasBindingPoint = true;
+}
+
+void UniformBufferObject::setBindingPointRange(unsigned int bindingPoint, int offset, int size)
+{
+    m_BindingPoint = bindingPoint;
+    GLCall(glBindBufferRange(GL_UNIFORM_BUFFER, m_BindingPoint, m_RendererID, offset, size));
+    m_HasBindingPoint = true;
+}
+
+unsigned int UniformBufferObject::getBindingPoint() const
+{
+    return m_BindingPoint;
+}
+
+int UniformBufferObject::GetOffsetAlignment()
+{
+    static int alignment = 0;
+    if (alignment == 0)
+    {
+        GLCall(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+        if (alignment <= 0)
+            alignment = 256;
+    }
+    return alignment;
+}
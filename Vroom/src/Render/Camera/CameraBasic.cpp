@@ -39,6 +39,11 @@ const glm::mat4 &CameraBasic::getViewProjection() const
     return m_ViewProjection;
 }
 
+Frustum CameraBasic::getFrustum() const
+{
+    return Frustum::FromViewProjection(getViewProjection());
+}
+
 glm::vec3 CameraBasic::getForwardVector() const
 {
     auto& v = getView();
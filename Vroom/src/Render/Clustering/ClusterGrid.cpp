@@ -0,0 +1,32 @@
+#include "Vroom/Render/Clustering/ClusterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vrm
+{
+
+glm::uvec3 ClusterGridSettings::getClusterCount(const glm::uvec2& viewportSize, const glm::mat4& projection, float near, float far) const
+{
+    const unsigned int tile = std::max(tileSize, 1u);
+    glm::uvec3 clusterCount;
+    clusterCount.x = std::max((viewportSize.x + tile - 1) / tile, 1u);
+    clusterCount.y = std::max((viewportSize.y + tile - 1) / tile, 1u);
+
+    unsigned int slices = depthSlices;
+    if (depthSlicing == DepthSlicing::MatchTiles && far > near && near > 0.f)
+    {
+        // A slice starting at depth d ends at d * (1 + tile height / d), the tile height growing with the depth as
+        // 2 * tan(fov / 2) * d / yCount. Slices are exponential, so they all have the same ratio.
+        const float tanHalfFov = 1.f / projection[1][1];
+        const float sliceRatio = 1.f + 2.f * tanHalfFov / static_cast<float>(clusterCount.y);
+        slices = static_cast<unsigned int>(std::ceil(std::log(far / near) / std::log(sliceRatio)));
+    }
+
+    const unsigned int tileCount = clusterCount.x * clusterCount.y;
+    const unsigned int maxSlices = std::max(MaxClusterCount / tileCount, 1u);
+    clusterCount.z = std::clamp(slices, 1u, std::min(MaxDepthSlices, maxSlices));
+    return clusterCount;
+}
+
+} // namespace vrm
@@ -0,0 +1,74 @@
+#include "Vroom/Render/Clustering/ClusterGridTuner.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Vroom/Core/Assert.h"
+
+namespace vrm
+{
+
+std::vector<ClusterGridSettings> ClusterGridTuner::GetDefaultCandidates()
+{
+    std::vector<ClusterGridSettings> candidates;
+    for (unsigned int tileSize : { 64u, 96u, 128u, 192u, 256u })
+    {
+        for (unsigned int depthSlices : { 16u, 24u, 32u })
+            candidates.push_back({ tileSize, DepthSlicing::Fixed, depthSlices });
+    }
+    return candidates;
+}
+
+void ClusterGridTuner::start(std::vector<ClusterGridSettings> candidates, unsigned int settleFrames, unsigned int measureFrames)
+{
+    VRM_ASSERT_MSG(!candidates.empty(), "Cluster grid tuning needs at least one candidate.");
+
+    m_Candidates = std::move(candidates);
+    m_Results.clear();
+    m_CandidateIndex = 0;
+    m_SettleFrames = settleFrames;
+    m_MeasureFrames = std::max(measureFrames, 1u);
+    m_Frame = 0;
+    m_MeasuredMilliseconds = 0.0;
+    m_Running = true;
+}
+
+void ClusterGridTuner::stop()
+{
+    m_Running = false;
+}
+
+void ClusterGridTuner::pushFrame(float milliseconds)
+{
+    if (!m_Running)
+        return;
+
+    if (m_Frame >= m_SettleFrames)
+        m_MeasuredMilliseconds += milliseconds;
+
+    if (++m_Frame < m_SettleFrames + m_MeasureFrames)
+        return;
+
+    m_Results.push_back({ m_Candidates[m_CandidateIndex], static_cast<float>(m_MeasuredMilliseconds / m_MeasureFrames) });
+    m_Frame = 0;
+    m_MeasuredMilliseconds = 0.0;
+
+    // The last candidate stays current until the settings are changed
+    if (m_CandidateIndex + 1 < m_Candidates.size())
+        m_CandidateIndex++;
+    else
+        m_Running = false;
+}
+
+bool ClusterGridTuner::getBestSettings(ClusterGridSettings& settings) const
+{
+    if (m_Results.empty())
+        return false;
+
+    const auto best = std::min_element(m_Results.begin(), m_Results.end(),
+        [](const Result& a, const Result& b) { return a.milliseconds < b.milliseconds; });
+    settings = best->settings;
+    return true;
+}
+
+} // namespace vrm
@@ -0,0 +1,453 @@
+#include "Vroom/Render/Clustering/ClusterLightCuller.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Vroom/Core/Assert.h"
+#include "Vroom/Render/RawShaderData/SSBOPointLightData.h"
+#include "Vroom/Render/RawShaderData/SSBOSpotLightData.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define VRM_CLUSTER_CULLING_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define VRM_CLUSTER_CULLING_SSE
+#endif
+
+namespace vrm
+{
+
+// Lights closer than this to a cluster center all count as this close, as in the compute shaders
+static constexpr float MIN_IMPORTANCE_DISTANCE_SQUARED = 1e-4f;
+
+// Intersection of the line from the view origin towards a point, with the plane at a given view depth
+static glm::vec3 IntersectionWithDepthPlane(const glm::vec3& direction, float depth)
+{
+    return (depth / -direction.z) * direction;
+}
+
+// Whether a cone, of angle under 90 degrees, touches a sphere: the sphere must be close enough to the cone side, and not
+// behind its apex. Same test as in the compute shaders.
+static bool ConeTouchesSphere(const glm::vec3& apex, const glm::vec3& direction, float cosAngle, float sinAngle, const glm::vec3& center, float radius)
+{
+    const glm::vec3 toCenter = center - apex;
+    const float alongAxis = glm::dot(toCenter, direction);
+    const float fromAxis = std::sqrt(std::max(glm::dot(toCenter, toCenter) - alongAxis * alongAxis, 0.f));
+    const float distanceToCone = cosAngle * fromAxis - sinAngle * alongAxis;
+    return distanceToCone <= radius && alongAxis >= -radius;
+}
+
+template <typename LightData>
+static int ReadLightCount(const std::vector<std::byte>& block)
+{
+    VRM_ASSERT_MSG(block.size() >= sizeof(int), "Light block has no light count.");
+
+    int lightCount = 0;
+    std::memcpy(&lightCount, block.data(), sizeof(int));
+    VRM_ASSERT_MSG(block.size() >= sizeof(int) + lightCount * sizeof(LightData), "Light block is smaller than its light count.");
+    return lightCount;
+}
+
+// Threads waiting for ranges of clusters to cull, so that no thread is created per cull
+class ClusterLightCuller::WorkerPool
+{
+public:
+    using Job = std::function<void(size_t)>;
+
+public:
+    explicit WorkerPool(size_t threadCount)
+    {
+        m_Threads.reserve(threadCount);
+        for (size_t thread = 0; thread < threadCount; ++thread)
+            m_Threads.emplace_back([this, thread] { work(thread + 1); });
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_JobReady.notify_all();
+
+        for (auto& thread : m_Threads)
+            thread.join();
+    }
+
+    inline size_t getThreadCount() const { return m_Threads.size(); }
+
+    /**
+     * @brief Runs a job for each worker, and waits for all of them. The calling thread is worker 0, and the pool threads
+     * are the next ones.
+     *
+     * @param workerCount The number of workers, up to the thread count plus one.
+     * @param job The job, called with the worker index.
+     */
+    void run(size_t workerCount, const Job& job)
+    {
+        VRM_DEBUG_ASSERT_MSG(workerCount >= 1 && workerCount <= m_Threads.size() + 1, "Not enough threads in the worker pool.");
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Job = &job;
+            m_JobWorkerCount = workerCount;
+            m_PendingWorkers = workerCount - 1;
+            ++m_Generation;
+        }
+        m_JobReady.notify_all();
+
+        job(0);
+
+        std::unique_lock lock(m_Mutex);
+        m_JobDone.wait(lock, [this] { return m_PendingWorkers == 0; });
+        m_Job = nullptr;
+    }
+
+private:
+    void work(size_t worker)
+    {
+        uint64_t doneGeneration = 0;
+        while (true)
+        {
+            const Job* job = nullptr;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_JobReady.wait(lock, [&] { return m_Stopping || m_Generation != doneGeneration; });
+                if (m_Stopping)
+                    return;
+
+                // Workers past the job worker count sit this job out
+                doneGeneration = m_Generation;
+                if (worker >= m_JobWorkerCount)
+                    continue;
+                job = m_Job;
+            }
+
+            (*job)(worker);
+
+            std::lock_guard lock(m_Mutex);
+            if (--m_PendingWorkers == 0)
+                m_JobDone.notify_one();
+        }
+    }
+
+private:
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_JobReady, m_JobDone;
+    const Job* m_Job = nullptr;
+    size_t m_JobWorkerCount = 0;
+    size_t m_PendingWorkers = 0;
+    // Incremented for each job, so that a worker runs each one once
+    uint64_t m_Generation = 0;
+    bool m_Stopping = false;
+};
+
+ClusterLightCuller::ClusterLightCuller()
+{
+    setWorkerCount(std::thread::hardware_concurrency());
+}
+
+ClusterLightCuller::ClusterLightCuller(ClusterLightCuller&&) = default;
+
+ClusterLightCuller::~ClusterLightCuller() = default;
+
+ClusterLightCuller& ClusterLightCuller::operator=(ClusterLightCuller&&) = default;
+
+void ClusterLightCuller::setWorkerCount(unsigned int workerCount)
+{
+    m_WorkerCount = std::max(workerCount, 1u);
+
+    if (m_WorkerPool && m_WorkerPool->getThreadCount() != m_WorkerCount - 1)
+        m_WorkerPool.reset();
+}
+
+void ClusterLightCuller::setClusterLightLimit(unsigned int clusterLightLimit)
+{
+    m_ClusterLightLimit = std::max(clusterLightLimit, 1u);
+}
+
+void ClusterLightCuller::buildClusters(const glm::uvec3& clusterCount, const glm::mat4& projection, float near, float far)
+{
+    m_ClusterCount = clusterCount;
+    m_Near = near;
+    m_Far = far;
+    m_Clusters.assign(static_cast<size_t>(clusterCount.x) * clusterCount.y * clusterCount.z, SSBOCluster());
+
+    const glm::mat4 invProjection = glm::inverse(projection);
+    const glm::vec2 clusterSize_NDC = { 2.f / clusterCount.x, 2.f / clusterCount.y };
+
+    for (unsigned int z = 0; z < clusterCount.z; ++z)
+    {
+        const float nearDepth = near * std::pow(far / near, static_cast<float>(z) / clusterCount.z);
+        const float farDepth = near * std::pow(far / near, static_cast<float>(z + 1) / clusterCount.z);
+
+        for (unsigned int y = 0; y < clusterCount.y; ++y)
+        {
+            for (unsigned int x = 0; x < clusterCount.x; ++x)
+            {
+                // Tile corners on the near plane, in view space
+                const glm::vec4 nearBottomLeft4_VS = invProjection * glm::vec4(-1.f + x * clusterSize_NDC.x, -1.f + y * clusterSize_NDC.y, -1.f, 1.f);
+                const glm::vec4 farTopRight4_VS = invProjection * glm::vec4(-1.f + (x + 1) * clusterSize_NDC.x, -1.f + (y + 1) * clusterSize_NDC.y, -1.f, 1.f);
+                const glm::vec3 nearBottomLeft_VS = glm::vec3(nearBottomLeft4_VS) / nearBottomLeft4_VS.w;
+                const glm::vec3 farTopRight_VS = glm::vec3(farTopRight4_VS) / farTopRight4_VS.w;
+
+                const glm::vec3 nearMin = IntersectionWithDepthPlane(nearBottomLeft_VS, nearDepth);
+                const glm::vec3 nearMax = IntersectionWithDepthPlane(farTopRight_VS, nearDepth);
+                const glm::vec3 farMin = IntersectionWithDepthPlane(nearBottomLeft_VS, farDepth);
+                const glm::vec3 farMax = IntersectionWithDepthPlane(farTopRight_VS, farDepth);
+
+                auto& cluster = m_Clusters[x + y * clusterCount.x + z * clusterCount.x * clusterCount.y];
+                cluster.minAABB_VS = glm::vec4(glm::min(nearMin, farMin), 1.f);
+                cluster.maxAABB_VS = glm::vec4(glm::max(nearMax, farMax), 1.f);
+                cluster.lightOffset = 0;
+                cluster.lightCount = 0;
+            }
+        }
+    }
+}
+
+void ClusterLightCuller::cull(const glm::mat4& view, const std::vector<std::byte>& lightBlock, const std::vector<std::byte>& spotLightBlock)
+{
+    const int lightCount = ReadLightCount<SSBOPointLightData>(lightBlock);
+    const int spotLightCount = spotLightBlock.empty() ? 0 : ReadLightCount<SSBOSpotLightData>(spotLightBlock);
+
+    m_LightX.clear(); m_LightY.clear(); m_LightZ.clear(); m_LightRadius.clear(); m_LightPower.clear();
+    m_LightBlockIndices.clear();
+    m_SpotDirections.clear(); m_SpotCosAngles.clear(); m_SpotSinAngles.clear();
+
+    for (int i = 0; i < lightCount; ++i)
+    {
+        SSBOPointLightData light;
+        std::memcpy(&light, lightBlock.data() + sizeof(int) + i * sizeof(SSBOPointLightData), sizeof(SSBOPointLightData));
+
+        // Lights of null radius light nothing
+        if (light.radius <= 0.f)
+            continue;
+
+        const glm::vec3 center_VS = glm::vec3(view * glm::vec4(light.position, 1.f));
+        m_LightX.push_back(center_VS.x);
+        m_LightY.push_back(center_VS.y);
+        m_LightZ.push_back(center_VS.z);
+        m_LightRadius.push_back(light.radius);
+        m_LightPower.push_back(light.intensity * std::max({ light.color.r, light.color.g, light.color.b }));
+        m_LightBlockIndices.push_back(static_cast<unsigned int>(i));
+    }
+
+    m_PointLightCount = m_LightBlockIndices.size();
+    const glm::mat3 viewRotation = glm::mat3(view);
+    for (int i = 0; i < spotLightCount; ++i)
+    {
+        SSBOSpotLightData light;
+        std::memcpy(&light, spotLightBlock.data() + sizeof(int) + i * sizeof(SSBOSpotLightData), sizeof(SSBOSpotLightData));
+
+        if (light.radius <= 0.f)
+            continue;
+
+        const glm::vec3 apex_VS = glm::vec3(view * glm::vec4(light.position, 1.f));
+        m_LightX.push_back(apex_VS.x);
+        m_LightY.push_back(apex_VS.y);
+        m_LightZ.push_back(apex_VS.z);
+        m_LightRadius.push_back(light.radius);
+        m_LightPower.push_back(light.intensity * std::max({ light.color.r, light.color.g, light.color.b }));
+        m_LightBlockIndices.push_back(static_cast<unsigned int>(i) | SpotLightBit);
+
+        m_SpotDirections.push_back(viewRotation * light.direction);
+        m_SpotCosAngles.push_back(light.cosOuterAngle);
+        m_SpotSinAngles.push_back(std::sqrt(std::max(1.f - light.cosOuterAngle * light.cosOuterAngle, 0.f)));
+    }
+
+    // Each worker culls a contiguous range of clusters. The calling thread takes the first one.
+    const size_t clusterCount = m_Clusters.size();
+    const size_t workerCount = std::max<size_t>(std::min<size_t>(m_WorkerCount, clusterCount), 1);
+    m_WorkerLightIndices.resize(workerCount);
+    m_WorkerMaxLightsPerCluster.assign(workerCount, 0);
+
+    auto rangeBegin = [&](size_t worker) { return clusterCount * worker / workerCount; };
+
+    auto cullRange = [this, &rangeBegin](size_t worker)
+        { cullClusters(rangeBegin(worker), rangeBegin(worker + 1), m_WorkerLightIndices[worker], m_WorkerMaxLightsPerCluster[worker]); };
+
+    if (workerCount == 1)
+    {
+        cullRange(0);
+    }
+    else
+    {
+        if (!m_WorkerPool)
+            m_WorkerPool = std::make_unique<WorkerPool>(m_WorkerCount - 1);
+        m_WorkerPool->run(workerCount, cullRange);
+    }
+
+    // Cluster offsets were relative to the indices of their worker
+    m_LightIndices.clear();
+    m_MaxLightsPerCluster = 0;
+    for (size_t worker = 0; worker < workerCount; ++worker)
+    {
+        const unsigned int workerOffset = static_cast<unsigned int>(m_LightIndices.size());
+        for (size_t i = rangeBegin(worker); i < rangeBegin(worker + 1); ++i)
+            m_Clusters[i].lightOffset += workerOffset;
+        m_MaxLightsPerCluster = std::max(m_MaxLightsPerCluster, m_WorkerMaxLightsPerCluster[worker]);
+
+        m_LightIndices.insert(m_LightIndices.end(), m_WorkerLightIndices[worker].begin(), m_WorkerLightIndices[worker].end());
+    }
+}
+
+void ClusterLightCuller::markClusters(const glm::vec3& center_VS, float radius, std::vector<uint8_t>& clusterFlags) const
+{
+    VRM_ASSERT_MSG(clusterFlags.size() == m_Clusters.size(), "One flag per cluster is needed.");
+
+    // Only the depth slices the sphere spans are tested, with one more slice on each side against rounding
+    const float minDepth = std::max(-center_VS.z - radius, m_Near);
+    const float maxDepth = std::min(-center_VS.z + radius, m_Far);
+    if (radius <= 0.f || minDepth > maxDepth || m_Clusters.empty())
+        return;
+
+    const float slicesPerLog = m_ClusterCount.z / std::log(m_Far / m_Near);
+    auto slice = [&](float depth) { return static_cast<int>(std::floor(std::log(depth / m_Near) * slicesPerLog)); };
+    const unsigned int firstSlice = static_cast<unsigned int>(std::clamp(slice(minDepth) - 1, 0, static_cast<int>(m_ClusterCount.z) - 1));
+    const unsigned int lastSlice = static_cast<unsigned int>(std::clamp(slice(maxDepth) + 1, 0, static_cast<int>(m_ClusterCount.z) - 1));
+
+    const size_t sliceSize = static_cast<size_t>(m_ClusterCount.x) * m_ClusterCount.y;
+    for (size_t i = firstSlice * sliceSize; i < (lastSlice + 1) * sliceSize; ++i)
+    {
+        const glm::vec3 offset = glm::clamp(center_VS, glm::vec3(m_Clusters[i].minAABB_VS), glm::vec3(m_Clusters[i].maxAABB_VS)) - center_VS;
+        if (glm::dot(offset, offset) <= radius * radius)
+            clusterFlags[i] = 1;
+    }
+}
+
+void ClusterLightCuller::cullClusters(size_t begin, size_t end, std::vector<unsigned int>& lightIndices, unsigned int& maxLightsPerCluster)
+{
+    lightIndices.clear();
+    maxLightsPerCluster = 0;
+
+    const size_t lightCount = m_PointLightCount;
+    for (size_t clusterIndex = begin; clusterIndex < end; ++clusterIndex)
+    {
+        auto& cluster = m_Clusters[clusterIndex];
+        const size_t clusterOffset = lightIndices.size();
+        size_t processed = 0;
+
+        // A light touches the cluster when the point of the AABB closest to its center is within its radius.
+        // Lights are listed by their index in the structure of arrays until the limit is applied.
+#if defined(VRM_CLUSTER_CULLING_AVX)
+        const __m256 minX = _mm256_set1_ps(cluster.minAABB_VS.x), maxX = _mm256_set1_ps(cluster.maxAABB_VS.x);
+        const __m256 minY = _mm256_set1_ps(cluster.minAABB_VS.y), maxY = _mm256_set1_ps(cluster.maxAABB_VS.y);
+        const __m256 minZ = _mm256_set1_ps(cluster.minAABB_VS.z), maxZ = _mm256_set1_ps(cluster.maxAABB_VS.z);
+
+        for (; processed + 8 <= lightCount; processed += 8)
+        {
+            const __m256 lx = _mm256_loadu_ps(&m_LightX[processed]);
+            const __m256 ly = _mm256_loadu_ps(&m_LightY[processed]);
+            const __m256 lz = _mm256_loadu_ps(&m_LightZ[processed]);
+            const __m256 radius = _mm256_loadu_ps(&m_LightRadius[processed]);
+
+            const __m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(lx, minX), maxX), lx);
+            const __m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(ly, minY), maxY), ly);
+            const __m256 dz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(lz, minZ), maxZ), lz);
+            __m256 distanceSquared = _mm256_mul_ps(dx, dx);
+            distanceSquared = _mm256_add_ps(_mm256_mul_ps(dy, dy), distanceSquared);
+            distanceSquared = _mm256_add_ps(_mm256_mul_ps(dz, dz), distanceSquared);
+
+            unsigned int hitMask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radius, radius), _CMP_LE_OQ)));
+            for (; hitMask != 0; hitMask &= hitMask - 1)
+                lightIndices.push_back(static_cast<unsigned int>(processed + std::countr_zero(hitMask)));
+        }
+#elif defined(VRM_CLUSTER_CULLING_SSE)
+        const __m128 minX = _mm_set1_ps(cluster.minAABB_VS.x), maxX = _mm_set1_ps(cluster.maxAABB_VS.x);
+        const __m128 minY = _mm_set1_ps(cluster.minAABB_VS.y), maxY = _mm_set1_ps(cluster.maxAABB_VS.y);
+        const __m128 minZ = _mm_set1_ps(cluster.minAABB_VS.z), maxZ = _mm_set1_ps(cluster.maxAABB_VS.z);
+
+        for (; processed + 4 <= lightCount; processed += 4)
+        {
+            const __m128 lx = _mm_loadu_ps(&m_LightX[processed]);
+            const __m128 ly = _mm_loadu_ps(&m_LightY[processed]);
+            const __m128 lz = _mm_loadu_ps(&m_LightZ[processed]);
+            const __m128 radius = _mm_loadu_ps(&m_LightRadius[processed]);
+
+            const __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(lx, minX), maxX), lx);
+            const __m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(ly, minY), maxY), ly);
+            const __m128 dz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(lz, minZ), maxZ), lz);
+            __m128 distanceSquared = _mm_mul_ps(dx, dx);
+            distanceSquared = _mm_add_ps(_mm_mul_ps(dy, dy), distanceSquared);
+            distanceSquared = _mm_add_ps(_mm_mul_ps(dz, dz), distanceSquared);
+
+            unsigned int hitMask = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(radius, radius))));
+            for (; hitMask != 0; hitMask &= hitMask - 1)
+                lightIndices.push_back(static_cast<unsigned int>(processed + std::countr_zero(hitMask)));
+        }
+#endif
+
+        // Remaining lights, or every light without SIMD support
+        const glm::vec3 aabbMin = glm::vec3(cluster.minAABB_VS);
+        const glm::vec3 aabbMax = glm::vec3(cluster.maxAABB_VS);
+        for (; processed < lightCount; ++processed)
+        {
+            const glm::vec3 center = { m_LightX[processed], m_LightY[processed], m_LightZ[processed] };
+            const glm::vec3 offset = glm::clamp(center, aabbMin, aabbMax) - center;
+            if (glm::dot(offset, offset) <= m_LightRadius[processed] * m_LightRadius[processed])
+                lightIndices.push_back(static_cast<unsigned int>(processed));
+        }
+
+        // Spot lights: range sphere against the AABB, then cone against the bounding sphere of the AABB
+        const glm::vec3 aabbCenter = 0.5f * (aabbMin + aabbMax);
+        const float aabbRadius = 0.5f * glm::length(aabbMax - aabbMin);
+        for (size_t light = m_PointLightCount; light < m_LightBlockIndices.size(); ++light)
+        {
+            const glm::vec3 apex = { m_LightX[light], m_LightY[light], m_LightZ[light] };
+            const glm::vec3 offset = glm::clamp(apex, aabbMin, aabbMax) - apex;
+            if (glm::dot(offset, offset) > m_LightRadius[light] * m_LightRadius[light])
+                continue;
+
+            const size_t spot = light - m_PointLightCount;
+            if (ConeTouchesSphere(apex, m_SpotDirections[spot], m_SpotCosAngles[spot], m_SpotSinAngles[spot], aabbCenter, aabbRadius))
+                lightIndices.push_back(static_cast<unsigned int>(light));
+        }
+
+        const unsigned int clusterLightCount = static_cast<unsigned int>(lightIndices.size() - clusterOffset);
+        maxLightsPerCluster = std::max(maxLightsPerCluster, clusterLightCount);
+        if (clusterLightCount > m_ClusterLightLimit)
+            keepMostImportantLights(cluster, lightIndices, clusterOffset);
+
+        for (size_t i = clusterOffset; i < lightIndices.size(); ++i)
+            lightIndices[i] = m_LightBlockIndices[lightIndices[i]];
+
+        cluster.lightOffset = static_cast<unsigned int>(clusterOffset);
+        cluster.lightCount = static_cast<unsigned int>(lightIndices.size() - clusterOffset);
+    }
+}
+
+void ClusterLightCuller::keepMostImportantLights(const SSBOCluster& cluster, std::vector<unsigned int>& lightIndices, size_t clusterOffset) const
+{
+    // Importance is the light intensity at the cluster center, attenuated by the squared distance
+    const glm::vec3 clusterCenter = 0.5f * (glm::vec3(cluster.minAABB_VS) + glm::vec3(cluster.maxAABB_VS));
+    auto importance = [&](unsigned int light)
+    {
+        const glm::vec3 offset = clusterCenter - glm::vec3(m_LightX[light], m_LightY[light], m_LightZ[light]);
+        return m_LightPower[light] / std::max(glm::dot(offset, offset), MIN_IMPORTANCE_DISTANCE_SQUARED);
+    };
+
+    // Lights are in block order, spot lights last as their index with SpotLightBit is the largest, so ties going to the
+    // lowest index here go to the lowest encoded index
+    const auto first = lightIndices.begin() + static_cast<std::ptrdiff_t>(clusterOffset);
+    std::nth_element(first, first + m_ClusterLightLimit, lightIndices.end(), [&](unsigned int a, unsigned int b)
+    {
+        const float importanceA = importance(a), importanceB = importance(b);
+        return importanceA > importanceB || (importanceA == importanceB && a < b);
+    });
+    lightIndices.resize(clusterOffset + m_ClusterLightLimit);
+}
+
+} // namespace vrm
@@ -1,24 +1,175 @@
 #include "Vroom/Render/Clustering/ClusteredLights.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+
 #include <glm/gtx/string_cast.hpp>
 
 #include "Vroom/Asset/AssetManager.h"
 #include "Vroom/Asset/StaticAsset/ComputeShaderAsset.h"
 #include "Vroom/Core/Application.h"
+#include "Vroom/Core/FrameStats.h"
+#include "Vroom/Core/Profiler.h"
+#include "Vroom/Render/Abstraction/GLCall.h"
+#include "Vroom/Render/Profiling/GPUProfiler.h"
 #include "Vroom/Scene/Scene.h"
 
 namespace vrm
 {
 
+// Binding of the ClusterStatisticsBlock of the light culling shader: total light indices, then maximum lights of a cluster
+static constexpr unsigned int STATISTICS_BINDING_POINT = 5;
+
+// Bindings of the active cluster list and of the cluster flags
+static constexpr int ACTIVE_CLUSTER_BINDING_POINT = 7;
+static constexpr int CLUSTER_FLAG_BINDING_POINT = 8;
+
+// Binding of the light counts of each cluster, used by light binning
+static constexpr int CLUSTER_LIGHT_COUNTER_BINDING_POINT = 9;
+
+// Header of the ActiveClusterBlock: culling work group counts, for the indirect dispatch, then active cluster count
+static constexpr GLuint ACTIVE_CLUSTER_HEADER[4] = { 0, 1, 1, 0 };
+static constexpr size_t ACTIVE_CLUSTER_COUNT_OFFSET = 3 * sizeof(GLuint);
+
+// Shared memory used per light by the shared memory culling kernel: view space center and radius
+static constexpr unsigned int SHARED_LIGHT_SIZE = 4 * sizeof(float);
+
+// Statistics read back: total light indices, maximum lights of a cluster, active cluster count, final light index count
+static constexpr size_t READBACK_VALUE_COUNT = 4;
+
+// Spheres of changed lights are slightly inflated to find the clusters to cull again, against rounding differences
+static constexpr float CHANGED_LIGHT_RADIUS_SCALE = 1.001f;
+static constexpr float CHANGED_LIGHT_RADIUS_MARGIN = 1e-3f;
+
+// Initial light index list size: clusters overlapped by a light, on average, before any statistics are read back
+static constexpr unsigned int ESTIMATED_CLUSTERS_PER_LIGHT = 16;
+static constexpr unsigned int MIN_LIGHT_INDEX_CAPACITY = 4096;
+
+static float GetPower(const SSBOPointLightData& light)
+{
+    return light.intensity * std::max({ light.color.r, light.color.g, light.color.b });
+}
+
+// Lights changing in hue only keep their clusters. Power decides the lights kept by clusters past the light limit.
+static bool ChangesClusters(const LightRegistry::PointLightChange& change)
+{
+    return change.previous.position != change.current.position || change.previous.radius != change.current.radius
+        || GetPower(change.previous) != GetPower(change.current);
+}
+
+static size_t CountChangedLights(const LightRegistry& lightRegistry)
+{
+    const auto& changes = lightRegistry.getPointLightChanges();
+    return static_cast<size_t>(std::count_if(changes.begin(), changes.end(), ChangesClusters));
+}
+
+static GLuint CreateReadbackBuffer()
+{
+    GLuint rendererID = 0;
+    GLCall(glGenBuffers(1, &rendererID));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, rendererID));
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, READBACK_VALUE_COUNT * sizeof(GLuint), nullptr, GL_DYNAMIC_READ));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+    return rendererID;
+}
+
 ClusteredLights::ClusteredLights()
 {
     m_ClustersBuilder = AssetManager::Get().getAsset<ComputeShaderAsset>("Resources/Engine/Shader/ComputeShader/ClusterGridCompute.glsl");
-    m_LightsCuller = AssetManager::Get().getAsset<ComputeShaderAsset>("Resources/Engine/Shader/ComputeShader/ClusterCullingCompute.glsl");
+    m_LightsBinner = AssetManager::Get().getAsset<ComputeShaderAsset>("Resources/Engine/Shader/ComputeShader/ClusterBinningCompute.glsl");
+    m_ActiveClusterMarker = AssetManager::Get().getAsset<ComputeShaderAsset>("Resources/Engine/Shader/ComputeShader/ActiveClusterMarkCompute.glsl");
+
+    // Shaders dispatched over clusters are compiled with the local size picked for this device
+    GLint maxInvocations = 0, maxWorkGroupSizeX = 0, maxSharedMemory = 0;
+    GLCall(glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, &maxInvocations));
+    GLCall(glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 0, &maxWorkGroupSizeX));
+    GLCall(glGetIntegerv(GL_MAX_COMPUTE_SHARED_MEMORY_SIZE, &maxSharedMemory));
+    const unsigned int localSize = std::min(DefaultCullingLocalSize, static_cast<unsigned int>(std::min(maxInvocations, maxWorkGroupSizeX)));
+
+    // A batch holds one light per invocation. Which kernel is faster depends on the device, and is measured.
+    const bool sharedBatchFits = static_cast<unsigned int>(maxSharedMemory) >= localSize * SHARED_LIGHT_SIZE;
+    loadCullingKernel(sharedBatchFits ? CullingKernel::SharedMemory : CullingKernel::Global, localSize);
+    m_SelectingKernel = sharedBatchFits;
+
+    m_CPUCuller.setClusterLightLimit(m_ClusterLightLimit);
+
+    m_ActiveClusterSSBO.setBindingPoint(ACTIVE_CLUSTER_BINDING_POINT);
+    m_ClusterFlagSSBO.setBindingPoint(CLUSTER_FLAG_BINDING_POINT);
+    m_ClusterLightCounterSSBO.setBindingPoint(CLUSTER_LIGHT_COUNTER_BINDING_POINT);
+
+    m_StatisticsReadbacks.resize(StatisticsLatency);
+    for (auto& readback : m_StatisticsReadbacks)
+        readback.rendererID = CreateReadbackBuffer();
+}
+
+ClusteredLights::~ClusteredLights()
+{
+    for (auto& readback : m_StatisticsReadbacks)
+    {
+        if (readback.fence)
+        {
+            GLCall_nothrow(glDeleteSync(readback.fence));
+        }
+        GLCall_nothrow(glDeleteBuffers(1, &readback.rendererID));
+    }
+
+    for (const auto& timing : m_KernelTimings)
+    {
+        GLCall_nothrow(glDeleteQueries(1, &timing.query));
+    }
 }
 
-void ClusteredLights::setBindingPoint(int clusterInfoBindingPoint)
+void ClusteredLights::setBindingPoints(int clusterInfoBindingPoint, int lightIndexBindingPoint)
 {
     m_SSBOClusterInfoSSBO.setBindingPoint(clusterInfoBindingPoint);
+    m_LightIndexSSBO.setBindingPoint(lightIndexBindingPoint);
+}
+
+void ClusteredLights::setCullingMode(CullingMode mode)
+{
+    m_CullingMode = mode;
+}
+
+void ClusteredLights::setCullingKernel(CullingKernel kernel, unsigned int localSize)
+{
+    m_SelectingKernel = false;
+    loadCullingKernel(kernel, localSize);
+}
+
+void ClusteredLights::loadCullingKernel(CullingKernel kernel, unsigned int localSize)
+{
+    VRM_ASSERT_MSG(localSize > 0, "Light culling local size must be greater than 0.");
+
+    m_CullingKernel = kernel;
+    m_CullingLocalSize = localSize;
+
+    // The compaction shader counts the work groups of the dispatches over the active clusters
+    const std::string localSizeDefine = "LOCAL_SIZE " + std::to_string(localSize);
+    const char* cullingPath = kernel == CullingKernel::SharedMemory
+        ? "Resources/Engine/Shader/ComputeShader/ClusterCullingSharedCompute.glsl"
+        : "Resources/Engine/Shader/ComputeShader/ClusterCullingCompute.glsl";
+
+    bool loaded = m_LightsCuller.loadFromFile(cullingPath, { localSizeDefine });
+    loaded &= m_LightOffsetsReserver.loadFromFile("Resources/Engine/Shader/ComputeShader/ClusterOffsetCompute.glsl", { localSizeDefine });
+    loaded &= m_LightsTrimmer.loadFromFile("Resources/Engine/Shader/ComputeShader/ClusterTrimCompute.glsl", { localSizeDefine });
+    loaded &= m_ActiveClusterCompactor.loadFromFile("Resources/Engine/Shader/ComputeShader/ActiveClusterCompactCompute.glsl",
+        { "CULLING_LOCAL_SIZE " + std::to_string(localSize) });
+    VRM_ASSERT_MSG(loaded, "Failed to load light culling shaders with a local size of {}.", localSize);
+
+    VRM_LOG_TRACE("Light culling kernel: {}, local size {}.", kernel == CullingKernel::SharedMemory ? "shared memory" : "global memory", localSize);
+}
+
+void ClusteredLights::setClusterLightLimit(unsigned int clusterLightLimit)
+{
+    clusterLightLimit = std::max(clusterLightLimit, 1u);
+    if (clusterLightLimit == m_ClusterLightLimit)
+        return;
+
+    m_ClusterLightLimit = clusterLightLimit;
+    m_CPUCuller.setClusterLightLimit(clusterLightLimit);
+    invalidateLightAssignment();
 }
 
 void ClusteredLights::setupClusters(const glm::uvec3& clusterCount, const CameraBasic& camera)
@@ -26,6 +177,8 @@ void ClusteredLights::setupClusters(const glm::uvec3& clusterCount, const Camera
     if (m_ClusterCount == clusterCount && m_Projection == camera.getProjection())
         return;
 
+    VRM_GPU_PROFILE_SCOPE("Cluster build");
+
     m_ClusterCount = clusterCount;
     m_TotalClusters = m_ClusterCount.x * m_ClusterCount.y * m_ClusterCount.z;
     m_Projection = camera.getProjection();
@@ -36,6 +189,18 @@ void ClusteredLights::setupClusters(const glm::uvec3& clusterCount, const Camera
     m_SSBOClusterInfoData.yCount = clusterCount.y;
     m_SSBOClusterInfoData.zCount = clusterCount.z;
     m_SSBOClusterInfoSSBO.setData(m_SSBOClusterInfoData);
+    invalidateLightAssignment();
+    // Releasing memory when the grid gets smaller. The move happens on the GPU.
+    m_SSBOClusterInfoSSBO.shrinkToFit();
+
+    // Flags and light counters start cleared. The shaders using them give them back cleared.
+    const std::vector<GLuint> zeros(m_TotalClusters, 0);
+    m_ClusterFlagSSBO.setData(zeros.data(), static_cast<int>(zeros.size() * sizeof(GLuint)));
+    m_ClusterFlagSSBO.shrinkToFit();
+    m_ClusterLightCounterSSBO.setData(zeros.data(), static_cast<int>(zeros.size() * sizeof(GLuint)));
+    m_ClusterLightCounterSSBO.shrinkToFit();
+    m_ActiveClusterSSBO.setData(nullptr, static_cast<int>(sizeof(ACTIVE_CLUSTER_HEADER) + m_TotalClusters * sizeof(GLuint)));
+    m_ActiveClusterSSBO.shrinkToFit();
 
     glm::mat4 invProjectionMatrix = glm::inverse(camera.getProjection()); // Only needed for clusters setup.
 
@@ -45,15 +210,437 @@ void ClusteredLights::setupClusters(const glm::uvec3& clusterCount, const Camera
     computeShader.setUniform1f("u_Far", camera.getFar());
     computeShader.setUniformMat4f("u_InvProjection", invProjectionMatrix);
     computeShader.dispatchCustomBarrier(m_ClusterCount.x, m_ClusterCount.y, m_ClusterCount.z, GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Cheap next to culling, and keeps the CPU mode available at any time
+    m_CPUCuller.buildClusters(m_ClusterCount, m_Projection, camera.getNear(), camera.getFar());
 }
 
-void ClusteredLights::processLights(const CameraBasic& camera)
+void ClusteredLights::findActiveClusters(const Texture2D& depthTexture, const CameraBasic& camera)
 {
-    const auto& computeShader = m_LightsCuller.getStaticAsset()->getComputeShader();
-    computeShader.bind();
-    computeShader.setUniformMat4f("u_View", camera.getView());
-    // Local sise is 128 for x in the compute shader, so we need to divide by 128.
-    computeShader.dispatchCustomBarrier(m_TotalClusters / 128u, 1, 1, GL_SHADER_STORAGE_BARRIER_BIT);
+    VRM_GPU_PROFILE_SCOPE("Active clusters");
+
+    m_ActiveClusterSSBO.setSubData(ACTIVE_CLUSTER_HEADER, sizeof(ACTIVE_CLUSTER_HEADER), 0);
+
+    const auto& marker = m_ActiveClusterMarker.getStaticAsset()->getComputeShader();
+    marker.bind();
+    depthTexture.bind(0);
+    marker.setUniform1i("u_Depth", 0);
+    marker.setUniformMat4f("u_InvProjection", glm::inverse(camera.getProjection()));
+    marker.setUniform1f("u_Near", camera.getNear());
+    marker.setUniform1f("u_Far", camera.getFar());
+
+    // Local size is 16x16 pixels in the mark shader
+    const unsigned int groupCountX = (static_cast<unsigned int>(depthTexture.getWidth()) + 15u) / 16u;
+    const unsigned int groupCountY = (static_cast<unsigned int>(depthTexture.getHeight()) + 15u) / 16u;
+    marker.dispatchCustomBarrier(groupCountX, groupCountY, 1, GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Local size is 128 for x in the compaction shader. The culling dispatch arguments it writes are read as commands.
+    m_ActiveClusterCompactor.dispatchCustomBarrier((m_TotalClusters + 127u) / 128u, 1, 1, GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    m_ActiveClustersFound = true;
+}
+
+bool ClusteredLights::needsFullCulling(const CameraBasic& camera, const LightRegistry& lightRegistry) const
+{
+    if (!m_LightAssignmentValid || !m_AssignmentCoversAllClusters || m_AssignedCullingMode != m_CullingMode || m_AssignedView != camera.getView())
+        return true;
+
+    // Spot lights are few, and not updated cluster by cluster: any change culls everything again
+    if (lightRegistry.haveSpotLightsChanged())
+        return true;
+
+    const size_t changedLights = CountChangedLights(lightRegistry);
+    if (changedLights == 0)
+        return false;
+
+    // CPU culling has no partial update. New lights must fit in the list without growing it, which would clear it.
+    const unsigned int lightCount = lightRegistry.getPointLightSlotCount() + lightRegistry.getSpotLightCount();
+    const unsigned int capacity = std::max(lightCount * ESTIMATED_CLUSTERS_PER_LIGHT, MIN_LIGHT_INDEX_CAPACITY);
+    return m_CullingMode == CullingMode::CPU || changedLights > MaxPartialUpdateLights || capacity > m_LightIndexCapacity;
+}
+
+bool ClusteredLights::needsActiveClusters(const CameraBasic& camera, const LightRegistry& lightRegistry) const
+{
+    // Nothing changed since an assignment of active clusters only: every cluster is culled, for the next frames to reuse
+    const bool settling = m_LightAssignmentValid && !m_AssignmentCoversAllClusters && m_AssignedCullingMode == m_CullingMode
+        && m_AssignedView == camera.getView() && CountChangedLights(lightRegistry) == 0 && !lightRegistry.haveSpotLightsChanged();
+
+    return m_CullingMode != CullingMode::CPU && !settling && needsFullCulling(camera, lightRegistry);
+}
+
+void ClusteredLights::processLights(const CameraBasic& camera, const LightRegistry& lightRegistry)
+{
+    // May grow the light index list, which needs every cluster to be culled again
+    readStatistics();
+    if (!m_KernelTimings.empty())
+        readKernelTimings();
+
+    const bool activeClustersOnly = m_ActiveClustersFound;
+    m_ActiveClustersFound = false;
+
+    if (!needsFullCulling(camera, lightRegistry) && updateChangedClusters(camera, lightRegistry))
+    {
+        reportStatistics();
+        return;
+    }
+
+    if (m_CullingMode == CullingMode::CPU)
+    {
+        processLightsCPU(camera, lightRegistry.getPointLightBlock(), lightRegistry.getSpotLightBlock());
+    }
+    else
+    {
+        VRM_GPU_PROFILE_SCOPE("Light culling");
+
+        const unsigned int lightCount = lightRegistry.getPointLightSlotCount() + lightRegistry.getSpotLightCount();
+
+        // Clusters reserve their ranges from the count at the start of the list
+        reserveLightIndices(std::max(lightCount * ESTIMATED_CLUSTERS_PER_LIGHT, MIN_LIGHT_INDEX_CAPACITY));
+        const GLuint lightIndexCount = 0;
+        m_LightIndexSSBO.setSubData(&lightIndexCount, sizeof(lightIndexCount), 0);
+        m_AppendedLightIndexBound = 0;
+
+        auto& readback = beginStatistics();
+
+        if (m_CullingMode == CullingMode::PerLight)
+        {
+            const auto& binner = m_LightsBinner.getStaticAsset()->getComputeShader();
+            binner.bind();
+            binner.setUniformMat4f("u_View", camera.getView());
+            binner.setUniformMat4f("u_Projection", camera.getProjection());
+            binner.setUniform1f("u_Near", camera.getNear());
+            binner.setUniform1f("u_Far", camera.getFar());
+
+            // Counting the lights of each cluster, reserving the ranges, writing the indices, then keeping the most
+            // important lights of the clusters past the limit. Local size is 128 for x in the binning shader, which
+            // takes the spot lights after the point lights.
+            const unsigned int lightGroupCount = (lightCount + 127u) / 128u;
+            binner.setUniform1i("u_Scatter", 0);
+            binner.dispatchCustomBarrier(lightGroupCount, 1, 1, GL_SHADER_STORAGE_BARRIER_BIT);
+
+            m_LightOffsetsReserver.bind();
+            dispatchOverClusters(m_LightOffsetsReserver, activeClustersOnly);
+
+            binner.bind();
+            binner.setUniform1i("u_Scatter", 1);
+            binner.dispatchCustomBarrier(lightGroupCount, 1, 1, GL_SHADER_STORAGE_BARRIER_BIT);
+
+            m_LightsTrimmer.bind();
+            m_LightsTrimmer.setUniformMat4f("u_View", camera.getView());
+            m_LightsTrimmer.setUniform1ui("u_ClusterLightLimit", m_ClusterLightLimit);
+            dispatchOverClusters(m_LightsTrimmer, activeClustersOnly);
+        }
+        else
+        {
+            // Kernels are compared on cullings of every cluster, whose cost does not depend on the active clusters
+            KernelTiming timing = { 0, m_CullingKernel };
+            if (m_SelectingKernel && !activeClustersOnly)
+            {
+                GLCall(glGenQueries(1, &timing.query));
+                GLCall(glBeginQuery(GL_TIME_ELAPSED, timing.query));
+            }
+
+            m_LightsCuller.bind();
+            m_LightsCuller.setUniformMat4f("u_View", camera.getView());
+            m_LightsCuller.setUniform1ui("u_ClusterLightLimit", m_ClusterLightLimit);
+            dispatchOverClusters(m_LightsCuller, activeClustersOnly);
+
+            if (timing.query != 0)
+            {
+                GLCall(glEndQuery(GL_TIME_ELAPSED));
+                m_KernelTimings.push_back(timing);
+            }
+        }
+
+        endStatistics(readback, activeClustersOnly, false);
+    }
+
+    // Clusters left out by an assignment of active clusters only have no lights, whatever the next frames show
+    m_LightAssignmentValid = true;
+    m_AssignmentCoversAllClusters = m_CullingMode == CullingMode::CPU || !activeClustersOnly;
+    m_AssignedView = camera.getView();
+    m_AssignedCullingMode = m_CullingMode;
+
+    reportStatistics();
+}
+
+void ClusteredLights::invalidateLightAssignment()
+{
+    m_LightAssignmentValid = false;
+}
+
+bool ClusteredLights::updateChangedClusters(const CameraBasic& camera, const LightRegistry& lightRegistry)
+{
+    // The clusters whose lights may change are the ones touched by the old or the new sphere of a changed light
+    m_ChangedClusterFlags.assign(m_TotalClusters, 0);
+    for (const auto& change : lightRegistry.getPointLightChanges())
+    {
+        if (!ChangesClusters(change))
+            continue;
+
+        for (const auto* light : { &change.previous, &change.current })
+        {
+            if (light->radius > 0.f)
+            {
+                const glm::vec3 center_VS = glm::vec3(camera.getView() * glm::vec4(light->position, 1.f));
+                m_CPUCuller.markClusters(center_VS, light->radius * CHANGED_LIGHT_RADIUS_SCALE + CHANGED_LIGHT_RADIUS_MARGIN, m_ChangedClusterFlags);
+            }
+        }
+    }
+
+    m_ChangedClusters.assign(std::begin(ACTIVE_CLUSTER_HEADER), std::end(ACTIVE_CLUSTER_HEADER));
+    for (GLuint i = 0; i < m_TotalClusters; ++i)
+    {
+        if (m_ChangedClusterFlags[i])
+            m_ChangedClusters.push_back(i);
+    }
+
+    const GLuint changedClusterCount = static_cast<GLuint>(m_ChangedClusters.size() - std::size(ACTIVE_CLUSTER_HEADER));
+    if (changedClusterCount == 0)
+        return true;
+
+    // New ranges are appended after the ones other clusters still use, until every cluster is culled again. The end of
+    // the list is bounded by the light indices of the last full culling read back, plus the most each update appends.
+    // An update that may not fit culls every cluster instead, and grows the list first if it would not even fit then.
+    const unsigned int lightCount = lightRegistry.getPointLightSlotCount() + lightRegistry.getSpotLightCount();
+    const unsigned int appendBound = changedClusterCount * std::min(m_ClusterLightLimit, lightCount);
+    if (!m_FullCullingLightIndexCount || *m_FullCullingLightIndexCount + m_AppendedLightIndexBound + appendBound > m_LightIndexCapacity)
+    {
+        if (m_FullCullingLightIndexCount && *m_FullCullingLightIndexCount + appendBound > m_LightIndexCapacity)
+        {
+            const unsigned int capacity = *m_FullCullingLightIndexCount + appendBound;
+            reserveLightIndices(capacity + capacity / 2);
+        }
+        return false;
+    }
+    m_AppendedLightIndexBound += appendBound;
+
+    VRM_GPU_PROFILE_SCOPE("Light culling");
+
+    // Same header as the compaction shader writes: culling work group count, then cluster count
+    m_ChangedClusters[0] = (changedClusterCount + m_CullingLocalSize - 1) / m_CullingLocalSize;
+    m_ChangedClusters[3] = changedClusterCount;
+    m_ActiveClusterSSBO.setSubData(m_ChangedClusters.data(), static_cast<int>(m_ChangedClusters.size() * sizeof(GLuint)), 0);
+
+    auto& readback = beginStatistics();
+
+    // Whatever the culling mode, the listed clusters test every light. The light index count is not reset.
+    m_LightsCuller.bind();
+    m_LightsCuller.setUniformMat4f("u_View", camera.getView());
+    m_LightsCuller.setUniform1ui("u_ClusterLightLimit", m_ClusterLightLimit);
+    dispatchOverClusters(m_LightsCuller, true);
+
+    endStatistics(readback, false, true);
+    return true;
+}
+
+void ClusteredLights::processLightsCPU(const CameraBasic& camera, const std::vector<std::byte>& lightBlock, const std::vector<std::byte>& spotLightBlock)
+{
+    VRM_PROFILE_SCOPE("ClusteredLights::processLightsCPU");
+
+    m_CPUCuller.cull(camera.getView(), lightBlock, spotLightBlock);
+    const auto& clusters = m_CPUCuller.getClusters();
+    const auto& lightIndices = m_CPUCuller.getLightIndices();
+
+    // Same layout as the GPU paths write: clusters after the grid size, light index count before the indices
+    m_SSBOClusterInfoSSBO.setSubData(clusters.data(), static_cast<int>(clusters.size() * sizeof(SSBOCluster)), static_cast<int>(offsetof(SSBOClusterInfo, clusters)));
+
+    const GLuint lightIndexCount = static_cast<GLuint>(lightIndices.size());
+    reserveLightIndices(std::max(lightIndexCount, MIN_LIGHT_INDEX_CAPACITY));
+    m_LightIndexSSBO.setSubData(&lightIndexCount, sizeof(lightIndexCount), 0);
+    if (lightIndexCount > 0)
+        m_LightIndexSSBO.setSubData(lightIndices.data(), static_cast<int>(lightIndexCount * sizeof(GLuint)), sizeof(GLuint));
+
+    m_LightStatistics.averageLightsPerCluster = clusters.empty() ? 0.0 : static_cast<double>(lightIndexCount) / clusters.size();
+    m_LightStatistics.maxLightsPerCluster = static_cast<double>(m_CPUCuller.getMaxLightsPerCluster());
+    m_LightStatistics.culledClusters = static_cast<double>(clusters.size());
+}
+
+void ClusteredLights::dispatchOverClusters(const ComputeShader& computeShader, bool listedClustersOnly) const
+{
+    computeShader.setUniform1i("u_ActiveClustersOnly", listedClustersOnly ? 1 : 0);
+
+    if (listedClustersOnly)
+    {
+        // Work groups were counted by the compaction shader, or with the list of changed clusters
+        computeShader.dispatchIndirectCustomBarrier(m_ActiveClusterSSBO.getRendererID(), 0, GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+    else
+    {
+        // The last work group is partially filled
+        const unsigned int groupCount = (m_TotalClusters + m_CullingLocalSize - 1) / m_CullingLocalSize;
+        computeShader.dispatchCustomBarrier(groupCount, 1, 1, GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+}
+
+ClusteredLights::StatisticsReadback& ClusteredLights::beginStatistics()
+{
+    // Statistics of this dispatch are accumulated with atomics, into a buffer read a few dispatches later. When the GPU
+    // is still behind on the oldest readback, it is kept for a later frame and a new one is inserted before it, as the
+    // newest: its light index count may be the only sign of an overflow.
+    if (m_StatisticsReadbacks[m_StatisticsIndex].fence)
+    {
+        VRM_LOG_TRACE("Adding a light culling readback, {} are in flight.", m_StatisticsReadbacks.size());
+        StatisticsReadback newReadback;
+        newReadback.rendererID = CreateReadbackBuffer();
+        m_StatisticsReadbacks.insert(m_StatisticsReadbacks.begin() + m_StatisticsIndex, newReadback);
+    }
+    auto& readback = m_StatisticsReadbacks[m_StatisticsIndex];
+
+    const GLuint zeros[READBACK_VALUE_COUNT] = {};
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, readback.rendererID));
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(zeros), zeros));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+    GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, STATISTICS_BINDING_POINT, readback.rendererID));
+    return readback;
+}
+
+void ClusteredLights::endStatistics(StatisticsReadback& readback, bool activeClustersOnly, bool partialUpdate)
+{
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, readback.rendererID));
+    if (activeClustersOnly)
+    {
+        // The active cluster count is read back with the statistics
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_ActiveClusterSSBO.getRendererID()));
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, ACTIVE_CLUSTER_COUNT_OFFSET, 2 * sizeof(GLuint), sizeof(GLuint)));
+    }
+    // So is the light index count, which tells whether the list overflowed
+    GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_LightIndexSSBO.getRendererID()));
+    GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 3 * sizeof(GLuint), sizeof(GLuint)));
+    GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    GLCall(readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    readback.clusterCount = m_TotalClusters;
+    readback.activeClustersOnly = activeClustersOnly;
+    readback.partialUpdate = partialUpdate;
+    m_StatisticsIndex = (m_StatisticsIndex + 1) % static_cast<unsigned int>(m_StatisticsReadbacks.size());
+}
+
+void ClusteredLights::readStatistics()
+{
+    // Oldest first, in dispatch order. Fences signal in that order, so the first pending readback ends the loop, and is
+    // polled again next frame: a static scene dispatches nothing, yet must still see the overflow of its last culling.
+    const unsigned int readbackCount = static_cast<unsigned int>(m_StatisticsReadbacks.size());
+    for (unsigned int i = 0; i < readbackCount; ++i)
+    {
+        auto& readback = m_StatisticsReadbacks[(m_StatisticsIndex + i) % readbackCount];
+        if (!readback.fence)
+            continue;
+
+        if (!readStatistics(readback))
+            return;
+    }
+}
+
+bool ClusteredLights::readStatistics(StatisticsReadback& readback)
+{
+    // Never waits: the CPU would stall on the GPU
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    GLCall(status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    GLCall(glDeleteSync(readback.fence));
+    readback.fence = nullptr;
+
+    if (status == GL_WAIT_FAILED || readback.clusterCount == 0)
+        return true;
+
+    GLuint values[READBACK_VALUE_COUNT] = {};
+    GLCall(glBindBuffer(GL_COPY_READ_BUFFER, readback.rendererID));
+    GLCall(glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(values), values));
+    GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+
+    // Partial updates only counted the lights of the clusters they culled
+    if (!readback.partialUpdate)
+    {
+        m_FullCullingLightIndexCount = values[3];
+
+        // Only active clusters had their lights counted
+        const unsigned int culledClusters = readback.activeClustersOnly ? values[2] : readback.clusterCount;
+        m_LightStatistics.averageLightsPerCluster = culledClusters > 0 ? static_cast<double>(values[0]) / culledClusters : 0.0;
+        m_LightStatistics.maxLightsPerCluster = static_cast<double>(values[1]);
+        m_LightStatistics.culledClusters = static_cast<double>(culledClusters);
+    }
+
+    // Some lights were dropped: the list grows with some headroom, so that moving lights do not make it grow every frame
+    if (values[3] > m_LightIndexCapacity)
+        reserveLightIndices(values[3] + values[3] / 2);
+    // Ranges left behind by partial updates are reclaimed by culling every cluster again
+    else if (readback.partialUpdate && values[3] > m_LightIndexCapacity / 2)
+        invalidateLightAssignment();
+
+    return true;
+}
+
+void ClusteredLights::readKernelTimings()
+{
+    // Oldest first: queries complete in the order they were issued
+    size_t readCount = 0;
+    for (; readCount < m_KernelTimings.size(); ++readCount)
+    {
+        const auto& timing = m_KernelTimings[readCount];
+        GLint available = 0;
+        GLCall(glGetQueryObjectiv(timing.query, GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+            break;
+
+        GLuint64 nanoseconds = 0;
+        GLCall(glGetQueryObjectui64v(timing.query, GL_QUERY_RESULT, &nanoseconds));
+        GLCall(glDeleteQueries(1, &timing.query));
+
+        // Timings of a kernel left since, or of a selection ended by setCullingKernel, are dropped
+        if (!m_SelectingKernel || timing.kernel != m_CullingKernel)
+            continue;
+
+        const size_t kernelIndex = static_cast<size_t>(timing.kernel);
+        if (m_KernelSampleCounts[kernelIndex]++ > 0)
+            m_KernelMilliseconds[kernelIndex] += static_cast<double>(nanoseconds) * 1e-6;
+        if (m_KernelSampleCounts[kernelIndex] <= KernelSelectionSamples)
+            continue;
+
+        // The current kernel is timed: the other one is timed next, unless it already is
+        const CullingKernel otherKernel = m_CullingKernel == CullingKernel::Global ? CullingKernel::SharedMemory : CullingKernel::Global;
+        if (m_KernelSampleCounts[static_cast<size_t>(otherKernel)] <= KernelSelectionSamples)
+        {
+            loadCullingKernel(otherKernel, m_CullingLocalSize);
+            continue;
+        }
+
+        const double globalMilliseconds = m_KernelMilliseconds[static_cast<size_t>(CullingKernel::Global)] / KernelSelectionSamples;
+        const double sharedMilliseconds = m_KernelMilliseconds[static_cast<size_t>(CullingKernel::SharedMemory)] / KernelSelectionSamples;
+        const CullingKernel fastestKernel = sharedMilliseconds < globalMilliseconds ? CullingKernel::SharedMemory : CullingKernel::Global;
+        VRM_LOG_INFO("Light culling kernel selected: {} ({:.3f} ms with global memory, {:.3f} ms with shared memory).",
+            fastestKernel == CullingKernel::SharedMemory ? "shared memory" : "global memory", globalMilliseconds, sharedMilliseconds);
+
+        m_SelectingKernel = false;
+        if (fastestKernel != m_CullingKernel)
+            loadCullingKernel(fastestKernel, m_CullingLocalSize);
+    }
+
+    m_KernelTimings.erase(m_KernelTimings.begin(), m_KernelTimings.begin() + static_cast<std::ptrdiff_t>(readCount));
+}
+
+void ClusteredLights::reportStatistics() const
+{
+    auto& frameStats = FrameStats::Get();
+    frameStats.set(FrameStats::Counter::AverageLightsPerCluster, m_LightStatistics.averageLightsPerCluster);
+    frameStats.set(FrameStats::Counter::MaxLightsPerCluster, m_LightStatistics.maxLightsPerCluster);
+    frameStats.set(FrameStats::Counter::ActiveClusters, m_LightStatistics.culledClusters);
+}
+
+void ClusteredLights::reserveLightIndices(unsigned int capacity)
+{
+    if (capacity <= m_LightIndexCapacity)
+        return;
+
+    VRM_LOG_TRACE("Growing cluster light index list from {} to {} indices.", m_LightIndexCapacity, capacity);
+
+    // The previous content is not kept, so every cluster is culled again
+    m_LightIndexCapacity = capacity;
+    invalidateLightAssignment();
+    m_LightIndexSSBO.setData(nullptr, static_cast<int>((1 + capacity) * sizeof(GLuint)));
 }
 
 } // namespace vrm
@@ -0,0 +1,139 @@
+#include "Vroom/Render/Clustering/LightBudget.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Vroom/Core/Profiler.h"
+#include "Vroom/Render/Camera/CameraBasic.h"
+#include "Vroom/Render/Clustering/LightRegistry.h"
+
+namespace vrm
+{
+
+static constexpr float PI = 3.14159265358979f;
+
+// Shading attenuates the color times the intensity by the squared distance
+template <typename Light>
+static float GetPower(const Light& light)
+{
+    return light.intensity * std::max({ light.color.r, light.color.g, light.color.b });
+}
+
+template <typename Light>
+static float GetRadius(const Light& light, float intensityCutoff)
+{
+    if (intensityCutoff <= 0.f)
+        return light.radius;
+
+    const float power = GetPower(light);
+    if (power <= 0.f)
+        return 0.f;
+
+    return std::min(light.radius, std::sqrt(power / intensityCutoff));
+}
+
+static bool IsSphereVisible(const Frustum& frustum, const glm::vec3& center, float radius)
+{
+    bool visible = true;
+    for (const auto& plane : frustum.planes)
+        visible &= glm::dot(glm::vec3(plane), center) + plane.w >= -radius;
+    return visible;
+}
+
+float LightBudget::GetEffectiveRadius(const PointLightComponent& pointLight, float intensityCutoff)
+{
+    return GetRadius(pointLight, intensityCutoff);
+}
+
+void LightBudget::beginFrame()
+{
+    m_Lights.clear();
+    m_SpotLights.clear();
+    m_DirectionalLights.clear();
+}
+
+void LightBudget::submitPointLight(const PointLightComponent& pointLight, const glm::vec3& position, entt::entity entity)
+{
+    m_Lights.push_back({ pointLight, position, entity });
+}
+
+void LightBudget::submitSpotLight(const SpotLightComponent& spotLight, const glm::vec3& position, const glm::vec3& direction)
+{
+    m_SpotLights.push_back({ spotLight, position, direction });
+}
+
+void LightBudget::submitDirectionalLight(const DirectionalLightComponent& directionalLight, const glm::vec3& direction)
+{
+    m_DirectionalLights.push_back({ directionalLight, direction });
+}
+
+void LightBudget::selectLights(const CameraBasic& camera, LightRegistry& lightRegistry)
+{
+    VRM_PROFILE_SCOPE("LightBudget::selectLights");
+
+    const Frustum frustum = camera.getFrustum();
+    const glm::mat4& view = camera.getView();
+    const glm::mat4& projection = camera.getProjection();
+
+    m_Scores.clear();
+    m_Kept.assign(m_Lights.size(), 0);
+
+    for (unsigned int i = 0; i < static_cast<unsigned int>(m_Lights.size()); ++i)
+    {
+        auto& light = m_Lights[i];
+        light.pointLight.radius = GetEffectiveRadius(light.pointLight, m_IntensityCutoff);
+        const float radius = light.pointLight.radius;
+        if (radius <= 0.f)
+            continue;
+
+        if (!IsSphereVisible(frustum, light.position, radius))
+            continue;
+
+        // Part of the screen covered by the projected sphere, from the tangent of its angular radius
+        const glm::vec3 center_VS = glm::vec3(view * glm::vec4(light.position, 1.f));
+        const float distanceSquared = glm::dot(center_VS, center_VS);
+        float coverage = 1.f;
+        if (distanceSquared > radius * radius)
+        {
+            const float tangentSquared = radius * radius / (distanceSquared - radius * radius);
+            coverage = std::min(PI * tangentSquared * projection[0][0] * projection[1][1] / 4.f, 1.f);
+        }
+
+        m_Scores.push_back({ coverage * GetPower(light.pointLight), i });
+    }
+
+    m_VisibleLightCount = static_cast<unsigned int>(m_Scores.size());
+
+    // Best scores first. Ties go to the first submitted light, so that the selection is stable from frame to frame.
+    if (m_Scores.size() > m_MaxLights)
+    {
+        std::nth_element(m_Scores.begin(), m_Scores.begin() + m_MaxLights, m_Scores.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first || (a.first == b.first && a.second < b.second); });
+        m_Scores.resize(m_MaxLights);
+    }
+
+    for (const auto& [_, index] : m_Scores)
+        m_Kept[index] = 1;
+
+    // Submission order is kept, so the slots of the registry do not follow the scores
+    for (size_t i = 0; i < m_Lights.size(); ++i)
+    {
+        if (m_Kept[i])
+            lightRegistry.submitPointLight(m_Lights[i].pointLight, m_Lights[i].position, m_Lights[i].entity);
+    }
+
+    m_KeptLightCount = static_cast<unsigned int>(m_Scores.size());
+
+    // The range sphere bounds the cone, which is enough to cull the few spot lights
+    for (auto& light : m_SpotLights)
+    {
+        light.spotLight.radius = GetRadius(light.spotLight, m_IntensityCutoff);
+        if (light.spotLight.radius > 0.f && IsSphereVisible(frustum, light.position, light.spotLight.radius))
+            lightRegistry.submitSpotLight(light.spotLight, light.position, light.direction);
+    }
+
+    for (const auto& light : m_DirectionalLights)
+        lightRegistry.submitDirectionalLight(light.directionalLight, light.direction);
+}
+
+} // namespace vrm
@@ -1,87 +1,252 @@
 #include "Vroom/Render/Clustering/LightRegistry.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace vrm
 {
 
+// Written past the end of the block when a light is removed, so that the change is recorded
+static const SSBOPointLightData NO_POINT_LIGHT = { glm::vec3(0.f), glm::vec3(0.f), 0.f, 0.f };
+
+static size_t SlotOffset(unsigned int slot)
+{
+    return sizeof(int) + static_cast<size_t>(slot) * sizeof(SSBOPointLightData);
+}
+
+/**
+ * @brief Rebuilds a block of lights: light count followed by the lights.
+ * @return True if the lights differ from the previous ones, or if the block was never built.
+ */
+template <typename LightData>
+static bool BuildWholeBlock(const std::vector<LightData>& lights, const std::vector<LightData>& previousLights, std::vector<std::byte>& block)
+{
+    if (!block.empty() && lights == previousLights)
+        return false;
+
+    const int lightCount = static_cast<int>(lights.size());
+    block.resize(sizeof(int) + lights.size() * sizeof(LightData));
+    std::memcpy(block.data(), &lightCount, sizeof(int));
+    if (!lights.empty())
+        std::memcpy(block.data() + sizeof(int), lights.data(), lights.size() * sizeof(LightData));
+    return true;
+}
+
 void LightRegistry::setBindingPoint(int bindingPoint)
 {
-    m_SSBOPointLights.setBindingPoint(bindingPoint);
+    m_BindingPoint = bindingPoint;
+}
+
+void LightRegistry::setSpotLightBindingPoint(int bindingPoint)
+{
+    m_SpotLightBindingPoint = bindingPoint;
+}
+
+void LightRegistry::setDirectionalLightBindingPoint(int bindingPoint)
+{
+    m_DirectionalLightBindingPoint = bindingPoint;
 }
 
 void LightRegistry::reserve(int lightCount)
 {
-    m_SSBOPointLights.reserve(sizeof(int) + lightCount * sizeof(SSBOPointLightData));
+    const size_t count = static_cast<size_t>(lightCount);
+    m_PointLights.reserve(count);
+    m_PointLightEntities.reserve(count);
+    m_PointLightFrames.reserve(count);
+    m_ChangeIndices.reserve(count);
+    m_PointLightBlock.reserve(SlotOffset(static_cast<unsigned int>(lightCount)));
 }
 
 void LightRegistry::beginFrame()
 {
-    m_AddedPointLights.clear();
-    m_PointLights.clear();
+    m_Frame++;
+    m_SubmittedCount = 0;
+    m_FrameStartSlotCount = getPointLightSlotCount();
+    m_PointLightChanges.clear();
 
-    // At the beginning of the frame, every address is set to free.
-    // If a light is added, it will remove the address from the free addresses set.
-    for (const auto& [_, address] : m_PointLightAddresses)
-        m_FreePointLightAdresses.insert(address);
+    std::swap(m_SpotLights, m_PreviousSpotLights);
+    m_SpotLights.clear();
+    std::swap(m_DirectionalLights, m_PreviousDirectionalLights);
+    m_DirectionalLights.clear();
 }
 
-void LightRegistry::submitPointLight(const PointLightComponent& pointLight, const glm::vec3& position, const std::string& identifier)
+void LightRegistry::submitPointLight(const PointLightComponent& pointLight, const glm::vec3& position, entt::entity entity)
 {
     SSBOPointLightData pointLightData{position, pointLight.color, pointLight.intensity, pointLight.radius};
 
-    if (auto it = m_PointLightAddresses.find(identifier); it != m_PointLightAddresses.end()) // Light already exists
+    const size_t entityIndex = static_cast<size_t>(entt::to_entity(entity));
+    if (entityIndex >= m_PointLightSlots.size())
+        m_PointLightSlots.resize(entityIndex + 1, NoIndex);
+
+    unsigned int slot = m_PointLightSlots[entityIndex];
+    if (slot == NoIndex) // Light doesn't exist, it is appended with a zeroed light so that the change is recorded
     {
-        const auto& address = it->second;
-        // Mark the address of the light as not free
-        m_FreePointLightAdresses.erase(address);
-
-        // Update the light
-        m_SSBOPointLights.setSubData(&pointLightData, sizeof(SSBOPointLightData), address);
-        int lightIndex = (address - sizeof(int)) / sizeof(SSBOPointLightData);
-        m_PointLights[lightIndex] = pointLightData;
+        slot = getPointLightSlotCount();
+        m_PointLightSlots[entityIndex] = slot;
+        m_PointLights.push_back(NO_POINT_LIGHT);
+        m_PointLightEntities.push_back(entity);
+        m_PointLightFrames.push_back(0);
     }
-    else // Light doesn't exist
+
+    // A recycled entity index takes the slot of the destroyed entity
+    m_PointLightEntities[slot] = entity;
+    if (m_PointLightFrames[slot] != m_Frame)
     {
-        // At the end of the frame, the free addresses set will be relevant, and we'll be able to reuse the memory of removed lights
-        // for new lights.
-        m_AddedPointLights[identifier] = pointLightData;
+        m_PointLightFrames[slot] = m_Frame;
+        m_SubmittedCount++;
     }
+
+    writePointLight(slot, pointLightData);
 }
 
-void LightRegistry::endFrame()
+void LightRegistry::submitSpotLight(const SpotLightComponent& spotLight, const glm::vec3& position, const glm::vec3& direction)
 {
-    updateData();
+    // The cone culling needs the outer angle under 90 degrees, and the falloff needs the inner angle inside the outer one
+    const float outerAngle = std::clamp(spotLight.outerAngle, 0.f, MaxSpotLightAngle);
+    const float innerAngle = std::clamp(spotLight.innerAngle, 0.f, outerAngle);
+
+    m_SpotLights.push_back({ position, spotLight.color, spotLight.intensity, spotLight.radius, glm::normalize(direction),
+        std::cos(outerAngle), std::cos(innerAngle) });
 }
 
-void LightRegistry::updateData()
+void LightRegistry::submitDirectionalLight(const DirectionalLightComponent& directionalLight, const glm::vec3& direction)
 {
-    for (const auto& [id, pointLight] : m_AddedPointLights)
+    m_DirectionalLights.push_back({ glm::normalize(direction), directionalLight.color, directionalLight.intensity });
+}
+
+const std::vector<std::byte>& LightRegistry::prepareFrame()
+{
+    // Lights that were not submitted are removed, the slot count only decreases then
+    if (m_SubmittedCount < getPointLightSlotCount())
     {
-        if (auto it = m_FreePointLightAdresses.begin(); it != m_FreePointLightAdresses.end())
-        {
-            // We can reuse the memory of a previously removed light
-            const int& freeAddress = *it;
-            m_SSBOPointLights.setSubData(&pointLight, sizeof(SSBOPointLightData), freeAddress);
-            m_PointLightAddresses[id] = freeAddress;
-            m_FreePointLightAdresses.erase(it);
-            int recycledAdress = (freeAddress - sizeof(int)) / sizeof(SSBOPointLightData);
-            m_PointLights[recycledAdress] = pointLight;
-        }
-        else
+        for (unsigned int slot = 0; slot < getPointLightSlotCount();)
         {
-            // We need to add some new data to the SSBO
-            m_SSBOPointLights.setSubData(&pointLight, sizeof(SSBOPointLightData), m_NextPointLightAddress);
-            m_PointLightAddresses[id] = m_NextPointLightAddress;
-            int index = (m_NextPointLightAddress - sizeof(int)) / sizeof(SSBOPointLightData);
-            m_PointLights[index] = pointLight;
-            m_NextPointLightAddress += sizeof(SSBOPointLightData);
+            if (m_PointLightFrames[slot] != m_Frame)
+                removePointLight(slot);
+            else
+                slot++;
         }
     }
 
-    int lightCount = static_cast<int>(m_PointLights.size());
-    m_SSBOPointLights.setSubData(&lightCount, sizeof(int), 0);
+    finishChanges();
+    buildBlock(m_FrameStartSlotCount);
+    m_FrameStartSlotCount = getPointLightSlotCount();
+
+    m_SpotLightsChanged = BuildWholeBlock(m_SpotLights, m_PreviousSpotLights, m_SpotLightBlock);
+    m_DirectionalLightsChanged = BuildWholeBlock(m_DirectionalLights, m_PreviousDirectionalLights, m_DirectionalLightBlock);
+    return m_PointLightBlock;
+}
+
+void LightRegistry::endFrame()
+{
+    prepareFrame();
+
+    // Growth copies the previous content on the GPU, so only the dirty ranges are ever written
+    for (const auto& range : m_DirtyRanges)
+        m_PointLightSSBO.setSubData(m_PointLightBlock.data() + range.offset, static_cast<int>(range.size), static_cast<int>(range.offset));
+    m_PointLightSSBO.setBindingPoint(m_BindingPoint);
+
+    if (m_SpotLightsChanged)
+        m_SpotLightSSBO.setData(m_SpotLightBlock.data(), static_cast<int>(m_SpotLightBlock.size()));
+    m_SpotLightSSBO.setBindingPoint(m_SpotLightBindingPoint);
+
+    if (m_DirectionalLightsChanged)
+        m_DirectionalLightSSBO.setData(m_DirectionalLightBlock.data(), static_cast<int>(m_DirectionalLightBlock.size()));
+    m_DirectionalLightSSBO.setBindingPoint(m_DirectionalLightBindingPoint);
+
+    // Removed lights leave their slots past the end of the block, which shrinking may drop after quiet frames
+    m_PointLightSSBO.truncate(static_cast<int>(m_PointLightBlock.size()));
+    m_PointLightSSBO.endFrame();
+    m_SpotLightSSBO.endFrame();
+    m_DirectionalLightSSBO.endFrame();
+}
+
+void LightRegistry::writePointLight(unsigned int slot, const SSBOPointLightData& pointLight)
+{
+    SSBOPointLightData& current = m_PointLights[slot];
+    if (current == pointLight)
+        return;
+
+    if (slot >= m_ChangeIndices.size())
+        m_ChangeIndices.resize(static_cast<size_t>(slot) + 1, NoIndex);
+
+    // The first change of the frame keeps the previous light, later ones only update the current light
+    unsigned int& changeIndex = m_ChangeIndices[slot];
+    if (changeIndex == NoIndex)
+    {
+        changeIndex = static_cast<unsigned int>(m_PointLightChanges.size());
+        m_PointLightChanges.push_back({ slot, current, pointLight });
+    }
+    else
+    {
+        m_PointLightChanges[changeIndex].current = pointLight;
+    }
+
+    current = pointLight;
+}
+
+void LightRegistry::removePointLight(unsigned int slot)
+{
+    const unsigned int lastSlot = getPointLightSlotCount() - 1;
+    m_PointLightSlots[static_cast<size_t>(entt::to_entity(m_PointLightEntities[slot]))] = NoIndex;
+
+    // The last light fills the hole, so the block stays dense
+    if (slot != lastSlot)
+    {
+        writePointLight(slot, m_PointLights[lastSlot]);
+        m_PointLightEntities[slot] = m_PointLightEntities[lastSlot];
+        m_PointLightFrames[slot] = m_PointLightFrames[lastSlot];
+        m_PointLightSlots[static_cast<size_t>(entt::to_entity(m_PointLightEntities[slot]))] = slot;
+    }
+
+    writePointLight(lastSlot, NO_POINT_LIGHT);
+    m_PointLights.pop_back();
+    m_PointLightEntities.pop_back();
+    m_PointLightFrames.pop_back();
+}
+
+void LightRegistry::finishChanges()
+{
+    for (const auto& change : m_PointLightChanges)
+        m_ChangeIndices[change.slot] = NoIndex;
+
+    // A light may have been edited back to its previous value, or added and removed in the same frame
+    std::erase_if(m_PointLightChanges, [](const PointLightChange& change) { return change.current == change.previous; });
+    std::sort(m_PointLightChanges.begin(), m_PointLightChanges.end(),
+        [](const PointLightChange& a, const PointLightChange& b) { return a.slot < b.slot; });
+}
+
+void LightRegistry::buildBlock(unsigned int previousSlotCount)
+{
+    m_DirtyRanges.clear();
+
+    const unsigned int slotCount = getPointLightSlotCount();
+    const bool firstBlock = m_PointLightBlock.empty();
+    m_PointLightBlock.resize(SlotOffset(slotCount));
 
-    //VRM_LOG_TRACE("SSBO size: {0}", m_SSBOPointLights.getCapacity());
-    //VRM_LOG_TRACE("Lights count in registry: {0}", m_PointLights.size());
+    if (firstBlock || slotCount != previousSlotCount)
+    {
+        int lightCount = static_cast<int>(slotCount);
+        std::memcpy(m_PointLightBlock.data(), &lightCount, sizeof(int));
+        m_DirtyRanges.push_back({ 0, sizeof(int) });
+    }
+
+    // Changes are in slot order. Close ones share a range, since a copy costs more than a few unchanged lights.
+    const size_t mergeGap = DirtyRangeMergeGap * sizeof(SSBOPointLightData);
+    for (const auto& change : m_PointLightChanges)
+    {
+        if (change.slot >= slotCount)
+            break;
+
+        const size_t offset = SlotOffset(change.slot);
+        std::memcpy(m_PointLightBlock.data() + offset, &change.current, sizeof(SSBOPointLightData));
+
+        if (!m_DirtyRanges.empty() && offset <= m_DirtyRanges.back().offset + m_DirtyRanges.back().size + mergeGap)
+            m_DirtyRanges.back().size = offset + sizeof(SSBOPointLightData) - m_DirtyRanges.back().offset;
+        else
+            m_DirtyRanges.push_back({ offset, sizeof(SSBOPointLightData) });
+    }
 }
 
 } // namespace vrm
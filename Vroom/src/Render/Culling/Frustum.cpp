@@ -0,0 +1,33 @@
+#include "Vroom/Render/Culling/Frustum.h"
+
+namespace vrm
+{
+
+Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+{
+    // Gribb & Hartmann method. glm matrices are column major, so rows are gathered by hand.
+    const auto& m = viewProjection;
+    const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[Left] = row3 + row0;
+    frustum.planes[Right] = row3 - row0;
+    frustum.planes[Bottom] = row3 + row1;
+    frustum.planes[Top] = row3 - row1;
+    frustum.planes[Near] = row3 + row2;
+    frustum.planes[Far] = row3 - row2;
+
+    for (auto& plane : frustum.planes)
+    {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.f)
+            plane /= length;
+    }
+
+    return frustum;
+}
+
+} // namespace vrm
@@ -0,0 +1,197 @@
+#include "Vroom/Render/Culling/FrustumCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define VRM_CULLING_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define VRM_CULLING_SSE
+#endif
+
+namespace vrm
+{
+
+void FrustumCuller::clear()
+{
+    m_Count = 0;
+    m_SphereX.clear(); m_SphereY.clear(); m_SphereZ.clear(); m_SphereRadius.clear();
+    m_BoxCenterX.clear(); m_BoxCenterY.clear(); m_BoxCenterZ.clear();
+    m_BoxExtentX.clear(); m_BoxExtentY.clear(); m_BoxExtentZ.clear();
+}
+
+void FrustumCuller::reserve(size_t count)
+{
+    m_SphereX.reserve(count); m_SphereY.reserve(count); m_SphereZ.reserve(count); m_SphereRadius.reserve(count);
+    m_BoxCenterX.reserve(count); m_BoxCenterY.reserve(count); m_BoxCenterZ.reserve(count);
+    m_BoxExtentX.reserve(count); m_BoxExtentY.reserve(count); m_BoxExtentZ.reserve(count);
+    m_Visibility.reserve(count);
+}
+
+size_t FrustumCuller::push(const AABB& box, const BoundingSphere& sphere, const glm::mat4& model)
+{
+    const glm::mat3 linear(model);
+
+    // Sphere: the radius is scaled by the largest axis scale, so the sphere stays conservative under non uniform scale.
+    const glm::vec3 sphereCenter = glm::vec3(model * glm::vec4(sphere.center, 1.f));
+    const float maxScale = std::sqrt(std::max({
+        glm::dot(linear[0], linear[0]),
+        glm::dot(linear[1], linear[1]),
+        glm::dot(linear[2], linear[2])
+    }));
+
+    // Box: world extents are the local extents projected on the absolute value of the linear part (Arvo's method).
+    const glm::vec3 boxCenter = glm::vec3(model * glm::vec4(box.getCenter(), 1.f));
+    const glm::vec3 extents = box.getExtents();
+    const glm::vec3 boxExtents = glm::abs(linear[0]) * extents.x + glm::abs(linear[1]) * extents.y + glm::abs(linear[2]) * extents.z;
+
+    m_SphereX.push_back(sphereCenter.x);
+    m_SphereY.push_back(sphereCenter.y);
+    m_SphereZ.push_back(sphereCenter.z);
+    m_SphereRadius.push_back(sphere.radius * maxScale);
+
+    m_BoxCenterX.push_back(boxCenter.x);
+    m_BoxCenterY.push_back(boxCenter.y);
+    m_BoxCenterZ.push_back(boxCenter.z);
+    m_BoxExtentX.push_back(boxExtents.x);
+    m_BoxExtentY.push_back(boxExtents.y);
+    m_BoxExtentZ.push_back(boxExtents.z);
+
+    return m_Count++;
+}
+
+size_t FrustumCuller::cull(const Frustum& frustum)
+{
+    m_Visibility.assign(m_Count, 0);
+
+    size_t processed = 0;
+
+#if defined(VRM_CULLING_AVX)
+    __m256 planeX[Frustum::Count], planeY[Frustum::Count], planeZ[Frustum::Count], planeW[Frustum::Count];
+    __m256 absPlaneX[Frustum::Count], absPlaneY[Frustum::Count], absPlaneZ[Frustum::Count];
+    for (int p = 0; p < Frustum::Count; ++p)
+    {
+        const auto& plane = frustum.planes[p];
+        planeX[p] = _mm256_set1_ps(plane.x); absPlaneX[p] = _mm256_set1_ps(std::abs(plane.x));
+        planeY[p] = _mm256_set1_ps(plane.y); absPlaneY[p] = _mm256_set1_ps(std::abs(plane.y));
+        planeZ[p] = _mm256_set1_ps(plane.z); absPlaneZ[p] = _mm256_set1_ps(std::abs(plane.z));
+        planeW[p] = _mm256_set1_ps(plane.w);
+    }
+
+    for (; processed + 8 <= m_Count; processed += 8)
+    {
+        const __m256 sx = _mm256_loadu_ps(&m_SphereX[processed]);
+        const __m256 sy = _mm256_loadu_ps(&m_SphereY[processed]);
+        const __m256 sz = _mm256_loadu_ps(&m_SphereZ[processed]);
+        const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&m_SphereRadius[processed]));
+        const __m256 cx = _mm256_loadu_ps(&m_BoxCenterX[processed]);
+        const __m256 cy = _mm256_loadu_ps(&m_BoxCenterY[processed]);
+        const __m256 cz = _mm256_loadu_ps(&m_BoxCenterZ[processed]);
+        const __m256 ex = _mm256_loadu_ps(&m_BoxExtentX[processed]);
+        const __m256 ey = _mm256_loadu_ps(&m_BoxExtentY[processed]);
+        const __m256 ez = _mm256_loadu_ps(&m_BoxExtentZ[processed]);
+
+        __m256 outside = _mm256_setzero_ps();
+        for (int p = 0; p < Frustum::Count; ++p)
+        {
+            // Sphere is outside when its signed distance is below -radius
+            __m256 sphereDistance = _mm256_add_ps(_mm256_mul_ps(sx, planeX[p]), planeW[p]);
+            sphereDistance = _mm256_add_ps(_mm256_mul_ps(sy, planeY[p]), sphereDistance);
+            sphereDistance = _mm256_add_ps(_mm256_mul_ps(sz, planeZ[p]), sphereDistance);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(sphereDistance, negRadius, _CMP_LT_OQ));
+
+            // Box is outside when its center distance is below minus its projected radius
+            __m256 boxDistance = _mm256_add_ps(_mm256_mul_ps(cx, planeX[p]), planeW[p]);
+            boxDistance = _mm256_add_ps(_mm256_mul_ps(cy, planeY[p]), boxDistance);
+            boxDistance = _mm256_add_ps(_mm256_mul_ps(cz, planeZ[p]), boxDistance);
+            __m256 boxRadius = _mm256_mul_ps(ex, absPlaneX[p]);
+            boxRadius = _mm256_add_ps(_mm256_mul_ps(ey, absPlaneY[p]), boxRadius);
+            boxRadius = _mm256_add_ps(_mm256_mul_ps(ez, absPlaneZ[p]), boxRadius);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(boxDistance, boxRadius), _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+
+        const int outsideMask = _mm256_movemask_ps(outside);
+        for (size_t lane = 0; lane < 8; ++lane)
+            m_Visibility[processed + lane] = ((outsideMask >> lane) & 1) ? 0 : 1;
+    }
+#elif defined(VRM_CULLING_SSE)
+    __m128 planeX[Frustum::Count], planeY[Frustum::Count], planeZ[Frustum::Count], planeW[Frustum::Count];
+    __m128 absPlaneX[Frustum::Count], absPlaneY[Frustum::Count], absPlaneZ[Frustum::Count];
+    for (int p = 0; p < Frustum::Count; ++p)
+    {
+        const auto& plane = frustum.planes[p];
+        planeX[p] = _mm_set1_ps(plane.x); absPlaneX[p] = _mm_set1_ps(std::abs(plane.x));
+        planeY[p] = _mm_set1_ps(plane.y); absPlaneY[p] = _mm_set1_ps(std::abs(plane.y));
+        planeZ[p] = _mm_set1_ps(plane.z); absPlaneZ[p] = _mm_set1_ps(std::abs(plane.z));
+        planeW[p] = _mm_set1_ps(plane.w);
+    }
+
+    for (; processed + 4 <= m_Count; processed += 4)
+    {
+        const __m128 sx = _mm_loadu_ps(&m_SphereX[processed]);
+        const __m128 sy = _mm_loadu_ps(&m_SphereY[processed]);
+        const __m128 sz = _mm_loadu_ps(&m_SphereZ[processed]);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&m_SphereRadius[processed]));
+        const __m128 cx = _mm_loadu_ps(&m_BoxCenterX[processed]);
+        const __m128 cy = _mm_loadu_ps(&m_BoxCenterY[processed]);
+        const __m128 cz = _mm_loadu_ps(&m_BoxCenterZ[processed]);
+        const __m128 ex = _mm_loadu_ps(&m_BoxExtentX[processed]);
+        const __m128 ey = _mm_loadu_ps(&m_BoxExtentY[processed]);
+        const __m128 ez = _mm_loadu_ps(&m_BoxExtentZ[processed]);
+
+        __m128 outside = _mm_setzero_ps();
+        for (int p = 0; p < Frustum::Count; ++p)
+        {
+            // Sphere is outside when its signed distance is below -radius
+            __m128 sphereDistance = _mm_add_ps(_mm_mul_ps(sx, planeX[p]), planeW[p]);
+            sphereDistance = _mm_add_ps(_mm_mul_ps(sy, planeY[p]), sphereDistance);
+            sphereDistance = _mm_add_ps(_mm_mul_ps(sz, planeZ[p]), sphereDistance);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(sphereDistance, negRadius));
+
+            // Box is outside when its center distance is below minus its projected radius
+            __m128 boxDistance = _mm_add_ps(_mm_mul_ps(cx, planeX[p]), planeW[p]);
+            boxDistance = _mm_add_ps(_mm_mul_ps(cy, planeY[p]), boxDistance);
+            boxDistance = _mm_add_ps(_mm_mul_ps(cz, planeZ[p]), boxDistance);
+            __m128 boxRadius = _mm_mul_ps(ex, absPlaneX[p]);
+            boxRadius = _mm_add_ps(_mm_mul_ps(ey, absPlaneY[p]), boxRadius);
+            boxRadius = _mm_add_ps(_mm_mul_ps(ez, absPlaneZ[p]), boxRadius);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(boxDistance, boxRadius), _mm_setzero_ps()));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (size_t lane = 0; lane < 4; ++lane)
+            m_Visibility[processed + lane] = ((outsideMask >> lane) & 1) ? 0 : 1;
+    }
+#endif
+
+    // Remaining volumes, or every volume without SIMD support
+    cullScalar(frustum, processed);
+
+    return static_cast<size_t>(std::count(m_Visibility.begin(), m_Visibility.end(), uint8_t(1)));
+}
+
+void FrustumCuller::cullScalar(const Frustum& frustum, size_t begin)
+{
+    for (size_t i = begin; i < m_Count; ++i)
+    {
+        bool outside = false;
+        for (const auto& plane : frustum.planes)
+        {
+            const float sphereDistance = plane.x * m_SphereX[i] + plane.y * m_SphereY[i] + plane.z * m_SphereZ[i] + plane.w;
+            const float boxDistance = plane.x * m_BoxCenterX[i] + plane.y * m_BoxCenterY[i] + plane.z * m_BoxCenterZ[i] + plane.w;
+            const float boxRadius = std::abs(plane.x) * m_BoxExtentX[i] + std::abs(plane.y) * m_BoxExtentY[i] + std::abs(plane.z) * m_BoxExtentZ[i];
+
+            if (sphereDistance < -m_SphereRadius[i] || boxDistance + boxRadius < 0.f)
+            {
+                outside = true;
+                break;
+            }
+        }
+
+        m_Visibility[i] = outside ? 0 : 1;
+    }
+}
+
+} // namespace vrm
@@ -0,0 +1,196 @@
+#include "Vroom/Render/Profiling/GPUProfiler.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Vroom/Render/Abstraction/GLCall.h"
+
+namespace vrm
+{
+
+// Marks open scopes which are not timed, because the profiler was disabled or outside of a frame when they started
+static constexpr size_t UNTIMED_RECORD = std::numeric_limits<size_t>::max();
+
+std::unique_ptr<GPUProfiler> GPUProfiler::s_Instance = nullptr;
+
+void GPUProfiler::Init()
+{
+    VRM_ASSERT_MSG(s_Instance == nullptr, "GPU profiler already initialized.");
+    s_Instance = std::unique_ptr<GPUProfiler>(new GPUProfiler());
+}
+
+void GPUProfiler::Shutdown()
+{
+    s_Instance.reset();
+}
+
+GPUProfiler& GPUProfiler::Get()
+{
+    VRM_ASSERT_MSG(s_Instance != nullptr, "GPU profiler not initialized.");
+    return *s_Instance;
+}
+
+bool GPUProfiler::IsInitialized()
+{
+    return s_Instance != nullptr;
+}
+
+GPUProfiler::~GPUProfiler()
+{
+    for (auto& frame : m_Frames)
+    {
+        if (!frame.queries.empty())
+        {
+            GLCall_nothrow(glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data()));
+        }
+    }
+}
+
+void GPUProfiler::beginFrame()
+{
+    VRM_DEBUG_ASSERT_MSG(!m_InFrame, "GPU profiler frame already started.");
+    m_InFrame = true;
+
+    // The queries of this slot were issued LatencyFrames frames ago
+    collectFrame(m_FrameIndex);
+
+    auto& frame = m_Frames[m_FrameIndex];
+    frame.usedQueryCount = 0;
+    frame.records.clear();
+}
+
+void GPUProfiler::endFrame()
+{
+    VRM_DEBUG_ASSERT_MSG(m_InFrame, "GPU profiler frame not started.");
+    VRM_DEBUG_ASSERT_MSG(m_OpenRecords.empty(), "GPU profiler scopes still open at the end of the frame.");
+
+    m_InFrame = false;
+    m_FrameIndex = (m_FrameIndex + 1) % LatencyFrames;
+}
+
+void GPUProfiler::beginScope(std::string_view name)
+{
+    GLCall(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, (GLsizei)name.size(), name.data()));
+
+    if (!m_Enabled || !m_InFrame)
+    {
+        m_OpenRecords.push_back(UNTIMED_RECORD);
+        return;
+    }
+
+    auto& frame = m_Frames[m_FrameIndex];
+    const size_t scopeIndex = getScopeIndex(name, static_cast<unsigned int>(m_OpenRecords.size()));
+
+    // Timestamps rather than elapsed time queries, because elapsed time queries cannot be nested
+    const unsigned int beginQuery = acquireQuery();
+    GLCall(glQueryCounter(beginQuery, GL_TIMESTAMP));
+
+    frame.records.push_back({ scopeIndex, beginQuery, 0 });
+    m_OpenRecords.push_back(frame.records.size() - 1);
+}
+
+void GPUProfiler::endScope()
+{
+    VRM_DEBUG_ASSERT_MSG(!m_OpenRecords.empty(), "No GPU profiler scope to end.");
+
+    const size_t recordIndex = m_OpenRecords.back();
+    m_OpenRecords.pop_back();
+
+    if (recordIndex != UNTIMED_RECORD)
+    {
+        const unsigned int endQuery = acquireQuery();
+        GLCall(glQueryCounter(endQuery, GL_TIMESTAMP));
+        m_Frames[m_FrameIndex].records[recordIndex].endQuery = endQuery;
+    }
+
+    GLCall(glPopDebugGroup());
+}
+
+size_t GPUProfiler::getScopeIndex(std::string_view name, unsigned int depth)
+{
+    if (auto it = m_ScopeIndices.find(name); it != m_ScopeIndices.end())
+    {
+        m_Scopes[it->second].depth = depth;
+        return it->second;
+    }
+
+    m_Scopes.push_back({ std::string(name), depth });
+    m_ScopeIndices.emplace(std::string(name), m_Scopes.size() - 1);
+    return m_Scopes.size() - 1;
+}
+
+unsigned int GPUProfiler::acquireQuery()
+{
+    auto& frame = m_Frames[m_FrameIndex];
+    if (frame.usedQueryCount == frame.queries.size())
+    {
+        unsigned int query = 0;
+        GLCall(glGenQueries(1, &query));
+        frame.queries.push_back(query);
+    }
+
+    return frame.queries[frame.usedQueryCount++];
+}
+
+void GPUProfiler::clearStatistics()
+{
+    for (auto& scope : m_Scopes)
+        scope.milliseconds.clear();
+}
+
+void GPUProfiler::collectFrame(unsigned int frameIndex)
+{
+    const auto& frame = m_Frames[frameIndex];
+    if (frame.records.empty())
+        return;
+
+    // Never waiting: if the GPU is still behind, the frame is dropped
+    for (const auto& record : frame.records)
+    {
+        GLint available = 0;
+        GLCall(glGetQueryObjectiv(record.endQuery, GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+        {
+            m_DroppedFrameCount++;
+            return;
+        }
+    }
+
+    m_CollectedFrameCount++;
+
+    // A scope can be entered several times per frame (one per scene for instance), its samples are the sum of them
+    std::vector<double> frameMilliseconds(m_Scopes.size(), -1.0);
+    for (const auto& record : frame.records)
+    {
+        GLuint64 begin = 0, end = 0;
+        GLCall(glGetQueryObjectui64v(record.beginQuery, GL_QUERY_RESULT, &begin));
+        GLCall(glGetQueryObjectui64v(record.endQuery, GL_QUERY_RESULT, &end));
+
+        double& milliseconds = frameMilliseconds[record.scopeIndex];
+        milliseconds = std::max(milliseconds, 0.0) + static_cast<double>(end - begin) / 1'000'000.0;
+    }
+
+    for (size_t i = 0; i < m_Scopes.size(); ++i)
+    {
+        if (frameMilliseconds[i] >= 0.0)
+        {
+            m_Scopes[i].milliseconds.push(static_cast<float>(frameMilliseconds[i]));
+            m_Scopes[i].lastFrame = m_CollectedFrameCount;
+        }
+    }
+}
+
+GPUProfileScope::GPUProfileScope(std::string_view name)
+    : m_Active(GPUProfiler::IsInitialized())
+{
+    if (m_Active)
+        GPUProfiler::Get().beginScope(name);
+}
+
+GPUProfileScope::~GPUProfileScope()
+{
+    if (m_Active && GPUProfiler::IsInitialized())
+        GPUProfiler::Get().endScope();
+}
+
+} // namespace vrm
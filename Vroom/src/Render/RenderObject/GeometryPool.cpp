@@ -0,0 +1,261 @@
+#include "Vroom/Render/RenderObject/GeometryPool.h"
+
+#include <algorithm>
+
+#include "Vroom/Core/Assert.h"
+#include "Vroom/Core/FrameStats.h"
+#include "Vroom/Core/Log.h"
+#include "Vroom/Asset/AssetData/Vertex.h"
+#include "Vroom/Render/Abstraction/GLCall.h"
+
+namespace vrm
+{
+
+// Initial capacities, in elements. Buffers grow by doubling.
+static constexpr size_t INITIAL_VERTEX_CAPACITY = 1 << 16;
+static constexpr size_t INITIAL_INDEX_CAPACITY = 1 << 18;
+
+std::array<std::unique_ptr<GeometryPool>, 4> GeometryPool::s_Pools = {};
+bool GeometryPool::s_Initialized = false;
+
+void GeometryPool::Init()
+{
+    VRM_ASSERT_MSG(!s_Initialized, "Geometry pools already initialized.");
+    s_Initialized = true;
+}
+
+void GeometryPool::Shutdown()
+{
+    for (auto& pool : s_Pools)
+        pool.reset();
+    s_Initialized = false;
+}
+
+GeometryPool& GeometryPool::Get(VertexFormat vertexFormat, IndexType indexType)
+{
+    VRM_ASSERT_MSG(s_Initialized, "Geometry pools not initialized.");
+
+    auto& pool = s_Pools[static_cast<size_t>(vertexFormat) * 2 + static_cast<size_t>(indexType)];
+    if (!pool)
+        pool = std::unique_ptr<GeometryPool>(new GeometryPool(vertexFormat, indexType));
+    return *pool;
+}
+
+bool GeometryPool::IsInitialized()
+{
+    return s_Initialized;
+}
+
+GeometryPool::IndexType GeometryPool::SelectIndexType(size_t vertexCount)
+{
+    return vertexCount <= 65536 ? IndexType::UInt16 : IndexType::UInt32;
+}
+
+GeometryPool::GeometryPool(VertexFormat vertexFormat, IndexType indexType)
+    : m_VertexFormat(vertexFormat), m_IndexType(indexType), m_VertexAllocator(0), m_IndexAllocator(0)
+{
+    switch (vertexFormat)
+    {
+    case VertexFormat::Standard:
+        m_Layout.pushFloat(3);
+        m_Layout.pushFloat(3);
+        m_Layout.pushFloat(2);
+        break;
+    case VertexFormat::Packed:
+        m_Layout.pushUShortNormalized(4);
+        m_Layout.pushShortNormalized(2);
+        m_Layout.pushHalfFloat(2);
+        break;
+    }
+
+    growBuffer(true, INITIAL_VERTEX_CAPACITY);
+    growBuffer(false, INITIAL_INDEX_CAPACITY);
+}
+
+GeometryPool::~GeometryPool()
+{
+    GLCall_nothrow(glDeleteBuffers(1, &m_VertexBufferID));
+    GLCall_nothrow(glDeleteBuffers(1, &m_IndexBufferID));
+}
+
+GeometryPool::Handle GeometryPool::allocate(const void* vertices, unsigned int vertexCount, const void* indices, unsigned int indexCount)
+{
+    VRM_ASSERT_MSG(vertexCount > 0 && indexCount > 0, "Cannot add an empty mesh to the geometry pool.");
+
+    Allocation allocation;
+    allocation.vertexCount = vertexCount;
+    allocation.indexCount = indexCount;
+
+    // Compaction and growth happen before allocating, because compacting moves every live range.
+    ensureFreeSpace(vertexCount, indexCount);
+    const auto baseVertex = m_VertexAllocator.allocate(vertexCount);
+    const auto firstIndex = m_IndexAllocator.allocate(indexCount);
+    VRM_ASSERT_MSG(baseVertex.has_value() && firstIndex.has_value(), "Geometry pool allocation failed after making space.");
+    allocation.baseVertex = static_cast<unsigned int>(*baseVertex);
+    allocation.firstIndex = static_cast<unsigned int>(*firstIndex);
+    allocation.alive = true;
+
+    const unsigned int stride = m_Layout.getStride();
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_VertexBufferID));
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.baseVertex * stride, (GLsizeiptr)vertexCount * stride, vertices));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_IndexBufferID));
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.firstIndex * getIndexSize(), (GLsizeiptr)indexCount * getIndexSize(), indices));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    FrameStats::Get().add(FrameStats::Counter::BytesUploaded, static_cast<double>(vertexCount * stride + indexCount * getIndexSize()));
+
+    Handle handle;
+    if (!m_FreeHandles.empty())
+    {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+        m_Allocations[handle] = allocation;
+    }
+    else
+    {
+        handle = static_cast<Handle>(m_Allocations.size());
+        m_Allocations.push_back(allocation);
+    }
+
+    return handle;
+}
+
+void GeometryPool::free(Handle handle)
+{
+    VRM_ASSERT_MSG(handle < m_Allocations.size() && m_Allocations[handle].alive, "Invalid geometry pool handle.");
+
+    auto& allocation = m_Allocations[handle];
+    m_VertexAllocator.free(allocation.baseVertex, allocation.vertexCount);
+    m_IndexAllocator.free(allocation.firstIndex, allocation.indexCount);
+    allocation.alive = false;
+
+    m_FreeHandles.push_back(handle);
+}
+
+void GeometryPool::compact()
+{
+    const unsigned int stride = m_Layout.getStride();
+    const unsigned int indexSize = getIndexSize();
+
+    // Copying every live range to new buffers of the same capacity, packed from the start.
+    // Copies within a single buffer cannot overlap, so going through new buffers is simpler than moving ranges in place.
+    unsigned int newVertexBufferID = 0, newIndexBufferID = 0;
+    GLCall(glGenBuffers(1, &newVertexBufferID));
+    GLCall(glGenBuffers(1, &newIndexBufferID));
+
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, newVertexBufferID));
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)m_VertexAllocator.getCapacity() * stride, nullptr, GL_STATIC_DRAW));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, newIndexBufferID));
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)m_IndexAllocator.getCapacity() * indexSize, nullptr, GL_STATIC_DRAW));
+
+    m_VertexAllocator.clear();
+    m_IndexAllocator.clear();
+
+    for (auto& allocation : m_Allocations)
+    {
+        if (!allocation.alive)
+            continue;
+
+        // Allocators are empty, so ranges are given in order, without holes.
+        const unsigned int baseVertex = static_cast<unsigned int>(*m_VertexAllocator.allocate(allocation.vertexCount));
+        const unsigned int firstIndex = static_cast<unsigned int>(*m_IndexAllocator.allocate(allocation.indexCount));
+
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_VertexBufferID));
+        GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, newVertexBufferID));
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            (GLintptr)allocation.baseVertex * stride, (GLintptr)baseVertex * stride, (GLsizeiptr)allocation.vertexCount * stride));
+
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_IndexBufferID));
+        GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, newIndexBufferID));
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            (GLintptr)allocation.firstIndex * indexSize, (GLintptr)firstIndex * indexSize, (GLsizeiptr)allocation.indexCount * indexSize));
+
+        // Indices are relative to the base vertex, so they stay valid without any rewrite.
+        allocation.baseVertex = baseVertex;
+        allocation.firstIndex = firstIndex;
+    }
+
+    GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    GLCall(glDeleteBuffers(1, &m_VertexBufferID));
+    GLCall(glDeleteBuffers(1, &m_IndexBufferID));
+    m_VertexBufferID = newVertexBufferID;
+    m_IndexBufferID = newIndexBufferID;
+
+    setupVertexArray();
+
+    VRM_LOG_TRACE("Geometry pool compacted: {} vertices, {} indices in use.", m_VertexAllocator.getUsed(), m_IndexAllocator.getUsed());
+}
+
+void GeometryPool::ensureFreeSpace(unsigned int vertexCount, unsigned int indexCount)
+{
+    const bool verticesFit = m_VertexAllocator.getLargestFreeRange() >= vertexCount;
+    const bool indicesFit = m_IndexAllocator.getLargestFreeRange() >= indexCount;
+    if (verticesFit && indicesFit)
+        return;
+
+    // Enough free space, but fragmented: compacting merges it into a single range at the end.
+    if ((!verticesFit && m_VertexAllocator.getFree() >= vertexCount) || (!indicesFit && m_IndexAllocator.getFree() >= indexCount))
+        compact();
+
+    // Not enough free space: the new space only merges with the free range at the end of the buffer, holes before the
+    // last allocated range do not count
+    if (m_VertexAllocator.getLargestFreeRange() < vertexCount)
+        growBuffer(true, std::max(m_VertexAllocator.getCapacity() * 2, m_VertexAllocator.getUsedEnd() + vertexCount));
+
+    if (m_IndexAllocator.getLargestFreeRange() < indexCount)
+        growBuffer(false, std::max(m_IndexAllocator.getCapacity() * 2, m_IndexAllocator.getUsedEnd() + indexCount));
+}
+
+void GeometryPool::growBuffer(bool isVertex, size_t capacity)
+{
+    unsigned int& bufferID = isVertex ? m_VertexBufferID : m_IndexBufferID;
+    RangeAllocator& allocator = isVertex ? m_VertexAllocator : m_IndexAllocator;
+    const size_t elementSize = isVertex ? m_Layout.getStride() : getIndexSize();
+
+    unsigned int newBufferID = 0;
+    GLCall(glGenBuffers(1, &newBufferID));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, newBufferID));
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)(capacity * elementSize), nullptr, GL_STATIC_DRAW));
+
+    // Copying the old content on the GPU, without going through client memory
+    if (bufferID != 0)
+    {
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, bufferID));
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)(allocator.getCapacity() * elementSize)));
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        GLCall(glDeleteBuffers(1, &bufferID));
+    }
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    bufferID = newBufferID;
+    allocator.grow(capacity);
+
+    if (m_VertexBufferID != 0 && m_IndexBufferID != 0)
+        setupVertexArray();
+
+    VRM_LOG_TRACE("Geometry pool {} buffer grown to {} elements.", isVertex ? "vertex" : "index", capacity);
+}
+
+void GeometryPool::setupVertexArray()
+{
+    m_VertexArray.bind();
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID));
+
+    const auto& elements = m_Layout.getElements();
+    GLintptr offset = 0;
+    for (unsigned int i = 0; i < elements.size(); i++)
+    {
+        const auto& element = elements[i];
+        GLCall(glEnableVertexAttribArray(i));
+        GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized, m_Layout.getStride(), (GLvoid*)offset));
+        offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+    }
+
+    // Element buffer binding is part of the vertex array state
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID));
+    m_VertexArray.unbind();
+}
+
+} // namespace vrm
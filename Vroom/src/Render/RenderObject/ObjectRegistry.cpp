@@ -0,0 +1,340 @@
+#include "Vroom/Render/RenderObject/ObjectRegistry.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Vroom/Core/Assert.h"
+#include "Vroom/Asset/StaticAsset/MaterialAsset.h"
+#include "Vroom/Render/Abstraction/GLCall.h"
+#include "Vroom/Render/RenderQueue/RenderKey.h"
+
+namespace vrm
+{
+
+// Object of a sub mesh. Packed meshes are culled in stored position space: the sphere is brought to quantized space, and
+// the model matrix includes the dequantization.
+static SSBOObjectData BuildObject(const MeshAsset::SubMesh& subMesh, const glm::mat4& model, uint32_t commandIndex)
+{
+    const auto& sphere = subMesh.meshData.getBoundingSphere();
+    const auto& renderMesh = subMesh.renderMesh;
+
+    if (renderMesh.isPacked())
+    {
+        const auto& quantization = renderMesh.getPositionQuantization();
+        const glm::vec4 quantizedSphere((sphere.center - quantization.offset) / quantization.scale, sphere.radius / quantization.scale);
+        return { model * renderMesh.getPositionTransform(), quantizedSphere, commandIndex, { 0, 0, 0 } };
+    }
+
+    return { model, glm::vec4(sphere.center, sphere.radius), commandIndex, { 0, 0, 0 } };
+}
+
+static uint64_t BuildCommandKey(const MeshAsset::SubMesh& subMesh)
+{
+    const MaterialAsset* material = subMesh.materialInstance.getStaticAsset();
+    return RenderKey::Build(
+        RenderPass::Opaque,
+        material->getShader(subMesh.renderMesh.getVertexFormat()).getID(),
+        material->getID(),
+        material->getTextureSetID(),
+        subMesh.renderMesh.getID(),
+        0.f
+    );
+}
+
+void ObjectRegistry::setBindingPoints(int objectBindingPoint, int drawCommandBindingPoint)
+{
+    m_ObjectBindingPoint = objectBindingPoint;
+    m_DrawCommandBindingPoint = drawCommandBindingPoint;
+}
+
+void ObjectRegistry::beginFrame()
+{
+    m_Frame++;
+}
+
+void ObjectRegistry::submitMesh(const MeshInstance& mesh, const glm::mat4& model, entt::entity entity)
+{
+    VRM_DEBUG_ASSERT_MSG(entity != entt::null, "Meshes of the GPU driven renderer need an entity.");
+
+    const size_t entityIndex = static_cast<size_t>(entt::to_entity(entity));
+    if (entityIndex >= m_EntryIndices.size())
+        m_EntryIndices.resize(entityIndex + 1, NoIndex);
+
+    unsigned int entryIndex = m_EntryIndices[entityIndex];
+    if (entryIndex == NoIndex)
+    {
+        entryIndex = static_cast<unsigned int>(m_Entries.size());
+        m_EntryIndices[entityIndex] = entryIndex;
+        m_Entries.push_back({ entity, mesh, model, m_Frame, {} });
+        addObjects(entryIndex);
+        return;
+    }
+
+    auto& entry = m_Entries[entryIndex];
+    entry.frame = m_Frame;
+
+    if (entry.mesh.getStaticAsset() != mesh.getStaticAsset())
+    {
+        removeObjects(entryIndex);
+        m_Entries[entryIndex].mesh = mesh;
+        m_Entries[entryIndex].model = model;
+        addObjects(entryIndex);
+    }
+    else if (entry.model != model)
+    {
+        entry.model = model;
+        writeObjects(entryIndex);
+    }
+}
+
+void ObjectRegistry::prepareFrame()
+{
+    for (unsigned int entryIndex = 0; entryIndex < m_Entries.size();)
+    {
+        // The last entry moves to this index, and is checked next
+        if (m_Entries[entryIndex].frame != m_Frame)
+            removeEntry(entryIndex);
+        else
+            entryIndex++;
+    }
+
+    if (m_CommandsUnsorted)
+        sortCommands();
+
+    buildDrawCommands();
+    buildDirtyRanges();
+}
+
+void ObjectRegistry::endFrame()
+{
+    prepareFrame();
+
+    // Blocks grow when written past their capacity, and shrink after quiet frames once objects are removed
+    for (const auto& range : m_DirtyRanges)
+    {
+        m_ObjectSSBO.setSubData(reinterpret_cast<const std::byte*>(m_Objects.data()) + range.offset,
+            static_cast<int>(range.size), static_cast<int>(range.offset));
+    }
+    m_ObjectSSBO.truncate(static_cast<int>(m_Objects.size() * sizeof(SSBOObjectData)));
+    m_ObjectSSBO.endFrame();
+
+    const int drawCommandsSize = static_cast<int>(m_DrawCommands.size() * sizeof(SSBODrawCommand));
+    if (m_DrawCommandsChanged && drawCommandsSize > 0)
+        m_DrawCommandTemplateSSBO.setData(m_DrawCommands.data(), drawCommandsSize);
+
+    // Instance counts are reset by copying the template on the GPU, after the draws of the previous frame read them
+    if (drawCommandsSize > 0)
+    {
+        if (m_DrawCommandSSBO.getCapacity() < drawCommandsSize)
+            m_DrawCommandSSBO.setData(nullptr, drawCommandsSize);
+
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_DrawCommandTemplateSSBO.getRendererID()));
+        GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_DrawCommandSSBO.getRendererID()));
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)drawCommandsSize));
+        GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+    }
+
+    m_ObjectSSBO.setBindingPoint(m_ObjectBindingPoint);
+    m_DrawCommandSSBO.setBindingPoint(m_DrawCommandBindingPoint);
+}
+
+void ObjectRegistry::addObjects(unsigned int entryIndex)
+{
+    auto& entry = m_Entries[entryIndex];
+    for (const auto& subMesh : entry.mesh.getStaticAsset()->getSubMeshes())
+    {
+        // Sub meshes seen for the first time get a command at the end, until commands are sorted again
+        auto [it, inserted] = m_CommandIndices.try_emplace(&subMesh, static_cast<unsigned int>(m_Commands.size()));
+        if (inserted)
+        {
+            m_Commands.push_back({ &subMesh, BuildCommandKey(subMesh), 0 });
+            m_CommandsUnsorted = true;
+        }
+        m_Commands[it->second].objectCount++;
+
+        const unsigned int slot = static_cast<unsigned int>(m_Objects.size());
+        m_Objects.push_back(BuildObject(subMesh, entry.model, it->second));
+        m_ObjectEntries.push_back(entryIndex);
+        m_ObjectSubMeshes.push_back(&subMesh);
+        entry.objects.push_back(slot);
+        markDirty(slot);
+    }
+}
+
+void ObjectRegistry::writeObjects(unsigned int entryIndex)
+{
+    const auto& entry = m_Entries[entryIndex];
+    for (unsigned int slot : entry.objects)
+    {
+        m_Objects[slot] = BuildObject(*m_ObjectSubMeshes[slot], entry.model, m_Objects[slot].commandIndex);
+        markDirty(slot);
+    }
+}
+
+void ObjectRegistry::removeObjects(unsigned int entryIndex)
+{
+    // From the last slot: the last object of the block, moved to each freed slot, never belongs to this entry
+    auto& slots = m_Entries[entryIndex].objects;
+    std::sort(slots.begin(), slots.end(), std::greater<unsigned int>());
+
+    for (unsigned int slot : slots)
+    {
+        auto& command = m_Commands[m_Objects[slot].commandIndex];
+        if (--command.objectCount == 0)
+            m_CommandsUnsorted = true;
+
+        const unsigned int lastSlot = static_cast<unsigned int>(m_Objects.size() - 1);
+        if (slot != lastSlot)
+        {
+            m_Objects[slot] = m_Objects[lastSlot];
+            m_ObjectEntries[slot] = m_ObjectEntries[lastSlot];
+            m_ObjectSubMeshes[slot] = m_ObjectSubMeshes[lastSlot];
+
+            auto& movedSlots = m_Entries[m_ObjectEntries[slot]].objects;
+            *std::find(movedSlots.begin(), movedSlots.end(), lastSlot) = slot;
+            markDirty(slot);
+        }
+
+        m_Objects.pop_back();
+        m_ObjectEntries.pop_back();
+        m_ObjectSubMeshes.pop_back();
+    }
+
+    slots.clear();
+}
+
+void ObjectRegistry::removeEntry(unsigned int entryIndex)
+{
+    removeObjects(entryIndex);
+    m_EntryIndices[static_cast<size_t>(entt::to_entity(m_Entries[entryIndex].entity))] = NoIndex;
+
+    const unsigned int lastIndex = static_cast<unsigned int>(m_Entries.size() - 1);
+    if (entryIndex != lastIndex)
+    {
+        m_Entries[entryIndex] = std::move(m_Entries[lastIndex]);
+        m_EntryIndices[static_cast<size_t>(entt::to_entity(m_Entries[entryIndex].entity))] = entryIndex;
+        for (unsigned int slot : m_Entries[entryIndex].objects)
+            m_ObjectEntries[slot] = entryIndex;
+    }
+
+    m_Entries.pop_back();
+}
+
+void ObjectRegistry::markDirty(unsigned int slot)
+{
+    if (slot >= m_DirtyFlags.size())
+        m_DirtyFlags.resize(slot + 1, 0);
+
+    if (!m_DirtyFlags[slot])
+    {
+        m_DirtyFlags[slot] = 1;
+        m_DirtyObjects.push_back(slot);
+    }
+}
+
+void ObjectRegistry::sortCommands()
+{
+    // Commands left without objects are dropped: their sub mesh may be gone with its mesh
+    std::vector<unsigned int> order;
+    for (unsigned int i = 0; i < m_Commands.size(); ++i)
+    {
+        if (m_Commands[i].objectCount > 0)
+            order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) { return m_Commands[a].key < m_Commands[b].key; });
+
+    std::vector<unsigned int> newIndices(m_Commands.size(), NoIndex);
+    std::vector<Command> commands;
+    commands.reserve(order.size());
+    m_CommandIndices.clear();
+    for (unsigned int index : order)
+    {
+        newIndices[index] = static_cast<unsigned int>(commands.size());
+        m_CommandIndices[m_Commands[index].subMesh] = static_cast<unsigned int>(commands.size());
+        commands.push_back(m_Commands[index]);
+    }
+    m_Commands = std::move(commands);
+
+    // Only the objects whose command moved are written again
+    for (unsigned int slot = 0; slot < m_Objects.size(); ++slot)
+    {
+        const unsigned int commandIndex = newIndices[m_Objects[slot].commandIndex];
+        if (commandIndex != m_Objects[slot].commandIndex)
+        {
+            m_Objects[slot].commandIndex = commandIndex;
+            markDirty(slot);
+        }
+    }
+
+    // Consecutive commands drawing with the same material from the same geometry pool are submitted with a single multi
+    // draw. The pool defines the vertex array and the index type, which are shared by every command of a multi draw.
+    m_IndirectBatches.clear();
+    for (unsigned int i = 0; i < m_Commands.size(); ++i)
+    {
+        const auto* subMesh = m_Commands[i].subMesh;
+        if (m_IndirectBatches.empty()
+            || m_IndirectBatches.back().subMesh->materialInstance.getStaticAsset() != subMesh->materialInstance.getStaticAsset()
+            || &m_IndirectBatches.back().subMesh->renderMesh.getVertexArray() != &subMesh->renderMesh.getVertexArray())
+        {
+            m_IndirectBatches.push_back({ subMesh, i, 0 });
+        }
+        m_IndirectBatches.back().commandCount++;
+    }
+
+    m_CommandsUnsorted = false;
+}
+
+void ObjectRegistry::buildDrawCommands()
+{
+    // Few commands, one per unique sub mesh. Geometry ranges are read every frame, since compacting the geometry pools
+    // moves them.
+    m_DrawCommandsChanged = m_DrawCommands.size() != m_Commands.size();
+    m_DrawCommands.resize(m_Commands.size());
+
+    uint32_t baseInstance = 0;
+    for (size_t i = 0; i < m_Commands.size(); ++i)
+    {
+        const auto& renderMesh = m_Commands[i].subMesh->renderMesh;
+        const SSBODrawCommand command = {
+            renderMesh.getIndexCount(), 0, renderMesh.getFirstIndex(), static_cast<int32_t>(renderMesh.getBaseVertex()), baseInstance
+        };
+        baseInstance += m_Commands[i].objectCount;
+
+        auto& current = m_DrawCommands[i];
+        if (current.count != command.count || current.firstIndex != command.firstIndex || current.baseVertex != command.baseVertex
+            || current.baseInstance != command.baseInstance)
+        {
+            current = command;
+            m_DrawCommandsChanged = true;
+        }
+    }
+}
+
+void ObjectRegistry::buildDirtyRanges()
+{
+    m_DirtyRanges.clear();
+
+    std::sort(m_DirtyObjects.begin(), m_DirtyObjects.end());
+    for (unsigned int slot : m_DirtyObjects)
+        m_DirtyFlags[slot] = 0;
+
+    // Close objects share a range, since a copy costs more than a few unchanged objects
+    const size_t mergeGap = DirtyRangeMergeGap * sizeof(SSBOObjectData);
+    for (unsigned int slot : m_DirtyObjects)
+    {
+        // Removed objects past the end of the block are not drawn anymore
+        if (slot >= m_Objects.size())
+            break;
+
+        const size_t offset = static_cast<size_t>(slot) * sizeof(SSBOObjectData);
+        if (!m_DirtyRanges.empty() && offset <= m_DirtyRanges.back().offset + m_DirtyRanges.back().size + mergeGap)
+            m_DirtyRanges.back().size = offset + sizeof(SSBOObjectData) - m_DirtyRanges.back().offset;
+        else
+            m_DirtyRanges.push_back({ offset, sizeof(SSBOObjectData) });
+    }
+
+    m_DirtyObjects.clear();
+}
+
+} // namespace vrm
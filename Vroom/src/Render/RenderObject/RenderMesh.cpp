@@ -1,37 +1,64 @@
 #include "Vroom/Render/RenderObject/RenderMesh.h"
 
+#include <vector>
+
 #include "Vroom/Core/Log.h"
 
 namespace vrm
 {
 
-RenderMesh::RenderMesh(const MeshData& meshData)
-    : m_VertexBuffer(meshData.getRawVericesData(), (unsigned int)meshData.getVertexCount() * sizeof(Vertex)),
-      m_IndexBuffer(meshData.getRawIndicesData(), (unsigned int)meshData.getIndexCount())
+RenderMesh::RenderMesh(const MeshData& meshData, VertexFormat vertexFormat)
+    : m_VertexFormat(vertexFormat), m_IndexType(GeometryPool::SelectIndexType(meshData.getVertexCount()))
 {
-    m_VertexBufferLayout.pushFloat(3);
-    m_VertexBufferLayout.pushFloat(3);
-    m_VertexBufferLayout.pushFloat(2);
+    if (meshData.getVertexCount() == 0 || meshData.getIndexCount() == 0)
+    {
+        VRM_LOG_WARN("Creating a render mesh without geometry.");
+        return;
+    }
 
-    m_VertexArray.addBuffer(m_VertexBuffer, m_VertexBufferLayout);
+    const void* vertices = meshData.getRawVericesData();
+    std::vector<PackedVertex> packedVertices;
+    if (m_VertexFormat == VertexFormat::Packed)
+    {
+        m_Quantization = VertexPacking::ComputeQuantization(meshData.getBoundingBox());
+        m_PositionTransform = m_Quantization.getMatrix();
+        packedVertices = VertexPacking::Pack(meshData.getVertices(), m_Quantization);
+        vertices = packedVertices.data();
+    }
+
+    // Mesh data always keeps 32 bits indices, narrowing happens at upload.
+    const void* indices = meshData.getRawIndicesData();
+    std::vector<uint16_t> shortIndices;
+    if (m_IndexType == GeometryPool::IndexType::UInt16)
+    {
+        shortIndices.assign(meshData.getIndices().begin(), meshData.getIndices().end());
+        indices = shortIndices.data();
+    }
+
+    m_Handle = getPool().allocate(
+        vertices, (unsigned int)meshData.getVertexCount(),
+        indices, (unsigned int)meshData.getIndexCount()
+    );
 }
 
 RenderMesh::RenderMesh(RenderMesh&& other)
-    : m_VertexBuffer(std::move(other.m_VertexBuffer)),
-      m_IndexBuffer(std::move(other.m_IndexBuffer)),
-      m_VertexArray(std::move(other.m_VertexArray)),
-      m_VertexBufferLayout(std::move(other.m_VertexBufferLayout))
+    : m_Handle(other.m_Handle), m_VertexFormat(other.m_VertexFormat), m_IndexType(other.m_IndexType),
+      m_Quantization(other.m_Quantization), m_PositionTransform(other.m_PositionTransform)
 {
+    other.m_Handle = GeometryPool::InvalidHandle;
 }
 
 RenderMesh& RenderMesh::operator=(RenderMesh&& other)
 {
     if (this != &other)
     {
-        m_VertexBuffer = std::move(other.m_VertexBuffer);
-        m_IndexBuffer = std::move(other.m_IndexBuffer);
-        m_VertexArray = std::move(other.m_VertexArray);
-        m_VertexBufferLayout = std::move(other.m_VertexBufferLayout);
+        release();
+        m_Handle = other.m_Handle;
+        m_VertexFormat = other.m_VertexFormat;
+        m_IndexType = other.m_IndexType;
+        m_Quantization = other.m_Quantization;
+        m_PositionTransform = other.m_PositionTransform;
+        other.m_Handle = GeometryPool::InvalidHandle;
     }
 
     return *this;
@@ -39,6 +66,16 @@ RenderMesh& RenderMesh::operator=(RenderMesh&& other)
 
 RenderMesh::~RenderMesh()
 {
+    release();
+}
+
+void RenderMesh::release()
+{
+    // Guarding against render meshes outliving the pool
+    if (m_Handle != GeometryPool::InvalidHandle && GeometryPool::IsInitialized())
+        getPool().free(m_Handle);
+
+    m_Handle = GeometryPool::InvalidHandle;
 }
 
-} // namespace vrm
\ No newline at end of file
+} // namespace vrm
@@ -0,0 +1,68 @@
+#include "Vroom/Render/RenderQueue/RenderQueue.h"
+
+#include <array>
+
+namespace vrm
+{
+
+void RenderQueue::clear()
+{
+    m_Packets.clear();
+}
+
+void RenderQueue::reserve(size_t packetCount)
+{
+    m_Packets.reserve(packetCount);
+}
+
+void RenderQueue::push(const DrawPacket& packet)
+{
+    m_Packets.push_back(packet);
+}
+
+void RenderQueue::sort()
+{
+    constexpr size_t RadixBits = 8;
+    constexpr size_t BucketCount = 1 << RadixBits;
+    constexpr size_t PassCount = sizeof(uint64_t) * 8 / RadixBits;
+
+    const size_t count = m_Packets.size();
+    if (count < 2)
+        return;
+
+    // Computing every histogram in a single read of the keys.
+    std::array<std::array<size_t, BucketCount>, PassCount> histograms = {};
+    for (const auto& packet : m_Packets)
+    {
+        for (size_t pass = 0; pass < PassCount; ++pass)
+            histograms[pass][(packet.key >> (pass * RadixBits)) & (BucketCount - 1)]++;
+    }
+
+    m_Scratch.resize(count);
+
+    for (size_t pass = 0; pass < PassCount; ++pass)
+    {
+        auto& histogram = histograms[pass];
+        const size_t shift = pass * RadixBits;
+
+        // If every key has the same digit, this pass would not change anything.
+        if (histogram[(m_Packets.front().key >> shift) & (BucketCount - 1)] == count)
+            continue;
+
+        // Exclusive prefix sum gives the first output slot of each bucket.
+        size_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        for (const auto& packet : m_Packets)
+            m_Scratch[histogram[(packet.key >> shift) & (BucketCount - 1)]++] = packet;
+
+        m_Packets.swap(m_Scratch);
+    }
+}
+
+} // namespace vrm
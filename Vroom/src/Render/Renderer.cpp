@@ -1,9 +1,13 @@
 #include "Vroom/Render/Renderer.h"
 
+#include <algorithm>
 #include <array>
+#include <string>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Vroom/Core/Application.h"
+#include "Vroom/Core/FrameStats.h"
+#include "Vroom/Core/Profiler.h"
 
 #include "Vroom/Render/Abstraction/GLCall.h"
 #include "Vroom/Render/Abstraction/VertexArray.h"
@@ -14,12 +18,19 @@
 #include "Vroom/Render/Abstraction/FrameBuffer.h"
 
 #include "Vroom/Render/RawShaderData/SSBOPointLightData.h"
+#include "Vroom/Render/RawShaderData/UBOFrameData.h"
+#include "Vroom/Render/RawShaderData/SSBODrawCommand.h"
+
+#include "Vroom/Render/RenderQueue/RenderKey.h"
+
+#include "Vroom/Render/Profiling/GPUProfiler.h"
 
 #include "Vroom/Asset/AssetManager.h"
 #include "Vroom/Asset/StaticAsset/ShaderAsset.h"
 #include "Vroom/Asset/StaticAsset/MaterialAsset.h"
 #include "Vroom/Asset/StaticAsset/TextureAsset.h"
 #include "Vroom/Asset/StaticAsset/MeshAsset.h"
+#include "Vroom/Asset/StaticAsset/ComputeShaderAsset.h"
 
 #include "Vroom/Scene/Components/PointLightComponent.h"
 
@@ -42,8 +53,11 @@ namespace vrm
 
 std::unique_ptr<Renderer> Renderer::s_Instance = nullptr;
 
+// Initial size of each frame region of the ring buffer. It grows when a frame needs more.
+static constexpr size_t FRAME_RING_CAPACITY = 4 << 20;
+
 Renderer::Renderer()
-    : m_ScreenQuadVBO(SCREEN_QUAD_VERTICES, 16 * sizeof(float)), m_ScreenQuadIBO(SCREEN_QUAD_INDICES, 6)
+    : m_ScreenQuadVBO(SCREEN_QUAD_VERTICES, 16 * sizeof(float)), m_ScreenQuadIBO(SCREEN_QUAD_INDICES, 6), m_FrameRing(FRAME_RING_CAPACITY)
 {
     // Initializing frame buffering data.
     m_ScreenShader = AssetManager::Get().getAsset<ShaderAsset>("Resources/Engine/Shader/ScreenShader/RenderShader_Screen.asset");
@@ -51,8 +65,21 @@ Renderer::Renderer()
     m_ScreenQuadLayout.pushFloat(2);
     m_ScreenQuadVAO.addBuffer(m_ScreenQuadVBO, m_ScreenQuadLayout);
 
+    // Instances (2) are bound from the frame ring buffer when written, objects (3) and draw commands (4) are owned by the
+    // object registry.
+    // Cluster light statistics (5) are bound by the clustered lights before each dispatch,
+    // active clusters (7), cluster flags (8) and cluster light counters (9) are owned by the clustered lights.
     m_LightRegistry.setBindingPoint(0);
-    m_ClusteredLights.setBindingPoint(1);
+    m_LightRegistry.setSpotLightBindingPoint(10);
+    m_LightRegistry.setDirectionalLightBindingPoint(11);
+    m_ClusteredLights.setBindingPoints(1, 6);
+    m_ObjectRegistry.setBindingPoints(3, 4);
+
+    m_GPUCuller = AssetManager::Get().getAsset<ComputeShaderAsset>("Resources/Engine/Shader/ComputeShader/FrustumCullingCompute.glsl");
+    const auto& gpuCullerShader = m_GPUCuller.getStaticAsset()->getComputeShader();
+    m_GPUCullerObjectCountLocation = gpuCullerShader.getUniformLocation("u_ObjectCount");
+    m_GPUCullerFrustumPlanesLocation = gpuCullerShader.getUniformLocation("u_FrustumPlanes[0]");
+    m_DepthPrepassMaterial = AssetManager::Get().getAsset<MaterialAsset>("Resources/Engine/Material/Mat_DepthPrepass.asset");
 
     GLCall(glEnable(GL_CULL_FACE));
     GLCall(glCullFace(GL_BACK));
@@ -81,21 +108,80 @@ Renderer& Renderer::Get()
     return *s_Instance;
 }
 
+void Renderer::beginFrame()
+{
+    m_FrameRing.beginFrame();
+}
+
+void Renderer::endFrame()
+{
+    m_FrameRing.endFrame();
+}
+
 void Renderer::beginScene(const CameraBasic& camera)
 {
     m_Camera = &camera;
 
-    m_LightRegistry.beginFrame();
+    // Writing camera data once for the whole scene, straight into the ring buffer. Each scene of a frame (multiple cameras or passes)
+    // gets its own allocation, so previously issued draws keep reading their own data.
+    auto frameDataAllocation = m_FrameRing.allocate(sizeof(UBOFrameData));
+    UBOFrameData& frameData = *static_cast<UBOFrameData*>(frameDataAllocation.data);
+    frameData.view = camera.getView();
+    frameData.projection = camera.getProjection();
+    frameData.viewProjection = camera.getViewProjection();
+    frameData.viewPosition = camera.getPosition();
+    frameData.nearPlane = camera.getNear();
+    frameData.viewportSize = m_ViewportSize;
+    frameData.farPlane = camera.getFar();
+    frameData._padding = 0.f;
+    FrameStats::Get().add(FrameStats::Counter::BytesUploaded, sizeof(UBOFrameData));
+
+    PersistentRingBuffer::BindRange(GL_UNIFORM_BUFFER, 0, frameDataAllocation);
+
+    m_LightBudget.beginFrame();
+    m_ObjectRegistry.beginFrame();
 }
 
 void Renderer::endScene(const FrameBuffer& target)
 {
-    // Setting up lights
+    VRM_PROFILE_SCOPE("Renderer::endScene");
+
+    // Setting up lights, only the ones worth shading reach the registry
+    m_LightRegistry.beginFrame();
+    m_LightBudget.selectLights(*m_Camera, m_LightRegistry);
     m_LightRegistry.endFrame();
     
-    // Clustered shading
-    m_ClusteredLights.setupClusters({ 12, 12, 24 }, *m_Camera);
-    m_ClusteredLights.processLights(*m_Camera);
+    // Culling objects first, so that the depth prepass can draw them before lights are culled
+    {
+        VRM_GPU_PROFILE_SCOPE("Object culling");
+
+        if (m_GPUDrivenEnabled)
+        {
+            buildGPUDrivenCommands();
+        }
+        else
+        {
+            buildRenderQueue();
+            buildInstanceBatches();
+        }
+    }
+
+    // Clustered shading. The grid follows the viewport. While it is tuned, every frame culls every cluster, so that the
+    // measures hold the whole culling cost.
+    const ClusterGridSettings& gridSettings = m_ClusterGridTuner.isRunning() ? m_ClusterGridTuner.getCurrentSettings() : m_ClusterGridSettings;
+    m_ClusteredLights.setupClusters(
+        gridSettings.getClusterCount(m_ViewportSize, m_Camera->getProjection(), m_Camera->getNear(), m_Camera->getFar()), *m_Camera);
+    if (m_ClusterGridTuner.isRunning())
+        m_ClusteredLights.invalidateLightAssignment();
+    // Nothing to detect with an empty viewport, every cluster is culled then. Frames reusing the light assignment of the
+    // previous ones have no use for active clusters either.
+    if (m_ActiveClustersEnabled && m_ViewportSize.x > 0 && m_ViewportSize.y > 0
+        && m_ClusteredLights.needsActiveClusters(*m_Camera, m_LightRegistry))
+    {
+        drawDepthPrepass();
+        m_ClusteredLights.findActiveClusters(m_DepthPrepassTarget.getDepthTexture(), *m_Camera);
+    }
+    m_ClusteredLights.processLights(*m_Camera, m_LightRegistry);
 
     // Rendering to the requested target
     target.bind();
@@ -103,72 +189,390 @@ void Renderer::endScene(const FrameBuffer& target)
     GLCall(glViewport(m_ViewportOrigin.x, m_ViewportOrigin.y, m_ViewportSize.x, m_ViewportSize.y));
 
     // Drawing meshes
-    for (const auto& mesh : m_Meshes)
     {
-        drawMesh(mesh.mesh, mesh.model);
+        VRM_GPU_PROFILE_SCOPE("Opaque pass");
+
+        if (m_GPUDrivenEnabled)
+            drawGPUDrivenCommands();
+        else
+            drawRenderQueue();
     }
 
+    auto& frameStats = FrameStats::Get();
+    frameStats.add(FrameStats::Counter::VisibleObjects, static_cast<double>(m_VisibleSubMeshCount));
+    frameStats.add(FrameStats::Counter::CulledObjects, static_cast<double>(m_CulledSubMeshCount));
+    frameStats.add(FrameStats::Counter::LightsCulled,
+        static_cast<double>(m_LightBudget.getSubmittedLightCount() - m_LightBudget.getKeptLightCount()));
+
+    if (m_ClusterGridTuner.isRunning())
+        updateClusterGridTuning();
+
     // Clearing data for next frame
     m_Camera = nullptr;
     m_Meshes.clear();
 }
 
-void Renderer::submitMesh(const MeshInstance& mesh, const glm::mat4& model)
+void Renderer::submitMesh(const MeshInstance& mesh, const glm::mat4& model, entt::entity entity)
+{
+    if (m_GPUDrivenEnabled)
+        m_ObjectRegistry.submitMesh(mesh, model, entity);
+    else
+        m_Meshes.push_back({ mesh, model });
+}
+
+void Renderer::submitPointLight(const glm::vec3& position, const PointLightComponent& pointLight, entt::entity entity)
+{
+    m_LightBudget.submitPointLight(pointLight, position, entity);
+    FrameStats::Get().add(FrameStats::Counter::LightsSubmitted);
+}
+
+void Renderer::submitSpotLight(const glm::vec3& position, const glm::vec3& direction, const SpotLightComponent& spotLight)
+{
+    m_LightBudget.submitSpotLight(spotLight, position, direction);
+}
+
+void Renderer::submitDirectionalLight(const glm::vec3& direction, const DirectionalLightComponent& directionalLight)
+{
+    m_LightBudget.submitDirectionalLight(directionalLight, direction);
+}
+
+void Renderer::buildRenderQueue()
+{
+    VRM_DEBUG_ASSERT_MSG(m_Camera, "No camera set for rendering. Did you call beginScene?");
+
+    m_RenderQueue.clear();
+
+    // Culling sub meshes outside of the camera frustum
+    m_FrustumCuller.clear();
+    if (m_FrustumCullingEnabled)
+    {
+        for (const auto& queuedMesh : m_Meshes)
+        {
+            for (const auto& subMesh : queuedMesh.mesh.getStaticAsset()->getSubMeshes())
+                m_FrustumCuller.push(subMesh.meshData.getBoundingBox(), subMesh.meshData.getBoundingSphere(), queuedMesh.model);
+        }
+        m_FrustumCuller.cull(m_Camera->getFrustum());
+    }
+
+    m_VisibleSubMeshCount = 0;
+    m_CulledSubMeshCount = 0;
+
+    const glm::mat4& view = m_Camera->getView();
+    const float nearPlane = m_Camera->getNear();
+    const float depthRange = m_Camera->getFar() - nearPlane;
+
+    size_t cullingIndex = 0;
+    for (const auto& queuedMesh : m_Meshes)
+    {
+        // Sub meshes are sorted with the depth of their object origin
+        const float viewDepth = -(view * queuedMesh.model[3]).z;
+        const float normalizedDepth = (viewDepth - nearPlane) / depthRange;
+
+        for (const auto& subMesh : queuedMesh.mesh.getStaticAsset()->getSubMeshes())
+        {
+            if (m_FrustumCullingEnabled && !m_FrustumCuller.isVisible(cullingIndex++))
+            {
+                m_CulledSubMeshCount++;
+                continue;
+            }
+            m_VisibleSubMeshCount++;
+
+            const MaterialAsset* material = subMesh.materialInstance.getStaticAsset();
+
+            uint64_t key = RenderKey::Build(
+                RenderPass::Opaque,
+                material->getShader(subMesh.renderMesh.getVertexFormat()).getID(),
+                material->getID(),
+                material->getTextureSetID(),
+                subMesh.renderMesh.getID(),
+                normalizedDepth
+            );
+
+            m_RenderQueue.push({ key, &subMesh, &queuedMesh.model });
+        }
+    }
+
+    m_RenderQueue.sort();
+}
+
+void Renderer::buildInstanceBatches()
+{
+    m_InstanceModels.clear();
+    m_InstanceBatches.clear();
+
+    // Packets are sorted by state, so packets drawing the same sub mesh (hence the same material) are contiguous.
+    // Each run of such packets becomes a single instanced draw.
+    for (const auto& packet : m_RenderQueue.getPackets())
+    {
+        if (m_InstanceBatches.empty() || m_InstanceBatches.back().subMesh != packet.subMesh)
+            m_InstanceBatches.push_back({ packet.subMesh, static_cast<unsigned int>(m_InstanceModels.size()), 0 });
+
+        // Packed positions are quantized, their dequantization is applied with the model matrix.
+        const auto& renderMesh = packet.subMesh->renderMesh;
+        if (renderMesh.isPacked())
+            m_InstanceModels.push_back(*packet.model * renderMesh.getPositionTransform());
+        else
+            m_InstanceModels.push_back(*packet.model);
+        m_InstanceBatches.back().instanceCount++;
+    }
+
+    // Writing every model matrix of the scene at once
+    if (!m_InstanceModels.empty())
+    {
+        auto allocation = m_FrameRing.push(m_InstanceModels.data(), m_InstanceModels.size() * sizeof(glm::mat4));
+        PersistentRingBuffer::BindRange(GL_SHADER_STORAGE_BUFFER, 2, allocation);
+    }
+}
+
+void Renderer::drawRenderQueue(const MaterialAsset* materialOverride)
 {
-    m_Meshes.push_back({ mesh, model });
+    VRM_DEBUG_ASSERT_MSG(m_Camera, "No camera set for rendering. Did you call beginScene?");
+
+    // Currently bound states. Reset every frame, because other passes may have changed the OpenGL state in between.
+    BoundState boundState;
+    auto& frameStats = FrameStats::Get();
+
+    for (const auto& batch : m_InstanceBatches)
+    {
+        const auto& subMesh = *batch.subMesh;
+        bindSubMeshState(subMesh, boundState, materialOverride);
+
+        // Drawing every instance of the batch, from the mesh range of the geometry pool.
+        // Model matrices are fetched by the vertex shader from the instance SSBO, at index gl_BaseInstance + gl_InstanceID.
+        const auto& renderMesh = subMesh.renderMesh;
+        GLCall(glDrawElementsInstancedBaseVertexBaseInstance(
+            GL_TRIANGLES,
+            (GLsizei)renderMesh.getIndexCount(),
+            renderMesh.getGLIndexType(),
+            reinterpret_cast<const void*>(static_cast<size_t>(renderMesh.getFirstIndex()) * renderMesh.getIndexSize()),
+            (GLsizei)batch.instanceCount,
+            (GLint)renderMesh.getBaseVertex(),
+            batch.baseInstance
+        ));
+
+        frameStats.add(FrameStats::Counter::DrawCalls);
+        frameStats.add(FrameStats::Counter::Triangles, static_cast<double>(renderMesh.getIndexCount() / 3) * batch.instanceCount);
+    }
 }
 
-void Renderer::submitPointLight(const glm::vec3& position, const PointLightComponent& pointLight, const std::string& identifier)
+void Renderer::buildGPUDrivenCommands()
 {
-    m_LightRegistry.submitPointLight(pointLight, position, identifier);
+    // Only the objects added, removed or moved since the last frame are uploaded
+    m_ObjectRegistry.endFrame();
+
+    const unsigned int objectCount = m_ObjectRegistry.getObjectCount();
+    if (objectCount == 0)
+        return;
+
+    // Instance counts are all zero, the culling shader increments them
+    auto instanceAllocation = m_FrameRing.allocate(objectCount * sizeof(glm::mat4));
+    PersistentRingBuffer::BindRange(GL_SHADER_STORAGE_BUFFER, 2, instanceAllocation);
+
+    // Culling on the GPU
+    const auto frustum = m_Camera->getFrustum();
+    const auto& computeShader = m_GPUCuller.getStaticAsset()->getComputeShader();
+    computeShader.bind();
+    computeShader.setUniform1ui(m_GPUCullerObjectCountLocation, objectCount);
+    computeShader.setUniform4fv(m_GPUCullerFrustumPlanesLocation, Frustum::Count, frustum.planes.data());
+
+    // Local size is 64 for x in the compute shader
+    const unsigned int groupCount = (objectCount + 63u) / 64u;
+    computeShader.dispatchCustomBarrier(groupCount, 1, 1, GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
 }
 
-void Renderer::drawMesh(const MeshInstance& mesh, const glm::mat4& model) const
+void Renderer::drawGPUDrivenCommands(const MaterialAsset* materialOverride)
 {
     VRM_DEBUG_ASSERT_MSG(m_Camera, "No camera set for rendering. Did you call beginScene?");
 
-    const auto& subMeshes = mesh.getStaticAsset()->getSubMeshes();
+    // Culling happens on the GPU, counts are not read back to avoid a stall
+    m_VisibleSubMeshCount = 0;
+    m_CulledSubMeshCount = 0;
 
-    const auto cameraPos = m_Camera->getPosition();
+    if (m_ObjectRegistry.getObjectCount() == 0)
+        return;
 
-    for (const auto& subMesh : subMeshes)
+    GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_ObjectRegistry.getDrawCommandSSBO().getRendererID()));
+
+    BoundState boundState;
+
+    for (const auto& batch : m_ObjectRegistry.getIndirectBatches())
     {
-        // Binding data
-        subMesh.renderMesh.getVertexArray().bind();
-        subMesh.renderMesh.getIndexBuffer().bind();
+        bindSubMeshState(*batch.subMesh, boundState, materialOverride);
+
+        // Commands of a batch share their geometry pool, hence their index type
+        const size_t commandOffset = batch.firstCommand * sizeof(SSBODrawCommand);
+        GLCall(glMultiDrawElementsIndirect(
+            GL_TRIANGLES,
+            batch.subMesh->renderMesh.getGLIndexType(),
+            reinterpret_cast<const void*>(commandOffset),
+            (GLsizei)batch.commandCount,
+            0
+        ));
+
+        // Triangles are not counted, instance counts stay on the GPU
+        FrameStats::Get().add(FrameStats::Counter::DrawCalls);
+    }
+
+    GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+}
+
+void Renderer::drawDepthPrepass()
+{
+    VRM_GPU_PROFILE_SCOPE("Depth prepass");
+
+    m_DepthPrepassTarget.resize(static_cast<int>(m_ViewportSize.x), static_cast<int>(m_ViewportSize.y));
+    m_DepthPrepassTarget.bind();
+    GLCall(glViewport(0, 0, m_ViewportSize.x, m_ViewportSize.y));
+    m_DepthPrepassTarget.clear();
 
-        const Shader& shader = subMesh.materialInstance.getStaticAsset()->getShader();
+    // Same batches as the opaque pass, so the depth of every fragment matches
+    if (m_GPUDrivenEnabled)
+        drawGPUDrivenCommands(m_DepthPrepassMaterial.getStaticAsset());
+    else
+        drawRenderQueue(m_DepthPrepassMaterial.getStaticAsset());
+
+    m_DepthPrepassTarget.unbind();
+}
+
+void Renderer::bindSubMeshState(const MeshAsset::SubMesh& subMesh, BoundState& boundState, const MaterialAsset* materialOverride) const
+{
+    const MaterialAsset* material = materialOverride ? materialOverride : subMesh.materialInstance.getStaticAsset();
+    const Shader& shader = material->getShader(subMesh.renderMesh.getVertexFormat());
+
+    // Camera data is read from the FrameData uniform block, bound in beginScene.
+    if (&shader != boundState.shader)
+    {
         shader.bind();
+        boundState.shader = &shader;
+        FrameStats::Get().add(FrameStats::Counter::ProgramBinds);
 
-        // Setting uniforms
-        shader.setUniformMat4f("u_Model", model);
-        shader.setUniformMat4f("u_View", m_Camera->getView());
-        shader.setUniformMat4f("u_Projection", m_Camera->getProjection());
-        shader.setUniformMat4f("u_ViewProjection", m_Camera->getViewProjection());
-        shader.setUniform3f("u_ViewPosition", cameraPos);
-        shader.setUniform1f("u_Near", m_Camera->getNear());
-        shader.setUniform1f("u_Far", m_Camera->getFar());
-        shader.setUniform2ui("u_ViewportSize", m_ViewportSize.x, m_ViewportSize.y);
+        // Texture uniforms belong to the program, so they must be set again for another variant of the same material.
+        boundState.material = nullptr;
+    }
 
+    if (material != boundState.material)
+    {
         // Setting material textures uniforms
-        size_t textureCount = subMesh.materialInstance.getStaticAsset()->getTextureCount();
+        size_t textureCount = material->getTextureCount();
+        VRM_DEBUG_ASSERT_MSG(textureCount <= boundState.textures.size(), "Too many textures in material.");
         if (textureCount > 0)
         {
-            std::vector<int> textureSlots(textureCount);
+            std::array<int, 8> textureSlots;
             for (size_t i = 0; i < textureCount; ++i)
             {
-                const auto& texture = subMesh.materialInstance.getStaticAsset()->getTexture(i);
-                texture.getStaticAsset()->getGPUTexture().bind((unsigned int)i);
+                const auto& texture = material->getTexture(i).getStaticAsset()->getGPUTexture();
+                if (boundState.textures[i] != texture.getRendererID())
+                {
+                    texture.bind((unsigned int)i);
+                    boundState.textures[i] = texture.getRendererID();
+                    FrameStats::Get().add(FrameStats::Counter::TextureBinds);
+                }
                 textureSlots[i] = (int)i;
             }
 
             shader.setUniform1iv("u_Texture", (int)textureCount, textureSlots.data());
         }
 
-        // Drawing data
-        GLCall(glDrawElements(GL_TRIANGLES, (GLsizei)subMesh.renderMesh.getIndexBuffer().getCount(), GL_UNSIGNED_INT, nullptr));
+        boundState.material = material;
     }
 
+    // Meshes live in a few geometry pools, so this only binds a handful of times per pass.
+    const VertexArray& vertexArray = subMesh.renderMesh.getVertexArray();
+    if (&vertexArray != boundState.vertexArray)
+    {
+        vertexArray.bind();
+        boundState.vertexArray = &vertexArray;
+        FrameStats::Get().add(FrameStats::Counter::VertexArrayBinds);
+    }
+}
+
+void Renderer::setFrustumCullingEnabled(bool enabled)
+{
+    m_FrustumCullingEnabled = enabled;
+}
+
+void Renderer::setGPUDrivenEnabled(bool enabled)
+{
+    m_GPUDrivenEnabled = enabled;
+}
+
+void Renderer::setActiveClustersEnabled(bool enabled)
+{
+    m_ActiveClustersEnabled = enabled;
+}
+
+void Renderer::setLightCullingMode(ClusteredLights::CullingMode mode)
+{
+    m_ClusteredLights.setCullingMode(mode);
+}
+
+void Renderer::setLightCullingKernel(ClusteredLights::CullingKernel kernel, unsigned int localSize)
+{
+    m_ClusteredLights.setCullingKernel(kernel, localSize);
+}
+
+void Renderer::setLightBudget(unsigned int maxLights)
+{
+    m_LightBudget.setMaxLights(maxLights);
+}
+
+void Renderer::setLightIntensityCutoff(float intensityCutoff)
+{
+    m_LightBudget.setIntensityCutoff(intensityCutoff);
+}
+
+void Renderer::setClusterLightLimit(unsigned int clusterLightLimit)
+{
+    m_ClusteredLights.setClusterLightLimit(clusterLightLimit);
+}
+
+void Renderer::setClusterGridSettings(const ClusterGridSettings& settings)
+{
+    m_ClusterGridSettings = settings;
+    m_ClusterGridTuner.stop();
+}
+
+bool Renderer::startClusterGridTuning(std::vector<ClusterGridSettings> candidates)
+{
+    if (!GPUProfiler::IsInitialized() || !GPUProfiler::Get().isEnabled())
+    {
+        VRM_LOG_WARN("Cluster grid tuning needs the GPU profiler.");
+        return false;
+    }
+
+    VRM_LOG_INFO("Tuning the cluster grid over {} candidates.", candidates.size());
+    m_ClusterGridTuner.start(std::move(candidates));
+    m_ClusterGridTunedFrame = GPUProfiler::Get().getCollectedFrameCount();
+    return true;
+}
+
+void Renderer::updateClusterGridTuning()
+{
+    // Timings come back a few frames late. The tuner skips the first frames of each candidate, so the ones read here
+    // were rendered with the current grid once it measures.
+    const auto& profiler = GPUProfiler::Get();
+    const size_t frame = profiler.getCollectedFrameCount();
+    if (frame == m_ClusterGridTunedFrame)
+        return;
+    m_ClusterGridTunedFrame = frame;
+
+    // Scopes that did not run during that frame, active clusters with no depth prepass for instance, keep older samples
+    float milliseconds = 0.f;
+    for (const auto& scope : profiler.getScopes())
+    {
+        if (scope.lastFrame != frame)
+            continue;
+        if (scope.name == "Active clusters" || scope.name == "Light culling" || scope.name == "Opaque pass")
+            milliseconds += scope.milliseconds.getLast();
+    }
+
+    m_ClusterGridTuner.pushFrame(milliseconds);
+    if (m_ClusterGridTuner.isRunning())
+        return;
+
+    m_ClusterGridTuner.getBestSettings(m_ClusterGridSettings);
+    VRM_LOG_INFO("Cluster grid tuned: tiles of {} pixels, {} depth slices.", m_ClusterGridSettings.tileSize,
+        m_ClusterGridSettings.depthSlicing == DepthSlicing::Fixed ? std::to_string(m_ClusterGridSettings.depthSlices) : "matching");
 }
 
 const glm::vec<2, unsigned int>& Renderer::getViewportOrigin() const
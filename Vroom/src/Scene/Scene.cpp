@@ -2,6 +2,8 @@
 
 #include "Vroom/Core/Application.h"
 #include "Vroom/Core/GameLayer.h"
+#include "Vroom/Core/FrameStats.h"
+#include "Vroom/Core/Profiler.h"
 
 #include "Vroom/Asset/Asset.h"
 
@@ -14,6 +16,8 @@
 #include "Vroom/Scene/Components/TransformComponent.h"
 #include "Vroom/Scene/Components/MeshComponent.h"
 #include "Vroom/Scene/Components/PointLightComponent.h"
+#include "Vroom/Scene/Components/SpotLightComponent.h"
+#include "Vroom/Scene/Components/DirectionalLightComponent.h"
 
 namespace vrm
 {
@@ -44,30 +48,62 @@ void Scene::init()
 
 void Scene::update(float dt)
 {
+    VRM_PROFILE_SCOPE("Scene::update");
+
     onUpdate(dt);
 
+    VRM_PROFILE_SCOPE("Scripts");
+    size_t scriptCount = 0;
     auto viewScripts = m_Registry.view<ScriptHandler>();
     for (auto entity : viewScripts)
     {
         auto& scriptHandler = viewScripts.get<ScriptHandler>(entity);
         scriptHandler.getScript().onUpdate(dt);
+        scriptCount++;
     }
+
+    // Every entity has a transform
+    auto& frameStats = FrameStats::Get();
+    frameStats.add(FrameStats::Counter::EntitiesUpdated, static_cast<double>(m_Registry.view<TransformComponent>().size()));
+    frameStats.add(FrameStats::Counter::ScriptsUpdated, static_cast<double>(scriptCount));
 }
 
 void Scene::render()
 {
+    VRM_PROFILE_SCOPE("Scene::render");
+
     Application& app = Application::Get();
     Renderer& renderer = Renderer::Get();
     renderer.beginScene(getCamera());
     
-    auto viewPointLights = m_Registry.view<PointLightComponent, TransformComponent, NameComponent>();
+    auto viewPointLights = m_Registry.view<PointLightComponent, TransformComponent>();
     for (auto entity : viewPointLights)
     {
         const auto& pointLightComponent = viewPointLights.get<PointLightComponent>(entity);
         const auto& transformComponent = viewPointLights.get<TransformComponent>(entity);
-        const auto& nameComponent = viewPointLights.get<NameComponent>(entity);
 
-        renderer.submitPointLight(transformComponent.getPosition(), pointLightComponent, nameComponent.name);
+        renderer.submitPointLight(transformComponent.getPosition(), pointLightComponent, entity);
+    }
+
+    // Spot and directional lights point along the -z axis of their transform
+    auto viewSpotLights = m_Registry.view<SpotLightComponent, TransformComponent>();
+    for (auto entity : viewSpotLights)
+    {
+        const auto& spotLightComponent = viewSpotLights.get<SpotLightComponent>(entity);
+        const auto& transformComponent = viewSpotLights.get<TransformComponent>(entity);
+
+        const glm::vec3 direction = glm::vec3(transformComponent.getTransform() * glm::vec4(0.f, 0.f, -1.f, 0.f));
+        renderer.submitSpotLight(transformComponent.getPosition(), direction, spotLightComponent);
+    }
+
+    auto viewDirectionalLights = m_Registry.view<DirectionalLightComponent, TransformComponent>();
+    for (auto entity : viewDirectionalLights)
+    {
+        const auto& directionalLightComponent = viewDirectionalLights.get<DirectionalLightComponent>(entity);
+        const auto& transformComponent = viewDirectionalLights.get<TransformComponent>(entity);
+
+        const glm::vec3 direction = glm::vec3(transformComponent.getTransform() * glm::vec4(0.f, 0.f, -1.f, 0.f));
+        renderer.submitDirectionalLight(direction, directionalLightComponent);
     }
 
     auto viewMeshes = m_Registry.view<MeshComponent, TransformComponent>();
@@ -76,7 +112,7 @@ void Scene::render()
         const auto& meshComponent = viewMeshes.get<MeshComponent>(entity);
         const auto& transformComponent = viewMeshes.get<TransformComponent>(entity);
 
-        renderer.submitMesh(meshComponent.getMesh(), transformComponent.getTransform());
+        renderer.submitMesh(meshComponent.getMesh(), transformComponent.getTransform(), entity);
     }
 
     onRender();
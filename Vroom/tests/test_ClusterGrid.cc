@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Vroom/Render/Clustering/ClusterGrid.h>
+#include <Vroom/Render/Clustering/ClusterGridTuner.h>
+
+namespace
+{
+
+constexpr float NEAR = 0.1f;
+constexpr float FAR = 100.f;
+
+glm::mat4 Projection(const glm::uvec2& viewportSize)
+{
+    return glm::perspective(glm::radians(90.f), static_cast<float>(viewportSize.x) / static_cast<float>(viewportSize.y), NEAR, FAR);
+}
+
+} // namespace
+
+TEST(ClusterGridTest, TilesFollowViewportSize)
+{
+    const vrm::ClusterGridSettings settings = { 64, vrm::DepthSlicing::Fixed, 24 };
+
+    const glm::uvec2 hd = { 1280, 720 };
+    EXPECT_EQ(settings.getClusterCount(hd, Projection(hd), NEAR, FAR), glm::uvec3(20, 12, 24));
+
+    // Rounding up: the viewport is split evenly between slightly smaller tiles
+    const glm::uvec2 uhd = { 3840, 2160 };
+    EXPECT_EQ(settings.getClusterCount(uhd, Projection(uhd), NEAR, FAR), glm::uvec3(60, 34, 24));
+
+    const glm::uvec2 empty = { 0, 0 };
+    EXPECT_EQ(settings.getClusterCount(empty, glm::mat4(1.f), NEAR, FAR), glm::uvec3(1, 1, 24));
+}
+
+TEST(ClusterGridTest, MatchingSlicesAreAsDeepAsTilesAreHigh)
+{
+    const vrm::ClusterGridSettings settings = { 256, vrm::DepthSlicing::MatchTiles, 0 };
+    const glm::uvec2 viewportSize = { 2048, 2048 };
+    const glm::uvec3 clusterCount = settings.getClusterCount(viewportSize, Projection(viewportSize), NEAR, FAR);
+
+    // At 90 degrees, the view is as high as twice the depth: 8 tiles give slices a quarter deeper than their start
+    EXPECT_EQ(clusterCount.y, 8u);
+    EXPECT_EQ(clusterCount.z, static_cast<unsigned int>(std::ceil(std::log(FAR / NEAR) / std::log(1.25f))));
+}
+
+TEST(ClusterGridTest, GridFitsClusterLimit)
+{
+    const vrm::ClusterGridSettings settings = { 8, vrm::DepthSlicing::Fixed, 64 };
+    const glm::uvec2 viewportSize = { 1920, 1080 };
+    const glm::uvec3 clusterCount = settings.getClusterCount(viewportSize, Projection(viewportSize), NEAR, FAR);
+
+    EXPECT_EQ(clusterCount.x, 240u);
+    EXPECT_EQ(clusterCount.y, 135u);
+    EXPECT_EQ(clusterCount.z, 2u);
+    EXPECT_LE(clusterCount.x * clusterCount.y * clusterCount.z, vrm::ClusterGridSettings::MaxClusterCount);
+}
+
+TEST(ClusterGridTunerTest, KeepsCheapestCandidate)
+{
+    const std::vector<vrm::ClusterGridSettings> candidates = {
+        { 64, vrm::DepthSlicing::Fixed, 24 },
+        { 128, vrm::DepthSlicing::Fixed, 24 },
+        { 256, vrm::DepthSlicing::Fixed, 24 },
+    };
+    const float costs[] = { 3.f, 1.f, 2.f };
+
+    vrm::ClusterGridTuner tuner;
+    tuner.start(candidates, 2, 4);
+
+    size_t frames = 0;
+    while (tuner.isRunning())
+    {
+        const size_t candidate = tuner.getResults().size();
+        ASSERT_EQ(tuner.getCurrentSettings(), candidates[candidate]);
+
+        // Settle frames are not measured
+        const unsigned int frame = static_cast<unsigned int>(frames % 6);
+        tuner.pushFrame(frame < 2 ? 100.f : costs[candidate]);
+        frames++;
+    }
+
+    EXPECT_EQ(frames, 18u);
+    ASSERT_EQ(tuner.getResults().size(), 3u);
+    EXPECT_FLOAT_EQ(tuner.getResults()[0].milliseconds, 3.f);
+    EXPECT_FLOAT_EQ(tuner.getResults()[1].milliseconds, 1.f);
+
+    vrm::ClusterGridSettings best;
+    ASSERT_TRUE(tuner.getBestSettings(best));
+    EXPECT_EQ(best, candidates[1]);
+}
+
+TEST(ClusterGridTunerTest, StoppedTunerKeepsMeasuredCandidates)
+{
+    vrm::ClusterGridTuner tuner;
+    vrm::ClusterGridSettings best;
+    EXPECT_FALSE(tuner.getBestSettings(best));
+
+    tuner.start(vrm::ClusterGridTuner::GetDefaultCandidates(), 0, 1);
+    tuner.pushFrame(5.f);
+    tuner.pushFrame(4.f);
+    tuner.stop();
+    tuner.pushFrame(1.f);
+
+    EXPECT_FALSE(tuner.isRunning());
+    ASSERT_EQ(tuner.getResults().size(), 2u);
+    ASSERT_TRUE(tuner.getBestSettings(best));
+    EXPECT_EQ(best, vrm::ClusterGridTuner::GetDefaultCandidates()[1]);
+}
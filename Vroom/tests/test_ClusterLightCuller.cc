@@ -0,0 +1,767 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Vroom/Core/Application.h>
+#include <Vroom/Render/Abstraction/DepthFrameBuffer.h>
+#include <Vroom/Render/Abstraction/DynamicSSBO.h>
+#include <Vroom/Render/Camera/FirstPersonCamera.h>
+#include <Vroom/Render/Clustering/ClusteredLights.h>
+#include <Vroom/Render/Clustering/ClusterLightCuller.h>
+#include <Vroom/Render/Clustering/LightRegistry.h>
+
+namespace
+{
+
+const glm::uvec3 CLUSTER_COUNT = { 12, 12, 24 };
+constexpr float NEAR = 0.1f;
+constexpr float FAR = 100.f;
+
+struct TestLight
+{
+    glm::vec3 position;
+    float radius;
+};
+
+// Lights spread in front of a camera at origin looking towards -Z, some of them partly outside of the frustum
+std::vector<TestLight> RandomLights(size_t count, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> lateral(-40.f, 40.f);
+    std::uniform_real_distribution<float> depth(-90.f, 5.f);
+    std::uniform_real_distribution<float> radius(0.5f, 8.f);
+
+    std::vector<TestLight> lights;
+    for (size_t i = 0; i < count; ++i)
+        lights.push_back({ { lateral(generator), lateral(generator), depth(generator) }, radius(generator) });
+    return lights;
+}
+
+struct TestSpotLight
+{
+    glm::vec3 position;
+    glm::vec3 direction;
+    float radius;
+    float angle;
+};
+
+// Spot lights spread as the point lights are, pointing anywhere, with cones from 10 to 60 degrees
+std::vector<TestSpotLight> RandomSpotLights(size_t count, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> lateral(-40.f, 40.f);
+    std::uniform_real_distribution<float> depth(-90.f, 5.f);
+    std::uniform_real_distribution<float> radius(2.f, 20.f);
+    std::uniform_real_distribution<float> axis(-1.f, 1.f);
+    std::uniform_real_distribution<float> angle(glm::radians(10.f), glm::radians(60.f));
+
+    std::vector<TestSpotLight> lights;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const glm::vec3 position = { lateral(generator), lateral(generator), depth(generator) };
+        glm::vec3 direction = { axis(generator), axis(generator), axis(generator) };
+        direction = glm::dot(direction, direction) > 1e-4f ? glm::normalize(direction) : glm::vec3(0.f, 0.f, -1.f);
+        lights.push_back({ position, direction, radius(generator), angle(generator) });
+    }
+    return lights;
+}
+
+// Submits a frame of lights. Entities are the indices of the lights, slots in the block do not follow them once a light is removed.
+void SubmitLights(vrm::LightRegistry& registry, const std::vector<TestLight>& lights, const std::vector<TestSpotLight>& spotLights = {})
+{
+    registry.beginFrame();
+    for (size_t i = 0; i < lights.size(); ++i)
+    {
+        if (lights[i].radius > 0.f)
+            registry.submitPointLight({ glm::vec3(1.f), 1.f, lights[i].radius }, lights[i].position, static_cast<entt::entity>(i));
+    }
+    for (const auto& light : spotLights)
+        registry.submitSpotLight({ glm::vec3(1.f), 1.f, light.radius, light.angle, light.angle }, light.position, light.direction);
+    registry.prepareFrame();
+}
+
+void SubmitRandomLights(vrm::LightRegistry& registry, size_t count, uint32_t seed)
+{
+    SubmitLights(registry, RandomLights(count, seed));
+}
+
+std::vector<vrm::SSBOPointLightData> ReadLights(const std::vector<std::byte>& lightBlock)
+{
+    int lightCount = 0;
+    std::memcpy(&lightCount, lightBlock.data(), sizeof(int));
+    std::vector<vrm::SSBOPointLightData> lights(lightCount);
+    std::memcpy(lights.data(), lightBlock.data() + sizeof(int), lightCount * sizeof(vrm::SSBOPointLightData));
+    return lights;
+}
+
+std::vector<vrm::SSBOSpotLightData> ReadSpotLights(const std::vector<std::byte>& spotLightBlock)
+{
+    int lightCount = 0;
+    std::memcpy(&lightCount, spotLightBlock.data(), sizeof(int));
+    std::vector<vrm::SSBOSpotLightData> lights(lightCount);
+    std::memcpy(lights.data(), spotLightBlock.data() + sizeof(int), lightCount * sizeof(vrm::SSBOSpotLightData));
+    return lights;
+}
+
+// Sorted light indices of a cluster
+std::vector<unsigned int> ClusterLights(const vrm::SSBOCluster& cluster, const std::vector<unsigned int>& lightIndices)
+{
+    std::vector<unsigned int> lights(lightIndices.begin() + cluster.lightOffset, lightIndices.begin() + cluster.lightOffset + cluster.lightCount);
+    std::sort(lights.begin(), lights.end());
+    return lights;
+}
+
+// Distance from the light sphere surface to the cluster AABB, negative inside
+float SphereToAABBDistance(const vrm::SSBOCluster& cluster, const glm::vec3& center, float radius)
+{
+    const glm::vec3 closestPoint = glm::clamp(center, glm::vec3(cluster.minAABB_VS), glm::vec3(cluster.maxAABB_VS));
+    return glm::length(closestPoint - center) - radius;
+}
+
+// Whether a spot light barely touches or misses the cluster: by its range sphere, by the cone side, or by its apex plane
+bool SpotLightGrazesAABB(const vrm::SSBOCluster& cluster, const glm::mat4& view, const vrm::SSBOSpotLightData& light)
+{
+    constexpr float epsilon = 1e-3f;
+    const glm::vec3 apex = glm::vec3(view * glm::vec4(light.position, 1.f));
+    if (std::abs(SphereToAABBDistance(cluster, apex, light.radius)) <= epsilon)
+        return true;
+
+    const glm::vec3 center = 0.5f * (glm::vec3(cluster.minAABB_VS) + glm::vec3(cluster.maxAABB_VS));
+    const float radius = 0.5f * glm::length(glm::vec3(cluster.maxAABB_VS) - glm::vec3(cluster.minAABB_VS));
+    const glm::vec3 toCenter = center - apex;
+    const float alongAxis = glm::dot(toCenter, glm::mat3(view) * light.direction);
+    const float fromAxis = std::sqrt(std::max(glm::dot(toCenter, toCenter) - alongAxis * alongAxis, 0.f));
+    const float sinAngle = std::sqrt(std::max(1.f - light.cosOuterAngle * light.cosOuterAngle, 0.f));
+    const float distanceToCone = light.cosOuterAngle * fromAxis - sinAngle * alongAxis;
+    return std::abs(distanceToCone - radius) <= epsilon || std::abs(alongAxis + radius) <= epsilon;
+}
+
+} // namespace
+
+class ClusterLightCullerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        projection = glm::perspective(glm::radians(90.f), 1.f, NEAR, FAR);
+        view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+        culler.buildClusters(CLUSTER_COUNT, projection, NEAR, FAR);
+    }
+
+    glm::mat4 projection, view;
+    vrm::ClusterLightCuller culler;
+};
+
+TEST_F(ClusterLightCullerTest, ClustersSpanTheDepthRange)
+{
+    const auto& clusters = culler.getClusters();
+    ASSERT_EQ(clusters.size(), CLUSTER_COUNT.x * CLUSTER_COUNT.y * CLUSTER_COUNT.z);
+
+    EXPECT_NEAR(clusters.front().maxAABB_VS.z, -NEAR, 1e-5f);
+    EXPECT_NEAR(clusters.back().minAABB_VS.z, -FAR, 1e-3f);
+
+    // Bottom left tile of the far slice reaches the frustum corner, at 90 degrees of field of view
+    const auto& farBottomLeft = clusters[(CLUSTER_COUNT.z - 1) * CLUSTER_COUNT.x * CLUSTER_COUNT.y];
+    EXPECT_NEAR(farBottomLeft.minAABB_VS.x, -FAR, 1e-3f);
+    EXPECT_NEAR(farBottomLeft.minAABB_VS.y, -FAR, 1e-3f);
+}
+
+TEST_F(ClusterLightCullerTest, MatchesBruteForce)
+{
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 1000, 7);
+    const auto lights = ReadLights(registry.getPointLightBlock());
+
+    culler.cull(view, registry.getPointLightBlock());
+    const auto& clusters = culler.getClusters();
+
+    unsigned int maxLights = 0;
+    for (const auto& cluster : clusters)
+    {
+        std::vector<unsigned int> expected;
+        for (unsigned int i = 0; i < lights.size(); ++i)
+        {
+            const glm::vec3 center = glm::vec3(view * glm::vec4(lights[i].position, 1.f));
+            const glm::vec3 offset = glm::clamp(center, glm::vec3(cluster.minAABB_VS), glm::vec3(cluster.maxAABB_VS)) - center;
+            if (lights[i].radius > 0.f && glm::dot(offset, offset) <= lights[i].radius * lights[i].radius)
+                expected.push_back(i);
+        }
+
+        EXPECT_EQ(ClusterLights(cluster, culler.getLightIndices()), expected);
+        maxLights = std::max(maxLights, cluster.lightCount);
+    }
+
+    EXPECT_EQ(culler.getMaxLightsPerCluster(), maxLights);
+}
+
+TEST_F(ClusterLightCullerTest, RangesAreContiguous)
+{
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 257, 3);
+    culler.cull(view, registry.getPointLightBlock());
+
+    unsigned int offset = 0;
+    for (const auto& cluster : culler.getClusters())
+    {
+        EXPECT_EQ(cluster.lightOffset, offset);
+        offset += cluster.lightCount;
+    }
+    EXPECT_EQ(offset, culler.getLightIndices().size());
+}
+
+TEST_F(ClusterLightCullerTest, WorkerCountDoesNotChangeResult)
+{
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 500, 11);
+
+    culler.setWorkerCount(1);
+    culler.cull(view, registry.getPointLightBlock());
+    const auto singleClusters = culler.getClusters();
+    const auto singleIndices = culler.getLightIndices();
+
+    culler.setWorkerCount(7);
+    culler.cull(view, registry.getPointLightBlock());
+    ASSERT_EQ(culler.getLightIndices(), singleIndices);
+    for (size_t i = 0; i < singleClusters.size(); ++i)
+    {
+        EXPECT_EQ(culler.getClusters()[i].lightOffset, singleClusters[i].lightOffset);
+        EXPECT_EQ(culler.getClusters()[i].lightCount, singleClusters[i].lightCount);
+    }
+}
+
+TEST_F(ClusterLightCullerTest, WorkersAreReusedAcrossCulls)
+{
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 300, 5);
+
+    culler.setWorkerCount(1);
+    culler.cull(view, registry.getPointLightBlock());
+    const auto singleIndices = culler.getLightIndices();
+
+    // Moving the culler moves its worker threads along
+    vrm::ClusterLightCuller movedCuller = std::move(culler);
+    movedCuller.setWorkerCount(4);
+    for (int i = 0; i < 20; ++i)
+    {
+        movedCuller.cull(view, registry.getPointLightBlock());
+        ASSERT_EQ(movedCuller.getLightIndices(), singleIndices);
+    }
+
+    // Fewer clusters than workers leaves some workers out of the cull
+    movedCuller.buildClusters({ 1, 1, 2 }, projection, NEAR, FAR);
+    movedCuller.cull(view, registry.getPointLightBlock());
+    EXPECT_EQ(movedCuller.getClusters().size(), 2u);
+
+    movedCuller.buildClusters(CLUSTER_COUNT, projection, NEAR, FAR);
+    movedCuller.cull(view, registry.getPointLightBlock());
+    EXPECT_EQ(movedCuller.getLightIndices(), singleIndices);
+}
+
+TEST_F(ClusterLightCullerTest, NullRadiusLightsAreSkipped)
+{
+    vrm::LightRegistry registry;
+    registry.beginFrame();
+    for (size_t i = 0; i < 64; ++i)
+        registry.submitPointLight({ glm::vec3(1.f), 1.f, i == 10 ? 0.f : 100.f }, glm::vec3(0.f, 0.f, -10.f), static_cast<entt::entity>(i));
+    registry.prepareFrame();
+    ASSERT_EQ(registry.getPointLightSlotCount(), 64u);
+
+    culler.cull(view, registry.getPointLightBlock());
+    const auto lights = ReadLights(registry.getPointLightBlock());
+    const auto& lightIndices = culler.getLightIndices();
+    for (unsigned int index : lightIndices)
+        EXPECT_GT(lights[index].radius, 0.f);
+    EXPECT_GT(lightIndices.size(), 0u);
+}
+
+TEST_F(ClusterLightCullerTest, LimitKeepsMostImportantLights)
+{
+    constexpr unsigned int LIMIT = 4;
+
+    const auto testLights = RandomLights(1000, 5);
+    vrm::LightRegistry registry;
+    registry.beginFrame();
+    for (size_t i = 0; i < testLights.size(); ++i)
+        registry.submitPointLight({ glm::vec3(1.f), 1.f + static_cast<float>(i % 7), testLights[i].radius }, testLights[i].position, static_cast<entt::entity>(i));
+    registry.prepareFrame();
+    const auto lights = ReadLights(registry.getPointLightBlock());
+
+    culler.cull(view, registry.getPointLightBlock());
+    const auto unlimitedClusters = culler.getClusters();
+    const auto unlimitedIndices = culler.getLightIndices();
+    const unsigned int unlimitedMaxLights = culler.getMaxLightsPerCluster();
+    ASSERT_GT(unlimitedMaxLights, LIMIT);
+
+    culler.setClusterLightLimit(LIMIT);
+    culler.cull(view, registry.getPointLightBlock());
+    EXPECT_EQ(culler.getMaxLightsPerCluster(), unlimitedMaxLights);
+
+    for (size_t c = 0; c < unlimitedClusters.size(); ++c)
+    {
+        const auto& cluster = unlimitedClusters[c];
+        const glm::vec3 clusterCenter = 0.5f * (glm::vec3(cluster.minAABB_VS) + glm::vec3(cluster.maxAABB_VS));
+        auto importance = [&](unsigned int light)
+        {
+            const glm::vec3 center = glm::vec3(view * glm::vec4(lights[light].position, 1.f));
+            const glm::vec3 offset = clusterCenter - center;
+            return lights[light].intensity / std::max(glm::dot(offset, offset), 1e-4f);
+        };
+
+        auto expected = ClusterLights(cluster, unlimitedIndices);
+        std::stable_sort(expected.begin(), expected.end(), [&](unsigned int a, unsigned int b) { return importance(a) > importance(b); });
+        expected.resize(std::min<size_t>(expected.size(), LIMIT));
+        std::sort(expected.begin(), expected.end());
+
+        EXPECT_EQ(ClusterLights(culler.getClusters()[c], culler.getLightIndices()), expected);
+    }
+}
+
+TEST_F(ClusterLightCullerTest, SpotLightsCoverTheirCone)
+{
+    const auto spotLights = RandomSpotLights(64, 23);
+    vrm::LightRegistry registry;
+    SubmitLights(registry, RandomLights(100, 29), spotLights);
+    ASSERT_EQ(registry.getSpotLightCount(), spotLights.size());
+
+    culler.cull(view, registry.getPointLightBlock(), registry.getSpotLightBlock());
+    const auto& clusters = culler.getClusters();
+
+    // Every cluster holding a point lit by a spot light lists it
+    std::mt19937 generator(31);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    size_t checkedPoints = 0;
+    for (unsigned int s = 0; s < spotLights.size(); ++s)
+    {
+        const auto& light = spotLights[s];
+        const glm::vec3 side = glm::normalize(glm::cross(light.direction, std::abs(light.direction.y) < 0.9f ? glm::vec3(0.f, 1.f, 0.f) : glm::vec3(1.f, 0.f, 0.f)));
+        const glm::vec3 up = glm::cross(light.direction, side);
+
+        for (int sample = 0; sample < 32; ++sample)
+        {
+            const float distance = light.radius * unit(generator);
+            const float angle = light.angle * unit(generator);
+            const float turn = 2.f * glm::pi<float>() * unit(generator);
+            const glm::vec3 offset = std::cos(angle) * light.direction + std::sin(angle) * (std::cos(turn) * side + std::sin(turn) * up);
+            const glm::vec3 point = glm::vec3(view * glm::vec4(light.position + distance * offset, 1.f));
+
+            for (const auto& cluster : clusters)
+            {
+                if (glm::any(glm::lessThan(point, glm::vec3(cluster.minAABB_VS))) || glm::any(glm::greaterThan(point, glm::vec3(cluster.maxAABB_VS))))
+                    continue;
+
+                const auto clusterLights = ClusterLights(cluster, culler.getLightIndices());
+                EXPECT_TRUE(std::binary_search(clusterLights.begin(), clusterLights.end(), s | vrm::ClusterLightCuller::SpotLightBit));
+                checkedPoints++;
+            }
+        }
+    }
+
+    EXPECT_GT(checkedPoints, 0u);
+}
+
+TEST_F(ClusterLightCullerTest, SpotLightPointingAwayTouchesNothing)
+{
+    // Both ranges reach past the near plane, but the cone points away from the view
+    vrm::LightRegistry registry;
+    registry.beginFrame();
+    registry.submitPointLight({ glm::vec3(1.f), 1.f, 4.f }, glm::vec3(0.f, 0.f, 1.f), static_cast<entt::entity>(0));
+    registry.submitSpotLight({ glm::vec3(1.f), 1.f, 4.f, glm::radians(10.f), glm::radians(15.f) }, glm::vec3(0.f, 0.f, 1.f), glm::vec3(0.f, 0.f, 1.f));
+    registry.prepareFrame();
+
+    culler.cull(view, registry.getPointLightBlock(), registry.getSpotLightBlock());
+
+    EXPECT_GT(culler.getLightIndices().size(), 0u);
+    for (unsigned int index : culler.getLightIndices())
+        EXPECT_EQ(index, 0u);
+}
+
+// Correctness oracle of the compute shaders: every GPU path must assign the same lights as the CPU culler, with each
+// culling kernel. The kernel is set by the test, which ends its selection.
+class ClusteredLightsGPUTest : public testing::TestWithParam<vrm::ClusteredLights::CullingKernel>
+{
+protected:
+    void SetUp() override
+    {
+        static char name[] = "VroomTests";
+        static char headless[] = "--headless";
+        char* argv[] = { name, headless };
+        app = new vrm::Application(2, argv);
+
+        // The culling shaders always read the spot light block
+        spotLightSSBO = std::make_unique<vrm::DynamicSSBO>();
+        spotLightSSBO->setBindingPoint(10);
+        const int spotLightCount = 0;
+        spotLightSSBO->setData(&spotLightCount, sizeof(spotLightCount));
+    }
+
+    void TearDown() override
+    {
+        spotLightSSBO.reset();
+        delete app;
+    }
+
+    // The light index list is grown from statistics read back StatisticsLatency dispatches later
+    void cullUntilFits(vrm::ClusteredLights& clusteredLights, const vrm::CameraBasic& camera, const vrm::LightRegistry& registry)
+    {
+        for (unsigned int i = 0; i <= vrm::ClusteredLights::StatisticsLatency; ++i)
+        {
+            clusteredLights.invalidateLightAssignment();
+            clusteredLights.processLights(camera, registry);
+            glFinish();
+        }
+    }
+
+    // Reads the clusters and light indices written by the GPU
+    void readAssignment(const vrm::ClusteredLights& clusteredLights, std::vector<vrm::SSBOCluster>& clusters, std::vector<unsigned int>& lightIndices)
+    {
+        // Cluster block: grid size, padded to 16 bytes, then the clusters
+        clusters.resize(CLUSTER_COUNT.x * CLUSTER_COUNT.y * CLUSTER_COUNT.z);
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        glBindBuffer(GL_COPY_READ_BUFFER, clusteredLights.getClusterInfoSSBO().getRendererID());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, offsetof(vrm::SSBOClusterInfo, clusters), clusters.size() * sizeof(vrm::SSBOCluster), clusters.data());
+
+        GLuint lightIndexCount = 0;
+        glBindBuffer(GL_COPY_READ_BUFFER, clusteredLights.getLightIndexSSBO().getRendererID());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(GLuint), &lightIndexCount);
+        ASSERT_LE(lightIndexCount, clusteredLights.getLightIndexCapacity()) << "Light index list overflowed";
+        lightIndices.resize(lightIndexCount);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, sizeof(GLuint), lightIndexCount * sizeof(GLuint), lightIndices.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    }
+
+    // Lights assigned differently by the GPU and the CPU culler. Lights whose sphere grazes the cluster may go either
+    // way, with the rounding of each side, and are not counted.
+    size_t countMismatches(const vrm::ClusteredLights& clusteredLights, const vrm::CameraBasic& camera, const std::vector<std::byte>& lightBlock,
+        const std::vector<std::byte>& spotLightBlock = {})
+    {
+        vrm::ClusterLightCuller cpuCuller;
+        cpuCuller.setClusterLightLimit(clusteredLights.getClusterLightLimit());
+        cpuCuller.buildClusters(CLUSTER_COUNT, camera.getProjection(), camera.getNear(), camera.getFar());
+        cpuCuller.cull(camera.getView(), lightBlock, spotLightBlock);
+        const auto& cpuClusters = cpuCuller.getClusters();
+        const auto lights = ReadLights(lightBlock);
+        const auto spotLights = spotLightBlock.empty() ? std::vector<vrm::SSBOSpotLightData>() : ReadSpotLights(spotLightBlock);
+
+        std::vector<vrm::SSBOCluster> gpuClusters;
+        std::vector<unsigned int> gpuIndices;
+        readAssignment(clusteredLights, gpuClusters, gpuIndices);
+
+        size_t mismatches = 0;
+        for (size_t c = 0; c < cpuClusters.size(); ++c)
+        {
+            EXPECT_NEAR(gpuClusters[c].minAABB_VS.z, cpuClusters[c].minAABB_VS.z, 1e-3f);
+            EXPECT_NEAR(gpuClusters[c].maxAABB_VS.x, cpuClusters[c].maxAABB_VS.x, 1e-3f);
+
+            const auto gpuLights = ClusterLights(gpuClusters[c], gpuIndices);
+            const auto cpuLights = ClusterLights(cpuClusters[c], cpuCuller.getLightIndices());
+
+            std::vector<unsigned int> difference;
+            std::set_symmetric_difference(gpuLights.begin(), gpuLights.end(), cpuLights.begin(), cpuLights.end(), std::back_inserter(difference));
+            for (unsigned int light : difference)
+            {
+                if ((light & vrm::ClusterLightCuller::SpotLightBit) != 0)
+                {
+                    if (!SpotLightGrazesAABB(cpuClusters[c], camera.getView(), spotLights[light & ~vrm::ClusterLightCuller::SpotLightBit]))
+                        mismatches++;
+                    continue;
+                }
+
+                const glm::vec3 center = glm::vec3(camera.getView() * glm::vec4(lights[light].position, 1.f));
+                if (std::abs(SphereToAABBDistance(cpuClusters[c], center, lights[light].radius)) > 1e-3f)
+                    mismatches++;
+            }
+        }
+
+        return mismatches;
+    }
+
+    vrm::Application* app;
+    std::unique_ptr<vrm::DynamicSSBO> spotLightSSBO;
+};
+
+INSTANTIATE_TEST_SUITE_P(CullingKernels, ClusteredLightsGPUTest,
+    testing::Values(vrm::ClusteredLights::CullingKernel::Global, vrm::ClusteredLights::CullingKernel::SharedMemory),
+    [](const testing::TestParamInfo<vrm::ClusteredLights::CullingKernel>& info)
+    {
+        return info.param == vrm::ClusteredLights::CullingKernel::SharedMemory ? "SharedMemory" : "Global";
+    });
+
+TEST_P(ClusteredLightsGPUTest, MatchesCPUCulling)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 2000, 13);
+    const auto& lightBlock = registry.getPointLightBlock();
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(lightBlock.data(), static_cast<int>(lightBlock.size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+
+    for (auto mode : { vrm::ClusteredLights::CullingMode::PerCluster, vrm::ClusteredLights::CullingMode::PerLight })
+    {
+        clusteredLights.setCullingMode(mode);
+        cullUntilFits(clusteredLights, camera, registry);
+
+        EXPECT_EQ(countMismatches(clusteredLights, camera, lightBlock), 0u) << "Culling mode " << static_cast<int>(mode);
+    }
+}
+
+TEST_P(ClusteredLightsGPUTest, PartialUpdateMatchesCPUCulling)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    auto lights = RandomLights(500, 17);
+    vrm::LightRegistry registry;
+    SubmitLights(registry, lights);
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(registry.getPointLightBlock().data(), static_cast<int>(registry.getPointLightBlock().size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+    cullUntilFits(clusteredLights, camera, registry);
+
+    // Same lights again: the assignment is kept
+    SubmitLights(registry, lights);
+    EXPECT_TRUE(registry.getPointLightChanges().empty());
+    EXPECT_FALSE(clusteredLights.needsFullCulling(camera, registry));
+
+    // A few lights move, one is removed and one is added
+    for (size_t i = 0; i < lights.size(); i += 100)
+        lights[i].position += glm::vec3(3.f, -2.f, -5.f);
+    lights[42].radius = 0.f;
+    lights.push_back({ { 0.f, 0.f, -30.f }, 6.f });
+    SubmitLights(registry, lights);
+    lightSSBO.setData(registry.getPointLightBlock().data(), static_cast<int>(registry.getPointLightBlock().size()));
+
+    ASSERT_FALSE(clusteredLights.needsFullCulling(camera, registry));
+    clusteredLights.processLights(camera, registry);
+
+    EXPECT_EQ(countMismatches(clusteredLights, camera, registry.getPointLightBlock()), 0u);
+}
+
+TEST_P(ClusteredLightsGPUTest, ManyPartialUpdatesStayInTheList)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    auto lights = RandomLights(500, 29);
+    vrm::LightRegistry registry;
+    SubmitLights(registry, lights);
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(registry.getPointLightBlock().data(), static_cast<int>(registry.getPointLightBlock().size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+    cullUntilFits(clusteredLights, camera, registry);
+
+    // Every frame appends new ranges, without waiting for the statistics of the previous ones. The list must be culled
+    // again, or grown, before they overflow it.
+    for (unsigned int frame = 0; frame < 200; ++frame)
+    {
+        for (size_t i = frame % 50; i < lights.size(); i += 50)
+            lights[i].position += glm::vec3(0.5f, -0.25f, (frame % 2 == 0) ? -1.f : 1.f);
+        SubmitLights(registry, lights);
+        lightSSBO.setData(registry.getPointLightBlock().data(), static_cast<int>(registry.getPointLightBlock().size()));
+
+        clusteredLights.processLights(camera, registry);
+
+        if (frame % 25 == 24)
+            ASSERT_EQ(countMismatches(clusteredLights, camera, registry.getPointLightBlock()), 0u) << "Frame " << frame;
+    }
+}
+
+TEST_P(ClusteredLightsGPUTest, ActiveClustersMatchFullCulling)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 1000, 47);
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(registry.getPointLightBlock().data(), static_cast<int>(registry.getPointLightBlock().size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+
+    // Two surfaces: 5 units away on the left half of the view, 20 units away on the right half
+    constexpr int depthSize = 256;
+    vrm::DepthFrameBuffer depthTarget;
+    depthTarget.resize(depthSize, depthSize);
+    depthTarget.bind();
+    glEnable(GL_SCISSOR_TEST);
+    for (const auto& [x, distance] : { std::pair<int, float>(0, 5.f), std::pair<int, float>(depthSize / 2, 20.f) })
+    {
+        const float ndcDepth = (FAR + NEAR - 2.f * FAR * NEAR / distance) / (FAR - NEAR);
+        glScissor(x, 0, depthSize / 2, depthSize);
+        glClearDepth(0.5 * ndcDepth + 0.5);
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+    glDisable(GL_SCISSOR_TEST);
+    glClearDepth(1.0);
+    depthTarget.unbind();
+
+    for (auto mode : { vrm::ClusteredLights::CullingMode::PerCluster, vrm::ClusteredLights::CullingMode::PerLight })
+    {
+        clusteredLights.setCullingMode(mode);
+        cullUntilFits(clusteredLights, camera, registry);
+
+        std::vector<vrm::SSBOCluster> fullClusters;
+        std::vector<unsigned int> fullIndices;
+        readAssignment(clusteredLights, fullClusters, fullIndices);
+
+        clusteredLights.invalidateLightAssignment();
+        clusteredLights.findActiveClusters(depthTarget.getDepthTexture(), camera);
+        clusteredLights.processLights(camera, registry);
+
+        std::vector<vrm::SSBOCluster> activeClusters;
+        std::vector<unsigned int> activeIndices;
+        readAssignment(clusteredLights, activeClusters, activeIndices);
+
+        // Active cluster block: dispatch arguments and active cluster count, then the active clusters
+        GLuint header[4] = {};
+        glBindBuffer(GL_COPY_READ_BUFFER, clusteredLights.getActiveClusterSSBO().getRendererID());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(header), header);
+        std::vector<GLuint> activeClusterIndices(header[3]);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, sizeof(header), activeClusterIndices.size() * sizeof(GLuint), activeClusterIndices.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        // Each tile column holds one surface, so a single slice of it is active
+        ASSERT_EQ(activeClusterIndices.size(), CLUSTER_COUNT.x * CLUSTER_COUNT.y) << "Culling mode " << static_cast<int>(mode);
+
+        std::vector<uint8_t> active(fullClusters.size(), 0);
+        for (GLuint cluster : activeClusterIndices)
+        {
+            active[cluster] = 1;
+            EXPECT_EQ(ClusterLights(activeClusters[cluster], activeIndices), ClusterLights(fullClusters[cluster], fullIndices))
+                << "Culling mode " << static_cast<int>(mode) << ", cluster " << cluster;
+        }
+
+        // Clusters left out hold no light
+        for (size_t c = 0; c < activeClusters.size(); ++c)
+        {
+            if (!active[c])
+                EXPECT_EQ(activeClusters[c].lightCount, 0u) << "Culling mode " << static_cast<int>(mode) << ", cluster " << c;
+        }
+    }
+}
+
+TEST_P(ClusteredLightsGPUTest, ClusterLightLimitMatchesCPUCulling)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    vrm::LightRegistry registry;
+    SubmitRandomLights(registry, 2000, 19);
+    const auto& lightBlock = registry.getPointLightBlock();
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(lightBlock.data(), static_cast<int>(lightBlock.size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setClusterLightLimit(8);
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+
+    // Lights of near equal importance may be swapped by the rounding of each side, a grazing light changes the kept ones too
+    for (auto mode : { vrm::ClusteredLights::CullingMode::PerCluster, vrm::ClusteredLights::CullingMode::PerLight })
+    {
+        clusteredLights.setCullingMode(mode);
+        cullUntilFits(clusteredLights, camera, registry);
+
+        EXPECT_LE(countMismatches(clusteredLights, camera, lightBlock), 8u) << "Culling mode " << static_cast<int>(mode);
+    }
+}
+
+TEST_P(ClusteredLightsGPUTest, SpotLightsMatchCPUCulling)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    vrm::LightRegistry registry;
+    SubmitLights(registry, RandomLights(1000, 37), RandomSpotLights(200, 41));
+    const auto& lightBlock = registry.getPointLightBlock();
+    const auto& spotLightBlock = registry.getSpotLightBlock();
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(lightBlock.data(), static_cast<int>(lightBlock.size()));
+    spotLightSSBO->setData(spotLightBlock.data(), static_cast<int>(spotLightBlock.size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+
+    for (auto mode : { vrm::ClusteredLights::CullingMode::PerCluster, vrm::ClusteredLights::CullingMode::PerLight })
+    {
+        clusteredLights.setCullingMode(mode);
+        cullUntilFits(clusteredLights, camera, registry);
+
+        EXPECT_EQ(countMismatches(clusteredLights, camera, lightBlock, spotLightBlock), 0u) << "Culling mode " << static_cast<int>(mode);
+    }
+}
+
+TEST_P(ClusteredLightsGPUTest, StaticSceneGrowsOverflowingList)
+{
+    vrm::FirstPersonCamera camera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+
+    // Large lights touch far more clusters than the initial list estimates
+    auto lights = RandomLights(300, 43);
+    for (auto& light : lights)
+        light.radius *= 6.f;
+
+    vrm::LightRegistry registry;
+    SubmitLights(registry, lights);
+
+    vrm::DynamicSSBO lightSSBO;
+    lightSSBO.setBindingPoint(0);
+    lightSSBO.setData(registry.getPointLightBlock().data(), static_cast<int>(registry.getPointLightBlock().size()));
+
+    vrm::ClusteredLights clusteredLights;
+    clusteredLights.setCullingKernel(GetParam(), clusteredLights.getCullingLocalSize());
+    clusteredLights.setBindingPoints(1, 6);
+    clusteredLights.setClusterLightLimit(static_cast<unsigned int>(lights.size()));
+    clusteredLights.setupClusters(CLUSTER_COUNT, camera);
+
+    clusteredLights.processLights(camera, registry);
+    const unsigned int initialCapacity = clusteredLights.getLightIndexCapacity();
+
+    // Nothing moves: no culling is dispatched unless the overflow of the first one is read back
+    for (unsigned int frame = 0; frame <= vrm::ClusteredLights::StatisticsLatency; ++frame)
+    {
+        glFinish();
+        SubmitLights(registry, lights);
+        clusteredLights.processLights(camera, registry);
+    }
+
+    EXPECT_GT(clusteredLights.getLightIndexCapacity(), initialCapacity);
+    EXPECT_EQ(countMismatches(clusteredLights, camera, registry.getPointLightBlock()), 0u);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <Vroom/Core/FrameStats.h>
+
+using Counter = vrm::FrameStats::Counter;
+
+TEST(FrameStatsTest, CountersResetAtEndOfFrame)
+{
+    vrm::FrameStats stats;
+    stats.add(Counter::DrawCalls);
+    stats.add(Counter::DrawCalls, 2.0);
+    stats.set(Counter::MaxLightsPerCluster, 7.0);
+    EXPECT_DOUBLE_EQ(stats.get(Counter::DrawCalls), 3.0);
+
+    stats.endFrame(16.f);
+
+    EXPECT_DOUBLE_EQ(stats.get(Counter::DrawCalls), 0.0);
+    ASSERT_EQ(stats.getFrameCount(), 1);
+    EXPECT_EQ(stats.getLastFrame().index, 0);
+    EXPECT_FLOAT_EQ(stats.getLastFrame().frameTime, 16.f);
+    EXPECT_DOUBLE_EQ(stats.getLastFrame().get(Counter::DrawCalls), 3.0);
+    EXPECT_DOUBLE_EQ(stats.getLastFrame().get(Counter::MaxLightsPerCluster), 7.0);
+}
+
+TEST(FrameStatsTest, HistoryKeepsLastFrames)
+{
+    vrm::FrameStats stats;
+    const size_t frameCount = vrm::FrameStats::HistoryFrames + 10;
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+        stats.set(Counter::Triangles, static_cast<double>(i));
+        stats.endFrame(static_cast<float>(i % 100 + 1));
+    }
+
+    ASSERT_EQ(stats.getFrameCount(), vrm::FrameStats::HistoryFrames);
+    EXPECT_EQ(stats.getFrame(0).index, 10);
+    EXPECT_DOUBLE_EQ(stats.getFrame(0).get(Counter::Triangles), 10.0);
+    EXPECT_EQ(stats.getLastFrame().index, frameCount - 1);
+
+    // 600 frames, times cycling through 1..100 ms
+    EXPECT_FLOAT_EQ(stats.getFrameTimePercentile(50.f), 50.f);
+    EXPECT_FLOAT_EQ(stats.getFrameTimePercentile(99.f), 99.f);
+
+    stats.clear();
+    EXPECT_EQ(stats.getFrameCount(), 0);
+    EXPECT_FLOAT_EQ(stats.getFrameTimePercentile(50.f), 0.f);
+}
+
+TEST(FrameStatsTest, WritesCSV)
+{
+    vrm::FrameStats stats;
+    stats.add(Counter::BytesUploaded, 4194304.0);
+    stats.endFrame(8.f);
+
+    std::ostringstream stream;
+    stats.write(stream, vrm::FrameStats::Format::CSV);
+
+    std::istringstream lines(stream.str());
+    std::string header, row;
+    std::getline(lines, header);
+    std::getline(lines, row);
+
+    EXPECT_EQ(header.rfind("frame,frame_time_ms,draw_calls,", 0), 0);
+    EXPECT_NE(header.find(",bytes_uploaded,"), std::string::npos);
+    EXPECT_EQ(row.rfind("0,8,0,", 0), 0);
+    EXPECT_NE(row.find(",4194304,"), std::string::npos);
+}
+
+TEST(FrameStatsTest, WritesJSON)
+{
+    vrm::FrameStats stats;
+    std::ostringstream empty;
+    stats.write(empty, vrm::FrameStats::Format::JSON);
+    EXPECT_EQ(empty.str(), "[\n]\n");
+
+    stats.add(Counter::ScriptsUpdated, 3.0);
+    stats.endFrame(10.f);
+    stats.endFrame(20.f);
+
+    std::ostringstream stream;
+    stats.write(stream, vrm::FrameStats::Format::JSON);
+    const std::string json = stream.str();
+
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_NE(json.find("{\"frame\":0,\"frame_time_ms\":10,\"draw_calls\":0,"), std::string::npos);
+    EXPECT_NE(json.find("\"scripts_updated\":3}"), std::string::npos);
+    EXPECT_NE(json.find("},\n{\"frame\":1,"), std::string::npos);
+}
+
+TEST(FrameStatsTest, EngineInstanceLivesBetweenInitAndShutdown)
+{
+    ASSERT_FALSE(vrm::FrameStats::IsInitialized());
+
+    vrm::FrameStats::Init();
+    ASSERT_TRUE(vrm::FrameStats::IsInitialized());
+    vrm::FrameStats::Get().add(Counter::DrawCalls);
+    EXPECT_DOUBLE_EQ(vrm::FrameStats::Get().get(Counter::DrawCalls), 1.0);
+
+    vrm::FrameStats::Shutdown();
+    EXPECT_FALSE(vrm::FrameStats::IsInitialized());
+}
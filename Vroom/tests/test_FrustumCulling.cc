@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Vroom/Asset/AssetData/MeshData.h>
+#include <Vroom/Render/Culling/Frustum.h>
+#include <Vroom/Render/Culling/FrustumCuller.h>
+
+class FrustumCullerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Camera at origin, looking towards -Z
+        glm::mat4 projection = glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+        frustum = vrm::Frustum::FromViewProjection(projection * view);
+
+        unitBox = { glm::vec3(-1.f), glm::vec3(1.f) };
+        unitSphere = { glm::vec3(0.f), std::sqrt(3.f) };
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    vrm::Frustum frustum;
+    vrm::FrustumCuller culler;
+    vrm::AABB unitBox;
+    vrm::BoundingSphere unitSphere;
+};
+
+TEST_F(FrustumCullerTest, PlanesAreNormalized)
+{
+    for (const auto& plane : frustum.planes)
+        EXPECT_NEAR(glm::length(glm::vec3(plane)), 1.f, 1e-5f);
+}
+
+TEST_F(FrustumCullerTest, InsideAndOutside)
+{
+    size_t front = culler.push(unitBox, unitSphere, glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, -10.f)));
+    size_t behind = culler.push(unitBox, unitSphere, glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, 10.f)));
+    size_t left = culler.push(unitBox, unitSphere, glm::translate(glm::mat4(1.f), glm::vec3(-50.f, 0.f, -10.f)));
+    size_t tooFar = culler.push(unitBox, unitSphere, glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, -200.f)));
+    size_t crossingNear = culler.push(unitBox, unitSphere, glm::mat4(1.f));
+
+    EXPECT_EQ(culler.cull(frustum), 2);
+    EXPECT_TRUE(culler.isVisible(front));
+    EXPECT_FALSE(culler.isVisible(behind));
+    EXPECT_FALSE(culler.isVisible(left));
+    EXPECT_FALSE(culler.isVisible(tooFar));
+    EXPECT_TRUE(culler.isVisible(crossingNear));
+}
+
+TEST_F(FrustumCullerTest, ScaleIsApplied)
+{
+    // Box center is outside of the left plane, but a large scale makes it reach inside.
+    glm::mat4 model = glm::translate(glm::mat4(1.f), glm::vec3(-20.f, 0.f, -10.f));
+    size_t small = culler.push(unitBox, unitSphere, model);
+    size_t large = culler.push(unitBox, unitSphere, glm::scale(model, glm::vec3(15.f, 1.f, 1.f)));
+
+    culler.cull(frustum);
+    EXPECT_FALSE(culler.isVisible(small));
+    EXPECT_TRUE(culler.isVisible(large));
+}
+
+TEST_F(FrustumCullerTest, SimdMatchesScalar)
+{
+    // Enough volumes to go through the SIMD batches and the scalar remainder.
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-120.f, 120.f);
+    std::uniform_real_distribution<float> scale(0.1f, 5.f);
+
+    std::vector<glm::mat4> models;
+    for (size_t i = 0; i < 1003; ++i)
+    {
+        glm::mat4 model = glm::translate(glm::mat4(1.f), glm::vec3(position(rng), position(rng), position(rng)));
+        models.push_back(glm::scale(model, glm::vec3(scale(rng))));
+        culler.push(unitBox, unitSphere, models.back());
+    }
+
+    size_t visibleCount = culler.cull(frustum);
+
+    size_t expectedCount = 0;
+    for (size_t i = 0; i < models.size(); ++i)
+    {
+        const glm::vec3 center = glm::vec3(models[i][3]);
+        const float extent = glm::length(glm::vec3(models[i][0]));
+        const float radius = unitSphere.radius * extent;
+
+        bool visible = true;
+        for (const auto& plane : frustum.planes)
+        {
+            const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            const float boxRadius = (std::abs(plane.x) + std::abs(plane.y) + std::abs(plane.z)) * extent;
+            if (distance < -radius || distance + boxRadius < 0.f)
+                visible = false;
+        }
+
+        EXPECT_EQ(culler.isVisible(i), visible) << "Volume " << i;
+        expectedCount += visible ? 1 : 0;
+    }
+
+    EXPECT_EQ(visibleCount, expectedCount);
+    EXPECT_GT(visibleCount, 0);
+    EXPECT_LT(visibleCount, models.size());
+}
+
+TEST_F(FrustumCullerTest, ClearKeepsNothing)
+{
+    culler.push(unitBox, unitSphere, glm::mat4(1.f));
+    culler.clear();
+
+    EXPECT_EQ(culler.size(), 0);
+    EXPECT_EQ(culler.cull(frustum), 0);
+}
+
+TEST(MeshDataBoundsTest, BoundsEncloseVertices)
+{
+    std::vector<vrm::Vertex> vertices = {
+        { { -1.f, 0.f, 2.f }, glm::vec3(0.f), glm::vec2(0.f) },
+        { { 3.f, -2.f, 2.f }, glm::vec3(0.f), glm::vec2(0.f) },
+        { { 1.f, 4.f, 0.f }, glm::vec3(0.f), glm::vec2(0.f) }
+    };
+    vrm::MeshData meshData(vertices, { 0, 1, 2 });
+
+    const auto& box = meshData.getBoundingBox();
+    EXPECT_EQ(box.min, glm::vec3(-1.f, -2.f, 0.f));
+    EXPECT_EQ(box.max, glm::vec3(3.f, 4.f, 2.f));
+
+    const auto& sphere = meshData.getBoundingSphere();
+    EXPECT_EQ(sphere.center, glm::vec3(1.f, 1.f, 1.f));
+    for (const auto& vertex : vertices)
+        EXPECT_LE(glm::distance(vertex.position, sphere.center), sphere.radius + 1e-5f);
+
+    // Bounds must survive copies
+    vrm::MeshData copy = meshData;
+    EXPECT_EQ(copy.getBoundingBox().max, box.max);
+    EXPECT_EQ(copy.getBoundingSphere().radius, sphere.radius);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <Vroom/Core/Application.h>
+#include <Vroom/Render/Abstraction/DynamicSSBO.h>
+#include <Vroom/Render/Abstraction/GPUBufferAllocator.h>
+
+class GPUBufferAllocatorTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static char name[] = "VroomTests";
+        static char headless[] = "--headless";
+        char* argv[] = { name, headless };
+        app = new vrm::Application(2, argv);
+    }
+
+    void TearDown() override
+    {
+        delete app;
+    }
+
+    std::vector<unsigned int> readBuffer(unsigned int rendererID, size_t count)
+    {
+        std::vector<unsigned int> values(count);
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        glBindBuffer(GL_COPY_READ_BUFFER, rendererID);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, count * sizeof(unsigned int), values.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        EXPECT_EQ(glGetError(), GL_NO_ERROR);
+        return values;
+    }
+
+    vrm::Application* app;
+};
+
+TEST_F(GPUBufferAllocatorTest, FreedRangesAreReused)
+{
+    vrm::GPUBufferAllocator buffer(GL_SHADER_STORAGE_BUFFER, 16);
+
+    const size_t first = buffer.allocate(40);
+    const size_t second = buffer.allocate(16);
+    const size_t third = buffer.allocate(1);
+    EXPECT_EQ(first, 0u);
+    EXPECT_EQ(second, 48u);
+    EXPECT_EQ(third, 64u);
+    EXPECT_EQ(buffer.getUsed(), 80u);
+
+    buffer.free(second, 16);
+    EXPECT_EQ(buffer.allocate(10), second);
+    EXPECT_EQ(buffer.getUsedEnd(), 80u);
+}
+
+TEST_F(GPUBufferAllocatorTest, GrowthKeepsContent)
+{
+    vrm::GPUBufferAllocator buffer(GL_SHADER_STORAGE_BUFFER, 4);
+
+    std::vector<unsigned int> values(64);
+    std::iota(values.begin(), values.end(), 1u);
+    const size_t offset = buffer.allocate(values.size() * sizeof(unsigned int));
+    buffer.write(values.data(), values.size() * sizeof(unsigned int), offset);
+    const size_t capacity = buffer.getCapacity();
+
+    // Full: the next allocation moves the content to a larger storage, and keeps the old one as a spare
+    buffer.allocate(sizeof(unsigned int));
+    EXPECT_GT(buffer.getCapacity(), capacity);
+    EXPECT_EQ(buffer.getSpareStorageCount(), 1u);
+    EXPECT_EQ(readBuffer(buffer.getRendererID(), values.size()), values);
+}
+
+TEST_F(GPUBufferAllocatorTest, QuietFramesShrinkMostlyEmptyBuffer)
+{
+    vrm::GPUBufferAllocator buffer(GL_SHADER_STORAGE_BUFFER, 4);
+    buffer.reserve(4096);
+
+    const std::vector<unsigned int> values = { 7, 8, 9, 10 };
+    const size_t size = values.size() * sizeof(unsigned int);
+    buffer.write(values.data(), size, buffer.allocate(size));
+
+    // The frame that grew the buffer does not count as quiet
+    buffer.endFrame();
+    for (unsigned int frame = 1; frame < vrm::GPUBufferAllocator::QuietFramesBeforeShrink; ++frame)
+        buffer.endFrame();
+    EXPECT_EQ(buffer.getCapacity(), 4096u);
+
+    buffer.endFrame();
+    EXPECT_EQ(buffer.getCapacity(), 2 * size);
+    EXPECT_EQ(readBuffer(buffer.getRendererID(), values.size()), values);
+}
+
+TEST_F(GPUBufferAllocatorTest, DynamicSSBOShrinksToWrittenData)
+{
+    vrm::DynamicSSBO ssbo;
+    std::vector<unsigned int> values(1024, 3u);
+    ssbo.setData(values.data(), static_cast<int>(values.size() * sizeof(unsigned int)));
+
+    // Only the first values are still in use
+    values.resize(16);
+    ssbo.setData(values.data(), static_cast<int>(values.size() * sizeof(unsigned int)));
+    for (unsigned int frame = 0; frame <= vrm::GPUBufferAllocator::QuietFramesBeforeShrink; ++frame)
+        ssbo.endFrame();
+
+    EXPECT_EQ(ssbo.getCapacity(), static_cast<int>(2 * values.size() * sizeof(unsigned int)));
+    EXPECT_EQ(readBuffer(ssbo.getRendererID(), values.size()), values);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <Vroom/Core/Application.h>
+#include <Vroom/Render/RenderObject/GeometryPool.h>
+
+class GeometryPoolTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static char name[] = "VroomTests";
+        static char headless[] = "--headless";
+        char* argv[] = { name, headless };
+        app = new vrm::Application(2, argv);
+    }
+
+    void TearDown() override
+    {
+        delete app;
+    }
+
+    vrm::GeometryPool::Handle allocate(vrm::GeometryPool& pool, size_t vertexCount)
+    {
+        const std::vector<vrm::PackedVertex> vertices(vertexCount);
+        const std::vector<uint32_t> indices = { 0, 1, 2 };
+        return pool.allocate(vertices.data(), static_cast<unsigned int>(vertexCount), indices.data(), static_cast<unsigned int>(indices.size()));
+    }
+
+    vrm::Application* app;
+};
+
+TEST_F(GeometryPoolTest, FreedRangesAreReused)
+{
+    auto& pool = vrm::GeometryPool::Get(vrm::VertexFormat::Packed, vrm::GeometryPool::IndexType::UInt32);
+
+    const auto first = allocate(pool, 1000);
+    const auto second = allocate(pool, 500);
+    const unsigned int baseVertex = pool.getAllocation(first).baseVertex;
+
+    pool.free(first);
+    const auto third = allocate(pool, 800);
+    EXPECT_EQ(pool.getAllocation(third).baseVertex, baseVertex);
+    EXPECT_TRUE(pool.getAllocation(second).alive);
+}
+
+TEST_F(GeometryPoolTest, GrowthFitsRequestWhenFreeSpaceIsFragmented)
+{
+    auto& pool = vrm::GeometryPool::Get(vrm::VertexFormat::Packed, vrm::GeometryPool::IndexType::UInt32);
+
+    // A hole before the last allocated range, too small to take part in the next allocation
+    const auto hole = allocate(pool, 1000);
+    const auto kept = allocate(pool, 60000);
+    pool.free(hole);
+
+    // More than the free space, and more than twice the capacity: the buffer grows without compacting
+    const size_t vertexCount = pool.getVertexCapacity() * 2 + 8000;
+    const auto large = allocate(pool, vertexCount);
+
+    const auto& allocation = pool.getAllocation(large);
+    EXPECT_TRUE(allocation.alive);
+    EXPECT_EQ(allocation.vertexCount, vertexCount);
+    EXPECT_LE(allocation.baseVertex + allocation.vertexCount, pool.getVertexCapacity());
+    EXPECT_TRUE(pool.getAllocation(kept).alive);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <Vroom/Render/Camera/FirstPersonCamera.h>
+#include <Vroom/Render/Clustering/LightBudget.h>
+#include <Vroom/Render/Clustering/LightRegistry.h>
+
+// Lights are selected and submitted to a registry that is only prepared: no OpenGL context is needed.
+
+namespace
+{
+
+constexpr float NEAR = 0.1f;
+constexpr float FAR = 100.f;
+
+vrm::PointLightComponent Light(float intensity, float radius)
+{
+    return { glm::vec3(1.f), intensity, radius };
+}
+
+entt::entity Entity(uint32_t index)
+{
+    return static_cast<entt::entity>(index);
+}
+
+// Looking down -Z from the origin
+vrm::FirstPersonCamera MakeCamera()
+{
+    return vrm::FirstPersonCamera(NEAR, FAR, glm::radians(90.f), 1.f, glm::vec3(0.f), glm::vec3(0.f));
+}
+
+const std::vector<vrm::SSBOPointLightData>& SelectLights(vrm::LightBudget& budget, vrm::LightRegistry& registry)
+{
+    const auto camera = MakeCamera();
+    registry.beginFrame();
+    budget.selectLights(camera, registry);
+    registry.prepareFrame();
+    return registry.getPointLights();
+}
+
+} // namespace
+
+TEST(LightBudgetTest, EffectiveRadiusFollowsIntensityCutoff)
+{
+    // Intensity 1 falls to 1 / 256 at a distance of 16
+    EXPECT_FLOAT_EQ(vrm::LightBudget::GetEffectiveRadius(Light(1.f, 100.f), 1.f / 256.f), 16.f);
+    EXPECT_FLOAT_EQ(vrm::LightBudget::GetEffectiveRadius(Light(4.f, 100.f), 1.f / 256.f), 32.f);
+
+    // The component radius is an upper bound, and the only bound without a cutoff
+    EXPECT_FLOAT_EQ(vrm::LightBudget::GetEffectiveRadius(Light(1.f, 5.f), 1.f / 256.f), 5.f);
+    EXPECT_FLOAT_EQ(vrm::LightBudget::GetEffectiveRadius(Light(1.f, 100.f), 0.f), 100.f);
+
+    EXPECT_FLOAT_EQ(vrm::LightBudget::GetEffectiveRadius(Light(0.f, 100.f), 1.f / 256.f), 0.f);
+}
+
+TEST(LightBudgetTest, LightsOutsideFrustumAreDropped)
+{
+    vrm::LightBudget budget;
+    vrm::LightRegistry registry;
+
+    budget.beginFrame();
+    budget.submitPointLight(Light(1.f, 2.f), glm::vec3(0.f, 0.f, -10.f), Entity(0)); // In front
+    budget.submitPointLight(Light(1.f, 2.f), glm::vec3(0.f, 0.f, 10.f), Entity(1));  // Behind
+    budget.submitPointLight(Light(1.f, 2.f), glm::vec3(0.f, 0.f, -150.f), Entity(2)); // Past the far plane
+    budget.submitPointLight(Light(1.f, 2.f), glm::vec3(11.f, 0.f, -10.f), Entity(3)); // Sphere crossing the right plane
+    budget.submitPointLight(Light(0.f, 2.f), glm::vec3(0.f, 0.f, -10.f), Entity(4));  // Lighting nothing
+
+    const auto& lights = SelectLights(budget, registry);
+
+    EXPECT_EQ(budget.getSubmittedLightCount(), 5u);
+    EXPECT_EQ(budget.getVisibleLightCount(), 2u);
+    EXPECT_EQ(budget.getKeptLightCount(), 2u);
+    ASSERT_EQ(lights.size(), 2u);
+    EXPECT_EQ(lights[0].position, glm::vec3(0.f, 0.f, -10.f));
+    EXPECT_EQ(lights[1].position, glm::vec3(11.f, 0.f, -10.f));
+}
+
+TEST(LightBudgetTest, BudgetKeepsBestScoredLightsInSubmissionOrder)
+{
+    vrm::LightBudget budget;
+    budget.setMaxLights(3);
+    vrm::LightRegistry registry;
+
+    // Same radius everywhere: the score grows with the intensity and shrinks with the distance
+    budget.beginFrame();
+    budget.submitPointLight(Light(1.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(0));
+    budget.submitPointLight(Light(8.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(1));
+    budget.submitPointLight(Light(1.f, 1.f), glm::vec3(0.f, 0.f, -50.f), Entity(2));
+    budget.submitPointLight(Light(4.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(3));
+    budget.submitPointLight(Light(2.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(4));
+
+    const auto& lights = SelectLights(budget, registry);
+
+    EXPECT_EQ(budget.getVisibleLightCount(), 5u);
+    EXPECT_EQ(budget.getKeptLightCount(), 3u);
+    ASSERT_EQ(lights.size(), 3u);
+    EXPECT_EQ(lights[0].intensity, 8.f);
+    EXPECT_EQ(lights[1].intensity, 4.f);
+    EXPECT_EQ(lights[2].intensity, 2.f);
+}
+
+TEST(LightBudgetTest, TiesGoToFirstSubmittedLights)
+{
+    vrm::LightBudget budget;
+    budget.setMaxLights(2);
+    vrm::LightRegistry registry;
+
+    budget.beginFrame();
+    for (uint32_t i = 0; i < 4; ++i)
+        budget.submitPointLight(Light(1.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(i));
+
+    SelectLights(budget, registry);
+
+    // Lights are keyed by entity: submitting the kept entities again changes nothing
+    registry.beginFrame();
+    registry.submitPointLight(Light(1.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(0));
+    registry.submitPointLight(Light(1.f, 1.f), glm::vec3(0.f, 0.f, -10.f), Entity(1));
+    registry.prepareFrame();
+    EXPECT_TRUE(registry.getPointLightChanges().empty());
+}
+
+TEST(LightBudgetTest, SpotAndDirectionalLightsAreNotBudgeted)
+{
+    vrm::LightBudget budget;
+    budget.setMaxLights(1);
+    vrm::LightRegistry registry;
+
+    const vrm::SpotLightComponent spotLight = { glm::vec3(1.f), 1.f, 2.f };
+    budget.beginFrame();
+    budget.submitPointLight(Light(1.f, 2.f), glm::vec3(0.f, 0.f, -10.f), Entity(0));
+    budget.submitPointLight(Light(1.f, 2.f), glm::vec3(0.f, 0.f, -20.f), Entity(1));
+    budget.submitSpotLight(spotLight, glm::vec3(0.f, 0.f, -10.f), glm::vec3(0.f, -1.f, 0.f));
+    budget.submitSpotLight(spotLight, glm::vec3(0.f, 0.f, 10.f), glm::vec3(0.f, 0.f, -1.f)); // Range behind the camera
+    budget.submitSpotLight(spotLight, glm::vec3(0.f, 0.f, -20.f), glm::vec3(0.f, -1.f, 0.f));
+    budget.submitDirectionalLight({ glm::vec3(1.f), 1.f }, glm::vec3(0.f, -1.f, 0.f));
+
+    const auto& lights = SelectLights(budget, registry);
+
+    // Only point lights are counted
+    EXPECT_EQ(budget.getSubmittedLightCount(), 2u);
+    EXPECT_EQ(budget.getKeptLightCount(), 1u);
+    EXPECT_EQ(lights.size(), 1u);
+
+    ASSERT_EQ(registry.getSpotLightCount(), 2u);
+    EXPECT_EQ(registry.getSpotLights()[0].position, glm::vec3(0.f, 0.f, -10.f));
+    EXPECT_EQ(registry.getSpotLights()[1].position, glm::vec3(0.f, 0.f, -20.f));
+    EXPECT_EQ(registry.getDirectionalLights().size(), 1u);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <Vroom/Render/Clustering/LightRegistry.h>
+
+// Only prepareFrame is called: the light block is built without an OpenGL context, and never uploaded.
+
+namespace
+{
+
+vrm::PointLightComponent Light(float radius)
+{
+    return { glm::vec3(1.f), 1.f, radius };
+}
+
+entt::entity Entity(uint32_t index)
+{
+    return static_cast<entt::entity>(index);
+}
+
+// Submits lights 0 to count - 1, with their index as radius, except the skipped one
+void SubmitLights(vrm::LightRegistry& registry, uint32_t count, uint32_t skipped = UINT32_MAX)
+{
+    registry.beginFrame();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (i != skipped)
+            registry.submitPointLight(Light(static_cast<float>(i + 1)), glm::vec3(static_cast<float>(i)), Entity(i));
+    }
+    registry.prepareFrame();
+}
+
+int ReadLightCount(const std::vector<std::byte>& lightBlock)
+{
+    int lightCount = 0;
+    std::memcpy(&lightCount, lightBlock.data(), sizeof(int));
+    return lightCount;
+}
+
+} // namespace
+
+TEST(LightRegistryTest, BlockHoldsSubmittedLights)
+{
+    vrm::LightRegistry registry;
+    SubmitLights(registry, 10);
+
+    const auto& lightBlock = registry.getPointLightBlock();
+    ASSERT_EQ(lightBlock.size(), sizeof(int) + 10 * sizeof(vrm::SSBOPointLightData));
+    EXPECT_EQ(ReadLightCount(lightBlock), 10);
+    EXPECT_EQ(registry.getPointLightChanges().size(), 10u);
+
+    // A single range covers the count and every light
+    ASSERT_EQ(registry.getDirtyRanges().size(), 1u);
+    EXPECT_EQ(registry.getDirtyRanges()[0].offset, 0u);
+    EXPECT_EQ(registry.getDirtyRanges()[0].size, lightBlock.size());
+}
+
+TEST(LightRegistryTest, UnchangedFrameWritesNothing)
+{
+    vrm::LightRegistry registry;
+    SubmitLights(registry, 10);
+    SubmitLights(registry, 10);
+
+    EXPECT_TRUE(registry.getPointLightChanges().empty());
+    EXPECT_TRUE(registry.getDirtyRanges().empty());
+}
+
+TEST(LightRegistryTest, RemovedLightIsReplacedByLastLight)
+{
+    vrm::LightRegistry registry;
+    SubmitLights(registry, 10);
+    SubmitLights(registry, 10, 3);
+
+    ASSERT_EQ(registry.getPointLightSlotCount(), 9u);
+    EXPECT_EQ(ReadLightCount(registry.getPointLightBlock()), 9);
+    EXPECT_EQ(registry.getPointLights()[3].radius, 10.f);
+
+    // The hole takes the last light, and the last slot is now past the end of the block
+    const auto& changes = registry.getPointLightChanges();
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0].slot, 3u);
+    EXPECT_EQ(changes[0].previous.radius, 4.f);
+    EXPECT_EQ(changes[0].current.radius, 10.f);
+    EXPECT_EQ(changes[1].slot, 9u);
+    EXPECT_EQ(changes[1].previous.radius, 10.f);
+    EXPECT_EQ(changes[1].current.radius, 0.f);
+
+    // The moved light keeps being updated in its new slot
+    registry.beginFrame();
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        if (i != 3)
+            registry.submitPointLight(Light(i == 9 ? 20.f : static_cast<float>(i + 1)), glm::vec3(static_cast<float>(i)), Entity(i));
+    }
+    registry.prepareFrame();
+
+    ASSERT_EQ(registry.getPointLightChanges().size(), 1u);
+    EXPECT_EQ(registry.getPointLightChanges()[0].slot, 3u);
+    EXPECT_EQ(registry.getPointLights()[3].radius, 20.f);
+}
+
+TEST(LightRegistryTest, CloseChangesShareARange)
+{
+    constexpr uint32_t LIGHT_COUNT = 200;
+    vrm::LightRegistry registry;
+    SubmitLights(registry, LIGHT_COUNT);
+
+    // Slots 10 and 12 are close, slot 150 is far from both
+    registry.beginFrame();
+    for (uint32_t i = 0; i < LIGHT_COUNT; ++i)
+    {
+        const bool moved = i == 10 || i == 12 || i == 150;
+        registry.submitPointLight(Light(static_cast<float>(i + 1)), glm::vec3(static_cast<float>(i) + (moved ? 1.f : 0.f)), Entity(i));
+    }
+    registry.prepareFrame();
+
+    const size_t lightSize = sizeof(vrm::SSBOPointLightData);
+    const auto& ranges = registry.getDirtyRanges();
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0].offset, sizeof(int) + 10 * lightSize);
+    EXPECT_EQ(ranges[0].size, 3 * lightSize);
+    EXPECT_EQ(ranges[1].offset, sizeof(int) + 150 * lightSize);
+    EXPECT_EQ(ranges[1].size, lightSize);
+}
+
+TEST(LightRegistryTest, EditedBackLightIsNotAChange)
+{
+    vrm::LightRegistry registry;
+    SubmitLights(registry, 4);
+
+    // Submitting twice keeps the last light, which is the one of the previous frame
+    registry.beginFrame();
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        registry.submitPointLight(Light(50.f), glm::vec3(0.f), Entity(i));
+        registry.submitPointLight(Light(static_cast<float>(i + 1)), glm::vec3(static_cast<float>(i)), Entity(i));
+    }
+    registry.prepareFrame();
+
+    EXPECT_TRUE(registry.getPointLightChanges().empty());
+    EXPECT_TRUE(registry.getDirtyRanges().empty());
+}
+
+TEST(LightRegistryTest, RemovedLightCanBeAddedBack)
+{
+    vrm::LightRegistry registry;
+    SubmitLights(registry, 8);
+    SubmitLights(registry, 8, 0);
+    SubmitLights(registry, 8);
+
+    ASSERT_EQ(registry.getPointLightSlotCount(), 8u);
+
+    // Every light is in the block once
+    std::vector<bool> found(8, false);
+    for (const auto& light : registry.getPointLights())
+    {
+        const size_t index = static_cast<size_t>(light.radius) - 1;
+        ASSERT_LT(index, found.size());
+        EXPECT_FALSE(found[index]);
+        found[index] = true;
+    }
+}
+
+TEST(LightRegistryTest, SpotAndDirectionalBlocksFollowTheirLights)
+{
+    vrm::LightRegistry registry;
+    auto submitFrame = [&](float spotIntensity)
+    {
+        registry.beginFrame();
+        registry.submitSpotLight({ glm::vec3(1.f), spotIntensity, 10.f, glm::radians(20.f), glm::radians(120.f) }, glm::vec3(1.f), glm::vec3(0.f, -2.f, 0.f));
+        registry.submitDirectionalLight({ glm::vec3(1.f, 0.9f, 0.8f), 3.f }, glm::vec3(1.f, -1.f, 0.f));
+        registry.prepareFrame();
+    };
+
+    submitFrame(2.f);
+    EXPECT_TRUE(registry.haveSpotLightsChanged());
+    EXPECT_TRUE(registry.haveDirectionalLightsChanged());
+    ASSERT_EQ(registry.getSpotLightBlock().size(), sizeof(int) + sizeof(vrm::SSBOSpotLightData));
+    EXPECT_EQ(ReadLightCount(registry.getSpotLightBlock()), 1);
+    ASSERT_EQ(registry.getDirectionalLightBlock().size(), sizeof(int) + sizeof(vrm::SSBODirectionalLightData));
+    EXPECT_EQ(ReadLightCount(registry.getDirectionalLightBlock()), 1);
+
+    // Directions are normalized, and the outer angle is kept under 90 degrees
+    const auto& spotLight = registry.getSpotLights()[0];
+    EXPECT_FLOAT_EQ(spotLight.direction.y, -1.f);
+    EXPECT_FLOAT_EQ(spotLight.cosOuterAngle, std::cos(vrm::LightRegistry::MaxSpotLightAngle));
+    EXPECT_FLOAT_EQ(spotLight.cosInnerAngle, std::cos(glm::radians(20.f)));
+    EXPECT_NEAR(glm::length(registry.getDirectionalLights()[0].direction), 1.f, 1e-6f);
+
+    submitFrame(2.f);
+    EXPECT_FALSE(registry.haveSpotLightsChanged());
+    EXPECT_FALSE(registry.haveDirectionalLightsChanged());
+
+    submitFrame(4.f);
+    EXPECT_TRUE(registry.haveSpotLightsChanged());
+    EXPECT_FALSE(registry.haveDirectionalLightsChanged());
+
+    // Removing every light leaves empty blocks
+    registry.beginFrame();
+    registry.prepareFrame();
+    EXPECT_TRUE(registry.haveSpotLightsChanged());
+    EXPECT_TRUE(registry.haveDirectionalLightsChanged());
+    ASSERT_EQ(registry.getSpotLightBlock().size(), sizeof(int));
+    EXPECT_EQ(ReadLightCount(registry.getSpotLightBlock()), 0);
+}
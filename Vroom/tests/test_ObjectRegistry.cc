@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Vroom/Asset/AssetManager.h>
+#include <Vroom/Asset/StaticAsset/MeshAsset.h>
+#include <Vroom/Core/Application.h>
+#include <Vroom/Render/RenderObject/ObjectRegistry.h>
+
+class ObjectRegistryTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static char name[] = "VroomTests";
+        static char headless[] = "--headless";
+        char* argv[] = { name, headless };
+        app = new vrm::Application(2, argv);
+
+        std::ofstream file(meshPath, std::ios::out | std::ios::trunc);
+        file << "v 0.0 0.0 0.0\n";
+        file << "v 1.0 0.0 0.0\n";
+        file << "v 1.0 1.0 0.0\n";
+        file << "f 1 2 3\n";
+        file.close();
+
+        mesh = vrm::AssetManager::Get().getAsset<vrm::MeshAsset>(meshPath);
+
+        for (int i = 0; i < 40; ++i)
+        {
+            entities.push_back(entityRegistry.create());
+            models.push_back(glm::translate(glm::mat4(1.f), glm::vec3(static_cast<float>(i), 0.f, 0.f)));
+        }
+    }
+
+    void TearDown() override
+    {
+        mesh = vrm::MeshInstance();
+        delete app;
+        std::remove(meshPath.c_str());
+    }
+
+    void submitFrame(vrm::ObjectRegistry& registry, size_t skippedEntity = SIZE_MAX)
+    {
+        registry.beginFrame();
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            if (i != skippedEntity)
+                registry.submitMesh(mesh, models[i], entities[i]);
+        }
+        registry.prepareFrame();
+    }
+
+    vrm::Application* app;
+    std::string meshPath = "test_object_registry.obj";
+    vrm::MeshInstance mesh;
+    entt::registry entityRegistry;
+    std::vector<entt::entity> entities;
+    std::vector<glm::mat4> models;
+};
+
+TEST_F(ObjectRegistryTest, StaticFrameUploadsNothing)
+{
+    vrm::ObjectRegistry registry;
+
+    submitFrame(registry);
+    ASSERT_EQ(registry.getObjectCount(), entities.size());
+    ASSERT_EQ(registry.getDirtyRanges().size(), 1u);
+    EXPECT_EQ(registry.getDirtyRanges()[0].size, entities.size() * sizeof(vrm::SSBOObjectData));
+    EXPECT_TRUE(registry.haveDrawCommandsChanged());
+
+    submitFrame(registry);
+    EXPECT_TRUE(registry.getDirtyRanges().empty());
+    EXPECT_FALSE(registry.haveDrawCommandsChanged());
+}
+
+TEST_F(ObjectRegistryTest, MovedEntityOnlyDirtiesItsObject)
+{
+    vrm::ObjectRegistry registry;
+    submitFrame(registry);
+
+    models[30] = glm::translate(models[30], glm::vec3(0.f, 1.f, 0.f));
+    submitFrame(registry);
+
+    ASSERT_EQ(registry.getDirtyRanges().size(), 1u);
+    EXPECT_EQ(registry.getDirtyRanges()[0].offset, 30 * sizeof(vrm::SSBOObjectData));
+    EXPECT_EQ(registry.getDirtyRanges()[0].size, sizeof(vrm::SSBOObjectData));
+    EXPECT_EQ(registry.getObjects()[30].model, models[30]);
+    EXPECT_FALSE(registry.haveDrawCommandsChanged());
+}
+
+TEST_F(ObjectRegistryTest, RemovedEntityIsReplacedByTheLastOne)
+{
+    vrm::ObjectRegistry registry;
+    submitFrame(registry);
+
+    submitFrame(registry, 1);
+
+    ASSERT_EQ(registry.getObjectCount(), entities.size() - 1);
+    EXPECT_EQ(registry.getObjects()[1].model, models.back());
+    ASSERT_EQ(registry.getDirtyRanges().size(), 1u);
+    EXPECT_EQ(registry.getDirtyRanges()[0].offset, sizeof(vrm::SSBOObjectData));
+    EXPECT_EQ(registry.getDirtyRanges()[0].size, sizeof(vrm::SSBOObjectData));
+
+    // The single command keeps its place, only its object count changed
+    ASSERT_EQ(registry.getDrawCommands().size(), 1u);
+    EXPECT_EQ(registry.getDrawCommands()[0].baseInstance, 0u);
+}
+
+TEST_F(ObjectRegistryTest, CommandsAreDroppedWithTheirLastObject)
+{
+    vrm::ObjectRegistry registry;
+    submitFrame(registry);
+    ASSERT_EQ(registry.getIndirectBatches().size(), 1u);
+
+    registry.beginFrame();
+    registry.prepareFrame();
+
+    EXPECT_EQ(registry.getObjectCount(), 0u);
+    EXPECT_TRUE(registry.getDrawCommands().empty());
+    EXPECT_TRUE(registry.getIndirectBatches().empty());
+    EXPECT_TRUE(registry.getDirtyRanges().empty());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include <Vroom/Core/Profiler.h>
+
+TEST(ProfilerTest, NestedScopesRecordDepth)
+{
+    vrm::Profiler::Clear();
+    {
+        vrm::ProfileScope outer("Outer");
+        {
+            vrm::ProfileScope inner("Inner");
+        }
+    }
+
+    auto events = vrm::Profiler::CollectEvents();
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_STREQ(events[0].name, "Outer");
+    EXPECT_EQ(events[0].depth, 0);
+    EXPECT_STREQ(events[1].name, "Inner");
+    EXPECT_EQ(events[1].depth, 1);
+    EXPECT_GE(events[1].start, events[0].start);
+    EXPECT_LE(events[1].start + events[1].duration, events[0].start + events[0].duration);
+
+    vrm::Profiler::Clear();
+    EXPECT_TRUE(vrm::Profiler::CollectEvents().empty());
+}
+
+TEST(ProfilerTest, DisabledScopesAreNotRecorded)
+{
+    vrm::Profiler::Clear();
+    vrm::Profiler::SetEnabled(false);
+    {
+        vrm::ProfileScope scope("Disabled");
+    }
+    vrm::Profiler::SetEnabled(true);
+
+    EXPECT_TRUE(vrm::Profiler::CollectEvents().empty());
+}
+
+TEST(ProfilerTest, EventsOfEachThreadAreCollected)
+{
+    vrm::Profiler::Clear();
+    {
+        vrm::ProfileScope scope("Main");
+    }
+    std::thread([]() { vrm::ProfileScope scope("Worker"); }).join();
+
+    auto events = vrm::Profiler::CollectEvents();
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_NE(events[0].threadID, events[1].threadID);
+    vrm::Profiler::Clear();
+}
+
+TEST(ProfilerTest, ChromeTraceFormat)
+{
+    std::vector<vrm::Profiler::Event> events = {
+        { "Frame", 1'000'000, 2'000'000, 0, 0 },
+        { "Quoted \"name\"", 1'500'000, 500'000, 0, 1 },
+    };
+
+    std::ostringstream stream;
+    vrm::Profiler::WriteChromeTrace(stream, events);
+    const std::string json = stream.str();
+
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"Frame\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":2000.000}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Quoted \\\"name\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\":500.000,\"dur\":500.000"), std::string::npos);
+}
+
+TEST(ProfilerTest, ChromeTraceKeepsNanosecondsOfLateEvents)
+{
+    // An hour into the capture, timestamps still keep their nanoseconds
+    std::vector<vrm::Profiler::Event> events = {
+        { "Frame", 0, 1'000, 0, 0 },
+        { "Late", 3'600'000'000'123, 4'567, 0, 0 },
+    };
+
+    std::ostringstream stream;
+    vrm::Profiler::WriteChromeTrace(stream, events);
+
+    EXPECT_NE(stream.str().find("\"ts\":3600000000.123,\"dur\":4.567"), std::string::npos);
+
+    // The stream formatting is left as it was
+    stream << 0.5;
+    EXPECT_EQ(stream.str().substr(stream.str().size() - 3), "0.5");
+}
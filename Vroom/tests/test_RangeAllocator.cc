@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <Vroom/DataStructure/RangeAllocator.h>
+
+TEST(RangeAllocatorTest, AllocateUntilFull)
+{
+    vrm::RangeAllocator allocator(100);
+
+    EXPECT_EQ(allocator.allocate(40), 0);
+    EXPECT_EQ(allocator.allocate(60), 40);
+    EXPECT_FALSE(allocator.allocate(1).has_value());
+
+    EXPECT_EQ(allocator.getUsed(), 100);
+    EXPECT_EQ(allocator.getFree(), 0);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 0);
+}
+
+TEST(RangeAllocatorTest, FreedRangesAreReused)
+{
+    vrm::RangeAllocator allocator(100);
+
+    auto a = allocator.allocate(30);
+    auto b = allocator.allocate(30);
+    auto c = allocator.allocate(30);
+    ASSERT_TRUE(a && b && c);
+
+    allocator.free(*b, 30);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 2);
+
+    // First fit: the hole left by b is used first
+    EXPECT_EQ(allocator.allocate(20), *b);
+}
+
+TEST(RangeAllocatorTest, NeighboursAreMerged)
+{
+    vrm::RangeAllocator allocator(90);
+
+    auto a = allocator.allocate(30);
+    auto b = allocator.allocate(30);
+    auto c = allocator.allocate(30);
+    ASSERT_TRUE(a && b && c);
+
+    allocator.free(*a, 30);
+    allocator.free(*c, 30);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 2);
+
+    allocator.free(*b, 30);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 1);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 90);
+    EXPECT_EQ(allocator.getUsed(), 0);
+}
+
+TEST(RangeAllocatorTest, FragmentationPreventsLargeAllocation)
+{
+    vrm::RangeAllocator allocator(100);
+
+    std::vector<size_t> offsets;
+    for (int i = 0; i < 10; ++i)
+        offsets.push_back(*allocator.allocate(10));
+
+    for (size_t i = 0; i < offsets.size(); i += 2)
+        allocator.free(offsets[i], 10);
+
+    EXPECT_EQ(allocator.getFree(), 50);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 10);
+    EXPECT_FALSE(allocator.allocate(20).has_value());
+}
+
+TEST(RangeAllocatorTest, GrowAppendsFreeSpace)
+{
+    vrm::RangeAllocator allocator(50);
+
+    auto a = allocator.allocate(30);
+    ASSERT_TRUE(a);
+    EXPECT_FALSE(allocator.allocate(40).has_value());
+
+    allocator.grow(100);
+    EXPECT_EQ(allocator.getCapacity(), 100);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 1); // Trailing free range merged with the new space
+    EXPECT_EQ(allocator.allocate(70), 30);
+
+    // Shrinking is not supported
+    allocator.grow(10);
+    EXPECT_EQ(allocator.getCapacity(), 100);
+}
+
+TEST(RangeAllocatorTest, ClearKeepsCapacity)
+{
+    vrm::RangeAllocator allocator(64);
+    allocator.allocate(16);
+    allocator.allocate(16);
+
+    allocator.clear();
+    EXPECT_EQ(allocator.getUsed(), 0);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 64);
+}
+
+TEST(RangeAllocatorTest, RandomAllocationsNeverOverlap)
+{
+    vrm::RangeAllocator allocator(4096);
+    std::vector<std::pair<size_t, size_t>> live;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 2000; ++step)
+    {
+        if (!live.empty() && rng() % 2 == 0)
+        {
+            size_t index = rng() % live.size();
+            allocator.free(live[index].first, live[index].second);
+            live.erase(live.begin() + index);
+        }
+        else
+        {
+            size_t size = 1 + rng() % 64;
+            if (auto offset = allocator.allocate(size))
+                live.push_back({ *offset, size });
+        }
+    }
+
+    size_t used = 0;
+    std::vector<bool> occupied(4096, false);
+    for (const auto& [offset, size] : live)
+    {
+        for (size_t i = offset; i < offset + size; ++i)
+        {
+            EXPECT_FALSE(occupied[i]);
+            occupied[i] = true;
+        }
+        used += size;
+    }
+    EXPECT_EQ(allocator.getUsed(), used);
+
+    for (const auto& [offset, size] : live)
+        allocator.free(offset, size);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 1);
+}
+
+TEST(RangeAllocatorTest, ShrinkDropsTrailingFreeSpaceOnly)
+{
+    vrm::RangeAllocator allocator(100);
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(20);
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(allocator.getUsedEnd(), 30);
+
+    allocator.free(*a, 10);
+    EXPECT_EQ(allocator.getUsedEnd(), 30);
+
+    // Cannot shrink below the last allocated range
+    allocator.shrink(5);
+    EXPECT_EQ(allocator.getCapacity(), 30);
+    EXPECT_EQ(allocator.getUsed(), 20);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 1);
+
+    allocator.grow(64);
+    allocator.shrink(40);
+    EXPECT_EQ(allocator.getCapacity(), 40);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 10);
+
+    allocator.free(*b, 20);
+    EXPECT_EQ(allocator.getUsedEnd(), 0);
+    allocator.shrink(0);
+    EXPECT_EQ(allocator.getCapacity(), 0);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 0);
+    EXPECT_FALSE(allocator.allocate(1).has_value());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <Vroom/Render/RenderQueue/RenderKey.h>
+#include <Vroom/Render/RenderQueue/RenderQueue.h>
+
+class RenderQueueTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        queue = vrm::RenderQueue();
+    }
+
+    void TearDown() override
+    {
+
+    }
+
+    vrm::RenderQueue queue;
+};
+
+TEST_F(RenderQueueTest, SortEmpty)
+{
+    EXPECT_NO_THROW(queue.sort());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(RenderQueueTest, SortIsOrdered)
+{
+    std::mt19937_64 generator(42);
+    for (size_t i = 0; i < 1000; ++i)
+        queue.push({ generator(), nullptr, nullptr });
+
+    queue.sort();
+
+    const auto& packets = queue.getPackets();
+    ASSERT_EQ(packets.size(), 1000);
+    for (size_t i = 1; i < packets.size(); ++i)
+        EXPECT_LE(packets[i - 1].key, packets[i].key);
+}
+
+TEST_F(RenderQueueTest, SortIsStable)
+{
+    // Equal keys must keep their submission order, which is tracked here with the model pointer.
+    std::vector<glm::mat4> models(100);
+    for (size_t i = 0; i < models.size(); ++i)
+        queue.push({ i % 3, nullptr, &models[i] });
+
+    queue.sort();
+
+    const auto& packets = queue.getPackets();
+    for (size_t i = 1; i < packets.size(); ++i)
+    {
+        if (packets[i - 1].key == packets[i].key)
+        {
+            EXPECT_LT(packets[i - 1].model, packets[i].model);
+        }
+    }
+}
+
+TEST(RenderKeyTest, FieldsPriority)
+{
+    using vrm::RenderKey;
+    using vrm::RenderPass;
+
+    // Shader has priority over everything but the pass
+    EXPECT_LT(RenderKey::Build(RenderPass::Opaque, 1, 50, 50, 50, 1.f), RenderKey::Build(RenderPass::Opaque, 2, 0, 0, 0, 0.f));
+    // Material has priority over mesh and depth
+    EXPECT_LT(RenderKey::Build(RenderPass::Opaque, 1, 1, 0, 50, 1.f), RenderKey::Build(RenderPass::Opaque, 1, 2, 0, 0, 0.f));
+    // Depth is the least significant field, front to back
+    EXPECT_LT(RenderKey::Build(RenderPass::Opaque, 1, 1, 1, 1, 0.1f), RenderKey::Build(RenderPass::Opaque, 1, 1, 1, 1, 0.9f));
+}
+
+TEST(RenderKeyTest, StateIgnoresDepth)
+{
+    using vrm::RenderKey;
+    using vrm::RenderPass;
+
+    auto nearKey = RenderKey::Build(RenderPass::Opaque, 3, 4, 5, 6, 0.f);
+    auto farKey = RenderKey::Build(RenderPass::Opaque, 3, 4, 5, 6, 1.f);
+
+    EXPECT_NE(nearKey, farKey);
+    EXPECT_EQ(RenderKey::StateOf(nearKey), RenderKey::StateOf(farKey));
+}
+
+TEST(RenderKeyTest, DepthIsClamped)
+{
+    using vrm::RenderKey;
+
+    EXPECT_EQ(RenderKey::QuantizeDepth(-5.f), 0u);
+    EXPECT_EQ(RenderKey::QuantizeDepth(5.f), RenderKey::QuantizeDepth(1.f));
+}
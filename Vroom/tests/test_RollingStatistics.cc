@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <Vroom/DataStructure/RollingStatistics.h>
+
+TEST(RollingStatisticsTest, EmptyWindowReturnsZero)
+{
+    vrm::RollingStatistics stats(4);
+    EXPECT_EQ(stats.getSampleCount(), 0);
+    EXPECT_FLOAT_EQ(stats.getMin(), 0.f);
+    EXPECT_FLOAT_EQ(stats.getAverage(), 0.f);
+    EXPECT_FLOAT_EQ(stats.getMax(), 0.f);
+}
+
+TEST(RollingStatisticsTest, PartialWindow)
+{
+    vrm::RollingStatistics stats(4);
+    stats.push(2.f);
+    stats.push(4.f);
+
+    EXPECT_EQ(stats.getSampleCount(), 2);
+    EXPECT_FLOAT_EQ(stats.getLast(), 4.f);
+    EXPECT_FLOAT_EQ(stats.getMin(), 2.f);
+    EXPECT_FLOAT_EQ(stats.getAverage(), 3.f);
+    EXPECT_FLOAT_EQ(stats.getMax(), 4.f);
+}
+
+TEST(RollingStatisticsTest, OldestSamplesAreReplaced)
+{
+    vrm::RollingStatistics stats(3);
+    for (float value : { 10.f, 1.f, 2.f, 3.f })
+        stats.push(value);
+
+    EXPECT_EQ(stats.getSampleCount(), 3);
+    EXPECT_FLOAT_EQ(stats.getMin(), 1.f);
+    EXPECT_FLOAT_EQ(stats.getAverage(), 2.f);
+    EXPECT_FLOAT_EQ(stats.getMax(), 3.f);
+
+    stats.clear();
+    EXPECT_EQ(stats.getSampleCount(), 0);
+    stats.push(5.f);
+    EXPECT_FLOAT_EQ(stats.getAverage(), 5.f);
+}
+
+TEST(RollingStatisticsTest, Percentiles)
+{
+    vrm::RollingStatistics stats(100);
+    EXPECT_FLOAT_EQ(stats.getPercentile(50.f), 0.f);
+
+    // Pushed out of order, percentiles sort them
+    for (int i = 100; i >= 1; --i)
+        stats.push(static_cast<float>(i));
+
+    EXPECT_FLOAT_EQ(stats.getPercentile(0.f), 1.f);
+    EXPECT_FLOAT_EQ(stats.getPercentile(50.f), 50.f);
+    EXPECT_FLOAT_EQ(stats.getPercentile(95.f), 95.f);
+    EXPECT_FLOAT_EQ(stats.getPercentile(99.f), 99.f);
+    EXPECT_FLOAT_EQ(stats.getPercentile(100.f), 100.f);
+}
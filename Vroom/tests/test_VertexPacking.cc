@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <Vroom/Asset/AssetData/VertexPacking.h>
+
+TEST(VertexPackingTest, OctahedralRoundTrip)
+{
+    std::mt19937 rng(3);
+    std::normal_distribution<float> distribution(0.f, 1.f);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        glm::vec3 normal = glm::normalize(glm::vec3(distribution(rng), distribution(rng), distribution(rng)));
+        glm::vec3 decoded = vrm::VertexPacking::DecodeOctahedral(vrm::VertexPacking::EncodeOctahedral(normal));
+        EXPECT_GT(glm::dot(normal, decoded), 0.99999f);
+    }
+
+    // Axes, including the folded lower hemisphere
+    for (const glm::vec3& axis : { glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, -1, 0), glm::vec3(0, 0, 1), glm::vec3(0, 0, -1) })
+    {
+        glm::vec3 decoded = vrm::VertexPacking::DecodeOctahedral(vrm::VertexPacking::EncodeOctahedral(axis));
+        EXPECT_GT(glm::dot(axis, decoded), 0.99999f);
+    }
+}
+
+TEST(VertexPackingTest, PackRoundTrip)
+{
+    std::vector<vrm::Vertex> vertices = {
+        { { -2.f, 0.5f, 3.f }, glm::normalize(glm::vec3(1.f, 2.f, -3.f)), { 0.f, 1.f } },
+        { { 4.f, -1.f, 3.5f }, glm::vec3(0.f, 0.f, -1.f), { 0.25f, 0.75f } },
+        { { 1.f, 2.f, -1.f }, glm::vec3(0.f, 1.f, 0.f), { 2.5f, -3.f } }
+    };
+
+    vrm::AABB box = { glm::vec3(-2.f, -1.f, -1.f), glm::vec3(4.f, 2.f, 3.5f) };
+    auto quantization = vrm::VertexPacking::ComputeQuantization(box);
+    EXPECT_EQ(quantization.offset, box.min);
+    EXPECT_FLOAT_EQ(quantization.scale, 6.f);
+
+    auto packed = vrm::VertexPacking::Pack(vertices, quantization);
+    ASSERT_EQ(packed.size(), vertices.size());
+
+    const float positionTolerance = quantization.scale / 65535.f;
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        vrm::Vertex unpacked = vrm::VertexPacking::Unpack(packed[i], quantization);
+        EXPECT_NEAR(unpacked.position.x, vertices[i].position.x, positionTolerance);
+        EXPECT_NEAR(unpacked.position.y, vertices[i].position.y, positionTolerance);
+        EXPECT_NEAR(unpacked.position.z, vertices[i].position.z, positionTolerance);
+        EXPECT_GT(glm::dot(unpacked.normal, vertices[i].normal), 0.9999f);
+        EXPECT_NEAR(unpacked.texCoords.x, vertices[i].texCoords.x, 1e-3f);
+        EXPECT_NEAR(unpacked.texCoords.y, vertices[i].texCoords.y, 1e-3f);
+    }
+}
+
+TEST(VertexPackingTest, DequantizationMatrix)
+{
+    vrm::VertexPacking::PositionQuantization quantization;
+    quantization.offset = glm::vec3(1.f, 2.f, 3.f);
+    quantization.scale = 4.f;
+
+    glm::vec4 position = quantization.getMatrix() * glm::vec4(0.5f, 0.25f, 1.f, 1.f);
+    EXPECT_FLOAT_EQ(position.x, 3.f);
+    EXPECT_FLOAT_EQ(position.y, 3.f);
+    EXPECT_FLOAT_EQ(position.z, 7.f);
+}
+
+TEST(VertexPackingTest, CanPackRejectsLargeTexCoords)
+{
+    std::vector<vrm::Vertex> vertices = { { glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f), { 0.5f, 0.5f } } };
+    EXPECT_TRUE(vrm::VertexPacking::CanPack(vertices));
+
+    vertices.push_back({ glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f), { 100.f, 0.5f } });
+    EXPECT_FALSE(vrm::VertexPacking::CanPack(vertices));
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Vroom/Core/Layer.h>
+#include <Vroom/Core/FrameStats.h>
+#include <Vroom/Render/Profiling/GPUProfiler.h>
+
+#include "VroomBench/BenchSettings.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Drives a benchmark run: loads each stress scene in the game layer, renders its warmup and measured frames,
+ * then writes the statistics of every scene as JSON and exits the application.
+ */
+class BenchLayer : public Layer
+{
+public:
+    /**
+     * @brief Constructs the layer, and loads the first scene in the game layer.
+     * @param settings The benchmark settings.
+     */
+    explicit BenchLayer(const BenchSettings& settings);
+    ~BenchLayer() = default;
+
+protected:
+    void onInit() override;
+    void onUpdate(float dt) override;
+
+private:
+    /**
+     * @brief Statistics of a measured scene.
+     */
+    struct SceneResult
+    {
+        BenchSceneSettings settings;
+        std::vector<FrameStats::Frame> frames;
+        // GPU timings of the last measured frames, up to GPUProfiler::HistoryFrames
+        std::vector<GPUProfiler::ScopeStatistics> gpuScopes;
+        bool sharedCulling = false;
+    };
+
+    void loadScene(size_t sceneIndex);
+    void collectSceneResult();
+    bool writeResults() const;
+
+private:
+    BenchSettings m_Settings;
+    std::vector<BenchSceneSettings> m_Scenes;
+    std::vector<SceneResult> m_Results;
+
+    size_t m_SceneIndex = 0;
+    size_t m_SceneFrame = 0;
+};
+
+} // namespace vrm
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Vroom/Scene/Scene.h>
+#include <Vroom/Render/Camera/FirstPersonCamera.h>
+
+#include "VroomBench/BenchSettings.h"
+
+namespace vrm
+{
+
+/**
+ * @brief Stress scene: cubes on a grid, each material on its own mesh, and point lights scattered above them.
+ * The camera orbits the grid once every pathFrames frames, regardless of the frame time, so that runs are reproducible.
+ */
+class BenchScene : public Scene
+{
+public:
+    /**
+     * @brief Constructs the scene. Entities are created on init.
+     * @param settings The scene parameters.
+     * @param meshPaths One mesh per unique material.
+     * @param seed The seed of the light placement.
+     * @param pathFrames The number of frames of a camera orbit.
+     */
+    BenchScene(const BenchSceneSettings& settings, std::vector<std::string> meshPaths, uint32_t seed, size_t pathFrames);
+    ~BenchScene() = default;
+
+protected:
+    void onInit() override;
+    void onUpdate(float dt) override;
+
+private:
+    void updateCamera();
+
+private:
+    BenchSceneSettings m_Settings;
+    std::vector<std::string> m_MeshPaths;
+    uint32_t m_Seed;
+    size_t m_PathFrames;
+
+    size_t m_Frame = 0;
+    float m_Extent = 0.f;
+
+    FirstPersonCamera m_Camera{ 0.1f, 200.f, glm::radians(90.f), 800.f / 600.f, glm::vec3{ 0.f }, glm::vec3{ 0.f } };
+};
+
+} // namespace vrm
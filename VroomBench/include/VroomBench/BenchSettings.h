@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vrm
+{
+
+/**
+ * @brief Parameters of one stress scene.
+ */
+struct BenchSceneSettings
+{
+    size_t meshCount = 1000;
+    size_t materialCount = 8;
+    size_t lightCount = 64;
+    float lightRadius = 10.f;
+    // Lights culled against the clusters found by the depth prepass only
+    bool activeClusters = false;
+    // Lights binned into the clusters they cover, instead of clusters testing every light
+    bool lightBinning = false;
+    // 1 for the shared memory light culling kernel, 0 for the global memory one, -1 to keep the one picked at startup
+    int sharedCulling = -1;
+    // Lights culled on the CPU and uploaded, instead of by compute shaders. Takes precedence over light binning.
+    bool cpuCulling = false;
+    // Maximum number of lights sent to the GPU per frame, 0 for every visible light
+    size_t lightBudget = 0;
+    // Width and height of a cluster tile, in pixels
+    unsigned int clusterTileSize = 128;
+};
+
+/**
+ * @brief Parameters of a benchmark run. Every combination of the listed values is measured, in order.
+ */
+struct BenchSettings
+{
+    std::vector<size_t> meshCounts = { 1000 };
+    std::vector<size_t> materialCounts = { 8 };
+    std::vector<size_t> lightCounts = { 64 };
+    std::vector<float> lightRadii = { 10.f };
+    // 0 or 1 for each mode of light culling: every cluster, active clusters only
+    std::vector<int> activeClusterModes = { 0 };
+    // 0 or 1 for each light assignment: per cluster culling, per light binning
+    std::vector<int> lightBinningModes = { 0 };
+    // 0 or 1 for each light culling kernel: global memory, shared memory. -1 keeps the one picked at startup.
+    std::vector<int> sharedCullingModes = { -1 };
+    // 0 or 1 for each light culling processor: GPU, CPU
+    std::vector<int> cpuCullingModes = { 0 };
+    // Maximum numbers of lights sent to the GPU per frame, 0 for every visible light
+    std::vector<size_t> lightBudgets = { 0 };
+    // Widths and heights of a cluster tile, in pixels
+    std::vector<unsigned int> clusterTileSizes = { 128 };
+
+    size_t warmupFrames = 30;
+    size_t frames = 300;
+    uint32_t seed = 1;
+    std::string outputPath = "bench_results.json";
+
+    /**
+     * @brief Parses the command line. Unknown arguments are ignored, they may be engine arguments.
+     * @param argc Command line argc.
+     * @param argv Command line argv.
+     * @param settings The settings to fill.
+     * @return False if an argument is malformed or misses its value, or if --help was requested.
+     */
+    static bool Parse(int argc, char** argv, BenchSettings& settings);
+
+    /**
+     * @brief Prints the command line usage.
+     */
+    static void PrintUsage();
+
+    /**
+     * @brief Gets every scene to measure: the cartesian product of the listed values.
+     * @return The scene settings.
+     */
+    std::vector<BenchSceneSettings> getScenes() const;
+};
+
+} // namespace vrm
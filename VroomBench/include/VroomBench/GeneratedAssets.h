@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace vrm
+{
+
+/**
+ * @brief Writes the asset files the stress scenes need, since materials are bound to mesh files.
+ */
+class GeneratedAssets
+{
+public:
+    GeneratedAssets() = delete;
+
+    /**
+     * @brief Writes one cube mesh per material, each material with its own color.
+     * Files are only written once per directory and material index.
+     * @param directory The directory to write to, created if needed.
+     * @param materialCount The number of unique materials.
+     * @return The paths of the meshes, one per material.
+     */
+    static std::vector<std::string> WriteMaterialCubes(const std::string& directory, size_t materialCount);
+};
+
+} // namespace vrm
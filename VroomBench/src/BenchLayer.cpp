@@ -0,0 +1,192 @@
+#include "VroomBench/BenchLayer.h"
+
+#include <fstream>
+#include <string>
+
+#include <Vroom/Core/Application.h>
+#include <Vroom/Core/GameLayer.h>
+#include <Vroom/DataStructure/RollingStatistics.h>
+#include <Vroom/Render/Renderer.h>
+
+#include "VroomBench/BenchScene.h"
+#include "VroomBench/GeneratedAssets.h"
+
+namespace vrm
+{
+
+// Generated meshes and materials, relative to the working directory
+static constexpr const char* GENERATED_ASSETS_DIRECTORY = "Resources/Bench/Generated";
+
+BenchLayer::BenchLayer(const BenchSettings& settings)
+    : m_Settings(settings), m_Scenes(settings.getScenes())
+{
+    VRM_ASSERT_MSG(!m_Scenes.empty(), "No bench scene to measure.");
+
+    // The game layer needs its first scene before layers are initialized
+    loadScene(0);
+}
+
+void BenchLayer::onInit()
+{
+    // Nothing can be presented without a display
+    if (Application::Get().isHeadless())
+        Application::Get().getGameLayer().getFrameBuffer().setOnScreenRender(false);
+}
+
+void BenchLayer::onUpdate(float dt)
+{
+    // Layers update from top to bottom, so a scene loaded here starts in this very frame
+    if (m_SceneFrame == m_Settings.warmupFrames + m_Settings.frames)
+    {
+        collectSceneResult();
+
+        if (++m_SceneIndex == m_Scenes.size())
+        {
+            if (!writeResults())
+                VRM_LOG_ERROR("Failed to write bench results to: {}", m_Settings.outputPath);
+            setShouldUpdate(false);
+            Application::Get().exit();
+            return;
+        }
+
+        loadScene(m_SceneIndex);
+        m_SceneFrame = 0;
+    }
+
+    // GPU timings of the warmup frames are dropped
+    if (m_SceneFrame == m_Settings.warmupFrames && GPUProfiler::IsInitialized())
+        GPUProfiler::Get().clearStatistics();
+
+    m_SceneFrame++;
+}
+
+void BenchLayer::loadScene(size_t sceneIndex)
+{
+    const auto& scene = m_Scenes[sceneIndex];
+    VRM_LOG_INFO("Bench scene {}/{}: {} meshes, {} materials, {} lights of radius {}, cluster tiles of {} pixels{}{}{}{}{}.",
+        sceneIndex + 1, m_Scenes.size(), scene.meshCount, scene.materialCount, scene.lightCount, scene.lightRadius, scene.clusterTileSize,
+        scene.activeClusters ? ", active clusters only" : "", scene.lightBinning ? ", light binning" : "",
+        scene.sharedCulling == 1 ? ", shared memory culling" : scene.sharedCulling == 0 ? ", global memory culling" : "",
+        scene.cpuCulling ? ", CPU culling" : "",
+        scene.lightBudget > 0 ? ", light budget of " + std::to_string(scene.lightBudget) : std::string());
+
+    Renderer::Get().setActiveClustersEnabled(scene.activeClusters);
+    if (scene.cpuCulling)
+        Renderer::Get().setLightCullingMode(ClusteredLights::CullingMode::CPU);
+    else
+        Renderer::Get().setLightCullingMode(scene.lightBinning ? ClusteredLights::CullingMode::PerLight : ClusteredLights::CullingMode::PerCluster);
+    Renderer::Get().setLightBudget(scene.lightBudget > 0 ? static_cast<unsigned int>(scene.lightBudget) : LightBudget::Unlimited);
+    ClusterGridSettings gridSettings = Renderer::Get().getClusterGridSettings();
+    gridSettings.tileSize = scene.clusterTileSize;
+    Renderer::Get().setClusterGridSettings(gridSettings);
+    // The local size picked for the device is kept
+    if (scene.sharedCulling >= 0)
+    {
+        Renderer::Get().setLightCullingKernel(scene.sharedCulling == 1 ? ClusteredLights::CullingKernel::SharedMemory : ClusteredLights::CullingKernel::Global,
+            Renderer::Get().getLightCullingLocalSize());
+    }
+
+    auto meshPaths = GeneratedAssets::WriteMaterialCubes(GENERATED_ASSETS_DIRECTORY, scene.materialCount);
+    Application::Get().getGameLayer().loadScene<BenchScene>(scene, std::move(meshPaths), m_Settings.seed, m_Settings.frames);
+}
+
+void BenchLayer::collectSceneResult()
+{
+    // The measured frames are the last ones of the history, warmup frames came before them
+    const auto& frameStats = FrameStats::Get();
+    VRM_ASSERT_MSG(frameStats.getFrameCount() >= m_Settings.frames, "Measured frames do not fit in the frame statistics history.");
+
+    SceneResult result = { m_Scenes[m_SceneIndex], {}, {}, Renderer::Get().getLightCullingKernel() == ClusteredLights::CullingKernel::SharedMemory };
+    result.frames.reserve(m_Settings.frames);
+    for (size_t i = frameStats.getFrameCount() - m_Settings.frames; i < frameStats.getFrameCount(); ++i)
+        result.frames.push_back(frameStats.getFrame(i));
+
+    // Scopes that did not run during this scene have no sample
+    if (GPUProfiler::IsInitialized())
+    {
+        for (const auto& scope : GPUProfiler::Get().getScopes())
+        {
+            if (scope.milliseconds.getSampleCount() > 0)
+                result.gpuScopes.push_back(scope);
+        }
+    }
+
+    m_Results.push_back(std::move(result));
+}
+
+bool BenchLayer::writeResults() const
+{
+    std::ofstream file(m_Settings.outputPath, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    const auto& viewport = Renderer::Get().getViewportSize();
+    file << "{\n"
+        << "\"headless\":" << (Application::Get().isHeadless() ? "true" : "false")
+        << ",\"resolution\":[" << viewport.x << "," << viewport.y << "]"
+        << ",\"seed\":" << m_Settings.seed
+        << ",\"warmup_frames\":" << m_Settings.warmupFrames
+        << ",\"frames\":" << m_Settings.frames
+        << ",\n\"scenes\":[";
+
+    for (size_t sceneIndex = 0; sceneIndex < m_Results.size(); ++sceneIndex)
+    {
+        const auto& result = m_Results[sceneIndex];
+
+        RollingStatistics frameTimes(result.frames.size());
+        std::array<double, FrameStats::CounterCount> counterSums = {};
+        for (const auto& frame : result.frames)
+        {
+            frameTimes.push(frame.frameTime);
+            for (size_t i = 0; i < FrameStats::CounterCount; ++i)
+                counterSums[i] += frame.counters[i];
+        }
+
+        file << (sceneIndex == 0 ? "\n" : ",\n")
+            << "{\"meshes\":" << result.settings.meshCount
+            << ",\"materials\":" << result.settings.materialCount
+            << ",\"lights\":" << result.settings.lightCount
+            << ",\"light_radius\":" << result.settings.lightRadius
+            << ",\"active_clusters\":" << (result.settings.activeClusters ? "true" : "false")
+            << ",\"light_binning\":" << (result.settings.lightBinning ? "true" : "false")
+            << ",\"culling_kernel\":" << (result.sharedCulling ? "\"shared\"" : "\"global\"")
+            << ",\"cpu_culling\":" << (result.settings.cpuCulling ? "true" : "false")
+            << ",\"light_budget\":" << result.settings.lightBudget
+            << ",\"cluster_tile\":" << result.settings.clusterTileSize
+            << ",\n \"frame_time_ms\":{\"min\":" << frameTimes.getMin()
+            << ",\"average\":" << frameTimes.getAverage()
+            << ",\"p50\":" << frameTimes.getPercentile(50.f)
+            << ",\"p95\":" << frameTimes.getPercentile(95.f)
+            << ",\"p99\":" << frameTimes.getPercentile(99.f)
+            << ",\"max\":" << frameTimes.getMax() << "}";
+
+        // Average of each counter over the measured frames
+        file << ",\n \"counters\":{";
+        for (size_t i = 0; i < FrameStats::CounterCount; ++i)
+        {
+            file << (i == 0 ? "\"" : ",\"") << FrameStats::GetCounterName(static_cast<FrameStats::Counter>(i)) << "\":"
+                << counterSums[i] / static_cast<double>(result.frames.size());
+        }
+
+        file << "},\n \"gpu_ms\":{";
+        for (size_t i = 0; i < result.gpuScopes.size(); ++i)
+        {
+            const auto& milliseconds = result.gpuScopes[i].milliseconds;
+            file << (i == 0 ? "\"" : ",\"") << result.gpuScopes[i].name << "\":{\"average\":" << milliseconds.getAverage()
+                << ",\"p50\":" << milliseconds.getPercentile(50.f)
+                << ",\"p95\":" << milliseconds.getPercentile(95.f) << "}";
+        }
+
+        file << "},\n \"frame_times_ms\":[";
+        for (size_t i = 0; i < result.frames.size(); ++i)
+            file << (i == 0 ? "" : ",") << result.frames[i].frameTime;
+        file << "]}";
+    }
+
+    file << "\n]}\n";
+
+    VRM_LOG_INFO("Bench results written to: {}", m_Settings.outputPath);
+    return file.good();
+}
+
+} // namespace vrm
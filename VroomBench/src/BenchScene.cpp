@@ -0,0 +1,87 @@
+#include "VroomBench/BenchScene.h"
+
+#include <cmath>
+#include <random>
+
+#include <glm/gtc/constants.hpp>
+
+#include <Vroom/Asset/AssetManager.h>
+#include <Vroom/Asset/StaticAsset/MeshAsset.h>
+#include <Vroom/Scene/Components/MeshComponent.h>
+#include <Vroom/Scene/Components/PointLightComponent.h>
+#include <Vroom/Scene/Components/TransformComponent.h>
+
+namespace vrm
+{
+
+// Distance between two cubes of the grid
+static constexpr float GRID_SPACING = 3.f;
+
+BenchScene::BenchScene(const BenchSceneSettings& settings, std::vector<std::string> meshPaths, uint32_t seed, size_t pathFrames)
+    : m_Settings(settings), m_MeshPaths(std::move(meshPaths)), m_Seed(seed), m_PathFrames(pathFrames)
+{
+}
+
+void BenchScene::onInit()
+{
+    setCamera(&m_Camera);
+
+    // Meshes on a square grid, centered on the origin
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(m_Settings.meshCount))));
+    m_Extent = 0.5f * GRID_SPACING * static_cast<float>(side);
+
+    for (size_t i = 0; i < m_Settings.meshCount; ++i)
+    {
+        auto entity = createEntity("Mesh_" + std::to_string(i));
+        auto mesh = AssetManager::Get().getAsset<MeshAsset>(m_MeshPaths[i % m_MeshPaths.size()]);
+        entity.addComponent<MeshComponent>(mesh);
+
+        auto& transform = entity.getComponent<TransformComponent>();
+        transform.setPosition({
+            GRID_SPACING * static_cast<float>(i % side) - m_Extent,
+            0.f,
+            GRID_SPACING * static_cast<float>(i / side) - m_Extent
+        });
+    }
+
+    // std::mt19937 is fully specified, unlike the standard distributions: mapping its output by hand keeps positions
+    // identical across standard libraries.
+    std::mt19937 generator(m_Seed);
+    auto random = [&generator](float min, float max)
+    {
+        return min + (max - min) * static_cast<float>(generator() >> 8) / static_cast<float>(1u << 24);
+    };
+
+    for (size_t i = 0; i < m_Settings.lightCount; ++i)
+    {
+        auto entity = createEntity("PointLight_" + std::to_string(i));
+        entity.addComponent<PointLightComponent>(glm::vec3{ random(0.2f, 1.f), random(0.2f, 1.f), random(0.2f, 1.f) }, 10.f, m_Settings.lightRadius);
+
+        auto& transform = entity.getComponent<TransformComponent>();
+        transform.setPosition({ random(-m_Extent, m_Extent), random(1.f, 4.f), random(-m_Extent, m_Extent) });
+    }
+
+    m_Camera.setFar(4.f * m_Extent + 50.f);
+    updateCamera();
+}
+
+void BenchScene::onUpdate(float dt)
+{
+    m_Frame++;
+    updateCamera();
+}
+
+void BenchScene::updateCamera()
+{
+    // Orbiting around the grid, looking at its center
+    const float angle = glm::two_pi<float>() * static_cast<float>(m_Frame % m_PathFrames) / static_cast<float>(m_PathFrames);
+    const float distance = 1.5f * m_Extent + 10.f;
+    const glm::vec3 position = { distance * std::cos(angle), 0.5f * m_Extent + 5.f, distance * std::sin(angle) };
+    const glm::vec3 direction = glm::normalize(-position);
+
+    // The view looks along -z, rotated by the pitch around x, then by the yaw around y
+    m_Camera.setWorldPosition(position);
+    m_Camera.setRotation({ std::asin(-direction.y), std::atan2(direction.x, -direction.z), 0.f });
+}
+
+} // namespace vrm
@@ -0,0 +1,164 @@
+#include "VroomBench/BenchSettings.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+#include <Vroom/Core/FrameStats.h>
+#include <Vroom/Core/Log.h>
+
+namespace vrm
+{
+
+template <typename T>
+static bool ParseValue(std::string_view text, T& value)
+{
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+template <typename T>
+static bool ParseList(std::string_view text, std::vector<T>& values)
+{
+    values.clear();
+    while (!text.empty())
+    {
+        const size_t comma = text.find(',');
+        T value;
+        if (!ParseValue(text.substr(0, comma), value))
+            return false;
+        values.push_back(value);
+
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+    }
+    return !values.empty();
+}
+
+// Lists of switches: 0 for off, 1 for on
+static bool ParseModes(std::string_view text, std::vector<int>& modes)
+{
+    return ParseList(text, modes) && std::all_of(modes.begin(), modes.end(), [](int mode) { return mode == 0 || mode == 1; });
+}
+
+bool BenchSettings::Parse(int argc, char** argv, BenchSettings& settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--help")
+            return false;
+
+        // Every bench option takes a value: --option value
+        const bool hasValue = i + 1 < argc;
+        const std::string_view value = hasValue ? argv[i + 1] : std::string_view();
+
+        bool valid = true;
+        if (argument == "--meshes")
+            valid = ParseList(value, settings.meshCounts);
+        else if (argument == "--materials")
+            valid = ParseList(value, settings.materialCounts);
+        else if (argument == "--lights")
+            valid = ParseList(value, settings.lightCounts);
+        else if (argument == "--light-radius")
+            valid = ParseList(value, settings.lightRadii);
+        else if (argument == "--active-clusters")
+            valid = ParseModes(value, settings.activeClusterModes);
+        else if (argument == "--light-binning")
+            valid = ParseModes(value, settings.lightBinningModes);
+        else if (argument == "--shared-culling")
+            valid = ParseModes(value, settings.sharedCullingModes);
+        else if (argument == "--cpu-culling")
+            valid = ParseModes(value, settings.cpuCullingModes);
+        else if (argument == "--light-budget")
+            valid = ParseList(value, settings.lightBudgets);
+        else if (argument == "--cluster-tile")
+            valid = ParseList(value, settings.clusterTileSizes)
+                && std::all_of(settings.clusterTileSizes.begin(), settings.clusterTileSizes.end(), [](unsigned int size) { return size > 0; });
+        else if (argument == "--warmup")
+            valid = ParseValue(value, settings.warmupFrames);
+        else if (argument == "--frames")
+            valid = ParseValue(value, settings.frames) && settings.frames > 0;
+        else if (argument == "--seed")
+            valid = ParseValue(value, settings.seed);
+        else if (argument == "--output")
+            settings.outputPath = value;
+        else
+            continue;
+
+        if (!hasValue)
+        {
+            VRM_LOG_ERROR("Missing value for {}.", argument);
+            return false;
+        }
+
+        if (!valid)
+        {
+            VRM_LOG_ERROR("Invalid value for {}: {}", argument, value);
+            return false;
+        }
+        ++i;
+    }
+
+    for (size_t materialCount : settings.materialCounts)
+    {
+        if (materialCount == 0)
+        {
+            VRM_LOG_ERROR("Material counts must be greater than 0.");
+            return false;
+        }
+    }
+
+    // Measured frames are read back from the frame statistics history
+    if (settings.frames > FrameStats::HistoryFrames)
+    {
+        VRM_LOG_WARN("Measured frames clamped from {} to {}.", settings.frames, FrameStats::HistoryFrames);
+        settings.frames = FrameStats::HistoryFrames;
+    }
+
+    return true;
+}
+
+void BenchSettings::PrintUsage()
+{
+    std::cout
+        << "Usage: VroomBench [options]\n"
+        << "Renders stress scenes offscreen and writes frame time and counter statistics as JSON.\n"
+        << "Lists are comma separated, every combination is measured.\n\n"
+        << "  --meshes <list>        Mesh counts (default 1000)\n"
+        << "  --materials <list>     Unique material counts (default 8)\n"
+        << "  --lights <list>        Point light counts (default 64)\n"
+        << "  --light-radius <list>  Point light radii (default 10)\n"
+        << "  --active-clusters <list> 1 to cull lights against clusters found by a depth prepass only (default 0)\n"
+        << "  --light-binning <list>   1 to bin each light into the clusters it covers (default 0)\n"
+        << "  --shared-culling <list>  1 for the shared memory light culling kernel, 0 for the global memory one\n"
+        << "                           (default: picked at startup)\n"
+        << "  --cpu-culling <list>     1 to cull lights on the CPU and upload the clusters (default 0)\n"
+        << "  --light-budget <list>    Lights sent to the GPU per frame, the most important ones (default 0: every visible light)\n"
+        << "  --cluster-tile <list>    Cluster tile sizes, in pixels (default 128)\n"
+        << "  --warmup <n>           Frames rendered before measuring each scene (default 30)\n"
+        << "  --frames <n>           Frames measured per scene (default 300)\n"
+        << "  --seed <n>             Seed of the light placement (default 1)\n"
+        << "  --output <path>        Output JSON file (default bench_results.json)\n"
+        << "  --window               Render in a visible window instead of offscreen\n";
+}
+
+std::vector<BenchSceneSettings> BenchSettings::getScenes() const
+{
+    std::vector<BenchSceneSettings> scenes;
+    for (size_t meshCount : meshCounts)
+        for (size_t materialCount : materialCounts)
+            for (size_t lightCount : lightCounts)
+                for (float lightRadius : lightRadii)
+                    for (int activeClusterMode : activeClusterModes)
+                        for (int lightBinningMode : lightBinningModes)
+                            for (int sharedCullingMode : sharedCullingModes)
+                                for (int cpuCullingMode : cpuCullingModes)
+                                    for (size_t lightBudget : lightBudgets)
+                                        for (unsigned int clusterTileSize : clusterTileSizes)
+                                            scenes.push_back({ meshCount, materialCount, lightCount, lightRadius, activeClusterMode == 1,
+                                                lightBinningMode == 1, sharedCullingMode, cpuCullingMode == 1, lightBudget, clusterTileSize });
+    return scenes;
+}
+
+} // namespace vrm
@@ -0,0 +1,69 @@
+#include "VroomBench/GeneratedAssets.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+#include <Vroom/Core/Assert.h>
+
+namespace vrm
+{
+
+// Unit cube with one normal per face. Faces are v/vt/vn, counter clockwise seen from outside.
+static constexpr const char* CUBE_VERTICES =
+    "v 1 -1 -1\nv 1 -1 1\nv -1 -1 1\nv -1 -1 -1\nv 1 1 -1\nv 1 1 1\nv -1 1 1\nv -1 1 -1\n"
+    "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+    "vn 0 -1 0\nvn 0 1 0\nvn 1 0 0\nvn 0 0 1\nvn -1 0 0\nvn 0 0 -1\n";
+
+static constexpr const char* CUBE_FACES =
+    "s off\n"
+    "f 2/1/1 3/2/1 4/3/1\nf 1/4/1 2/1/1 4/3/1\n"
+    "f 8/1/2 7/2/2 6/3/2\nf 5/4/2 8/1/2 6/3/2\n"
+    "f 5/1/3 6/2/3 2/3/3\nf 1/4/3 5/1/3 2/3/3\n"
+    "f 6/1/4 7/2/4 3/3/4\nf 2/4/4 6/1/4 3/3/4\n"
+    "f 3/1/5 7/2/5 8/3/5\nf 4/4/5 3/1/5 8/3/5\n"
+    "f 1/1/6 4/2/6 8/3/6\nf 5/4/6 1/1/6 8/3/6\n";
+
+std::vector<std::string> GeneratedAssets::WriteMaterialCubes(const std::string& directory, size_t materialCount)
+{
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::string> meshPaths;
+    meshPaths.reserve(materialCount);
+
+    for (size_t i = 0; i < materialCount; ++i)
+    {
+        const std::string name = "BenchMat_" + std::to_string(i);
+        const std::string meshPath = directory + "/BenchCube_" + std::to_string(i) + ".obj";
+        meshPaths.push_back(meshPath);
+
+        if (std::filesystem::exists(meshPath))
+            continue;
+
+        // Hues stepped by the golden ratio: neighbouring materials differ, and a material keeps its color whatever the count
+        const float hue = std::fmod(0.618034f * static_cast<float>(i), 1.f);
+        const float r = 0.5f + 0.5f * std::cos(6.2831853f * hue);
+        const float g = 0.5f + 0.5f * std::cos(6.2831853f * (hue - 1.f / 3.f));
+        const float b = 0.5f + 0.5f * std::cos(6.2831853f * (hue - 2.f / 3.f));
+
+        const std::string preFragPath = directory + "/" + name + "_PreFrag.glsl";
+        std::ofstream preFrag(preFragPath);
+        preFrag << "void PreFrag(out vec3 ambient, out vec3 diffuse, out vec3 specular, out float shininess)\n{\n"
+            << "    ambient = vec3(" << 0.1f * r << ", " << 0.1f * g << ", " << 0.1f * b << ");\n"
+            << "    diffuse = vec3(" << r << ", " << g << ", " << b << ");\n"
+            << "    specular = vec3(0.5, 0.5, 0.5);\n"
+            << "    shininess = 8.0;\n}\n";
+
+        std::ofstream material(directory + "/" + name + ".asset");
+        material << "shading-model Phong\n\nprefrag " << preFragPath << "\n";
+
+        std::ofstream mesh(meshPath);
+        mesh << "o BenchCube\n" << CUBE_VERTICES << "usemtl " << name << "\n" << CUBE_FACES;
+
+        VRM_ASSERT_MSG(preFrag.good() && material.good() && mesh.good(), "Failed to write bench assets to: {}", directory);
+    }
+
+    return meshPaths;
+}
+
+} // namespace vrm
@@ -0,0 +1,40 @@
+#include <string_view>
+#include <vector>
+
+#include <Vroom/Core/Application.h>
+#include <Vroom/Core/GameLayer.h>
+
+#include "VroomBench/BenchLayer.h"
+#include "VroomBench/BenchSettings.h"
+
+int main(int argc, char** argv)
+{
+	vrm::BenchSettings settings;
+	if (!vrm::BenchSettings::Parse(argc, argv, settings))
+	{
+		vrm::BenchSettings::PrintUsage();
+		return 1;
+	}
+
+	// Offscreen unless a window is explicitly requested
+	std::vector<char*> arguments(argv, argv + argc);
+	bool windowed = false;
+	for (int i = 1; i < argc; ++i)
+		windowed |= std::string_view(argv[i]) == "--window";
+
+	char headlessArgument[] = "--headless";
+	if (!windowed)
+		arguments.push_back(headlessArgument);
+
+	vrm::Application app{ static_cast<int>(arguments.size()), arguments.data() };
+
+	app.getGameLayer().createCustomEvent("Exit")
+		.bindInput(vrm::Event::Type::Exit)
+		.bindCallback([&app](const vrm::Event&) { app.exit(); });
+
+	app.pushLayer<vrm::BenchLayer>(settings);
+
+	app.run();
+
+	return 0;
+}
@@ -40,11 +40,6 @@ private:
     StatisticsPanel m_StatisticsPanel;
     Viewport m_Viewport;
 
-    // Frame time management
-    size_t m_FrameAccumulator;
-    float m_TimeAccumulator;
-    const float m_TimeSample;
-
 };
 
 } // namespace vrm
\ No newline at end of file
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
+#include <Vroom/Core/FrameStats.h>
+#include <Vroom/Render/Profiling/GPUProfiler.h>
+
 #include "VroomEditor/UserInterface/ImGuiElement.h"
 
 namespace vrm
@@ -15,7 +21,8 @@ protected:
     void onImgui() override;
 
 public: // Public ImGui related variables
-    float frameTime;
+    const FrameStats* frameStats;
+    const std::vector<GPUProfiler::ScopeStatistics>* gpuScopes;
 
 };
 
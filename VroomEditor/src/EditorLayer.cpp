@@ -1,8 +1,10 @@
 #include "VroomEditor/EditorLayer.h"
 
 #include <Vroom/Core/Application.h>
+#include <Vroom/Core/FrameStats.h>
 #include <Vroom/Core/GameLayer.h>
 #include <Vroom/Core/Window.h>
+#include <Vroom/Render/Profiling/GPUProfiler.h>
 
 #include "imgui.h"
 #include "backends/imgui_impl_glfw.h"
@@ -18,10 +20,7 @@ EditorLayer::EditorLayer()
     : m_MainMenuBar(),
       m_StatisticsPanel(),
       m_Viewport(),
-      m_Font(nullptr),
-      m_FrameAccumulator(0),
-      m_TimeAccumulator(0.f),
-      m_TimeSample(1.f)
+      m_Font(nullptr)
 {
     // We need to load a first scene before initialization of layers, because game layer will be initialized first.
     Application::Get().getGameLayer().loadScene<EditorScene>();
@@ -84,15 +83,11 @@ void EditorLayer::onEnd()
 
 void EditorLayer::onUpdate(float dt)
 {
-    // Frame time management
-    m_FrameAccumulator++;
-    m_TimeAccumulator += dt;
-    if (m_TimeAccumulator >= m_TimeSample)
-    {
-        m_StatisticsPanel.frameTime = m_TimeSample / m_FrameAccumulator;
-        m_FrameAccumulator = 0;
-        m_TimeAccumulator -= m_TimeSample;
-    }
+    // Frame times and counters of the previous frames
+    m_StatisticsPanel.frameStats = &FrameStats::Get();
+
+    // GPU timings, a few frames late
+    m_StatisticsPanel.gpuScopes = &GPUProfiler::Get().getScopes();
 
     // Handling viewport resize
     if (m_Viewport.didSizeChangeLastFrame())
@@ -142,6 +137,8 @@ void EditorLayer::onImgui()
     ImGui::PopFont();
 
     ImGui::Render();
+
+    VRM_GPU_PROFILE_SCOPE("ImGui");
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
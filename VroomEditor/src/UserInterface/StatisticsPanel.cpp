@@ -2,11 +2,16 @@
 
 #include <imgui.h>
 
+#include <Vroom/Core/Profiler.h>
+
 namespace vrm
 {
 
+// Number of frames written by a CPU trace capture
+static constexpr size_t CPU_TRACE_FRAME_COUNT = 10;
+
 StatisticsPanel::StatisticsPanel()
-    : frameTime(0.f)
+    : frameStats(nullptr), gpuScopes(nullptr)
 {
 }
 
@@ -18,8 +23,66 @@ void StatisticsPanel::onImgui()
 {
     ImGui::Begin("Statistics");
 
-    ImGui::Text("Frame time: %.5f s", frameTime);
-    ImGui::Text("Frame rate: %.0f FPS", 1.f / frameTime);
+    if (frameStats && frameStats->getFrameCount() > 0)
+    {
+        // Percentiles over the history, rather than a mean hiding spikes
+        const float median = frameStats->getFrameTimePercentile(50.f);
+        ImGui::Text("Frame time (ms): p50 %.2f  p95 %.2f  p99 %.2f",
+            median, frameStats->getFrameTimePercentile(95.f), frameStats->getFrameTimePercentile(99.f));
+        ImGui::Text("Frame rate: %.0f FPS", median > 0.f ? 1000.f / median : 0.f);
+
+        ImGui::Separator();
+
+        const auto& lastFrame = frameStats->getLastFrame();
+        for (size_t i = 0; i < FrameStats::CounterCount; ++i)
+        {
+            const auto counter = static_cast<FrameStats::Counter>(i);
+            const auto name = FrameStats::GetCounterName(counter);
+            ImGui::Text("%.*s: %.6g", static_cast<int>(name.size()), name.data(), lastFrame.get(counter));
+        }
+
+        ImGui::Separator();
+    }
+
+    ImGui::Text("GPU time (ms)");
+    if (gpuScopes && ImGui::BeginTable("GPUScopes", 4, ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Scope");
+        ImGui::TableSetupColumn("Min");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableHeadersRow();
+
+        for (const auto& scope : *gpuScopes)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%*s%s", static_cast<int>(scope.depth * 2), "", scope.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.milliseconds.getMin());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.milliseconds.getAverage());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.milliseconds.getMax());
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+
+    // Trace readable by chrome://tracing or Perfetto
+    ImGui::BeginDisabled(Profiler::IsCapturing());
+    if (ImGui::Button("Capture CPU trace"))
+        Profiler::CaptureFrames(CPU_TRACE_FRAME_COUNT, "cpu_trace.json");
+    ImGui::EndDisabled();
+
+    // Frame statistics are streamed as they end, for offline analysis
+    auto& engineFrameStats = FrameStats::Get();
+    if (!engineFrameStats.isRecording() && ImGui::Button("Record frame statistics"))
+        engineFrameStats.startRecording("frame_stats.csv", FrameStats::Format::CSV);
+    else if (engineFrameStats.isRecording() && ImGui::Button("Stop recording"))
+        engineFrameStats.stopRecording();
 
     ImGui::End();
 }